@@ -0,0 +1,64 @@
+//	Copyright (c) 2008-2022 Ryo Suzuki.
+//	Copyright (c) 2016-2022 OpenSiv3D Project.
+//	Licensed under the MIT License.
+
+# version 410
+
+//
+//	VSInput
+//
+layout(location = 0) in vec4 VertexPosition;
+layout(location = 1) in vec3 VertexNormal;
+layout(location = 2) in vec2 VertexUV;
+
+//
+//	VSOutput
+//
+layout(location = 0) out vec3 WorldPosition;
+layout(location = 1) out vec2 UV;
+layout(location = 2) out vec3 Normal;
+layout(location = 3) flat out vec4 DiffuseColor;
+out gl_PerVertex
+{
+	vec4 gl_Position;
+};
+
+//
+//	Constant Buffer
+//
+layout(std140) uniform VSPerView
+{
+	mat4x4 g_worldToProjected;
+};
+
+struct Instance
+{
+	mat4x4 localToWorld;
+	vec4   diffuseColor;
+};
+
+// Must match GL4Instance3DBuffer::MaxInstancesPerDraw
+layout(std140) uniform VSPerInstance
+{
+	Instance g_instances[192];
+};
+
+layout(std140) uniform VSPerMaterial
+{
+	vec4 g_uvTransform;
+};
+
+//
+//	Functions
+//
+void main()
+{
+	mat4x4 localToWorld = g_instances[gl_InstanceID].localToWorld;
+	vec4 worldPosition = VertexPosition * localToWorld;
+
+	gl_Position		= worldPosition * g_worldToProjected;
+	WorldPosition	= worldPosition.xyz;
+	UV				= (VertexUV * g_uvTransform.xy + g_uvTransform.zw);
+	Normal			= VertexNormal * mat3x3(localToWorld);
+	DiffuseColor	= g_instances[gl_InstanceID].diffuseColor;
+}
@@ -186,6 +186,9 @@
 // スレッド | Thread
 # include <Siv3D/Threading.hpp>
 
+// スレッドプール | Thread pool
+# include <Siv3D/ThreadPool.hpp>
+
 // 非同期タスク | Asynchronous task
 # include <Siv3D/AsyncTask.hpp>
 
@@ -1144,6 +1147,7 @@
 # include <Siv3D/ImageDecoder.hpp>
 
 # include <Siv3D/PNGFilter.hpp>
+# include <Siv3D/PNGCompression.hpp>
 # include <Siv3D/ImageFormat/PNGDecoder.hpp>
 # include <Siv3D/ImageFormat/PNGEncoder.hpp>
 
@@ -1618,6 +1622,7 @@
 
 # include <Siv3D/TextStyle.hpp>
 # include <Siv3D/DrawableText.hpp>
+# include <Siv3D/PreparedText.hpp>
 # include <Siv3D/Print.hpp>
 # include <Siv3D/PutText.hpp>
 # include <Siv3D/Icon.hpp>
@@ -1700,6 +1705,9 @@
 // スクリーンキャプチャ | Screen capture
 # include <Siv3D/ScreenCapture.hpp>
 
+// 画面の録画 | Screen recorder
+# include <Siv3D/ScreenRecorder.hpp>
+
 //////////////////////////////////////////////////
 //
 //	2D パーティクルシステム | 2D Particle System
@@ -1740,6 +1748,10 @@
 # include <Siv3D/Physics2D/P2ContactPair.hpp>
 # include <Siv3D/Physics2D/P2Contact.hpp>
 # include <Siv3D/Physics2D/P2Collision.hpp>
+# include <Siv3D/Physics2D/P2ContactMode.hpp>
+# include <Siv3D/Physics2D/P2ContactEvent.hpp>
+# include <Siv3D/Physics2D/P2RaycastHit.hpp>
+# include <Siv3D/Physics2D/P2BodyStates.hpp>
 # include <Siv3D/Physics2D/P2World.hpp>
 # include <Siv3D/Physics2D/P2Body.hpp>
 # include <Siv3D/Physics2D/P2Shape.hpp>
@@ -25,6 +25,7 @@
 # include "String.hpp"
 # include "Meta.hpp"
 # include "Threading.hpp"
+# include "ThreadPool.hpp"
 # include "FormatData.hpp"
 # include "Format.hpp"
 # include "FormatLiteral.hpp"
@@ -1096,6 +1097,37 @@ namespace s3d
 		template <class Fty, std::enable_if_t<std::is_invocable_v<Fty, Type>>* = nullptr>
 		auto parallel_map(Fty f) const;
 
+		/// @brief 指定したスレッドプールを使って、条件を満たす要素の個数を並列に数えます。
+		/// @tparam Fty 条件を記述した関数の型
+		/// @param f 条件を記述した関数
+		/// @param pool 使用するスレッドプール
+		/// @return 条件を満たす要素の個数
+		template <class Fty, std::enable_if_t<std::is_invocable_r_v<bool, Fty, Type>>* = nullptr>
+		[[nodiscard]]
+		size_t parallel_count_if(Fty f, ThreadPool& pool) const;
+
+		/// @brief 指定したスレッドプールを使って、全ての要素に対して並列に関数を呼び出します。
+		/// @tparam Fty 呼び出す関数の型
+		/// @param f 呼び出す関数
+		/// @param pool 使用するスレッドプール
+		template <class Fty, std::enable_if_t<std::is_invocable_v<Fty, Type&>>* = nullptr>
+		void parallel_each(Fty f, ThreadPool& pool);
+
+		/// @brief 指定したスレッドプールを使って、全ての要素に対して並列に関数を呼び出します。
+		/// @tparam Fty 呼び出す関数の型
+		/// @param f 呼び出す関数
+		/// @param pool 使用するスレッドプール
+		template <class Fty, std::enable_if_t<std::is_invocable_v<Fty, Type>>* = nullptr>
+		void parallel_each(Fty f, ThreadPool& pool) const;
+
+		/// @brief 指定したスレッドプールを使って、全ての要素に並列に関数を適用した結果からなる新しい配列を返します。
+		/// @tparam Fty 適用する関数の型
+		/// @param f 適用する関数
+		/// @param pool 使用するスレッドプール
+		/// @return 新しい配列
+		template <class Fty, std::enable_if_t<std::is_invocable_v<Fty, Type>>* = nullptr>
+		auto parallel_map(Fty f, ThreadPool& pool) const;
+
 	# endif
 
 		/// @brief 
@@ -13,8 +13,11 @@
 # ifndef SIV3D_NO_CONCURRENT_API
 
 # include <future>
+# include <thread>
+# include <functional>
 # include <type_traits>
 # include "Platform.hpp"
+# include "ThreadPool.hpp"
 
 namespace s3d
 {
@@ -43,12 +46,25 @@ namespace s3d
 		/// @tparam ...Args 非同期処理のタスクで実行する関数の引数の型
 		/// @param f 非同期処理のタスクで実行する関数
 		/// @param ...args 非同期処理のタスクで実行する関数の引数
-		/// @remark 作成と同時にタスクが非同期で実行されます
+		/// @remark 作成と同時にタスクが専用のスレッドで非同期に実行されます（`std::async(std::launch::async, ...)` と同じです）
 		template <class Fty, class... Args, std::enable_if_t<std::is_invocable_v<Fty, Args...>>* = nullptr>
 		SIV3D_NODISCARD_CXX20
 		explicit AsyncTask(Fty&& f, Args&&... args);
 
-		~AsyncTask() = default;
+		/// @brief 指定したスレッドプールで実行される非同期処理のタスクを作成します
+		/// @tparam Fty 非同期処理のタスクで実行する関数の型
+		/// @tparam ...Args 非同期処理のタスクで実行する関数の引数の型
+		/// @param pool タスクを実行するスレッドプール
+		/// @param f 非同期処理のタスクで実行する関数
+		/// @param ...args 非同期処理のタスクで実行する関数の引数
+		/// @remark 作成と同時にタスクが非同期で実行されます
+		template <class Fty, class... Args, std::enable_if_t<std::is_invocable_v<Fty, Args...>>* = nullptr>
+		SIV3D_NODISCARD_CXX20
+		AsyncTask(ThreadPool& pool, Fty&& f, Args&&... args);
+
+		/// @brief デストラクタ
+		/// @remark 実行中のタスクを持つ場合、`std::async` と同様に完了を待ちます
+		~AsyncTask();
 
 		AsyncTask(const base_type&) = delete;
 		
@@ -94,21 +110,43 @@ namespace s3d
 	private:
 
 		base_type m_data;
+
+		// タスクを実行しているスレッドプール（`std::future` から作成した場合は nullptr）
+		ThreadPool* m_pool = nullptr;
+
+		void release();
 	};
 
 	template <class Fty, class... Args, std::enable_if_t<std::is_invocable_v<Fty, Args...>>* = nullptr>
 	AsyncTask(Fty, Args...)->AsyncTask<std::invoke_result_t<std::decay_t<Fty>, std::decay_t<Args>...>>;
 
+	template <class Fty, class... Args, std::enable_if_t<std::is_invocable_v<Fty, Args...>>* = nullptr>
+	AsyncTask(ThreadPool&, Fty, Args...)->AsyncTask<std::invoke_result_t<std::decay_t<Fty>, std::decay_t<Args>...>>;
+
 	/// @brief 非同期処理のタスクを作成します
 	/// @tparam Fty 非同期処理のタスクで実行する関数の型
 	/// @tparam ...Args 非同期処理のタスクで実行する関数の引数の型
 	/// @param f 非同期処理のタスクで実行する関数
 	/// @param ...args 非同期処理のタスクで実行する関数の引数
-	/// @remark 作成と同時にタスクが非同期で実行されます
+	/// @remark 作成と同時にタスクが専用のスレッドで非同期に実行されます（`std::async(std::launch::async, ...)` と同じです）
+	/// @remark 通信やほかのスレッドの待機など、長時間ブロックする処理にも使えます。短いタスクを多数実行する場合は、スレッドを起動するコストがかからない `Async(Threading::GetDefaultPool(), f)` を使ってください
 	/// @return 作成された非同期処理のタスク
 	template <class Fty, class... Args, std::enable_if_t<std::is_invocable_v<Fty, Args...>>* = nullptr>
 	[[nodiscard]]
 	inline auto Async(Fty&& f, Args&&... args);
+
+	/// @brief 指定したスレッドプールで実行される非同期処理のタスクを作成します
+	/// @tparam Fty 非同期処理のタスクで実行する関数の型
+	/// @tparam ...Args 非同期処理のタスクで実行する関数の引数の型
+	/// @param pool タスクを実行するスレッドプール
+	/// @param f 非同期処理のタスクで実行する関数
+	/// @param ...args 非同期処理のタスクで実行する関数の引数
+	/// @remark 作成と同時にタスクが非同期で実行されます
+	/// @remark スレッドプールのワーカースレッドの数は固定のため、長時間ブロックする処理には `Async(f)` を使ってください
+	/// @return 作成された非同期処理のタスク
+	template <class Fty, class... Args, std::enable_if_t<std::is_invocable_v<Fty, Args...>>* = nullptr>
+	[[nodiscard]]
+	inline auto Async(ThreadPool& pool, Fty&& f, Args&&... args);
 }
 
 # include "detail/AsyncTask.ipp"
@@ -15,6 +15,7 @@
 # include "Font.hpp"
 # include "Format.hpp"
 # include "TextStyle.hpp"
+# include "PreparedText.hpp"
 
 namespace s3d
 {
@@ -41,6 +42,11 @@ namespace s3d
 		[[nodiscard]]
 		Array<double> getXAdvances(double size) const;
 
+		/// @brief グリフの配置とテクスチャ領域をあらかじめ計算したテキストを作成します。
+		/// @return グリフの配置とテクスチャ領域をあらかじめ計算したテキスト
+		[[nodiscard]]
+		PreparedText prepare() const;
+
 		/// @brief テキストが描画される領域を返します。
 		/// @param x 描画する左上の X 座標
 		/// @param y 描画する左上の Y 座標
@@ -177,6 +177,19 @@ namespace s3d
 		[[nodiscard]]
 		int32 getBufferThickness() const;
 
+		/// @brief グリフをキャッシュするテクスチャの使用メモリの上限を設定します。
+		/// @param bytes 使用メモリの上限（バイト）
+		/// @remark デフォルト値は 64 MiB です。
+		/// @remark 上限を超えると、最も長く使われていないページを空にして再利用します。現在のフレームで使われているページは再利用しないため、一時的に上限を超えることがあります。
+		/// @remark ただし、ページが 4 つ以上あり、上限の 2 倍を超える場合は、次のフレームでページを再利用できるようになるまで新しいグリフを追加しません。
+		/// @return *this
+		const Font& setGlyphCacheMemoryBudget(size_t bytes) const;
+
+		/// @brief グリフをキャッシュするテクスチャの使用メモリの上限を返します。
+		/// @return グリフをキャッシュするテクスチャの使用メモリの上限（バイト）
+		[[nodiscard]]
+		size_t getGlyphCacheMemoryBudget() const;
+
 		/// @brief 指定した文字のグリフを持つかを返します。
 		/// @param ch 文字
 		/// @return グリフを持つ場合 true, それ以外の場合は false
@@ -405,7 +418,24 @@ namespace s3d
 		/// @return 事前生成に成功した場合 true, それ以外の場合は false
 		bool preload(StringView chars) const;
 
+		/// @brief 指定した文字列のためのグリフを、バックグラウンドで事前生成します。
+		/// @param chars 文字列
+		/// @remark レンダリング方式が SDF, MSDF の場合、グリフの画像はワーカースレッドで生成され、次以降のフレームの最初の描画の際にキャッシュテクスチャに追加されます。
+		/// @remark 生成中のグリフは、生成が完了するまで描画されません。文字の幅などは通常どおり計算されます。
+		/// @remark レンダリング方式が Bitmap の場合は `preload()` と同じです。
+		/// @return 事前生成の開始に成功した場合 true, それ以外の場合は false
+		bool preloadAsync(StringView chars) const;
+
+		/// @brief キャッシュされている SDF, MSDF のグリフを、次回の実行で再利用できるようキャッシュファイルに書き込みます。
+		/// @remark 次回の実行では、同じフォントファイルと設定のフォントが最初にグリフを必要としたときに、キャッシュファイルからグリフを読み込みます。
+		/// @remark キャッシュの大きさによっては書き込みに時間がかかるため、シーンの切り替え時などに呼ぶことを推奨します。
+		/// @remark レンダリング方式が Bitmap の場合は何もしません。
+		/// @return 書き込んだ場合 true, 前回の読み込みや書き込みから変更が無い場合や、書き込みに失敗した場合は false
+		bool saveGlyphCache() const;
+
 		/// @brief フォントの内部でキャッシュされているテクスチャを返します。
+		/// @remark グリフのキャッシュは複数のページ（テクスチャ）に分かれることがあり、この関数は最初のページのみを返します。2 ページ目以降にキャッシュされたグリフは含まれません。
+		/// @remark 個々のグリフのテクスチャは `getGlyph()` で取得してください。使われなくなったページは再利用されるため、テクスチャの内容は後のフレームで変わることがあります。
 		/// @return フォントの内部でキャッシュされているテクスチャ
 		[[nodiscard]]
 		const Texture& getTexture() const;
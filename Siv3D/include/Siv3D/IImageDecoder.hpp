@@ -17,6 +17,7 @@
 # include "Image.hpp"
 # include "Optional.hpp"
 # include "Grid.hpp"
+# include "2DShapes.hpp"
 # include "BinaryReader.hpp"
 
 namespace s3d
@@ -54,6 +55,31 @@ namespace s3d
 
 		[[nodiscard]]
 		virtual Grid<uint16> decodeGray16(IReader&, FilePathView) const;
+
+		/// @brief 画像データを、指定した大きさに収まるよう縮小してデコードします。
+		/// @param reader 画像データの IReader インタフェース
+		/// @param targetSize 画像の最大の大きさ（ピクセル）
+		/// @param pathHint ファイルパス（オプション）
+		/// @return 作成した Image
+		/// @remark デフォルトの実装は、画像全体をデコードしてから縮小します。
+		[[nodiscard]]
+		virtual Image decodeScaled(IReader& reader, const Size& targetSize, FilePathView pathHint) const;
+
+		/// @brief 画像データの一部の領域をデコードします。
+		/// @param reader 画像データの IReader インタフェース
+		/// @param region デコードする領域
+		/// @param pathHint ファイルパス（オプション）
+		/// @return 作成した Image。領域のうち画像の範囲外の部分は含まれません
+		/// @remark デフォルトの実装は、画像全体をデコードしてから切り出します。
+		[[nodiscard]]
+		virtual Image decodeRegion(IReader& reader, const Rect& region, FilePathView pathHint) const;
+
+		/// @brief `decodeScaled()` が返す画像の大きさを計算します。
+		/// @param imageSize 元の画像の大きさ（ピクセル）
+		/// @param targetSize 画像の最大の大きさ（ピクセル）
+		/// @return アスペクト比を保ったまま targetSize に収まる大きさ。拡大はしません
+		[[nodiscard]]
+		static Size ScaledSize(const Size& imageSize, const Size& targetSize) noexcept;
 	};
 }
 
@@ -24,6 +24,7 @@
 # include "ColorHSV.hpp"
 # include "IReader.hpp"
 # include "PNGFilter.hpp"
+# include "PNGCompression.hpp"
 # include "PPMType.hpp"
 # include "WebPMethod.hpp"
 # include "BorderType.hpp"
@@ -382,10 +383,10 @@ namespace s3d
 
 		bool saveWithDialog() const;
 
-		bool savePNG(FilePathView path, PNGFilter filter = PNGEncoder::DefaultFilter) const;
+		bool savePNG(FilePathView path, PNGFilter filter = PNGEncoder::DefaultFilter, PNGCompression compression = PNGEncoder::DefaultCompression) const;
 
 		[[nodiscard]]
-		Blob encodePNG(PNGFilter filter = PNGEncoder::DefaultFilter) const;
+		Blob encodePNG(PNGFilter filter = PNGEncoder::DefaultFilter, PNGCompression compression = PNGEncoder::DefaultCompression) const;
 
 		bool saveJPEG(FilePathView path, int32 quality = JPEGEncoder::DefaultQuality) const;
 
@@ -40,6 +40,42 @@ namespace s3d
 		[[nodiscard]]
 		Grid<uint16> DecodeGray16(IReader& reader, ImageFormat imageFormat = ImageFormat::Unspecified);
 
+		/// @brief 画像ファイルを、指定した大きさに収まるよう縮小してデコードします。
+		/// @param path 画像ファイルのパス
+		/// @param targetSize 画像の最大の大きさ（ピクセル）
+		/// @param imageFormat 画像ファイルのフォーマット
+		/// @return 作成した Image
+		/// @remark `Decode(path).fitted(targetSize, AllowScaleUp::No)` と同じ大きさの画像を返します。JPEG と PNG は、元の大きさの画像を作成せずにデコードします。
+		[[nodiscard]]
+		Image DecodeScaled(FilePathView path, const Size& targetSize, ImageFormat imageFormat = ImageFormat::Unspecified);
+
+		/// @brief 画像データを、指定した大きさに収まるよう縮小してデコードします。
+		/// @param reader 画像データの IReader インタフェース
+		/// @param targetSize 画像の最大の大きさ（ピクセル）
+		/// @param imageFormat 画像データのフォーマット
+		/// @return 作成した Image
+		/// @remark `Decode(reader).fitted(targetSize, AllowScaleUp::No)` と同じ大きさの画像を返します。JPEG と PNG は、元の大きさの画像を作成せずにデコードします。
+		[[nodiscard]]
+		Image DecodeScaled(IReader& reader, const Size& targetSize, ImageFormat imageFormat = ImageFormat::Unspecified);
+
+		/// @brief 画像ファイルの一部の領域をデコードします。
+		/// @param path 画像ファイルのパス
+		/// @param region デコードする領域
+		/// @param imageFormat 画像ファイルのフォーマット
+		/// @return 作成した Image。領域のうち画像の範囲外の部分は含まれません
+		/// @remark JPEG は領域を含むブロックだけを、PNG は領域の下端までの行だけをデコードします。
+		[[nodiscard]]
+		Image DecodeRegion(FilePathView path, const Rect& region, ImageFormat imageFormat = ImageFormat::Unspecified);
+
+		/// @brief 画像データの一部の領域をデコードします。
+		/// @param reader 画像データの IReader インタフェース
+		/// @param region デコードする領域
+		/// @param imageFormat 画像データのフォーマット
+		/// @return 作成した Image。領域のうち画像の範囲外の部分は含まれません
+		/// @remark JPEG は領域を含むブロックだけを、PNG は領域の下端までの行だけをデコードします。
+		[[nodiscard]]
+		Image DecodeRegion(IReader& reader, const Rect& region, ImageFormat imageFormat = ImageFormat::Unspecified);
+
 		template <class ImageDecoder>
 		bool Add();
 
@@ -65,5 +65,23 @@ namespace s3d
 		/// @return 作成した Image
 		[[nodiscard]]
 		Image decode(IReader& reader, FilePathView pathHint = {}) const override;
+
+		/// @brief JPEG 形式の画像データを、指定した大きさに収まるよう縮小してデコードします。
+		/// @param reader 画像データの IReader インタフェース
+		/// @param targetSize 画像の最大の大きさ（ピクセル）
+		/// @param pathHint ファイルパス（オプション）
+		/// @return 作成した Image
+		/// @remark libjpeg-turbo の DCT スケーリングで targetSize 以上の最小の大きさにデコードしてから縮小します。
+		[[nodiscard]]
+		Image decodeScaled(IReader& reader, const Size& targetSize, FilePathView pathHint = {}) const override;
+
+		/// @brief JPEG 形式の画像データの一部の領域をデコードします。
+		/// @param reader 画像データの IReader インタフェース
+		/// @param region デコードする領域
+		/// @param pathHint ファイルパス（オプション）
+		/// @return 作成した Image。領域のうち画像の範囲外の部分は含まれません
+		/// @remark 領域を含む MCU ブロックだけをロスレスに切り出してからデコードします。
+		[[nodiscard]]
+		Image decodeRegion(IReader& reader, const Rect& region, FilePathView pathHint = {}) const override;
 	};
 }
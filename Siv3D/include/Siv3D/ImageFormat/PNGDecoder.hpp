@@ -67,6 +67,24 @@ namespace s3d
 		[[nodiscard]]
 		Image decode(IReader& reader, FilePathView pathHint = {}) const override;
 
+		/// @brief PNG 形式の画像データを、指定した大きさに収まるよう縮小してデコードします。
+		/// @param reader 画像データの IReader インタフェース
+		/// @param targetSize 画像の最大の大きさ（ピクセル）
+		/// @param pathHint ファイルパス（オプション）
+		/// @return 作成した Image
+		/// @remark 1 行ずつデコードしながら整数倍の平均で縮小するため、元の大きさの画像は作成しません。インタレース PNG は画像全体をデコードします。
+		[[nodiscard]]
+		Image decodeScaled(IReader& reader, const Size& targetSize, FilePathView pathHint = {}) const override;
+
+		/// @brief PNG 形式の画像データの一部の領域をデコードします。
+		/// @param reader 画像データの IReader インタフェース
+		/// @param region デコードする領域
+		/// @param pathHint ファイルパス（オプション）
+		/// @return 作成した Image。領域のうち画像の範囲外の部分は含まれません
+		/// @remark 領域の下端より後の行はデコードしません。インタレース PNG は画像全体をデコードします。
+		[[nodiscard]]
+		Image decodeRegion(IReader& reader, const Rect& region, FilePathView pathHint = {}) const override;
+
 		/// @brief 16-bit グレースケール PNG の画像ファイルをデコードして Grid を作成します。
 		/// @param path 画像ファイルのパス
 		/// @return 作成した Grid
@@ -12,6 +12,7 @@
 # pragma once
 # include <Siv3D/IImageEncoder.hpp>
 # include <Siv3D/PNGFilter.hpp>
+# include <Siv3D/PNGCompression.hpp>
 # include <Siv3D/Grid.hpp>
 
 namespace s3d
@@ -24,6 +25,9 @@ namespace s3d
 		/// @brief デフォルトの PNG フィルタ (PNGFilter::Default)
 		static constexpr PNGFilter DefaultFilter = PNGFilter::Default;
 
+		/// @brief デフォルトの圧縮のプリセット (PNGCompression::Default)
+		static constexpr PNGCompression DefaultCompression = PNGCompression::Default;
+
 		/// @brief エンコーダの対応形式 `U"PNG"` を返します。
 		/// @return 文字列 `U"PNG"`
 		[[nodiscard]]
@@ -52,6 +56,14 @@ namespace s3d
 		/// @return 保存に成功した場合 true, それ以外の場合は false
 		bool save(const Image& image, FilePathView path, PNGFilter filter) const;
 
+		/// @brief Image を PNG 形式でエンコードしてファイルに保存します。
+		/// @param image エンコードする Image
+		/// @param path 保存するファイルのパス
+		/// @param filter 使用するフィルタ
+		/// @param compression 圧縮のプリセット
+		/// @return 保存に成功した場合 true, それ以外の場合は false
+		bool save(const Image& image, FilePathView path, PNGFilter filter, PNGCompression compression) const;
+
 		/// @brief 16-bit グレースケールデータ (Grid) を PNG 形式でエンコードしてファイルに保存します。
 		/// @param image エンコードする Grid
 		/// @param path 保存するファイルのパス
@@ -72,6 +84,15 @@ namespace s3d
 		/// @return 書き出しに成功した場合 true, それ以外の場合は false
 		bool encode(const Image& image, IWriter& writer, PNGFilter filter) const;
 
+		/// @brief Image を PNG 形式でエンコードして書き出します。
+		/// @param image エンコードする Image
+		/// @param writer 書き出し先の IWriter インタフェース
+		/// @param filter 使用するフィルタ
+		/// @param compression 圧縮のプリセット
+		/// @return 書き出しに成功した場合 true, それ以外の場合は false
+		/// @remark 画像を行の帯に分割し、フィルタと圧縮を複数のスレッドで並列に行います。
+		bool encode(const Image& image, IWriter& writer, PNGFilter filter, PNGCompression compression) const;
+
 		/// @brief 16-bit グレースケールデータ (Grid) を PNG 形式でエンコードして書き出します。
 		/// @param image エンコードする Grid
 		/// @param writer 書き出し先の IWriter インタフェース
@@ -92,6 +113,15 @@ namespace s3d
 		[[nodiscard]]
 		Blob encode(const Image& image, PNGFilter filter) const;
 
+		/// @brief Image を PNG 形式でエンコードした結果を Blob で返します。
+		/// @param image エンコードする Image
+		/// @param filter 使用するフィルタ
+		/// @param compression 圧縮のプリセット
+		/// @return エンコード結果
+		/// @remark 画像を行の帯に分割し、フィルタと圧縮を複数のスレッドで並列に行います。
+		[[nodiscard]]
+		Blob encode(const Image& image, PNGFilter filter, PNGCompression compression) const;
+
 		/// @brief 16-bit グレースケールデータ (Grid) を PNG 形式でエンコードした結果を Blob で返します。
 		/// @param image エンコードする Grid
 		/// @param filter 使用するフィルタ
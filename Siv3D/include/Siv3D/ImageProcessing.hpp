@@ -39,6 +39,15 @@ namespace s3d
 		[[nodiscard]]
 		Array<Image> GenerateMips(const Image& src, size_t maxLevel);
 
+		/// @brief 画像からミップマップ画像を作成します。
+		/// @param src 画像
+		/// @param maxLevel ミップマップの最大個数（この値が 2 の場合、一辺の大きさが 1/2 と 1/4 のミップマップが生成される）
+		/// @param isSRGB 画像の色を sRGB として扱い、線形な色空間で平均する場合は `IsSRGB::Yes`
+		/// @return ミップマップ画像
+		/// @remark 各レベルは、1 つ上のレベルの 2x2 ピクセルの平均です。大きなレベルは行ごとに分割して並列に処理します。
+		[[nodiscard]]
+		Array<Image> GenerateMips(const Image& src, size_t maxLevel, IsSRGB isSRGB);
+
 		void Sobel(const Image& src, Image& dst, int32 dx = 1, int32 dy = 1, int32 apertureSize = 3);
 
 		void Laplacian(const Image& src, Image& dst, int32 apertureSize = 3);
@@ -10,6 +10,7 @@
 //-----------------------------------------------
 
 # pragma once
+# include <functional>
 # include "Common.hpp"
 # include "Array.hpp"
 # include "Optional.hpp"
@@ -513,6 +514,34 @@ namespace s3d
 		[[nodiscard]]
 		static JSON Load(std::unique_ptr<IReader>&& reader, AllowExceptions allowExceptions = AllowExceptions::No);
 
+		/// @brief JSON ファイルを先頭から逐次読み込み、ルートの配列の各要素に対して関数を呼び出します。
+		/// @tparam Fty 呼び出す関数の型。`bool(const JSON&)` または `void(const JSON&)`
+		/// @param path ファイルパス
+		/// @param f 要素ごとに呼び出す関数。false を返すと読み込みを中断します
+		/// @param allowExceptions 例外を発生させるか
+		/// @return 読み込みに成功した（または f によって中断された）場合 true, それ以外の場合は false
+		/// @remark ファイル全体を展開しないため、メモリに収まらない大きさのファイルも読み込めます。
+		template <class Fty, std::enable_if_t<std::is_invocable_v<Fty, const JSON&>>* = nullptr>
+		static bool ForEach(FilePathView path, Fty f, AllowExceptions allowExceptions = AllowExceptions::No);
+
+		/// @brief JSON ファイルを先頭から逐次読み込み、JSON Pointer が指す配列の各要素に対して関数を呼び出します。
+		/// @tparam Fty 呼び出す関数の型。`bool(const JSON&)` または `void(const JSON&)`
+		/// @param path ファイルパス
+		/// @param jsonPointer 対象の値を指す JSON Pointer
+		/// @param f 要素ごとに呼び出す関数。false を返すと読み込みを中断します
+		/// @param allowExceptions 例外を発生させるか
+		/// @return 読み込みに成功した（または f によって中断された）場合 true, それ以外の場合は false
+		/// @remark JSON Pointer が指す値が配列でない場合は、その値に対して 1 回だけ関数を呼び出します。
+		/// @remark 対象の要素以外は JSON オブジェクトとして展開されません。
+		template <class Fty, std::enable_if_t<std::is_invocable_v<Fty, const JSON&>>* = nullptr>
+		static bool ForEach(FilePathView path, StringView jsonPointer, Fty f, AllowExceptions allowExceptions = AllowExceptions::No);
+
+		template <class Reader, class Fty, std::enable_if_t<std::is_base_of_v<IReader, Reader> && std::is_invocable_v<Fty, const JSON&>>* = nullptr>
+		static bool ForEach(Reader&& reader, StringView jsonPointer, Fty f, AllowExceptions allowExceptions = AllowExceptions::No);
+
+		template <class Fty, std::enable_if_t<std::is_invocable_v<Fty, const JSON&>>* = nullptr>
+		static bool ForEach(std::unique_ptr<IReader>&& reader, StringView jsonPointer, Fty f, AllowExceptions allowExceptions = AllowExceptions::No);
+
 		/// @brief JSON 文字列をパースして JSON オブジェクトを返します。
 		/// @param str 文字列
 		/// @param allowExceptions 例外を発生させるか
@@ -569,6 +598,17 @@ namespace s3d
 		Optional<double> getOptDouble() const;
 
 		Optional<bool> getOptBool() const;
+
+		static JSON LoadUTF8(std::unique_ptr<IReader>&& reader, AllowExceptions allowExceptions);
+
+		static JSON ParseUTF8(const char* begin, const char* end, AllowExceptions allowExceptions);
+
+		static bool ForEachImpl(FilePathView path, StringView jsonPointer, const std::function<bool(const JSON&)>& callback, AllowExceptions allowExceptions);
+
+		static bool ForEachImpl(std::unique_ptr<IReader>&& reader, StringView jsonPointer, const std::function<bool(const JSON&)>& callback, AllowExceptions allowExceptions);
+
+		template <class Fty>
+		static std::function<bool(const JSON&)> MakeForEachCallback(Fty&& f);
 	};
 
 	struct JSONItem
@@ -281,6 +281,20 @@ namespace s3d
 		/// @return *this
 		const Line& drawDoubleHeadedArrow(double width = 1.0, const SizeF& headSize = SizeF{ 5.0, 5.0 }, const ColorF& color = Palette::White) const;
 
+		/// @brief 複数の線分をまとめて描きます。
+		/// @param lines 線分の配列
+		/// @param thickness 線分の太さ
+		/// @param color 色
+		/// @remark 線のスタイルは LineStyle::SquareCap です。1 つずつ draw() するよりも、頂点の作成にかかる時間が短くなります。
+		static void DrawBatch(const Array<Line>& lines, double thickness = 1.0, const ColorF& color = Palette::White);
+
+		/// @brief 複数の線分をまとめて描きます。
+		/// @param lines 線分の配列
+		/// @param thickness 線分の太さ
+		/// @param colors 線分ごとの色の配列
+		/// @remark lines と colors の要素数が異なる場合、少ないほうの数だけ描きます。
+		static void DrawBatch(const Array<Line>& lines, double thickness, const Array<ColorF>& colors);
+
 
 		template <class CharType>
 		friend std::basic_ostream<CharType>& operator <<(std::basic_ostream<CharType>& output, const Line& value)
@@ -17,6 +17,16 @@
 
 namespace s3d
 {
+	/// @brief ログの書き込み待ちのバッファがいっぱいのときの動作
+	enum class LogOverflowPolicy : uint8
+	{
+		/// @brief 書き込めなかったログを破棄します。
+		Drop,
+
+		/// @brief バッファに空きができるまで待ちます。
+		Block,
+	};
+
 	namespace detail
 	{
 		struct LoggerBuffer
@@ -105,6 +115,13 @@ namespace s3d
 
 			/// @brief ログ出力を有効化します
 			void enable() const;
+
+			/// @brief 書き込み待ちのログをすべて出力します
+			void flush() const;
+
+			/// @brief ログの書き込み待ちのバッファがいっぱいのときの動作を設定します
+			/// @param policy バッファがいっぱいのときの動作。デフォルトは `LogOverflowPolicy::Block`
+			void setOverflowPolicy(LogOverflowPolicy policy) const;
 		};
 	}
 
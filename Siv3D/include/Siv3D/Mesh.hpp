@@ -10,9 +10,11 @@
 //-----------------------------------------------
 
 # pragma once
+# include <span>
 # include "Common.hpp"
 # include "Array.hpp"
 # include "Vertex3D.hpp"
+# include "TriangleIndex.hpp"
 # include "Mat4x4.hpp"
 # include "ColorHSV.hpp"
 # include "AssetHandle.hpp"
@@ -36,6 +38,12 @@ namespace s3d
 		SIV3D_NODISCARD_CXX20
 		explicit Mesh(const MeshData& meshData);
 
+		/// @brief 頂点とインデックスの配列から、MeshData を経由せずにメッシュを作成します。
+		/// @param vertices 頂点
+		/// @param indices 三角形のインデックス
+		SIV3D_NODISCARD_CXX20
+		Mesh(std::span<const Vertex3D> vertices, std::span<const TriangleIndex32> indices);
+
 		virtual ~Mesh();
 
 		[[nodiscard]]
@@ -135,6 +143,42 @@ namespace s3d
 
 
 
+		/// @brief 同じメッシュを、異なる変換行列で複数回描画します。
+		/// @param transforms 各インスタンスの変換行列
+		/// @param color 色
+		/// @remark 可能な場合は 1 回の描画呼び出しにまとめられます。カスタムシェーダを使っている場合は 1 つずつ描画されます。
+		void drawInstanced(std::span<const Mat4x4> transforms, const ColorF& color = Palette::White) const;
+
+		/// @brief 同じメッシュを、異なる変換行列と色で複数回描画します。
+		/// @param transforms 各インスタンスの変換行列
+		/// @param colors 各インスタンスの色。transforms と同じ要素数である必要があります。
+		void drawInstanced(std::span<const Mat4x4> transforms, std::span<const ColorF> colors) const;
+
+		/// @brief 同じメッシュを、マテリアルを指定して、異なる変換行列で複数回描画します。
+		/// @param transforms 各インスタンスの変換行列
+		/// @param material マテリアル
+		void drawInstanced(std::span<const Mat4x4> transforms, const PhongMaterial& material) const;
+
+		/// @brief テクスチャを貼った同じメッシュを、異なる変換行列で複数回描画します。
+		/// @param transforms 各インスタンスの変換行列
+		/// @param texture テクスチャ
+		/// @param color 色
+		void drawInstanced(std::span<const Mat4x4> transforms, const Texture& texture, const ColorF& color = Palette::White) const;
+
+		/// @brief テクスチャを貼った同じメッシュを、異なる変換行列と色で複数回描画します。
+		/// @param transforms 各インスタンスの変換行列
+		/// @param texture テクスチャ
+		/// @param colors 各インスタンスの色。transforms と同じ要素数である必要があります。
+		void drawInstanced(std::span<const Mat4x4> transforms, const Texture& texture, std::span<const ColorF> colors) const;
+
+		/// @brief テクスチャを貼った同じメッシュを、マテリアルを指定して、異なる変換行列で複数回描画します。
+		/// @param transforms 各インスタンスの変換行列
+		/// @param texture テクスチャ
+		/// @param material マテリアル
+		void drawInstanced(std::span<const Mat4x4> transforms, const Texture& texture, const PhongMaterial& material) const;
+
+
+
 		void drawSubset(uint32 startTriangle, uint32 triangleCount, const ColorF& color = Palette::White) const;
 
 		void drawSubset(uint32 startTriangle, uint32 triangleCount, double x, double y, double z, const ColorF& color = Palette::White) const;
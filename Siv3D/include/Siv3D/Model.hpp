@@ -18,6 +18,7 @@
 # include "StringView.hpp"
 # include "ColorOption.hpp"
 # include "TextureDesc.hpp"
+# include "PredefinedYesNo.hpp"
 
 namespace s3d
 {
@@ -31,11 +32,19 @@ namespace s3d
 		Model();
 
 		/// @brief 3D モデルを読み込みます。
-		/// @param path ファイルのパス（対応している形式は Wavefront OBJ）
+		/// @param path ファイルのパス（対応している形式は Wavefront OBJ と、Model::Bake() で作成したファイル）
 		/// @param colorOption 色空間
 		SIV3D_NODISCARD_CXX20
 		explicit Model(FilePathView path, ColorOption colorOption = ColorOption::Default);
 
+		/// @brief 3D モデルを読み込みます。
+		/// @param path ファイルのパス（対応している形式は Wavefront OBJ と、Model::Bake() で作成したファイル）
+		/// @param colorOption 色空間
+		/// @param useCache OBJ ファイルの読み込み結果を、同じフォルダの `（ファイル名）.s3dmodel` にキャッシュするか
+		/// @remark キャッシュは OBJ ファイルと MTL ファイルのハッシュ値と色空間が一致する場合にのみ使われ、一致しない場合は作り直されます。
+		SIV3D_NODISCARD_CXX20
+		Model(FilePathView path, ColorOption colorOption, UseCache useCache);
+
 		/// @brief デストラクタ
 		virtual ~Model();
 
@@ -104,6 +113,15 @@ namespace s3d
 		/// @param textureDesc テクスチャの設定
 		/// @return テクスチャアセットの登録に成功した場合 true, それ以外の場合は false
 		static bool RegisterDiffuseTextures(const Model& model, TextureDesc textureDesc = TextureDesc::MippedSRGB);
+
+		/// @brief OBJ ファイルを読み込み、すぐに読み込めるバイナリ形式で書き出します。
+		/// @param sourcePath OBJ ファイルのパス
+		/// @param outputPath 書き出すファイルのパス
+		/// @param colorOption 色空間
+		/// @return 書き出しに成功した場合 true, それ以外の場合は false
+		/// @remark 書き出したファイルは、ファイルマップから頂点とインデックスを直接 GPU に転送するため、OBJ ファイルより高速に読み込めます。
+		/// @remark テクスチャのパスは、OBJ ファイルと同じフォルダからの相対パスとして保存されます。
+		static bool Bake(FilePathView sourcePath, FilePathView outputPath, ColorOption colorOption = ColorOption::Default);
 	};
 }
 
@@ -0,0 +1,36 @@
+﻿//-----------------------------------------------
+//
+//	This file is part of the Siv3D Engine.
+//
+//	Copyright (c) 2008-2022 Ryo Suzuki
+//	Copyright (c) 2016-2022 OpenSiv3D Project
+//
+//	Licensed under the MIT License.
+//
+//-----------------------------------------------
+
+
+# pragma once
+# include "Common.hpp"
+
+namespace s3d
+{
+	/// @brief PNG 圧縮時の速度と圧縮率のプリセット
+	enum class PNGCompression : uint8
+	{
+		/// @brief 圧縮しない（フィルタも使わない）
+		Store,
+
+		/// @brief Sub フィルタと、最も速い deflate 圧縮を使う（指定したフィルタは無視される）
+		Fastest,
+
+		/// @brief 速い deflate 圧縮 (zlib レベル 1)
+		Fast,
+
+		/// @brief 標準的な deflate 圧縮 (zlib レベル 6)
+		Default,
+
+		/// @brief 最も圧縮率の高い deflate 圧縮 (zlib レベル 9)
+		Best,
+	};
+}
@@ -10,8 +10,11 @@
 //-----------------------------------------------
 
 # pragma once
+# include <span>
 # include "Common.hpp"
+# include "Array.hpp"
 # include "PointVector.hpp"
+# include "Particle2D.hpp"
 # include "IEmitter2D.hpp"
 # include "ParticleSystem2DParameters.hpp"
 # include "Scene.hpp"
@@ -53,9 +56,20 @@ namespace s3d
 
 		void setTexture(const Texture& texture) noexcept;
 
+		/// @brief パーティクルの放出に使う乱数エンジンのシード値を設定します。
+		/// @param seed シード値
+		/// @remark パーティクルシステムはそれぞれ専用の乱数エンジンを持ちます。作成時のシード値は、現在のスレッドの乱数エンジンから取得します。
+		void setSeed(uint64 seed) noexcept;
+
 		[[nodiscard]]
 		size_t num_particles() const noexcept;
 
+		/// @brief 現在のパーティクルの一覧を返します。
+		/// @return パーティクルの一覧
+		/// @remark パーティクルの並び順は、放出された順とは限りません。
+		[[nodiscard]]
+		Array<Particle2D> getParticles() const;
+
 		void prewarm();
 
 		void update(double deltaTime = Scene::DeltaTime());
@@ -64,6 +78,18 @@ namespace s3d
 
 		void drawDebug() const;
 
+		/// @brief 複数のパーティクルシステムを、エンジンのスレッドプールで並列に更新します。
+		/// @param systems パーティクルシステムの配列
+		/// @param deltaTime 前回の更新からの経過時間（秒）
+		/// @remark 結果はスレッドの数によらず、1 つずつ update() した場合と同じになります。
+		/// @remark エミッターはワーカースレッドから呼ばれます。同じパーティクルシステムやそのコピーを、配列に複数含めてはいけません。
+		static void UpdateAll(std::span<ParticleSystem2D> systems, double deltaTime = Scene::DeltaTime());
+
+		/// @brief 複数のパーティクルシステムを、配列の順に描きます。
+		/// @param systems パーティクルシステムの配列
+		/// @remark 頂点はエンジンのスレッドプールで並列に作成します。sizeOverLifeTimeFunc または colorOverLifeTimeFunc を使うパーティクルシステムの頂点は、呼び出し元のスレッドで作成します。
+		static void DrawAll(std::span<const ParticleSystem2D> systems);
+
 	private:
 
 		class ParticleSystem2DDetail;
@@ -0,0 +1,59 @@
+﻿//-----------------------------------------------
+//
+//	This file is part of the Siv3D Engine.
+//
+//	Copyright (c) 2008-2022 Ryo Suzuki
+//	Copyright (c) 2016-2022 OpenSiv3D Project
+//
+//	Licensed under the MIT License.
+//
+//-----------------------------------------------
+
+# pragma once
+# include "../Common.hpp"
+# include "../PointVector.hpp"
+# include "../Array.hpp"
+# include "P2Fwd.hpp"
+
+namespace s3d
+{
+	/// @brief P2World の物体の状態を、要素ごとの配列にまとめたもの
+	/// @remark `P2World::exportStates()` と `P2World::importStates()` で使います。すべての配列は同じ要素数である必要があります。
+	struct P2BodyStates
+	{
+		/// @brief 物体の ID
+		Array<P2BodyID> ids;
+
+		/// @brief 物体の座標 (cm)
+		Array<Vec2> positions;
+
+		/// @brief 物体の回転角度（ラジアン）
+		Array<double> angles;
+
+		/// @brief 物体の速度 (cm/s)
+		Array<Vec2> linearVelocities;
+
+		/// @brief 物体の角速度（ラジアン/s）
+		Array<double> angularVelocities;
+
+		/// @brief 物体の数を返します。
+		/// @return 物体の数
+		[[nodiscard]]
+		size_t size() const noexcept;
+
+		/// @brief 物体が 1 つも無いかを返します。
+		/// @return 物体が 1 つも無い場合 true, それ以外の場合は false
+		[[nodiscard]]
+		bool isEmpty() const noexcept;
+
+		/// @brief 物体の数を変更します。
+		/// @param size 新しい物体の数
+		void resize(size_t size);
+
+		/// @brief 物体を消去します。
+		/// @remark 確保したメモリは解放しません。
+		void clear() noexcept;
+	};
+}
+
+# include "detail/P2BodyStates.ipp"
@@ -0,0 +1,53 @@
+﻿//-----------------------------------------------
+//
+//	This file is part of the Siv3D Engine.
+//
+//	Copyright (c) 2008-2022 Ryo Suzuki
+//	Copyright (c) 2016-2022 OpenSiv3D Project
+//
+//	Licensed under the MIT License.
+//
+//-----------------------------------------------
+
+# pragma once
+# include <array>
+# include "../Common.hpp"
+# include "../PointVector.hpp"
+# include "P2Fwd.hpp"
+# include "P2ContactPair.hpp"
+# include "P2Contact.hpp"
+
+namespace s3d
+{
+	/// @brief 接触イベントの種類
+	enum class P2ContactEventType : uint8
+	{
+		/// @brief 直前のステップで接触が始まった
+		Begin,
+
+		/// @brief 前のステップから接触が続いている
+		Persist,
+
+		/// @brief 接触が終わった
+		End,
+	};
+
+	/// @brief `P2ContactMode::Events` で記録される、部品どうしの接触イベント
+	struct P2ContactEvent
+	{
+		/// @brief 接触している物体の ID のペア
+		P2ContactPair pair;
+
+		/// @brief イベントの種類
+		P2ContactEventType type = P2ContactEventType::Begin;
+
+		/// @brief 接触点の数（最大 2）。`P2ContactEventType::End` の場合は 0
+		uint32 num_contacts = 0;
+
+		/// @brief 物体 A から物体 B への接触の方向ベクトル
+		Vec2 normal = { 0.0, 0.0 };
+
+		/// @brief 接触点の情報。先頭の `num_contacts` 個が有効です。
+		std::array<P2Contact, 2> contacts;
+	};
+}
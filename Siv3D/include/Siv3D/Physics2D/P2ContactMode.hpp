@@ -0,0 +1,27 @@
+﻿//-----------------------------------------------
+//
+//	This file is part of the Siv3D Engine.
+//
+//	Copyright (c) 2008-2022 Ryo Suzuki
+//	Copyright (c) 2016-2022 OpenSiv3D Project
+//
+//	Licensed under the MIT License.
+//
+//-----------------------------------------------
+
+# pragma once
+# include "../Common.hpp"
+
+namespace s3d
+{
+	/// @brief P2World が物体の接触情報を記録する方法
+	enum class P2ContactMode : uint8
+	{
+		/// @brief 接触している物体のペアごとに P2Collision を記録します。`P2World::getCollisions()` で取得します。
+		Collisions,
+
+		/// @brief 部品の接触ごとに、接触の開始・継続・終了を P2ContactEvent として記録します。`P2World::getContactEvents()` で取得します。
+		/// @remark 接触の数が多い場合、Collisions よりも高速です。
+		Events,
+	};
+}
@@ -31,6 +31,11 @@ namespace s3d
 	enum class P2ShapeType : uint8;
 	struct P2ContactPair;
 	struct P2Contact;
+	enum class P2ContactMode : uint8;
+	enum class P2ContactEventType : uint8;
+	struct P2ContactEvent;
+	struct P2RaycastHit;
+	struct P2BodyStates;
 	class P2Collision;
 	class P2World;
 	class P2Body;
@@ -0,0 +1,34 @@
+﻿//-----------------------------------------------
+//
+//	This file is part of the Siv3D Engine.
+//
+//	Copyright (c) 2008-2022 Ryo Suzuki
+//	Copyright (c) 2016-2022 OpenSiv3D Project
+//
+//	Licensed under the MIT License.
+//
+//-----------------------------------------------
+
+# pragma once
+# include "../Common.hpp"
+# include "../PointVector.hpp"
+# include "P2Fwd.hpp"
+
+namespace s3d
+{
+	/// @brief レイキャストやシェイプキャストで物体と交差した位置の情報
+	struct P2RaycastHit
+	{
+		/// @brief 交差した物体の ID
+		P2BodyID id = 0;
+
+		/// @brief 交差した点の座標 (cm)
+		Vec2 pos = { 0.0, 0.0 };
+
+		/// @brief 交差した点での物体の表面の法線ベクトル
+		Vec2 normal = { 0.0, 0.0 };
+
+		/// @brief 線分の始点（シェイプキャストでは移動前の形状）から交差までの距離の、線分（移動量）の長さに対する割合 [0.0, 1.0]
+		double fraction = 0.0;
+	};
+}
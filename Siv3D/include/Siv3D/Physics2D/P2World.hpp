@@ -11,14 +11,21 @@
 
 # pragma once
 # include <memory>
+# include <span>
 # include "../Common.hpp"
 # include "../PointVector.hpp"
 # include "../HashTable.hpp"
 # include "../Scene.hpp"
+# include "../Optional.hpp"
+# include "../Blob.hpp"
 # include "P2Fwd.hpp"
 # include "P2BodyType.hpp"
 # include "P2Material.hpp"
 # include "P2Filter.hpp"
+# include "P2ContactMode.hpp"
+# include "P2ContactEvent.hpp"
+# include "P2RaycastHit.hpp"
+# include "P2BodyStates.hpp"
 # include "P2Body.hpp"
 # include "P2PivotJoint.hpp"
 # include "P2DistanceJoint.hpp"
@@ -49,6 +56,38 @@ namespace s3d
 		/// @param positionIterations 物体の衝突時の位置の補正の回数
 		void update(double timeStep = Scene::DeltaTime(), int32 velocityIterations = 6, int32 positionIterations = 2) const;
 
+		/// @brief 経過時間を固定のタイムステップに分割して、2D 物理演算のワールドの状態を更新します。
+		/// @param deltaTime 経過時間（秒）
+		/// @param fixedTimeStep 1 回のステップで進める時間（秒）
+		/// @param maxSteps 1 回の呼び出しで行う最大のステップ数。処理が追い付かず、これを超えた分の時間は切り捨てられます。
+		/// @param velocityIterations 物体の衝突時の速度の補正の回数
+		/// @param positionIterations 物体の衝突時の位置の補正の回数
+		/// @return 行ったステップの数
+		/// @remark `fixedTimeStep` に満たない時間は次の呼び出しに持ち越されます。描画時には `exportInterpolatedStates()` で補間した状態を使うと、動きが滑らかになります。
+		size_t updateFixed(double deltaTime = Scene::DeltaTime(), double fixedTimeStep = (1.0 / 60.0), int32 maxSteps = 4, int32 velocityIterations = 6, int32 positionIterations = 2) const;
+
+		/// @brief 直前の `updateFixed()` で持ち越された時間の、タイムステップに対する割合を返します。
+		/// @return 持ち越された時間の、タイムステップに対する割合 [0.0, 1.0)
+		[[nodiscard]]
+		double getInterpolationAlpha() const noexcept;
+
+		/// @brief すべての物体の状態を、`updateFixed()` の最後のステップの前後の間で補間して取得します。
+		/// @param states 物体の状態を格納する配列。物体は ID の昇順に並びます。
+		/// @remark 座標と回転角度を `getInterpolationAlpha()` の割合で補間します。速度と角速度は現在の値です。
+		/// @remark 最後のステップの後に作成された物体は、現在の状態になります。
+		void exportInterpolatedStates(P2BodyStates& states) const;
+
+		/// @brief 互いに接触していない物体のグループ（アイランド）を、複数のスレッドで並列に解くかを設定します（デフォルトでは無効）。
+		/// @param enabled 並列に解く場合 true, それ以外の場合は false
+		/// @remark 同じ静的な物体に接する複数のアイランドは、同じスレッドで順に解きます。結果はスレッドの数によらず、無効の場合と完全に一致します。
+		/// @remark 衝突のコールバックはすべて、`update()` を呼んだスレッドから呼ばれます。
+		void setParallelSolveEnabled(bool enabled);
+
+		/// @brief アイランドを複数のスレッドで並列に解く設定が有効かを返します。
+		/// @return 並列に解く場合 true, それ以外の場合は false
+		[[nodiscard]]
+		bool getParallelSolveEnabled() const noexcept;
+
 		/// @brief ワールド内の物体がスリープ状態になることを許可・不許可を設定します（デフォルトでは許可）。
 		/// @param enabled 許可する場合 true, 許可しない場合 false
 		void setSleepEnabled(bool enabled);
@@ -281,10 +320,125 @@ namespace s3d
 		P2MouseJoint createMouseJoint(const P2Body& body, const Vec2& worldTargetPos);
 
 		/// @brief 物体の接触情報の一覧を返します。
+		/// @remark `P2ContactMode::Events` の場合は空です。
 		/// @return 物体の接触情報の一覧
 		[[nodiscard]]
 		const HashTable<P2ContactPair, P2Collision>& getCollisions() const noexcept;
 
+		/// @brief 物体の接触情報を記録する方法を設定します。
+		/// @param mode 接触情報を記録する方法。デフォルトは `P2ContactMode::Collisions` です。
+		/// @remark 方法を変更すると、それまでに記録した接触情報は破棄されます。
+		void setContactMode(P2ContactMode mode);
+
+		/// @brief 物体の接触情報を記録する方法を返します。
+		/// @return 物体の接触情報を記録する方法
+		[[nodiscard]]
+		P2ContactMode getContactMode() const noexcept;
+
+		/// @brief 直前の `update()` で記録された接触イベントの一覧を返します。
+		/// @remark `P2ContactMode::Events` の場合のみ記録されます。
+		/// @remark 部品の組ごとに 1 つのイベントが記録されます。ステップ中に終わった接触の End が発生順に並び、その後に、ステップの終わりに接触している組の Begin または Persist が続きます。
+		/// @remark `update()` の後に物体を削除して終わった接触の End は、末尾に追加され、次の `update()` の結果に引き継がれます。
+		/// @remark 接触点の力積は、そのステップでソルバーが求めた値です。
+		/// @remark 次の `update()` までの間のみ有効です。イベントの配列は使いまわされるため、ステップごとのメモリ確保は行いません。
+		/// @return 接触イベントの一覧
+		[[nodiscard]]
+		std::span<const P2ContactEvent> getContactEvents() const noexcept;
+
+		/// @brief 部品の AABB が長方形と交差する物体の ID の一覧を返します。
+		/// @param rect 長方形 (cm)
+		/// @return 物体の ID の一覧（昇順）
+		[[nodiscard]]
+		Array<P2BodyID> queryAABB(const RectF& rect) const;
+
+		/// @brief 部品の AABB が長方形と交差する物体の ID の一覧を取得します。
+		/// @param rect 長方形 (cm)
+		/// @param results 物体の ID の一覧（昇順）を格納する配列。最初に空にされます。
+		/// @remark 配列の容量が足りている場合、メモリの確保を行いません。
+		void queryAABB(const RectF& rect, Array<P2BodyID>& results) const;
+
+		/// @brief 複数の長方形について、部品の AABB が長方形と交差する物体の ID の一覧を取得します。
+		/// @param rects 長方形 (cm) の一覧
+		/// @param results すべての長方形の結果を連結して格納する配列。最初に空にされます。
+		/// @param offsets `rects[i]` の結果が `results` の [offsets[i], offsets[i + 1]) にあることを表す配列（要素数は `rects.size() + 1`）
+		/// @remark 配列の容量が足りている場合、メモリの確保を行いません。
+		void queryAABB(const Array<RectF>& rects, Array<P2BodyID>& results, Array<size_t>& offsets) const;
+
+		/// @brief 線分と最初に交差する物体を返します。
+		/// @param start 線分の始点 (cm)
+		/// @param end 線分の終点 (cm)
+		/// @return 最初に交差した物体の情報。交差しない場合は none
+		[[nodiscard]]
+		Optional<P2RaycastHit> raycast(const Vec2& start, const Vec2& end) const;
+
+		/// @brief 線分と最初に交差する物体を返します。
+		/// @param ray 線分 (cm)
+		/// @return 最初に交差した物体の情報。交差しない場合は none
+		[[nodiscard]]
+		Optional<P2RaycastHit> raycast(const Line& ray) const;
+
+		/// @brief 複数の線分について、線分と最初に交差する物体を取得します。
+		/// @param rays 線分 (cm) の一覧
+		/// @param results `rays[i]` と最初に交差した物体の情報を `results[i]` に格納する配列
+		/// @remark 配列の容量が足りている場合、メモリの確保を行いません。
+		void raycast(const Array<Line>& rays, Array<Optional<P2RaycastHit>>& results) const;
+
+		/// @brief 線分と交差するすべての部品の情報を返します。
+		/// @param ray 線分 (cm)
+		/// @return 交差した部品の情報の一覧（始点から近い順）
+		[[nodiscard]]
+		Array<P2RaycastHit> raycastAll(const Line& ray) const;
+
+		/// @brief 線分と交差するすべての部品の情報を取得します。
+		/// @param ray 線分 (cm)
+		/// @param results 交差した部品の情報（始点から近い順）を格納する配列。最初に空にされます。
+		/// @remark 配列の容量が足りている場合、メモリの確保を行いません。
+		void raycastAll(const Line& ray, Array<P2RaycastHit>& results) const;
+
+		/// @brief 円を移動させたときに、最初に接触する物体を返します。
+		/// @param circle 移動前の円 (cm)
+		/// @param translation 移動量 (cm)
+		/// @return 最初に接触した物体の情報。接触しない場合は none
+		/// @remark 移動前の時点で円と重なっている部品は無視します。
+		[[nodiscard]]
+		Optional<P2RaycastHit> shapeCast(const Circle& circle, const Vec2& translation) const;
+
+		/// @brief 長方形を移動させたときに、最初に接触する物体を返します。
+		/// @param rect 移動前の長方形 (cm)
+		/// @param translation 移動量 (cm)
+		/// @return 最初に接触した物体の情報。接触しない場合は none
+		/// @remark 移動前の時点で長方形と重なっている部品は無視します。
+		[[nodiscard]]
+		Optional<P2RaycastHit> shapeCast(const RectF& rect, const Vec2& translation) const;
+
+		/// @brief すべての物体の ID, 座標, 回転角度, 速度, 角速度を一括で取得します。
+		/// @param states 物体の状態を格納する配列。物体は ID の昇順に並びます。
+		/// @remark 物体ごとに P2Body から取得するよりも高速です。配列の容量が足りている場合、メモリの確保を行いません。
+		void exportStates(P2BodyStates& states) const;
+
+		/// @brief 物体の座標, 回転角度, 速度, 角速度を一括で設定します。
+		/// @param states 物体の状態。ID が一致する物体にのみ設定され、ワールドに無い ID は無視されます。
+		/// @return 状態を設定した物体の数
+		/// @remark ID が昇順に並んでいる場合（`exportStates()` の結果など）、メモリの確保を行いません。
+		size_t importStates(const P2BodyStates& states);
+
+		/// @brief すべての物体の状態を、バイナリ形式のスナップショットとして保存します。
+		/// @return スナップショット
+		/// @remark 物体の座標, 回転角度, 速度, 角速度, スリープ状態を、内部の精度のまま保存します。物体の形状やジョイントは保存しません。
+		[[nodiscard]]
+		Blob saveSnapshot() const;
+
+		/// @brief すべての物体の状態を、バイナリ形式のスナップショットとして保存します。
+		/// @param blob スナップショットを格納する Blob。以前の内容は上書きされます。
+		/// @remark Blob の容量が足りている場合、メモリの確保を行いません。毎フレーム保存するロールバックなどに使います。
+		void saveSnapshot(Blob& blob) const;
+
+		/// @brief スナップショットから物体の状態を復元します。
+		/// @param blob `saveSnapshot()` で保存したスナップショット
+		/// @return 復元に成功した場合 true, スナップショットの形式が不正な場合は false
+		/// @remark ID が一致する物体にのみ適用されます。接触のキャッシュは復元されないため、復元後の結果は保存時の結果と完全には一致しない場合があります。
+		bool loadSnapshot(const Blob& blob);
+
 	private:
 
 		std::shared_ptr<detail::P2WorldDetail> pImpl;
@@ -0,0 +1,43 @@
+﻿//-----------------------------------------------
+//
+//	This file is part of the Siv3D Engine.
+//
+//	Copyright (c) 2008-2022 Ryo Suzuki
+//	Copyright (c) 2016-2022 OpenSiv3D Project
+//
+//	Licensed under the MIT License.
+//
+//-----------------------------------------------
+
+# pragma once
+
+namespace s3d
+{
+	inline size_t P2BodyStates::size() const noexcept
+	{
+		return ids.size();
+	}
+
+	inline bool P2BodyStates::isEmpty() const noexcept
+	{
+		return ids.isEmpty();
+	}
+
+	inline void P2BodyStates::resize(const size_t size)
+	{
+		ids.resize(size);
+		positions.resize(size);
+		angles.resize(size);
+		linearVelocities.resize(size);
+		angularVelocities.resize(size);
+	}
+
+	inline void P2BodyStates::clear() noexcept
+	{
+		ids.clear();
+		positions.clear();
+		angles.clear();
+		linearVelocities.clear();
+		angularVelocities.clear();
+	}
+}
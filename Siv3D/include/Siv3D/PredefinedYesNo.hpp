@@ -118,4 +118,10 @@ namespace s3d
 
 	/// @brief リガチャ（合字）を使う
 	using Ligature = YesNo<struct Ligature_tag>;
+
+	/// @brief キャッシュを使う
+	using UseCache = YesNo<struct UseCache_tag>;
+
+	/// @brief 色を sRGB として扱う
+	using IsSRGB = YesNo<struct IsSRGB_tag>;
 }
@@ -0,0 +1,193 @@
+﻿//-----------------------------------------------
+//
+//	This file is part of the Siv3D Engine.
+//
+//	Copyright (c) 2008-2022 Ryo Suzuki
+//	Copyright (c) 2016-2022 OpenSiv3D Project
+//
+//	Licensed under the MIT License.
+//
+//-----------------------------------------------
+
+# pragma once
+# include <memory>
+# include "Common.hpp"
+# include "String.hpp"
+# include "Font.hpp"
+# include "TextStyle.hpp"
+# include "2DShapes.hpp"
+
+namespace s3d
+{
+	struct DrawableText;
+
+	/// @brief グリフの配置とテクスチャ領域をあらかじめ計算したテキスト
+	/// @remark 毎フレーム同じテキストを描く場合、DrawableText よりも高速に描画できます。
+	/// @remark 描画時の色、位置、サイズを変えても配置はやり直しません。テキストを変更した場合は、変更された位置以降のグリフだけを配置し直します。
+	class PreparedText
+	{
+	private:
+
+		class PreparedTextDetail;
+
+	public:
+
+		SIV3D_NODISCARD_CXX20
+		PreparedText();
+
+		/// @brief テキストを配置します。
+		/// @param font フォント
+		/// @param text テキスト
+		SIV3D_NODISCARD_CXX20
+		PreparedText(const Font& font, String text);
+
+		/// @brief DrawableText を配置します。
+		/// @param drawableText DrawableText
+		SIV3D_NODISCARD_CXX20
+		explicit PreparedText(const DrawableText& drawableText);
+
+		SIV3D_NODISCARD_CXX20
+		PreparedText(const PreparedText& other);
+
+		SIV3D_NODISCARD_CXX20
+		PreparedText(PreparedText&& other) noexcept;
+
+		~PreparedText();
+
+		PreparedText& operator =(const PreparedText& other);
+
+		PreparedText& operator =(PreparedText&& other) noexcept;
+
+		/// @brief フォントを返します。
+		/// @return フォント
+		[[nodiscard]]
+		const Font& font() const noexcept;
+
+		/// @brief テキストを返します。
+		/// @return テキスト
+		[[nodiscard]]
+		const String& text() const noexcept;
+
+		/// @brief テキストが空であるかを返します。
+		/// @return テキストが空である場合 true, それ以外の場合は false
+		[[nodiscard]]
+		bool isEmpty() const noexcept;
+
+		/// @brief テキストが空でないかを返します。
+		/// @return テキストが空でない場合 true, それ以外の場合は false
+		[[nodiscard]]
+		explicit operator bool() const noexcept;
+
+		/// @brief テキストを変更します。
+		/// @param text 新しいテキスト
+		/// @remark 以前のテキストとグリフが一致する先頭部分は、配置をやり直しません。
+		void setText(String text);
+
+		/// @brief テキストの末尾に文字列を追加します。
+		/// @param text 追加する文字列
+		/// @remark 以前のテキストのグリフは、シェーピングの結果が変わらない限り配置をやり直しません。
+		void append(StringView text);
+
+		/// @brief 直前の配置で、配置をやり直したクラスタの数を返します。
+		/// @return 直前の配置で、配置をやり直したクラスタの数
+		[[nodiscard]]
+		size_t num_relayoutClusters() const noexcept;
+
+		/// @brief 描画するグリフの数を返します。
+		/// @return 描画するグリフの数
+		[[nodiscard]]
+		size_t num_glyphs() const noexcept;
+
+		/// @brief 配置の結果が使用しているメモリ（バイト）を返します。
+		/// @return 配置の結果が使用しているメモリ（バイト）
+		/// @remark テキスト、シェーピングの結果、配置済みのグリフの合計です。
+		[[nodiscard]]
+		size_t memoryUsage() const noexcept;
+
+		/// @brief テキストが描画される領域を返します。
+		/// @param pos 描画する左上の座標
+		/// @return テキストが描画される領域
+		[[nodiscard]]
+		RectF region(const Vec2& pos = Vec2{ 0, 0 }) const;
+
+		/// @brief テキストが描画される領域を返します。
+		/// @param size フォントのサイズ
+		/// @param pos 描画する左上の座標
+		/// @return テキストが描画される領域
+		[[nodiscard]]
+		RectF region(double size, const Vec2& pos = Vec2{ 0, 0 }) const;
+
+		/// @brief テキストが描画される領域を返します。
+		/// @param pos 描画する中心の座標
+		/// @return テキストが描画される領域
+		[[nodiscard]]
+		RectF regionAt(const Vec2& pos = Vec2{ 0, 0 }) const;
+
+		/// @brief テキストが描画される領域を返します。
+		/// @param size フォントのサイズ
+		/// @param pos 描画する中心の座標
+		/// @return テキストが描画される領域
+		[[nodiscard]]
+		RectF regionAt(double size, const Vec2& pos = Vec2{ 0, 0 }) const;
+
+		/// @brief テキストを描画します。
+		/// @param x 描画する左上の X 座標
+		/// @param y 描画する左上の Y 座標
+		/// @param color 色
+		/// @return テキストが描画された領域
+		RectF draw(double x, double y, const ColorF& color = Palette::White) const;
+
+		/// @brief テキストを描画します。
+		/// @param pos 描画する左上の座標
+		/// @param color 色
+		/// @return テキストが描画された領域
+		RectF draw(const Vec2& pos = Vec2{ 0, 0 }, const ColorF& color = Palette::White) const;
+
+		/// @brief テキストを描画します。
+		/// @param size フォントのサイズ
+		/// @param pos 描画する左上の座標
+		/// @param color 色
+		/// @return テキストが描画された領域
+		RectF draw(double size, const Vec2& pos, const ColorF& color = Palette::White) const;
+
+		/// @brief テキストを描画します。
+		/// @param textStyle テキストスタイル
+		/// @param pos 描画する左上の座標
+		/// @param color 色
+		/// @return テキストが描画された領域
+		RectF draw(const TextStyle& textStyle, const Vec2& pos, const ColorF& color = Palette::White) const;
+
+		/// @brief テキストを描画します。
+		/// @param textStyle テキストスタイル
+		/// @param size フォントのサイズ
+		/// @param pos 描画する左上の座標
+		/// @param color 色
+		/// @return テキストが描画された領域
+		RectF draw(const TextStyle& textStyle, double size, const Vec2& pos, const ColorF& color = Palette::White) const;
+
+		/// @brief 中心位置を指定してテキストを描画します。
+		/// @param pos 描画する中心の座標
+		/// @param color 色
+		/// @return テキストが描画された領域
+		RectF drawAt(const Vec2& pos = Vec2{ 0, 0 }, const ColorF& color = Palette::White) const;
+
+		/// @brief 中心位置を指定してテキストを描画します。
+		/// @param size フォントのサイズ
+		/// @param pos 描画する中心の座標
+		/// @param color 色
+		/// @return テキストが描画された領域
+		RectF drawAt(double size, const Vec2& pos, const ColorF& color = Palette::White) const;
+
+		/// @brief 中心位置を指定してテキストを描画します。
+		/// @param textStyle テキストスタイル
+		/// @param size フォントのサイズ
+		/// @param pos 描画する中心の座標
+		/// @param color 色
+		/// @return テキストが描画された領域
+		RectF drawAt(const TextStyle& textStyle, double size, const Vec2& pos, const ColorF& color = Palette::White) const;
+
+	private:
+
+		std::unique_ptr<PreparedTextDetail> pImpl;
+	};
+}
@@ -28,6 +28,12 @@ namespace s3d
 
 		uint32 activeVoice = 0;
 
+		uint32 glyphShapingCacheHits = 0;
+
+		uint32 glyphShapingCacheMisses = 0;
+
+		uint32 pendingGlyphCount = 0;
+
 		void print() const;
 	};
 }
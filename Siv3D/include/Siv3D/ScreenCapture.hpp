@@ -15,6 +15,7 @@
 # include "String.hpp"
 # include "DateTime.hpp"
 # include "InputGroups.hpp"
+# include "AsyncTask.hpp"
 
 namespace s3d
 {
@@ -38,6 +39,13 @@ namespace s3d
 		/// @param path 保存するスクリーンショットのファイル名
 		void SaveCurrentFrame(FilePath&& path = (DateTime::Now().format(U"yyyyMMdd-HHmmss-SSS") + U".png"));
 
+		/// @brief 現在のフレームを、メインスレッドを止めずにスクリーンショットとして保存します。
+		/// @param path 保存するスクリーンショットのファイル名
+		/// @return 保存が完了すると結果を返す非同期処理のタスク。保存に成功した場合は true, 失敗した場合は false を返します。
+		/// @remark 画像は 1~2 フレーム後の `System::Update()` で読み出され、エンコードとファイルの書き込みは別のスレッドで行われます。
+		/// @remark `System::Update()` を呼ばずに結果を待つと、処理が完了しません。
+		AsyncTask<bool> SaveCurrentFrameAsync(FilePath&& path = (DateTime::Now().format(U"yyyyMMdd-HHmmss-SSS") + U".png"));
+
 		/// @brief 現在のフレームのスクリーンショットを、次の `System::Update()` でメモリ上に保存します。
 		/// @remark 保存されたスクリーンショットは、`ScreenCapture::GetFrame()` を通して取得できます。
 		void RequestCurrentFrame();
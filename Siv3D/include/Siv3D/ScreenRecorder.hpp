@@ -0,0 +1,100 @@
+﻿//-----------------------------------------------
+//
+//	This file is part of the Siv3D Engine.
+//
+//	Copyright (c) 2008-2022 Ryo Suzuki
+//	Copyright (c) 2016-2022 OpenSiv3D Project
+//
+//	Licensed under the MIT License.
+//
+//-----------------------------------------------
+
+# pragma once
+# include <memory>
+# include "Common.hpp"
+# include "StringView.hpp"
+# include "PointVector.hpp"
+
+namespace s3d
+{
+	/// @brief 画面の録画
+	/// @remark 毎フレーム `captureFrame()` を呼ぶと、そのフレームを非同期で読み出し、別のスレッドで動画ファイルに書き出します。
+	/// @remark 書き出しが間に合わないフレームは、メインスレッドを待たせずに破棄します。破棄したフレームの代わりに前後のフレームを繰り返し書き出すため、動画の長さは保たれます。
+	class ScreenRecorder
+	{
+	public:
+
+		/// @brief デフォルトコンストラクタ
+		SIV3D_NODISCARD_CXX20
+		ScreenRecorder();
+
+		/// @brief シーンと同じ解像度で録画を開始します。
+		/// @param path 動画ファイルのパス
+		/// @param fps 動画の FPS
+		SIV3D_NODISCARD_CXX20
+		explicit ScreenRecorder(FilePathView path, double fps = 60.0);
+
+		/// @brief 指定した解像度で録画を開始します。
+		/// @param path 動画ファイルのパス
+		/// @param size 動画の解像度。シーンの解像度と異なる場合は、拡大縮小してから書き出します。
+		/// @param fps 動画の FPS
+		SIV3D_NODISCARD_CXX20
+		ScreenRecorder(FilePathView path, const Size& size, double fps = 60.0);
+
+		bool open(FilePathView path, double fps = 60.0);
+
+		bool open(FilePathView path, const Size& size, double fps = 60.0);
+
+		/// @brief 書き出し待ちのフレームをすべて書き出してから、動画ファイルをクローズします。
+		/// @remark 読み出し中のフレームは破棄されます。
+		void close();
+
+		/// @brief 録画中であるかを返します。
+		/// @return 録画中である場合 true, それ以外の場合は false
+		[[nodiscard]]
+		bool isOpen() const noexcept;
+
+		/// @brief 録画中であるかを返します。
+		/// @remark `isOpen()` と同じです。
+		/// @return 録画中である場合 true, それ以外の場合は false
+		[[nodiscard]]
+		explicit operator bool() const noexcept;
+
+		/// @brief 現在のフレームを録画します。
+		/// @remark 次の `System::Update()` でフレームの読み出しを開始し、1~2 フレーム後に書き出しのスレッドに渡します。
+		void captureFrame();
+
+		/// @brief 動画ファイルに書き出したフレームの数を返します。
+		/// @remark 破棄したフレームの代わりに繰り返し書き出したフレームも含みます。
+		/// @return 書き出したフレームの数
+		[[nodiscard]]
+		size_t num_writtenFrames() const;
+
+		/// @brief 書き出しが間に合わずに破棄したフレームの数を返します。
+		/// @remark 破棄したフレームは、前後のフレームを繰り返して埋められます。
+		/// @return 破棄したフレームの数
+		[[nodiscard]]
+		size_t num_droppedFrames() const;
+
+		/// @brief 動画の解像度を返します。
+		/// @return 動画の解像度
+		[[nodiscard]]
+		Size getSize() const noexcept;
+
+		/// @brief 動画の FPS を返します。
+		/// @return 動画の FPS
+		[[nodiscard]]
+		double getFPS() const noexcept;
+
+		/// @brief 動画ファイルのフルパスを返します。
+		/// @return 動画ファイルのフルパス
+		[[nodiscard]]
+		const FilePath& path() const noexcept;
+
+	private:
+
+		class ScreenRecorderDetail;
+
+		std::shared_ptr<ScreenRecorderDetail> pImpl;
+	};
+}
@@ -0,0 +1,153 @@
+﻿//-----------------------------------------------
+//
+//	This file is part of the Siv3D Engine.
+//
+//	Copyright (c) 2008-2022 Ryo Suzuki
+//	Copyright (c) 2016-2022 OpenSiv3D Project
+//
+//	Licensed under the MIT License.
+//
+//-----------------------------------------------
+
+# pragma once
+# ifndef SIV3D_NO_CONCURRENT_API
+
+# include <memory>
+# include <functional>
+# include <atomic>
+# include <mutex>
+# include <condition_variable>
+# include <type_traits>
+# include "Common.hpp"
+# include "Utility.hpp"
+# include "Threading.hpp"
+
+namespace s3d
+{
+	/// @brief 複数のタスクの完了を待つためのカウンタ | Counter for waiting on the completion of a group of tasks
+	class WaitGroup
+	{
+	public:
+
+		SIV3D_NODISCARD_CXX20
+		WaitGroup() = default;
+
+		WaitGroup(const WaitGroup&) = delete;
+
+		WaitGroup& operator =(const WaitGroup&) = delete;
+
+		/// @brief 完了を待つタスクの数を増やします。 | Adds n tasks to the group.
+		/// @param n 増やすタスクの数 | Number of tasks to add
+		void add(size_t n = 1) noexcept;
+
+		/// @brief タスクが 1 つ完了したことを通知します。 | Marks one task in the group as done.
+		void done();
+
+		/// @brief すべてのタスクが完了しているかを返します。 | Returns whether all tasks in the group are done.
+		/// @return すべてのタスクが完了している場合 true, それ以外の場合は false | Returns true if all tasks are done, false otherwise
+		[[nodiscard]]
+		bool isDone() const noexcept;
+
+		/// @brief すべてのタスクが完了するまで待機します。 | Blocks until all tasks in the group are done.
+		void wait();
+
+	private:
+
+		std::atomic<size_t> m_count = { 0 };
+
+		std::mutex m_mutex;
+
+		std::condition_variable m_condition;
+	};
+
+	/// @brief ワークスティーリング方式のスレッドプール | Work-stealing thread pool
+	/// @remark ワーカースレッドは作成時に起動し、デストラクタでは未処理のタスクをすべて実行してから終了します。
+	/// @remark ワーカースレッドの数は固定です。ネットワークやファイルの待機、ほかのタスクの完了待ちなど、長時間ブロックするタスクを追加すると、ほかのタスクが実行されなくなります。そのような処理には専用のスレッドを使ってください。
+	class ThreadPool
+	{
+	public:
+
+		/// @brief `Threading::GetConcurrency() - 1` 個（最低 1 個）のワーカースレッドを持つスレッドプールを作成します。
+		SIV3D_NODISCARD_CXX20
+		ThreadPool();
+
+		/// @brief 指定した数のワーカースレッドを持つスレッドプールを作成します。
+		/// @param numThreads ワーカースレッドの数（最低 1）
+		SIV3D_NODISCARD_CXX20
+		explicit ThreadPool(size_t numThreads);
+
+		ThreadPool(const ThreadPool&) = delete;
+
+		ThreadPool& operator =(const ThreadPool&) = delete;
+
+		~ThreadPool();
+
+		/// @brief ワーカースレッドの数を返します。
+		/// @return ワーカースレッドの数
+		[[nodiscard]]
+		size_t num_threads() const noexcept;
+
+		/// @brief 現在のスレッドがこのスレッドプールのワーカースレッドであるかを返します。
+		/// @return このスレッドプールのワーカースレッドである場合 true, それ以外の場合は false
+		[[nodiscard]]
+		bool isWorkerThread() const noexcept;
+
+		/// @brief タスクを追加します。
+		/// @param task タスク
+		/// @remark タスクから送出された例外は破棄されます。
+		void submit(std::function<void()> task);
+
+		/// @brief タスクを追加し、その完了を `waitGroup` で待てるようにします。
+		/// @param waitGroup タスクの完了を通知する WaitGroup
+		/// @param task タスク
+		void submit(WaitGroup& waitGroup, std::function<void()> task);
+
+		/// @brief 未処理のタスクを 1 つ実行します。
+		/// @return タスクを実行した場合 true, 未処理のタスクが無かった場合は false
+		bool tryRunPendingTask();
+
+		/// @brief `waitGroup` のタスクがすべて完了するまで、未処理のタスクを実行しながら待機します。
+		/// @param waitGroup WaitGroup
+		void wait(WaitGroup& waitGroup);
+
+		/// @brief 範囲 [first, last) を grainSize ごとに分割し、呼び出し元のスレッドとワーカースレッドで並列に処理します。
+		/// @tparam Fty 分割された範囲 [begin, end) を処理する関数の型
+		/// @param first 範囲の開始
+		/// @param last 範囲の終端
+		/// @param grainSize 1 回の呼び出しで処理する最大の要素数
+		/// @param f 分割された範囲 [begin, end) を処理する関数
+		/// @remark すべての処理が完了するまで戻りません。`f` から送出された最初の例外は呼び出し元で再送出されます。
+		template <class Fty, std::enable_if_t<std::is_invocable_v<Fty, size_t, size_t>>* = nullptr>
+		void parallel_for(size_t first, size_t last, size_t grainSize, Fty f);
+
+		/// @brief 範囲 [first, last) をワーカースレッドの数に応じて分割し、並列に処理します。
+		/// @tparam Fty 分割された範囲 [begin, end) を処理する関数の型
+		/// @param first 範囲の開始
+		/// @param last 範囲の終端
+		/// @param f 分割された範囲 [begin, end) を処理する関数
+		template <class Fty, std::enable_if_t<std::is_invocable_v<Fty, size_t, size_t>>* = nullptr>
+		void parallel_for(size_t first, size_t last, Fty f);
+
+	private:
+
+		class ThreadPoolDetail;
+
+		std::unique_ptr<ThreadPoolDetail> pImpl;
+
+		void parallelForImpl(size_t first, size_t last, size_t grainSize, void(*function)(void*, size_t, size_t), void* context);
+	};
+
+	namespace Threading
+	{
+		/// @brief エンジンが管理するスレッドプールを返します。 | Returns the engine-owned thread pool.
+		/// @remark 最初に呼ばれたときにワーカースレッドが起動します。`Array` の並列アルゴリズムの既定の実行先です。`Async(Threading::GetDefaultPool(), f)` でタスクを実行できます。
+		/// @remark エンジンの内部の処理も共有するため、長時間ブロックするタスクは追加しないでください。
+		/// @return エンジンが管理するスレッドプール | Engine-owned thread pool
+		[[nodiscard]]
+		ThreadPool& GetDefaultPool();
+	}
+}
+
+# include "detail/ThreadPool.ipp"
+
+# endif // SIV3D_NO_CONCURRENT_API
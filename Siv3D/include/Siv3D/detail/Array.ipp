@@ -1513,56 +1513,7 @@ namespace s3d
 
 	# else
 
-		if (isEmpty())
-		{
-			return 0;
-		}
-
-		const size_t numThreads = Threading::GetConcurrency();
-
-		if (numThreads <= 1)
-		{
-			return count_if(f);
-		}
-
-		const size_t countPerthread = Max<size_t>(1, (size() + (numThreads - 1)) / numThreads);
-
-		Array<std::future<std::ptrdiff_t>> futures;
-
-		auto it = begin();
-		size_t countLeft = size();
-
-		for (size_t i = 0; i < (numThreads - 1); ++i)
-		{
-			const size_t n = Min(countPerthread, countLeft);
-
-			if (n == 0)
-			{
-				break;
-			}
-
-			futures.emplace_back(std::async(std::launch::async, [=, &f]()
-			{
-				return std::count_if(it, it + n, f);
-			}));
-
-			it += n;
-			countLeft -= n;
-		}
-
-		size_t result = 0;
-		
-		if (countLeft)
-		{
-			result = std::count_if(it, it + countLeft, f);
-		}
-
-		for (auto& future : futures)
-		{
-			result += future.get();
-		}
-
-		return result;
+		return parallel_count_if(std::move(f), Threading::GetDefaultPool());
 
 	# endif
 	}
@@ -1577,52 +1528,7 @@ namespace s3d
 
 	# else
 
-		if (isEmpty())
-		{
-			return;
-		}
-
-		const size_t numThreads = Threading::GetConcurrency();
-
-		if (numThreads <= 1)
-		{
-			return each(f);
-		}
-
-		const size_t countPerthread = Max<size_t>(1, (size() + (numThreads - 1)) / numThreads);
-
-		Array<std::future<std::ptrdiff_t>> futures;
-
-		auto it = begin();
-		size_t countLeft = size();
-
-		for (size_t i = 0; i < (numThreads - 1); ++i)
-		{
-			const size_t n = Min(countPerthread, countLeft);
-
-			if (n == 0)
-			{
-				break;
-			}
-
-			futures.emplace_back(std::async(std::launch::async, [=, &f]()
-			{
-				std::for_each(it, it + n, f);
-			}));
-
-			it += n;
-			countLeft -= n;
-		}
-
-		if (countLeft)
-		{
-			std::for_each(it, it + countLeft, f);
-		}
-
-		for (auto& future : futures)
-		{
-			future.get();
-		}
+		parallel_each(std::move(f), Threading::GetDefaultPool());
 
 	# endif
 	}
@@ -1637,59 +1543,73 @@ namespace s3d
 
 	# else
 
-		if (isEmpty())
-		{
-			return;
-		}
+		parallel_each(std::move(f), Threading::GetDefaultPool());
 
-		const size_t numThreads = Threading::GetConcurrency();
+	# endif
+	}
+
+	template <class Type, class Allocator>
+	template <class Fty, std::enable_if_t<std::is_invocable_v<Fty, Type>>*>
+	inline auto Array<Type, Allocator>::parallel_map(Fty f) const
+	{
+		return parallel_map(std::move(f), Threading::GetDefaultPool());
+	}
 
-		if (numThreads <= 1)
+	template <class Type, class Allocator>
+	template <class Fty, std::enable_if_t<std::is_invocable_r_v<bool, Fty, Type>>*>
+	inline size_t Array<Type, Allocator>::parallel_count_if(Fty f, ThreadPool& pool) const
+	{
+		if (isEmpty())
 		{
-			return each(f);
+			return 0;
 		}
 
-		const size_t countPerthread = Max<size_t>(1, (size() + (numThreads - 1)) / numThreads);
-
-		Array<std::future<std::ptrdiff_t>> futures;
-
-		auto it = begin();
-		size_t countLeft = size();
+		std::atomic<size_t> result = 0;
 
-		for (size_t i = 0; i < (numThreads - 1); ++i)
+		pool.parallel_for(0, size(), [&](const size_t first, const size_t last)
 		{
-			const size_t n = Min(countPerthread, countLeft);
-
-			if (n == 0)
-			{
-				break;
-			}
+			const auto it = begin();
+			result += static_cast<size_t>(std::count_if((it + first), (it + last), f));
+		});
 
-			futures.emplace_back(std::async(std::launch::async, [=, &f]()
-			{
-				std::for_each(it, it + n, f);
-			}));
+		return result;
+	}
 
-			it += n;
-			countLeft -= n;
+	template <class Type, class Allocator>
+	template <class Fty, std::enable_if_t<std::is_invocable_v<Fty, Type&>>*>
+	inline void Array<Type, Allocator>::parallel_each(Fty f, ThreadPool& pool)
+	{
+		if (isEmpty())
+		{
+			return;
 		}
 
-		if (countLeft)
+		pool.parallel_for(0, size(), [&](const size_t first, const size_t last)
 		{
-			std::for_each(it, it + countLeft, f);
-		}
+			const auto it = begin();
+			std::for_each((it + first), (it + last), f);
+		});
+	}
 
-		for (auto& future : futures)
+	template <class Type, class Allocator>
+	template <class Fty, std::enable_if_t<std::is_invocable_v<Fty, Type>>*>
+	inline void Array<Type, Allocator>::parallel_each(Fty f, ThreadPool& pool) const
+	{
+		if (isEmpty())
 		{
-			future.get();
+			return;
 		}
 
-	# endif
+		pool.parallel_for(0, size(), [&](const size_t first, const size_t last)
+		{
+			const auto it = begin();
+			std::for_each((it + first), (it + last), f);
+		});
 	}
 
 	template <class Type, class Allocator>
 	template <class Fty, std::enable_if_t<std::is_invocable_v<Fty, Type>>*>
-	inline auto Array<Type, Allocator>::parallel_map(Fty f) const
+	inline auto Array<Type, Allocator>::parallel_map(Fty f, ThreadPool& pool) const
 	{
 		using Ret = std::remove_cvref_t<decltype(f((*this)[0]))>;
 
@@ -1698,61 +1618,19 @@ namespace s3d
 			return Array<Ret>{};
 		}
 
-		const size_t numThreads = Threading::GetConcurrency();
-
-		if (numThreads <= 1)
-		{
-			return map(f);
-		}
-
 		Array<Ret> new_array(size());
 
-		const size_t countPerthread = Max<size_t>(1, (size() + (numThreads - 1)) / numThreads);
-
-		Array<std::future<void>> futures;
-
-		auto itDst = new_array.begin();
-		auto itSrc = begin();
-		size_t countLeft = size();
-
-		for (size_t i = 0; i < (numThreads - 1); ++i)
+		pool.parallel_for(0, size(), [&](const size_t first, const size_t last)
 		{
-			const size_t n = Min(countPerthread, countLeft);
-
-			if (n == 0)
-			{
-				break;
-			}
-
-			futures.emplace_back(std::async(std::launch::async, [=, &f]() mutable
-			{
-				const auto itSrcEnd = itSrc + n;
-
-				while (itSrc != itSrcEnd)
-				{
-					*itDst++ = f(*itSrc++);
-				}
-			}));
-
-			itDst += n;
-			itSrc += n;
-			countLeft -= n;
-		}
-
-		if (countLeft)
-		{
-			const auto itSrcEnd = end();
+			auto itDst = (new_array.begin() + first);
+			auto itSrc = (begin() + first);
+			const auto itSrcEnd = (begin() + last);
 
 			while (itSrc != itSrcEnd)
 			{
 				*itDst++ = f(*itSrc++);
 			}
-		}
-
-		for (auto& future : futures)
-		{
-			future.get();
-		}
+		});
 
 		return new_array;
 	}
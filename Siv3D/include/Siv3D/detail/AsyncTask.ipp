@@ -19,17 +19,44 @@ namespace s3d
 
 	template <class Type>
 	inline AsyncTask<Type>::AsyncTask(AsyncTask&& other) noexcept
-		: m_data{ std::move(other.m_data) } {}
+		: m_data{ std::move(other.m_data) }
+		, m_pool{ std::exchange(other.m_pool, nullptr) } {}
 
 	template <class Type>
 	template <class Fty, class... Args, std::enable_if_t<std::is_invocable_v<Fty, Args...>>*>
 	inline AsyncTask<Type>::AsyncTask(Fty&& f, Args&&... args)
 		: m_data{ std::async(std::launch::async, std::forward<Fty>(f), std::forward<Args>(args)...) } {}
 
+	template <class Type>
+	template <class Fty, class... Args, std::enable_if_t<std::is_invocable_v<Fty, Args...>>*>
+	inline AsyncTask<Type>::AsyncTask(ThreadPool& pool, Fty&& f, Args&&... args)
+		: m_pool{ &pool }
+	{
+		// std::async と同様に、関数と引数はコピー（ムーブ）して保持する
+		auto task = std::make_shared<std::packaged_task<Type()>>(
+			[f = std::forward<Fty>(f), ...args = std::forward<Args>(args)]() mutable -> Type
+			{
+				return std::invoke(std::move(f), std::move(args)...);
+			});
+
+		m_data = task->get_future();
+
+		pool.submit([task = std::move(task)]() { (*task)(); });
+	}
+
+	template <class Type>
+	inline AsyncTask<Type>::~AsyncTask()
+	{
+		release();
+	}
+
 	template <class Type>
 	inline AsyncTask<Type>& AsyncTask<Type>::operator =(base_type&& other) noexcept
 	{
+		release();
+
 		m_data = std::move(other);
+		m_pool = nullptr;
 
 		return *this;
 	}
@@ -37,7 +64,13 @@ namespace s3d
 	template <class Type>
 	inline AsyncTask<Type>& AsyncTask<Type>::operator =(AsyncTask&& other) noexcept
 	{
-		m_data = std::move(other.m_data);
+		if (this != &other)
+		{
+			release();
+
+			m_data = std::move(other.m_data);
+			m_pool = std::exchange(other.m_pool, nullptr);
+		}
 
 		return *this;
 	}
@@ -58,12 +91,30 @@ namespace s3d
 	template <class Type>
 	inline Type AsyncTask<Type>::get()
 	{
+		wait();
+
+		m_pool = nullptr;
+
 		return m_data.get();
 	}
 
 	template <class Type>
 	inline void AsyncTask<Type>::wait() const
 	{
+		// スレッドプールのワーカースレッドで待機する場合、デッドロックを避けるため未処理のタスクを実行しながら待つ
+		if (m_pool && m_data.valid() && m_pool->isWorkerThread())
+		{
+			while (m_data.wait_for(std::chrono::seconds(0)) != std::future_status::ready)
+			{
+				if (not m_pool->tryRunPendingTask())
+				{
+					std::this_thread::yield();
+				}
+			}
+
+			return;
+		}
+
 		m_data.wait();
 	}
 
@@ -84,12 +135,30 @@ namespace s3d
 	template <class Type>
 	inline std::shared_future<Type> AsyncTask<Type>::share() noexcept
 	{
+		m_pool = nullptr;
+
 		return m_data.share();
 	}
 
+	template <class Type>
+	inline void AsyncTask<Type>::release()
+	{
+		// std::async によるタスクと同様に、破棄する前に完了を待つ
+		if (m_pool && m_data.valid())
+		{
+			wait();
+		}
+	}
+
 	template <class Fty, class... Args, std::enable_if_t<std::is_invocable_v<Fty, Args...>>*>
 	inline auto Async(Fty&& f, Args&&... args)
 	{
 		return AsyncTask<std::invoke_result_t<std::decay_t<Fty>, std::decay_t<Args>...>>{ std::forward<Fty>(f), std::forward<Args>(args)... };
 	}
+
+	template <class Fty, class... Args, std::enable_if_t<std::is_invocable_v<Fty, Args...>>*>
+	inline auto Async(ThreadPool& pool, Fty&& f, Args&&... args)
+	{
+		return AsyncTask<std::invoke_result_t<std::decay_t<Fty>, std::decay_t<Args>...>>{ pool, std::forward<Fty>(f), std::forward<Args>(args)... };
+	}
 }
@@ -53,4 +53,61 @@ namespace s3d
 	{
 		return{};
 	}
+
+	inline Image IImageDecoder::decodeScaled(IReader& reader, const Size& targetSize, const FilePathView pathHint) const
+	{
+		Image image = decode(reader, pathHint);
+
+		const Size size = ScaledSize(image.size(), targetSize);
+
+		if ((size.x <= 0) || (size.y <= 0))
+		{
+			return{};
+		}
+
+		if (size != image.size())
+		{
+			image.scale(size, InterpolationAlgorithm::Area);
+		}
+
+		return image;
+	}
+
+	inline Image IImageDecoder::decodeRegion(IReader& reader, const Rect& region, const FilePathView pathHint) const
+	{
+		const Image image = decode(reader, pathHint);
+
+		const Rect bounds = region.getOverlap(Rect{ image.size() });
+
+		if (not bounds.hasArea())
+		{
+			return{};
+		}
+
+		return image.clipped(bounds);
+	}
+
+	inline Size IImageDecoder::ScaledSize(const Size& imageSize, const Size& targetSize) noexcept
+	{
+		if ((imageSize.x <= 0) || (imageSize.y <= 0)
+			|| (targetSize.x <= 0) || (targetSize.y <= 0))
+		{
+			return{ 0, 0 };
+		}
+
+		// Image::fitted() と同じ大きさにする
+		const int32 width = Min(targetSize.x, imageSize.x);
+		const int32 height = Min(targetSize.y, imageSize.y);
+		const double ws = (static_cast<double>(width) / imageSize.x);
+		const double hs = (static_cast<double>(height) / imageSize.y);
+
+		if (ws < hs)
+		{
+			return{ width, Max(static_cast<int32>(imageSize.y * ws), 1) };
+		}
+		else
+		{
+			return{ Max(static_cast<int32>(imageSize.x * hs), 1), height };
+		}
+	}
 }
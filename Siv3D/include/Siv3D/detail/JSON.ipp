@@ -133,7 +133,44 @@ namespace s3d
 	template <class Reader, std::enable_if_t<std::is_base_of_v<IReader, Reader>>*>
 	inline JSON JSON::Load(Reader&& reader, const AllowExceptions allowExceptions)
 	{
-		return Load(std::make_shared<Reader>(std::move(reader)), allowExceptions);
+		return Load(std::make_unique<Reader>(std::move(reader)), allowExceptions);
+	}
+
+	template <class Fty, std::enable_if_t<std::is_invocable_v<Fty, const JSON&>>*>
+	inline bool JSON::ForEach(const FilePathView path, Fty f, const AllowExceptions allowExceptions)
+	{
+		return ForEach(path, U"", std::move(f), allowExceptions);
+	}
+
+	template <class Fty, std::enable_if_t<std::is_invocable_v<Fty, const JSON&>>*>
+	inline bool JSON::ForEach(const FilePathView path, const StringView jsonPointer, Fty f, const AllowExceptions allowExceptions)
+	{
+		return ForEachImpl(path, jsonPointer, MakeForEachCallback(std::move(f)), allowExceptions);
+	}
+
+	template <class Reader, class Fty, std::enable_if_t<std::is_base_of_v<IReader, Reader> && std::is_invocable_v<Fty, const JSON&>>*>
+	inline bool JSON::ForEach(Reader&& reader, const StringView jsonPointer, Fty f, const AllowExceptions allowExceptions)
+	{
+		return ForEachImpl(std::make_unique<Reader>(std::move(reader)), jsonPointer, MakeForEachCallback(std::move(f)), allowExceptions);
+	}
+
+	template <class Fty, std::enable_if_t<std::is_invocable_v<Fty, const JSON&>>*>
+	inline bool JSON::ForEach(std::unique_ptr<IReader>&& reader, const StringView jsonPointer, Fty f, const AllowExceptions allowExceptions)
+	{
+		return ForEachImpl(std::move(reader), jsonPointer, MakeForEachCallback(std::move(f)), allowExceptions);
+	}
+
+	template <class Fty>
+	inline std::function<bool(const JSON&)> JSON::MakeForEachCallback(Fty&& f)
+	{
+		if constexpr (std::is_same_v<std::invoke_result_t<Fty, const JSON&>, void>)
+		{
+			return [f = std::forward<Fty>(f)](const JSON& value) mutable { f(value); return true; };
+		}
+		else
+		{
+			return [f = std::forward<Fty>(f)](const JSON& value) mutable { return static_cast<bool>(f(value)); };
+		}
 	}
 
 	SIV3D_CONCEPT_INTEGRAL_
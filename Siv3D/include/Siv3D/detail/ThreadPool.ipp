@@ -0,0 +1,44 @@
+﻿//-----------------------------------------------
+//
+//	This file is part of the Siv3D Engine.
+//
+//	Copyright (c) 2008-2022 Ryo Suzuki
+//	Copyright (c) 2016-2022 OpenSiv3D Project
+//
+//	Licensed under the MIT License.
+//
+//-----------------------------------------------
+
+# pragma once
+
+namespace s3d
+{
+	template <class Fty, std::enable_if_t<std::is_invocable_v<Fty, size_t, size_t>>*>
+	inline void ThreadPool::parallel_for(const size_t first, const size_t last, const size_t grainSize, Fty f)
+	{
+		if (last <= first)
+		{
+			return;
+		}
+
+		parallelForImpl(first, last, grainSize, [](void* context, const size_t begin, const size_t end)
+		{
+			(*static_cast<Fty*>(context))(begin, end);
+		}, std::addressof(f));
+	}
+
+	template <class Fty, std::enable_if_t<std::is_invocable_v<Fty, size_t, size_t>>*>
+	inline void ThreadPool::parallel_for(const size_t first, const size_t last, Fty f)
+	{
+		if (last <= first)
+		{
+			return;
+		}
+
+		// 負荷の偏りを吸収するため、スレッドあたり 4 分割程度にする
+		const size_t numChunks = ((num_threads() + 1) * 4);
+		const size_t grainSize = Max<size_t>(1, ((last - first) + (numChunks - 1)) / numChunks);
+
+		parallel_for(first, last, grainSize, std::move(f));
+	}
+}
@@ -55,12 +55,12 @@ namespace s3d
 		m_initialized = true;
 	}
 
-	GL4Mesh::GL4Mesh(const Array<Vertex3D>& vertices, const Array<TriangleIndex32>& indices, const bool isDynamic)
+	GL4Mesh::GL4Mesh(const std::span<const Vertex3D> vertices, const std::span<const TriangleIndex32> indices, const bool isDynamic)
 		: m_vertexCount{ static_cast<uint32>(vertices.size()) }
 		, m_indexCount{ static_cast<uint32>(indices.size() * 3) }
 		, m_vertexStride{ sizeof(Vertex3D) }
-		, m_boundingSphere{ Geometry3D::BoundingSphere(vertices) }
-		, m_boundingBox{ Geometry3D::BoundingBox(vertices) }
+		, m_boundingSphere{ Geometry3D::BoundingSphere(vertices.data(), vertices.size()) }
+		, m_boundingBox{ Geometry3D::BoundingBox(vertices.data(), vertices.size()) }
 		, m_isDynamic{ isDynamic }
 	{
 		::glGenVertexArrays(1, &m_vao);
@@ -9,6 +9,7 @@
 //
 //-----------------------------------------------
 
+# include <cstring>
 # include <Siv3D/EngineLog.hpp>
 # include <Siv3D/Renderer2D/GL4/CRenderer2D_GL4.hpp>
 # include <Siv3D/Common/Siv3DEngine.hpp>
@@ -36,7 +37,20 @@ namespace s3d
 
 	GL4BackBuffer::~GL4BackBuffer()
 	{
-		// do nothing
+		for (auto& readback : m_asyncReadbacks)
+		{
+			if (readback.fence)
+			{
+				::glDeleteSync(readback.fence);
+				readback.fence = nullptr;
+			}
+
+			if (readback.pixelBuffer)
+			{
+				::glDeleteBuffers(1, &readback.pixelBuffer);
+				readback.pixelBuffer = 0;
+			}
+		}
 	}
 
 	void GL4BackBuffer::clear(const GL4ClearTarget clearTargets)
@@ -132,6 +146,92 @@ namespace s3d
 		return m_screenCaptureImage;
 	}
 
+	bool GL4BackBuffer::captureAsync()
+	{
+		AsyncReadback& readback = m_asyncReadbacks[m_asyncWriteIndex];
+
+		if (readback.fence)
+		{
+			return false;
+		}
+
+		if (not readback.pixelBuffer)
+		{
+			::glGenBuffers(1, &readback.pixelBuffer);
+		}
+
+		::glBindBuffer(GL_PIXEL_PACK_BUFFER, readback.pixelBuffer);
+
+		if (readback.size != m_sceneSize)
+		{
+			::glBufferData(GL_PIXEL_PACK_BUFFER, (m_sceneSize.x * m_sceneSize.y * sizeof(Color)), nullptr, GL_STREAM_READ);
+			readback.size = m_sceneSize;
+		}
+
+		const GLuint frameBuffer = ((m_sampleCount == 1)
+			? m_sceneBuffers.scene->getFrameBuffer() : m_sceneBuffers.resolved->getFrameBuffer());
+
+		// ピクセルバッファへの書き込みは GPU 側で行われるため、ここでは完了を待たない
+		::glBindFramebuffer(GL_READ_FRAMEBUFFER, frameBuffer);
+		{
+			::glReadPixels(0, 0, m_sceneSize.x, m_sceneSize.y, GL_RGBA, GL_UNSIGNED_BYTE, nullptr);
+		}
+		::glBindFramebuffer(GL_READ_FRAMEBUFFER, 0);
+
+		::glBindBuffer(GL_PIXEL_PACK_BUFFER, 0);
+
+		readback.fence = ::glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
+
+		m_asyncWriteIndex = ((m_asyncWriteIndex + 1) % m_asyncReadbacks.size());
+
+		return true;
+	}
+
+	bool GL4BackBuffer::retrieveAsyncCapture(Image& image)
+	{
+		AsyncReadback& readback = m_asyncReadbacks[m_asyncReadIndex];
+
+		if (not readback.fence)
+		{
+			return false;
+		}
+
+		if (::glClientWaitSync(readback.fence, 0, 0) == GL_TIMEOUT_EXPIRED)
+		{
+			return false;
+		}
+
+		::glDeleteSync(readback.fence);
+		readback.fence = nullptr;
+
+		m_asyncReadIndex = ((m_asyncReadIndex + 1) % m_asyncReadbacks.size());
+
+		image.resize(readback.size);
+
+		::glBindBuffer(GL_PIXEL_PACK_BUFFER, readback.pixelBuffer);
+		{
+			if (const void* pixels = ::glMapBufferRange(GL_PIXEL_PACK_BUFFER, 0, image.size_bytes(), GL_MAP_READ_BIT))
+			{
+				std::memcpy(image.data(), pixels, image.size_bytes());
+
+				::glUnmapBuffer(GL_PIXEL_PACK_BUFFER);
+			}
+			else
+			{
+				LOG_FAIL(U"✖ GL4BackBuffer::retrieveAsyncCapture(): glMapBufferRange() failed");
+				image.clear();
+			}
+		}
+		::glBindBuffer(GL_PIXEL_PACK_BUFFER, 0);
+
+		for (auto& pixel : image)
+		{
+			pixel.a = 255;
+		}
+
+		return true;
+	}
+
 	//////////////////////////////////////////////////
 	//
 	//	LetterboxColor
@@ -10,6 +10,7 @@
 //-----------------------------------------------
 
 # pragma once
+# include <array>
 # include <Siv3D/Common.hpp>
 # include <Siv3D/Common/OpenGL.hpp>
 # include <Siv3D/PointVector.hpp>
@@ -63,6 +64,24 @@ namespace s3d
 
 		Image m_screenCaptureImage;
 
+		// 非同期のスクリーンショットの読み出しに使うピクセルバッファ
+		struct AsyncReadback
+		{
+			GLuint pixelBuffer = 0;
+
+			GLsync fence = nullptr;
+
+			Size size{ 0, 0 };
+		};
+
+		std::array<AsyncReadback, 2> m_asyncReadbacks;
+
+		// 最も古い、読み出し中のバッファ
+		size_t m_asyncReadIndex = 0;
+
+		// 次に読み出しを開始するバッファ
+		size_t m_asyncWriteIndex = 0;
+
 	public:
 
 		GL4BackBuffer();
@@ -83,6 +102,15 @@ namespace s3d
 
 		const Image& getScreenCapture() const;
 
+		/// @brief シーンの内容のピクセルバッファへの読み出しを開始します。
+		/// @return 読み出しを開始した場合 true, 空いているピクセルバッファが無い場合は false
+		bool captureAsync();
+
+		/// @brief 読み出しが完了した、最も古いスクリーンショットを取得します。
+		/// @param image 取得した画像の格納先
+		/// @return 読み出しが完了したスクリーンショットがあった場合 true, それ以外の場合は false
+		bool retrieveAsyncCapture(Image& image);
+
 		//////////////////////////////////////////////////
 		//
 		//	LetterboxColor
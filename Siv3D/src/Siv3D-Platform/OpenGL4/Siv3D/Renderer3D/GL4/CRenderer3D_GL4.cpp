@@ -54,6 +54,7 @@ namespace s3d
 			LOG_INFO(U"📦 Loading vertex shaders for CRenderer3D_GL4:");
 			m_standardVS = std::make_unique<GL4StandardVS3D>();
 			m_standardVS->forward = GLSL{ Resource(U"engine/shader/glsl/forward3d.vert"), { { U"VSPerView", 1 }, { U"VSPerObject", 2 }, { U"VSPerMaterial", 3 } } };
+			m_standardVS->forwardInstanced = GLSL{ Resource(U"engine/shader/glsl/forward3d_instanced.vert"), { { U"VSPerView", 1 }, { U"VSPerInstance", 2 }, { U"VSPerMaterial", 3 } } };
 			m_standardVS->line3D = GLSL{ Resource(U"engine/shader/glsl/line3d.vert"), { { U"VSPerView", 1 }, { U"VSPerObject", 2 } } };
 
 			if (not m_standardVS->setup())
@@ -67,6 +68,7 @@ namespace s3d
 			LOG_INFO(U"📦 Loading pixel shaders for CRenderer3D_GL4:");
 			m_standardPS = std::make_unique<GL4StandardPS3D>();
 			m_standardPS->forward = GLSL{ Resource(U"engine/shader/glsl/forward3d.frag"), { { U"PSPerFrame", 0 }, { U"PSPerView", 1 }, { U"PSPerMaterial", 3 } } };
+			m_standardPS->forwardInstanced = GLSL{ Resource(U"engine/shader/glsl/forward3d_instanced.frag"), { { U"PSPerFrame", 0 }, { U"PSPerView", 1 }, { U"PSPerMaterial", 3 } } };
 			m_standardPS->line3D = GLSL{ Resource(U"engine/shader/glsl/line3d.frag"), {} };
 
 			if (not m_standardPS->setup())
@@ -79,6 +81,16 @@ namespace s3d
 		{
 			throw EngineError{ U"GL4Line3DBatch::init() failed" };
 		}
+
+		if (not m_instanceBuffer.init())
+		{
+			throw EngineError{ U"GL4Instance3DBuffer::init() failed" };
+		}
+	}
+
+	void CRenderer3D_GL4::update()
+	{
+		m_stat = {};
 	}
 
 	const Renderer3DStat& CRenderer3D_GL4::getStat() const
@@ -88,6 +100,13 @@ namespace s3d
 
 	void CRenderer3D_GL4::addMesh(const uint32 startIndex, const uint32 indexCount, const Mesh& mesh, const PhongMaterial& material)
 	{
+		if (not hasCustomShader())
+		{
+			const Mat4x4 transform = Mat4x4::Identity();
+			addInstances(startIndex, indexCount, mesh, Float4{ 1.0f, 1.0f, 0.0f, 0.0f }, material, { &transform, 1 }, {});
+			return;
+		}
+
 		if (not m_currentCustomVS)
 		{
 			m_commandManager.pushStandardVS(m_standardVS->forwardID);
@@ -109,6 +128,14 @@ namespace s3d
 
 	void CRenderer3D_GL4::addTexturedMesh(const uint32 startIndex, const uint32 indexCount, const Mesh& mesh, const Texture& texture, const PhongMaterial& material)
 	{
+		if (not hasCustomShader())
+		{
+			const Mat4x4 transform = Mat4x4::Identity();
+			m_commandManager.pushPSTexture(0, texture);
+			addInstances(startIndex, indexCount, mesh, Float4{ 1.0f, 1.0f, 0.0f, 0.0f }, material, { &transform, 1 }, {});
+			return;
+		}
+
 		if (not m_currentCustomVS)
 		{
 			m_commandManager.pushStandardVS(m_standardVS->forwardID);
@@ -131,6 +158,20 @@ namespace s3d
 
 	void CRenderer3D_GL4::addTexturedMesh(const uint32 startIndex, const uint32 indexCount, const Mesh& mesh, const TextureRegion& textureRegion, const PhongMaterial& material)
 	{
+		Float4 uvTransform;
+		uvTransform.x = (textureRegion.uvRect.right - textureRegion.uvRect.left);
+		uvTransform.y = (textureRegion.uvRect.bottom - textureRegion.uvRect.top);
+		uvTransform.z = textureRegion.uvRect.left;
+		uvTransform.w = textureRegion.uvRect.top;
+
+		if (not hasCustomShader())
+		{
+			const Mat4x4 transform = Mat4x4::Identity();
+			m_commandManager.pushPSTexture(0, textureRegion.texture);
+			addInstances(startIndex, indexCount, mesh, uvTransform, material, { &transform, 1 }, {});
+			return;
+		}
+
 		if (not m_currentCustomVS)
 		{
 			m_commandManager.pushStandardVS(m_standardVS->forwardID);
@@ -143,12 +184,6 @@ namespace s3d
 
 		m_commandManager.pushInputLayout(GL4InputLayout3D::Mesh);
 		m_commandManager.pushMesh(mesh);
-
-		Float4 uvTransform;
-		uvTransform.x = (textureRegion.uvRect.right - textureRegion.uvRect.left);
-		uvTransform.y = (textureRegion.uvRect.bottom - textureRegion.uvRect.top);
-		uvTransform.z = textureRegion.uvRect.left;
-		uvTransform.w = textureRegion.uvRect.top;
 		m_commandManager.pushUVTransform(uvTransform);
 		m_commandManager.pushPSTexture(0, textureRegion.texture);
 
@@ -157,6 +192,57 @@ namespace s3d
 		m_commandManager.pushDraw(startIndex, indexCount, phong, instanceCount);
 	}
 
+	void CRenderer3D_GL4::addMeshInstanced(const uint32 startIndex, const uint32 indexCount, const Mesh& mesh, const PhongMaterial& material, const std::span<const Mat4x4> transforms, const std::span<const ColorF> colors)
+	{
+		if (not hasCustomShader())
+		{
+			addInstances(startIndex, indexCount, mesh, Float4{ 1.0f, 1.0f, 0.0f, 0.0f }, material, transforms, colors);
+			return;
+		}
+
+		const Mat4x4 localTransform = m_commandManager.getCurrentLocalTransform();
+		PhongMaterial instanceMaterial = material;
+
+		for (size_t i = 0; i < transforms.size(); ++i)
+		{
+			if (not colors.empty())
+			{
+				instanceMaterial.diffuseColor = colors[i];
+			}
+
+			m_commandManager.pushLocalTransform(transforms[i] * localTransform);
+			addMesh(startIndex, indexCount, mesh, instanceMaterial);
+		}
+
+		m_commandManager.pushLocalTransform(localTransform);
+	}
+
+	void CRenderer3D_GL4::addTexturedMeshInstanced(const uint32 startIndex, const uint32 indexCount, const Mesh& mesh, const Texture& texture, const PhongMaterial& material, const std::span<const Mat4x4> transforms, const std::span<const ColorF> colors)
+	{
+		if (not hasCustomShader())
+		{
+			m_commandManager.pushPSTexture(0, texture);
+			addInstances(startIndex, indexCount, mesh, Float4{ 1.0f, 1.0f, 0.0f, 0.0f }, material, transforms, colors);
+			return;
+		}
+
+		const Mat4x4 localTransform = m_commandManager.getCurrentLocalTransform();
+		PhongMaterial instanceMaterial = material;
+
+		for (size_t i = 0; i < transforms.size(); ++i)
+		{
+			if (not colors.empty())
+			{
+				instanceMaterial.diffuseColor = colors[i];
+			}
+
+			m_commandManager.pushLocalTransform(transforms[i] * localTransform);
+			addTexturedMesh(startIndex, indexCount, mesh, texture, instanceMaterial);
+		}
+
+		m_commandManager.pushLocalTransform(localTransform);
+	}
+
 	void CRenderer3D_GL4::addLine3D(const Float3& begin, const Float3& end, const Float4(&colors)[2])
 	{
 		constexpr VertexLine3D::IndexType vertexSize = 2, indexSize = 2;
@@ -422,6 +508,23 @@ namespace s3d
 		m_commandManager.pushConstantBuffer(stage, slot, buffer, data, num_vectors);
 	}
 
+	bool CRenderer3D_GL4::hasCustomShader() const noexcept
+	{
+		return (m_currentCustomVS || m_currentCustomPS);
+	}
+
+	void CRenderer3D_GL4::addInstances(const uint32 startIndex, const uint32 indexCount, const Mesh& mesh, const Float4& uvTransform, const PhongMaterial& material, const std::span<const Mat4x4> transforms, const std::span<const ColorF> colors)
+	{
+		m_commandManager.pushStandardVS(m_standardVS->forwardInstancedID);
+		m_commandManager.pushStandardPS(m_standardPS->forwardInstancedID);
+		m_commandManager.pushInputLayout(GL4InputLayout3D::Mesh);
+		m_commandManager.pushMesh(mesh);
+		m_commandManager.pushUVTransform(uvTransform);
+
+		const PhongMaterialInternal phong{ material };
+		m_commandManager.pushDrawInstanced(startIndex, indexCount, phong, transforms, colors);
+	}
+
 	void CRenderer3D_GL4::flush()
 	{
 		ScopeGuard cleanUp = [this]()
@@ -451,6 +554,12 @@ namespace s3d
 		pShader->setConstantBufferPS(1, m_psPerViewConstants.base());
 		pShader->setConstantBufferPS(3, m_psPerMaterialConstants.base());
 
+		m_instanceBuffer.update(m_commandManager.getDrawInstanceds(), m_commandManager.getInstances());
+
+		// インスタンス描画では、VS slot-2 を VSPerObject の代わりにインスタンスのデータに使う
+		const uint32 perObjectBinding = Shader::Internal::MakeUniformBlockBinding(ShaderStage::Vertex, 2);
+		bool perObjectConstantsUnbound = false;
+
 		BatchInfoLine3D batchInfoLine3D;
 		VertexShader::IDType vsID = m_standardVS->forwardID;
 		PixelShader::IDType psID = m_standardPS->forwardID;
@@ -485,6 +594,12 @@ namespace s3d
 					const PhongMaterialInternal& material = m_commandManager.getDrawPhongMaterial(instanceIndex);
 					m_psPerMaterialConstants->material = material;
 
+					if (perObjectConstantsUnbound)
+					{
+						pShader->setConstantBufferVS(2, m_vsPerObjectConstants.base());
+						perObjectConstantsUnbound = false;
+					}
+
 					m_vsPerViewConstants._update_if_dirty();
 					m_vsPerObjectConstants._update_if_dirty();
 					m_vsPerMaterialConstants._update_if_dirty();
@@ -497,12 +612,44 @@ namespace s3d
 
 					instanceIndex += instanceCount;
 
-					//++m_stat.drawCalls;
-					//m_stat.triangleCount += (indexCount / 3);
+					++m_stat.drawCalls;
+					m_stat.triangleCount += (indexCount / 3);
 
 					LOG_COMMAND(U"Draw[{}] indexCount = {}, startIndexLocation = {}"_fmt(command.index, indexCount, startIndexLocation));
 					break;
 				}
+			case GL4Renderer3DCommandType::DrawInstanced:
+				{
+					const GL4DrawInstanced3DCommand& draw = m_commandManager.getDrawInstanced(command.index);
+					const uint32 indexCount = draw.indexCount;
+					const uint32 startIndexLocation = draw.startIndex;
+
+					m_psPerMaterialConstants->material = draw.material;
+
+					m_vsPerViewConstants._update_if_dirty();
+					m_vsPerMaterialConstants._update_if_dirty();
+					m_psPerFrameConstants._update_if_dirty();
+					m_psPerViewConstants._update_if_dirty();
+					m_psPerMaterialConstants._update_if_dirty();
+
+					constexpr Vertex3D::IndexType* pBase = 0;
+
+					for (uint32 firstInstance = 0; firstInstance < draw.instanceCount; firstInstance += GL4Instance3DBuffer::MaxInstancesPerDraw)
+					{
+						const uint32 instanceCount = Min((draw.instanceCount - firstInstance), GL4Instance3DBuffer::MaxInstancesPerDraw);
+
+						m_instanceBuffer.bind(perObjectBinding, command.index, firstInstance);
+						::glDrawElementsInstanced(GL_TRIANGLES, indexCount, GL_UNSIGNED_INT, (pBase + startIndexLocation), instanceCount);
+
+						++m_stat.drawCalls;
+						m_stat.triangleCount += ((indexCount / 3) * instanceCount);
+					}
+
+					perObjectConstantsUnbound = true;
+
+					LOG_COMMAND(U"DrawInstanced[{}] indexCount = {}, startIndexLocation = {}, instanceCount = {}"_fmt(command.index, indexCount, startIndexLocation, draw.instanceCount));
+					break;
+				}
 			case GL4Renderer3DCommandType::DrawLine3D:
 				{
 					m_line3DBatch.setBuffers();
@@ -510,6 +657,12 @@ namespace s3d
 					pShader->setVS(m_standardVS->line3DID);
 					pShader->setPS(m_standardPS->line3DID);
 
+					if (perObjectConstantsUnbound)
+					{
+						pShader->setConstantBufferVS(2, m_vsPerObjectConstants.base());
+						perObjectConstantsUnbound = false;
+					}
+
 					m_vsPerViewConstants._update_if_dirty();
 					m_vsPerObjectConstants._update_if_dirty();
 					m_vsPerMaterialConstants._update_if_dirty();
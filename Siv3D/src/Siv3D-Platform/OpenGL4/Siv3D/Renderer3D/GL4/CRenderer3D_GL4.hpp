@@ -18,6 +18,7 @@
 # include <Siv3D/Renderer3D/Renderer3DCommon.hpp>
 # include "GL4Renderer3DCommand.hpp"
 # include "GL4Line3DBatch.hpp"
+# include "GL4Instance3DBuffer.hpp"
 
 namespace s3d
 {
@@ -29,16 +30,19 @@ namespace s3d
 	struct GL4StandardVS3D
 	{
 		VertexShader forward;
+		VertexShader forwardInstanced;
 		VertexShader line3D;
 
 		VertexShader::IDType forwardID;
+		VertexShader::IDType forwardInstancedID;
 		VertexShader::IDType line3DID;
 
 		bool setup()
 		{
-			const bool result = (forward && line3D);
+			const bool result = (forward && forwardInstanced && line3D);
 
 			forwardID = forward.id();
+			forwardInstancedID = forwardInstanced.id();
 			line3DID = line3D.id();
 
 			return result;
@@ -48,16 +52,19 @@ namespace s3d
 	struct GL4StandardPS3D
 	{
 		PixelShader forward;
+		PixelShader forwardInstanced;
 		PixelShader line3D;
 
 		PixelShader::IDType forwardID;
+		PixelShader::IDType forwardInstancedID;
 		PixelShader::IDType line3DID;
 
 		bool setup()
 		{
-			const bool result = forward && line3D;
+			const bool result = forward && forwardInstanced && line3D;
 
 			forwardID = forward.id();
+			forwardInstancedID = forwardInstanced.id();
 			line3DID = line3D.id();
 
 			return result;
@@ -74,6 +81,8 @@ namespace s3d
 
 		void init() override;
 
+		void update() override;
+
 		const Renderer3DStat& getStat() const override;
 
 		void addMesh(uint32 startIndex, uint32 indexCount, const Mesh& mesh, const PhongMaterial& material) override;
@@ -82,6 +91,10 @@ namespace s3d
 
 		void addTexturedMesh(uint32 startIndex, uint32 indexCount, const Mesh& mesh, const TextureRegion& textureRegion, const PhongMaterial& material) override;
 
+		void addMeshInstanced(uint32 startIndex, uint32 indexCount, const Mesh& mesh, const PhongMaterial& material, std::span<const Mat4x4> transforms, std::span<const ColorF> colors) override;
+
+		void addTexturedMeshInstanced(uint32 startIndex, uint32 indexCount, const Mesh& mesh, const Texture& texture, const PhongMaterial& material, std::span<const Mat4x4> transforms, std::span<const ColorF> colors) override;
+
 		void addLine3D(const Float3& begin, const Float3& end, const Float4(&colors)[2]) override;
 
 
@@ -181,9 +194,17 @@ namespace s3d
 
 		GL4Line3DBatch m_line3DBatch;
 
+		GL4Instance3DBuffer m_instanceBuffer;
+
 		Optional<VertexShader> m_currentCustomVS;
 		Optional<PixelShader> m_currentCustomPS;
 
 		Renderer3DStat m_stat;
+
+		// カスタムシェーダはインスタンスごとのデータを読まないため、インスタンス描画を使わない
+		[[nodiscard]]
+		bool hasCustomShader() const noexcept;
+
+		void addInstances(uint32 startIndex, uint32 indexCount, const Mesh& mesh, const Float4& uvTransform, const PhongMaterial& material, std::span<const Mat4x4> transforms, std::span<const ColorF> colors);
 	};
 }
@@ -0,0 +1,109 @@
+﻿//-----------------------------------------------
+//
+//	This file is part of the Siv3D Engine.
+//
+//	Copyright (c) 2008-2022 Ryo Suzuki
+//	Copyright (c) 2016-2022 OpenSiv3D Project
+//
+//	Licensed under the MIT License.
+//
+//-----------------------------------------------
+
+
+# include <cstring>
+# include <Siv3D/EngineLog.hpp>
+# include "GL4Instance3DBuffer.hpp"
+
+namespace s3d
+{
+	namespace detail
+	{
+		[[nodiscard]]
+		static constexpr uint32 AlignUp(const uint32 value, const uint32 alignment) noexcept
+		{
+			return (((value + alignment - 1) / alignment) * alignment);
+		}
+	}
+
+	GL4Instance3DBuffer::~GL4Instance3DBuffer()
+	{
+		if (m_uniformBuffer)
+		{
+			::glDeleteBuffers(1, &m_uniformBuffer);
+			m_uniformBuffer = 0;
+		}
+	}
+
+	bool GL4Instance3DBuffer::init()
+	{
+		GLint alignment = 0;
+		::glGetIntegerv(GL_UNIFORM_BUFFER_OFFSET_ALIGNMENT, &alignment);
+
+		if (0 < alignment)
+		{
+			m_offsetAlignment = static_cast<uint32>(alignment);
+		}
+
+		LOG_TRACE(U"GL_UNIFORM_BUFFER_OFFSET_ALIGNMENT: {}"_fmt(alignment));
+
+		::glGenBuffers(1, &m_uniformBuffer);
+
+		return (m_uniformBuffer != 0);
+	}
+
+	void GL4Instance3DBuffer::update(const Array<GL4DrawInstanced3DCommand>& draws, const Array<VSPerInstanceData3D>& instances)
+	{
+		if (draws.isEmpty())
+		{
+			return;
+		}
+
+		// 描画呼び出しごとのデータを、バインドできる位置から詰めて配置する
+		const uint32 blockStride = detail::AlignUp(BlockSize, m_offsetAlignment);
+		uint32 writePos = 0;
+		uint32 bufferSize = 0;
+
+		m_drawOffsets.resize(draws.size());
+
+		for (size_t i = 0; i < draws.size(); ++i)
+		{
+			const uint32 instanceCount = draws[i].instanceCount;
+			const uint32 lastBlock = ((instanceCount - 1) / MaxInstancesPerDraw);
+			const uint32 lastBlockOffset = (writePos + lastBlock * blockStride);
+			m_drawOffsets[i] = writePos;
+
+			// バインドする範囲 (BlockSize) は次の描画のデータと重なってもよいが、バッファには収まっている必要がある
+			bufferSize = Max(bufferSize, (lastBlockOffset + BlockSize));
+			writePos = detail::AlignUp((lastBlockOffset + (instanceCount - lastBlock * MaxInstancesPerDraw) * static_cast<uint32>(sizeof(VSPerInstanceData3D))), m_offsetAlignment);
+		}
+
+		m_data.resize(bufferSize);
+
+		for (size_t i = 0; i < draws.size(); ++i)
+		{
+			const GL4DrawInstanced3DCommand& draw = draws[i];
+
+			for (uint32 first = 0; first < draw.instanceCount; first += MaxInstancesPerDraw)
+			{
+				const uint32 count = Min((draw.instanceCount - first), MaxInstancesPerDraw);
+				const uint32 offset = (m_drawOffsets[i] + (first / MaxInstancesPerDraw) * blockStride);
+				std::memcpy((m_data.data() + offset), (instances.data() + draw.startInstance + first), (sizeof(VSPerInstanceData3D) * count));
+			}
+		}
+
+		// バッファを確保しなおして、GPU が使用中の古いデータの解放を待たないようにする
+		::glBindBuffer(GL_UNIFORM_BUFFER, m_uniformBuffer);
+		::glBufferData(GL_UNIFORM_BUFFER, bufferSize, m_data.data(), GL_STREAM_DRAW);
+		::glBindBuffer(GL_UNIFORM_BUFFER, 0);
+	}
+
+	void GL4Instance3DBuffer::bind(const uint32 binding, const uint32 drawIndex, const uint32 firstInstance) const
+	{
+		assert((firstInstance % MaxInstancesPerDraw) == 0);
+
+		const uint32 blockStride = detail::AlignUp(BlockSize, m_offsetAlignment);
+		const uint32 offset = (m_drawOffsets[drawIndex] + (firstInstance / MaxInstancesPerDraw) * blockStride);
+
+		::glBindBufferRange(GL_UNIFORM_BUFFER, binding, m_uniformBuffer, offset, BlockSize);
+	}
+}
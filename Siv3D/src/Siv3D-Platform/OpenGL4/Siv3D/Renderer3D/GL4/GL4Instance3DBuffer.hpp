@@ -0,0 +1,63 @@
+﻿//-----------------------------------------------
+//
+//	This file is part of the Siv3D Engine.
+//
+//	Copyright (c) 2008-2022 Ryo Suzuki
+//	Copyright (c) 2016-2022 OpenSiv3D Project
+//
+//	Licensed under the MIT License.
+//
+//-----------------------------------------------
+
+
+# pragma once
+# include <Siv3D/Common.hpp>
+# include <Siv3D/Common/OpenGL.hpp>
+# include <Siv3D/Array.hpp>
+# include <Siv3D/Renderer3D/Renderer3DCommon.hpp>
+# include "GL4Renderer3DCommand.hpp"
+
+namespace s3d
+{
+	/// @brief インスタンス描画で使う、インスタンスごとのデータを格納する Uniform Buffer
+	class GL4Instance3DBuffer
+	{
+	public:
+
+		/// @brief 1 回の描画呼び出しで描けるインスタンスの最大数
+		/// @remark GL_MAX_UNIFORM_BLOCK_SIZE の最小保証値 16 KiB に収まる数です。シェーダの配列の大きさと一致させる必要があります。
+		static constexpr uint32 MaxInstancesPerDraw = 192;
+
+		GL4Instance3DBuffer() = default;
+
+		~GL4Instance3DBuffer();
+
+		[[nodiscard]]
+		bool init();
+
+		/// @brief すべてのインスタンス描画のデータを、1 回の転送で Uniform Buffer に書き込みます。
+		/// @param draws インスタンス描画の一覧
+		/// @param instances インスタンスのデータ
+		void update(const Array<GL4DrawInstanced3DCommand>& draws, const Array<VSPerInstanceData3D>& instances);
+
+		/// @brief drawIndex 番目の描画の、firstInstance 番目からのインスタンスのデータをバインドします。
+		/// @param binding Uniform Block のバインディングポイント
+		/// @param drawIndex 描画のインデックス
+		/// @param firstInstance 先頭のインスタンス。MaxInstancesPerDraw の倍数である必要があります。
+		void bind(uint32 binding, uint32 drawIndex, uint32 firstInstance) const;
+
+	private:
+
+		static constexpr uint32 BlockSize = (sizeof(VSPerInstanceData3D) * MaxInstancesPerDraw);
+
+		GLuint m_uniformBuffer = 0;
+
+		// glBindBufferRange() に渡すオフセットはこの値の倍数でなければならない
+		uint32 m_offsetAlignment = 256;
+
+		// 各描画の最初のデータの位置（バイト）
+		Array<uint32> m_drawOffsets;
+
+		Array<Byte> m_data;
+	};
+}
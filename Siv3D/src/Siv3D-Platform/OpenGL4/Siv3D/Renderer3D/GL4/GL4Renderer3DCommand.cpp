@@ -13,6 +13,20 @@
 
 namespace s3d
 {
+	namespace detail
+	{
+		// 拡散反射色はインスタンスごとに持つため比較しない
+		[[nodiscard]]
+		static bool HasSameParameters(const PhongMaterialInternal& a, const PhongMaterialInternal& b) noexcept
+		{
+			return ((a.amibientColor == b.amibientColor)
+				&& (a.hasDiffuseTexture == b.hasDiffuseTexture)
+				&& (a.specularColor == b.specularColor)
+				&& (a.shininess == b.shininess)
+				&& (a.emissionColor == b.emissionColor));
+		}
+	}
+
 	GL4Renderer3DCommandManager::GL4Renderer3DCommandManager()
 	{
 		m_vsSamplerStates.fill(Array<SamplerState>{ SamplerState::Default3D });
@@ -49,6 +63,9 @@ namespace s3d
 
 			m_drawLine3Ds.clear();
 
+			m_drawInstanceds.clear();
+			m_instances.clear();
+
 			//	m_nullDraws.clear();
 			m_blendStates = { m_blendStates.back() };
 			m_rasterizerStates = { m_rasterizerStates.back() };
@@ -377,7 +394,8 @@ namespace s3d
 	bool GL4Renderer3DCommandManager::hasDraw() const noexcept
 	{
 		return ((not m_draws.isEmpty())
-			|| (not m_drawLine3Ds.isEmpty()));
+			|| (not m_drawLine3Ds.isEmpty())
+			|| (not m_drawInstanceds.isEmpty()));
 	}
 
 	const Array<GL4Renderer3DCommand>& GL4Renderer3DCommandManager::getCommands() const noexcept
@@ -440,6 +458,64 @@ namespace s3d
 		return m_drawLine3Ds[index];
 	}
 
+	void GL4Renderer3DCommandManager::pushDrawInstanced(const uint32 startIndex, const uint32 indexCount, const PhongMaterialInternal& material, const std::span<const Mat4x4> transforms, const std::span<const ColorF> colors)
+	{
+		assert(colors.empty() || (colors.size() == transforms.size()));
+
+		if (transforms.empty())
+		{
+			return;
+		}
+
+		// インスタンスのデータにはローカル変換行列が含まれるため、その変更だけであれば直前の描画にまとめられる
+		CurrentBatchStateChanges<GL4Renderer3DCommandType> changes = m_changes;
+		changes.clear(GL4Renderer3DCommandType::Draw);
+		changes.clear(GL4Renderer3DCommandType::LocalTransform);
+
+		const bool merge = ((not m_commands.isEmpty())
+			&& (m_commands.back().type == GL4Renderer3DCommandType::DrawInstanced)
+			&& (not changes.hasStateChange())
+			&& (m_currentDrawLine3D.indexCount == 0)
+			&& (m_drawInstanceds.back().startIndex == startIndex)
+			&& (m_drawInstanceds.back().indexCount == indexCount)
+			&& detail::HasSameParameters(m_drawInstanceds.back().material, material));
+
+		if (not merge)
+		{
+			if (m_changes.hasStateChange())
+			{
+				flush();
+			}
+
+			m_commands.emplace_back(GL4Renderer3DCommandType::DrawInstanced, static_cast<uint32>(m_drawInstanceds.size()));
+			m_drawInstanceds.push_back({ startIndex, indexCount, static_cast<uint32>(m_instances.size()), 0, material });
+		}
+
+		for (size_t i = 0; i < transforms.size(); ++i)
+		{
+			VSPerInstanceData3D& instance = m_instances.emplace_back();
+			instance.localToWorld = (transforms[i] * m_currentLocalTransform).transposed();
+			instance.diffuseColor = (colors.empty() ? material.diffuseColor : colors[i].toFloat4());
+		}
+
+		m_drawInstanceds.back().instanceCount += static_cast<uint32>(transforms.size());
+	}
+
+	const GL4DrawInstanced3DCommand& GL4Renderer3DCommandManager::getDrawInstanced(const uint32 index) const noexcept
+	{
+		return m_drawInstanceds[index];
+	}
+
+	const Array<GL4DrawInstanced3DCommand>& GL4Renderer3DCommandManager::getDrawInstanceds() const noexcept
+	{
+		return m_drawInstanceds;
+	}
+
+	const Array<VSPerInstanceData3D>& GL4Renderer3DCommandManager::getInstances() const noexcept
+	{
+		return m_instances;
+	}
+
 	//void GL4Renderer2DCommandManager::pushNullVertices(const uint32 count)
 	//{
 	//	if (m_changes.hasStateChange())
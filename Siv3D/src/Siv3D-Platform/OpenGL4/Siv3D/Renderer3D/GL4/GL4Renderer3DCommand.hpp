@@ -10,6 +10,7 @@
 //-----------------------------------------------
 
 # pragma once
+# include <span>
 # include <Siv3D/Common.hpp>
 # include <Siv3D/Array.hpp>
 # include <Siv3D/Optional.hpp>
@@ -29,6 +30,7 @@
 # include <Siv3D/PhongMaterial.hpp>
 # include <Siv3D/Renderer2D/CurrentBatchStateChanges.hpp>
 # include <Siv3D/Renderer3D/VertexLine3D.hpp>
+# include <Siv3D/Renderer3D/Renderer3DCommon.hpp>
 
 namespace s3d
 {
@@ -42,6 +44,8 @@ namespace s3d
 
 		DrawLine3D,
 
+		DrawInstanced,
+
 		BlendState,
 
 		RasterizerState,
@@ -171,6 +175,19 @@ namespace s3d
 		uint32 indexCount = 0;
 	};
 
+	struct GL4DrawInstanced3DCommand
+	{
+		uint32 startIndex = 0;
+
+		uint32 indexCount = 0;
+
+		uint32 startInstance = 0;
+
+		uint32 instanceCount = 0;
+
+		PhongMaterialInternal material;
+	};
+
 	struct GL4ConstantBuffer3DCommand
 	{
 		ShaderStage stage	= ShaderStage::Vertex;
@@ -199,6 +216,8 @@ namespace s3d
 		// buffer
 		Array<GL4Draw3DCommand> m_draws;
 		Array<GL4DrawLine3DCommand> m_drawLine3Ds;
+		Array<GL4DrawInstanced3DCommand> m_drawInstanceds;
+		Array<VSPerInstanceData3D> m_instances;
 		//Array<uint32> m_nullDraws;
 		Array<PhongMaterialInternal> m_drawPhongMaterials;
 		Array<BlendState> m_blendStates				= { BlendState::Default3D };
@@ -289,6 +308,13 @@ namespace s3d
 		void pushDrawLine3D(VertexLine3D::IndexType indexCount);
 		const GL4DrawLine3DCommand& getDrawLine3D(uint32 index) const noexcept;
 
+		/// @brief 現在の状態で、同じメッシュを transforms.size() 個描画します。
+		/// @remark 直前の描画とメッシュ、インデックスの範囲、テクスチャなどの状態、および拡散反射色以外のマテリアルが同じ場合は、1 つの描画にまとめます。
+		void pushDrawInstanced(uint32 startIndex, uint32 indexCount, const PhongMaterialInternal& material, std::span<const Mat4x4> transforms, std::span<const ColorF> colors);
+		const GL4DrawInstanced3DCommand& getDrawInstanced(uint32 index) const noexcept;
+		const Array<GL4DrawInstanced3DCommand>& getDrawInstanceds() const noexcept;
+		const Array<VSPerInstanceData3D>& getInstances() const noexcept;
+
 		//void pushNullVertices(uint32 count);
 		//uint32 getNullDraw(uint32 index) const noexcept;
 
@@ -49,19 +49,24 @@ namespace s3d
 
 	Mesh::IDType CMesh_GLES3::create(const MeshData& meshData)
 	{
-		if ((not meshData.vertices) || (not meshData.indices))
+		return create(meshData.vertices, meshData.indices);
+	}
+
+	Mesh::IDType CMesh_GLES3::create(const std::span<const Vertex3D> vertices, const std::span<const TriangleIndex32> indices)
+	{
+		if (vertices.empty() || indices.empty())
 		{
 			return Mesh::IDType::NullAsset();
 		}
 
-		auto mesh = std::make_unique<GLES3Mesh>(meshData, false);
+		auto mesh = std::make_unique<GLES3Mesh>(vertices, indices, false);
 
 		if (not mesh->isInitialized())
 		{
 			return Mesh::IDType::NullAsset();
 		}
 
-		const String info = U"(type: Default, vertex count:{0}, triangle count: {1})"_fmt(meshData.vertices.size(), meshData.indices.size());
+		const String info = U"(type: Default, vertex count:{0}, triangle count: {1})"_fmt(vertices.size(), indices.size());
 		return m_meshes.add(std::move(mesh), info);
 	}
 
@@ -112,6 +112,9 @@ namespace s3d
 		// VertexBuilder でのメモリアロケーションを避けるためのバッファ
 		Array<Float2> m_buffer;
 
+		// 多数の図形をまとめて作成するときの、図形ごとの書き込み位置
+		Array<Vertex2DBatchOffset> m_batchOffsetBuffer;
+
 
 		Renderer2DStat m_stat;
 
@@ -177,6 +180,12 @@ namespace s3d
 
 		void addPolygonFrame(const Float2* points, size_t size, float thickness, const Float4& color) override;
 
+		void addBatch(const Batch2DBuildFunc& build) override;
+
+		void addParticles(const ParticleStore2D& particles,
+			const ParticleSystem2DParameters::SizeOverLifeTimeFunc& sizeOverLifeTimeFunc,
+			const ParticleSystem2DParameters::ColorOverLifeTimeFunc& colorOverLifeTimeFunc) override;
+
 		void addNullVertices(uint32 count) override;
 
 		void addTextureRegion(const Texture& texture, const FloatRect& rect, const FloatRect& uv, const Float4& color) override;
@@ -191,9 +200,9 @@ namespace s3d
 
 		void addTexturedVertices(const Texture& texture, const Vertex2D* vertices, size_t vertexCount, const TriangleIndex* indices, size_t num_triangles) override;
 
-		void addTexturedParticles(const Texture& texture, const Array<Particle2D>& particles,
-			ParticleSystem2DParameters::SizeOverLifeTimeFunc sizeOverLifeTimeFunc,
-			ParticleSystem2DParameters::ColorOverLifeTimeFunc colorOverLifeTimeFunc) override;
+		void addTexturedParticles(const Texture& texture, const ParticleStore2D& particles,
+			const ParticleSystem2DParameters::SizeOverLifeTimeFunc& sizeOverLifeTimeFunc,
+			const ParticleSystem2DParameters::ColorOverLifeTimeFunc& colorOverLifeTimeFunc) override;
 
 
 		Float4 getColorMul() const override;
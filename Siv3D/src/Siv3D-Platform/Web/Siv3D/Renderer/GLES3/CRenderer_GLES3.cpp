@@ -142,7 +142,10 @@ namespace s3d
 			{
 				// sleep
 			}
-		}	
+		}
+
+		pRenderer2D->update();
+		pRenderer3D->update();
 	}
 
 	void CRenderer_GLES3::flush()
@@ -199,6 +202,17 @@ namespace s3d
 		return m_backBuffer->getScreenCapture();
 	}
 
+	bool CRenderer_GLES3::captureScreenshotAsync()
+	{
+		// 非同期の読み出しには未対応
+		return false;
+	}
+
+	bool CRenderer_GLES3::retrieveScreenshotAsync(Image&)
+	{
+		return false;
+	}
+
 	void CRenderer_GLES3::setSceneResizeMode(const ResizeMode resizeMode)
 	{
 		m_backBuffer->setSceneResizeMode(resizeMode);
@@ -138,6 +138,7 @@ namespace s3d
 		}
 
 		pRenderer2D->update();
+		pRenderer3D->update();
 	}
 
 	void CRenderer_WebGPU::flush()
@@ -224,6 +225,17 @@ namespace s3d
 		return m_backBuffer->getScreenCapture();
 	}
 
+	bool CRenderer_WebGPU::captureScreenshotAsync()
+	{
+		// 非同期の読み出しには未対応
+		return false;
+	}
+
+	bool CRenderer_WebGPU::retrieveScreenshotAsync(Image&)
+	{
+		return false;
+	}
+
 	void CRenderer_WebGPU::setSceneResizeMode(const ResizeMode resizeMode)
 	{
 		m_backBuffer->setSceneResizeMode(resizeMode);
@@ -47,12 +47,12 @@ namespace s3d
 		m_initialized = true;
 	}
 
-	WebGPUMesh::WebGPUMesh(const wgpu::Device& device, const Array<Vertex3D>& vertices, const Array<TriangleIndex32>& indices, const bool isDynamic)
+	WebGPUMesh::WebGPUMesh(const wgpu::Device& device, const std::span<const Vertex3D> vertices, const std::span<const TriangleIndex32> indices, const bool isDynamic)
 		: m_vertexCount{ static_cast<uint32>(vertices.size()) }
 		, m_indexCount{ static_cast<uint32>(indices.size() * 3) }
 		, m_vertexStride{ sizeof(Vertex3D) }
-		, m_boundingSphere{ Geometry3D::BoundingSphere(vertices) }
-		, m_boundingBox{ Geometry3D::BoundingBox(vertices) }
+		, m_boundingSphere{ Geometry3D::BoundingSphere(vertices.data(), vertices.size()) }
+		, m_boundingBox{ Geometry3D::BoundingBox(vertices.data(), vertices.size()) }
 		, m_isDynamic{ isDynamic }
 	{
 		{
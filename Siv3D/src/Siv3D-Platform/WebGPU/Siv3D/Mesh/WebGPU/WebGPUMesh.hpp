@@ -10,6 +10,7 @@
 //-----------------------------------------------
 
 # pragma once
+# include <span>
 # include <Siv3D/Common.hpp>
 # include <Siv3D/Array.hpp>
 # include <Siv3D/Vertex3D.hpp>
@@ -31,7 +32,7 @@ namespace s3d
 		WebGPUMesh(const wgpu::Device& device, size_t vertexCount, size_t triangleCount);
 
 		SIV3D_NODISCARD_CXX20
-		WebGPUMesh(const wgpu::Device& device, const Array<Vertex3D>& vertices, const Array<TriangleIndex32>& indices, bool isDynamic);
+		WebGPUMesh(const wgpu::Device& device, std::span<const Vertex3D> vertices, std::span<const TriangleIndex32> indices, bool isDynamic);
 
 		~WebGPUMesh();
 
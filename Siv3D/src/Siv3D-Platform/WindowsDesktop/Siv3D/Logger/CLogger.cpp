@@ -59,4 +59,14 @@ namespace s3d
 	{
 		m_enabled = enabled;
 	}
+
+	void CLogger::flush()
+	{
+		// OutputDebugStringW() はバッファリングされない
+	}
+
+	void CLogger::setOverflowPolicy(const LogOverflowPolicy)
+	{
+		// バッファを使わないため、常に LogOverflowPolicy::Block と同じ
+	}
 }
@@ -33,5 +33,9 @@ namespace s3d
 		void write(LogType type, StringView s) override;
 
 		void setEnabled(bool enabled) override;
+
+		void flush() override;
+
+		void setOverflowPolicy(LogOverflowPolicy policy) override;
 	};
 }
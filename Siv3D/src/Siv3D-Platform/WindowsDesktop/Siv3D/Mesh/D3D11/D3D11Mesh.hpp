@@ -10,6 +10,7 @@
 //-----------------------------------------------
 
 # pragma once
+# include <span>
 # include <Siv3D/Common.hpp>
 # include <Siv3D/Array.hpp>
 # include <Siv3D/Vertex3D.hpp>
@@ -30,7 +31,7 @@ namespace s3d
 		D3D11Mesh(ID3D11Device* device, size_t vertexCount, size_t triangleCount);
 
 		SIV3D_NODISCARD_CXX20
-		D3D11Mesh(ID3D11Device* device, const Array<Vertex3D>& vertices, const Array<TriangleIndex32>& indices, bool isDynamic);
+		D3D11Mesh(ID3D11Device* device, std::span<const Vertex3D> vertices, std::span<const TriangleIndex32> indices, bool isDynamic);
 
 		[[nodiscard]]
 		bool isInitialized() const noexcept;
@@ -91,6 +91,7 @@ namespace s3d
 		}
 
 		pRenderer2D->update();
+		pRenderer3D->update();
 	}
 
 	void CRenderer_D3D11::flush()
@@ -113,6 +114,17 @@ namespace s3d
 		return m_screenCapture->getImage();
 	}
 
+	bool CRenderer_D3D11::captureScreenshotAsync()
+	{
+		// [Siv3D ToDo] ステージングテクスチャによる非同期の読み出し
+		return false;
+	}
+
+	bool CRenderer_D3D11::retrieveScreenshotAsync(Image&)
+	{
+		return false;
+	}
+
 	bool CRenderer_D3D11::present()
 	{
 		if (not m_swapChain->present(m_vSyncEnabled))
@@ -80,6 +80,10 @@ namespace s3d
 
 		const Image& getScreenCapture() const override;
 
+		bool captureScreenshotAsync() override;
+
+		bool retrieveScreenshotAsync(Image& image) override;
+
 		void setSceneResizeMode(ResizeMode resizeMode) override;
 
 		ResizeMode getSceneResizeMode() const noexcept override;
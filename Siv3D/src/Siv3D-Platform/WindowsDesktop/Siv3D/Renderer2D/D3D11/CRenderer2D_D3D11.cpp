@@ -602,6 +602,49 @@ namespace s3d
 		}
 	}
 
+	void CRenderer2D_D3D11::addBatch(const Batch2DBuildFunc& build)
+	{
+		const float scale = getMaxScaling();
+		size_t offset = 0;
+
+		while (const auto indexCount = build(m_bufferCreator, m_batchOffsetBuffer, scale, offset))
+		{
+			if (not m_currentCustomVS)
+			{
+				m_commandManager.pushStandardVS(m_standardVS->spriteID);
+			}
+
+			if (not m_currentCustomPS)
+			{
+				m_commandManager.pushStandardPS(m_standardPS->shapeID);
+			}
+
+			m_commandManager.pushDraw(indexCount);
+		}
+	}
+
+	void CRenderer2D_D3D11::addParticles(const ParticleStore2D& particles,
+		const ParticleSystem2DParameters::SizeOverLifeTimeFunc& sizeOverLifeTimeFunc,
+		const ParticleSystem2DParameters::ColorOverLifeTimeFunc& colorOverLifeTimeFunc)
+	{
+		size_t offset = 0;
+
+		while (const auto indexCount = Vertex2DBuilder::BuildParticles(m_bufferCreator, particles, sizeOverLifeTimeFunc, colorOverLifeTimeFunc, offset))
+		{
+			if (not m_currentCustomVS)
+			{
+				m_commandManager.pushStandardVS(m_standardVS->spriteID);
+			}
+
+			if (not m_currentCustomPS)
+			{
+				m_commandManager.pushStandardPS(m_standardPS->shapeID);
+			}
+
+			m_commandManager.pushDraw(indexCount);
+		}
+	}
+
 	void CRenderer2D_D3D11::addNullVertices(const uint32 count)
 	{
 		if (not m_currentCustomPS)
@@ -726,11 +769,13 @@ namespace s3d
 		}
 	}
 
-	void CRenderer2D_D3D11::addTexturedParticles(const Texture& texture, const Array<Particle2D>& particles,
-		ParticleSystem2DParameters::SizeOverLifeTimeFunc sizeOverLifeTimeFunc,
-		ParticleSystem2DParameters::ColorOverLifeTimeFunc colorOverLifeTimeFunc)
+	void CRenderer2D_D3D11::addTexturedParticles(const Texture& texture, const ParticleStore2D& particles,
+		const ParticleSystem2DParameters::SizeOverLifeTimeFunc& sizeOverLifeTimeFunc,
+		const ParticleSystem2DParameters::ColorOverLifeTimeFunc& colorOverLifeTimeFunc)
 	{
-		if (const auto indexCount = Vertex2DBuilder::BuildTexturedParticles(m_bufferCreator, particles, sizeOverLifeTimeFunc, colorOverLifeTimeFunc))
+		size_t offset = 0;
+
+		while (const auto indexCount = Vertex2DBuilder::BuildParticles(m_bufferCreator, particles, sizeOverLifeTimeFunc, colorOverLifeTimeFunc, offset))
 		{
 			if (not m_currentCustomVS)
 			{
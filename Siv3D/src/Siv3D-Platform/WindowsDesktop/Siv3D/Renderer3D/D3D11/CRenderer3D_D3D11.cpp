@@ -114,6 +114,11 @@ namespace s3d
 		}
 	}
 
+	void CRenderer3D_D3D11::update()
+	{
+		m_stat = {};
+	}
+
 	const Renderer3DStat& CRenderer3D_D3D11::getStat() const
 	{
 		return m_stat;
@@ -190,6 +195,46 @@ namespace s3d
 		m_commandManager.pushDraw(startIndex, indexCount, phong, instanceCount);
 	}
 
+	void CRenderer3D_D3D11::addMeshInstanced(const uint32 startIndex, const uint32 indexCount, const Mesh& mesh, const PhongMaterial& material, const std::span<const Mat4x4> transforms, const std::span<const ColorF> colors)
+	{
+		// [Siv3D ToDo] インスタンシングによる描画
+		const Mat4x4 localTransform = m_commandManager.getCurrentLocalTransform();
+		PhongMaterial instanceMaterial = material;
+
+		for (size_t i = 0; i < transforms.size(); ++i)
+		{
+			if (not colors.empty())
+			{
+				instanceMaterial.diffuseColor = colors[i];
+			}
+
+			m_commandManager.pushLocalTransform(transforms[i] * localTransform);
+			addMesh(startIndex, indexCount, mesh, instanceMaterial);
+		}
+
+		m_commandManager.pushLocalTransform(localTransform);
+	}
+
+	void CRenderer3D_D3D11::addTexturedMeshInstanced(const uint32 startIndex, const uint32 indexCount, const Mesh& mesh, const Texture& texture, const PhongMaterial& material, const std::span<const Mat4x4> transforms, const std::span<const ColorF> colors)
+	{
+		// [Siv3D ToDo] インスタンシングによる描画
+		const Mat4x4 localTransform = m_commandManager.getCurrentLocalTransform();
+		PhongMaterial instanceMaterial = material;
+
+		for (size_t i = 0; i < transforms.size(); ++i)
+		{
+			if (not colors.empty())
+			{
+				instanceMaterial.diffuseColor = colors[i];
+			}
+
+			m_commandManager.pushLocalTransform(transforms[i] * localTransform);
+			addTexturedMesh(startIndex, indexCount, mesh, texture, instanceMaterial);
+		}
+
+		m_commandManager.pushLocalTransform(localTransform);
+	}
+
 	void CRenderer3D_D3D11::addLine3D(const Float3& begin, const Float3& end, const Float4(&colors)[2])
 	{
 		constexpr VertexLine3D::IndexType vertexSize = 2, indexSize = 2;
@@ -532,8 +577,8 @@ namespace s3d
 					
 					instanceIndex += instanceCount;
 
-					//++m_stat.drawCalls;
-					//m_stat.triangleCount += (indexCount / 3);
+					++m_stat.drawCalls;
+					m_stat.triangleCount += (indexCount / 3);
 
 					LOG_COMMAND(U"Draw[{}] indexCount = {}, startIndexLocation = {}"_fmt(command.index, indexCount, startIndexLocation));
 					break;
@@ -116,6 +116,9 @@ namespace s3d
 				// sleep
 			}
 		}
+
+		pRenderer2D->update();
+		pRenderer3D->update();
 	}
 
 	void CRenderer_GL4::flush()
@@ -172,6 +175,16 @@ namespace s3d
 		return m_backBuffer->getScreenCapture();
 	}
 
+	bool CRenderer_GL4::captureScreenshotAsync()
+	{
+		return m_backBuffer->captureAsync();
+	}
+
+	bool CRenderer_GL4::retrieveScreenshotAsync(Image& image)
+	{
+		return m_backBuffer->retrieveAsyncCapture(image);
+	}
+
 	void CRenderer_GL4::setSceneResizeMode(const ResizeMode resizeMode)
 	{
 		m_backBuffer->setSceneResizeMode(resizeMode);
@@ -72,6 +72,10 @@ namespace s3d
 		void captureScreenshot() override;
 	
 		const Image& getScreenCapture() const override;
+
+		bool captureScreenshotAsync() override;
+
+		bool retrieveScreenshotAsync(Image& image) override;
 	
 		void setSceneResizeMode(ResizeMode resizeMode) override;
 
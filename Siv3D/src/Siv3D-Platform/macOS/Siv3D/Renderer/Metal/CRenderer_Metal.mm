@@ -146,6 +146,17 @@ namespace s3d
 		return emptyImage;
 	}
 
+	bool CRenderer_Metal::captureScreenshotAsync()
+	{
+		// [Siv3D ToDo]
+		return false;
+	}
+
+	bool CRenderer_Metal::retrieveScreenshotAsync(Image&)
+	{
+		return false;
+	}
+
 	void CRenderer_Metal::setSceneResizeMode(const ResizeMode resizeMode)
 	{
 		m_backBuffer->setSceneResizeMode(resizeMode);
@@ -10,8 +10,10 @@
 //-----------------------------------------------
 
 # include <array>
+# include <iostream>
 # include <Siv3D/String.hpp>
 # include <Siv3D/FormatLiteral.hpp>
+# include <Siv3D/Unicode.hpp>
 # include <Siv3D/Time.hpp>
 # include "CLogger.hpp"
 
@@ -19,26 +21,106 @@ namespace s3d
 {
 	namespace detail
 	{
-		constexpr std::array<StringView, 7> LogTypeNames =
+		constexpr std::array<std::string_view, 7> LogTypeNames =
 		{
-			U"[error]   "_sv,
-			U"[fail]    "_sv,
-			U"[warning] "_sv,
-			U""_sv,
-			U"[info]    "_sv,
-			U"[trace]   "_sv,
-			U"[verbose] "_sv,
+			"[error]   ",
+			"[fail]    ",
+			"[warning] ",
+			"",
+			"[info]    ",
+			"[trace]   ",
+			"[verbose] ",
 		};
+
+		// 書き込み待ちのログの最大数 (2 の累乗)
+		constexpr size_t LogBufferCapacity = 4096;
+
+		// 書き込み待ちのログがこの数に達するたびにロガースレッドを起こす
+		constexpr size_t LogWakeUpInterval = (LogBufferCapacity / 4);
+
+		// ロガースレッドが書き込みとフラッシュを行う最大の間隔
+		constexpr std::chrono::milliseconds LogFlushInterval{ 100 };
+
+		static void AppendLine(std::string& output, const int64 timeStamp, const LogType type, const StringView text)
+		{
+			output.append(std::to_string(timeStamp));
+			output.append(": ");
+			output.append(LogTypeNames[FromEnum(type)]);
+			output.append(Unicode::ToUTF8(text));
+			output.push_back('\n');
+		}
+
+		LogRingBuffer::LogRingBuffer(const size_t capacity)
+			: m_entries{ std::make_unique<Entry[]>(capacity) }
+			, m_mask{ (capacity - 1) }
+		{
+			for (size_t i = 0; i < capacity; ++i)
+			{
+				m_entries[i].sequence.store(i, std::memory_order_relaxed);
+			}
+		}
+
+		Optional<size_t> LogRingBuffer::tryPush(const int64 timeStamp, const LogType type, const StringView text)
+		{
+			size_t pos = m_enqueuePos.load(std::memory_order_relaxed);
+
+			for (;;)
+			{
+				Entry& entry = m_entries[pos & m_mask];
+				const size_t sequence = entry.sequence.load(std::memory_order_acquire);
+				const std::ptrdiff_t diff = (static_cast<std::ptrdiff_t>(sequence) - static_cast<std::ptrdiff_t>(pos));
+
+				if (diff == 0)
+				{
+					if (m_enqueuePos.compare_exchange_weak(pos, (pos + 1), std::memory_order_relaxed))
+					{
+						entry.timeStamp = timeStamp;
+						entry.type = type;
+						entry.text.assign(text);
+						entry.sequence.store((pos + 1), std::memory_order_release);
+						return pos;
+					}
+				}
+				else if (diff < 0)
+				{
+					// 読み出しが追い付いていない
+					return none;
+				}
+				else
+				{
+					pos = m_enqueuePos.load(std::memory_order_relaxed);
+				}
+			}
+		}
 	}
 
 	CLogger::CLogger()
+		: m_buffer{ detail::LogBufferCapacity }
 	{
+	# if not SIV3D_PLATFORM(WEB)
+
+		m_thread = std::thread{ &CLogger::run, this };
 
+	# endif
 	}
 
 	CLogger::~CLogger()
 	{
-	
+	# if not SIV3D_PLATFORM(WEB)
+
+		{
+			std::lock_guard lock{ m_mutex };
+			m_abort = true;
+		}
+
+		m_condition.notify_one();
+
+		if (m_thread.joinable())
+		{
+			m_thread.join();
+		}
+
+	# endif
 	}
 
 	void CLogger::write(const LogType type, const StringView s)
@@ -49,22 +131,147 @@ namespace s3d
 		}
 
 		const int64 timeStamp = Time::GetMillisec();
-		const StringView logTypeName = detail::LogTypeNames[FromEnum(type)];
-		const String text = U"{}: {}"_fmt(timeStamp, logTypeName) + s;
-		const std::string output = text.narrow();
+
+	# if SIV3D_PLATFORM(WEB)
+
+		// Web 版はスレッドを使えない場合があるため、その場で書き込む
+		std::string output;
+		detail::AppendLine(output, timeStamp, type, s);
 
 		std::lock_guard lock{ m_mutex };
 		{
-		# if SIV3D_PLATFORM(WEB)
-			std::cout << output << std::endl;
-		# else
-			std::clog << output << std::endl;
-		# endif
+			std::cout << output << std::flush;
 		}
+
+	# else
+
+		// 書式化と UTF-8 への変換はロガースレッドで行う
+		Optional<size_t> pos = m_buffer.tryPush(timeStamp, type, s);
+
+		if (not pos)
+		{
+			if (m_overflowPolicy == LogOverflowPolicy::Drop)
+			{
+				++m_droppedCount;
+				wakeUp();
+				return;
+			}
+
+			do
+			{
+				wakeUp();
+				std::this_thread::yield();
+			} while (not (pos = m_buffer.tryPush(timeStamp, type, s)));
+		}
+
+		if ((*pos % detail::LogWakeUpInterval) == 0)
+		{
+			wakeUp();
+		}
+
+		// エラーは、直後にアプリケーションが終了しても失われないよう、書き込みを待つ
+		if (type == LogType::Error)
+		{
+			flush();
+		}
+
+	# endif
 	}
 
 	void CLogger::setEnabled(const bool enabled)
 	{
 		m_enabled = enabled;
-	}	
+	}
+
+	void CLogger::flush()
+	{
+	# if not SIV3D_PLATFORM(WEB)
+
+		if (std::this_thread::get_id() == m_thread.get_id())
+		{
+			return;
+		}
+
+		std::unique_lock lock{ m_mutex };
+
+		const uint64 ticket = ++m_flushRequested;
+
+		m_condition.notify_one();
+
+		m_flushedCondition.wait(lock, [&]() { return ((ticket <= m_flushCompleted) || m_abort); });
+
+	# endif
+	}
+
+	void CLogger::setOverflowPolicy(const LogOverflowPolicy policy)
+	{
+		m_overflowPolicy = policy;
+	}
+
+	void CLogger::wakeUp()
+	{
+		if (m_sleeping.exchange(false))
+		{
+			std::lock_guard lock{ m_mutex };
+			m_condition.notify_one();
+		}
+	}
+
+	void CLogger::run()
+	{
+		std::string output;
+
+		for (;;)
+		{
+			uint64 flushRequested;
+			bool abort;
+			{
+				std::lock_guard lock{ m_mutex };
+				flushRequested = m_flushRequested;
+				abort = m_abort;
+			}
+
+			// 溜まっているログをまとめて書き込む
+			const auto append = [&output](const detail::LogRingBuffer::Entry& entry)
+			{
+				detail::AppendLine(output, entry.timeStamp, entry.type, entry.text);
+			};
+
+			while (m_buffer.tryPop(append)) {}
+
+			if (const size_t droppedCount = m_droppedCount.exchange(0))
+			{
+				detail::AppendLine(output, Time::GetMillisec(), LogType::Warning, U"CLogger: {} log messages were dropped"_fmt(droppedCount));
+			}
+
+			if (not output.empty())
+			{
+				std::clog.write(output.data(), static_cast<std::streamsize>(output.size()));
+				std::clog.flush();
+				output.clear();
+			}
+
+			std::unique_lock lock{ m_mutex };
+
+			m_flushCompleted = flushRequested;
+			m_flushedCondition.notify_all();
+
+			if (abort)
+			{
+				break;
+			}
+
+			if ((m_flushRequested != m_flushCompleted) || m_abort)
+			{
+				continue;
+			}
+
+			m_sleeping = true;
+
+			m_condition.wait_for(lock, detail::LogFlushInterval,
+				[this]() { return ((not m_sleeping) || (m_flushRequested != m_flushCompleted) || m_abort); });
+
+			m_sleeping = false;
+		}
+	}
 }
@@ -12,17 +12,109 @@
 # pragma once
 # include <atomic>
 # include <mutex>
+# include <condition_variable>
+# include <thread>
+# include <memory>
+# include <Siv3D/String.hpp>
+# include <Siv3D/Optional.hpp>
+# include <Siv3D/LogType.hpp>
+# include <Siv3D/Logger.hpp>
 # include <Siv3D/Logger/ILogger.hpp>
 
 namespace s3d
 {
+	namespace detail
+	{
+		/// @brief 複数のスレッドから書き込み、1 つのスレッドから読み出すロックフリーのリングバッファ
+		/// @remark D. Vyukov の Bounded MPMC queue を、読み出し側を 1 スレッドに限定して使います。
+		class LogRingBuffer
+		{
+		public:
+
+			struct Entry
+			{
+				std::atomic<size_t> sequence;
+
+				int64 timeStamp;
+
+				LogType type;
+
+				// 要素を使いまわすことで、確保したメモリを再利用する
+				String text;
+			};
+
+			/// @param capacity 最大の要素数。2 の累乗である必要があります。
+			explicit LogRingBuffer(size_t capacity);
+
+			/// @brief ログを追加します。
+			/// @return 追加した位置。バッファがいっぱいで追加できなかった場合 none
+			[[nodiscard]]
+			Optional<size_t> tryPush(int64 timeStamp, LogType type, StringView text);
+
+			/// @brief 先頭のログを取り出して処理します。読み出し側のスレッドからのみ呼べます。
+			/// @return ログが無かった場合 false
+			template <class Fty>
+			[[nodiscard]]
+			bool tryPop(Fty f)
+			{
+				Entry& entry = m_entries[m_dequeuePos & m_mask];
+
+				if (entry.sequence.load(std::memory_order_acquire) != (m_dequeuePos + 1))
+				{
+					return false;
+				}
+
+				f(entry);
+
+				entry.sequence.store((m_dequeuePos + m_mask + 1), std::memory_order_release);
+				++m_dequeuePos;
+				return true;
+			}
+
+		private:
+
+			std::unique_ptr<Entry[]> m_entries;
+
+			size_t m_mask = 0;
+
+			alignas(64) std::atomic<size_t> m_enqueuePos{ 0 };
+
+			alignas(64) size_t m_dequeuePos = 0;
+		};
+	}
+
 	class CLogger final : public ISiv3DLogger
 	{
 	private:
 
+		std::atomic<bool> m_enabled{ true };
+
+		std::atomic<LogOverflowPolicy> m_overflowPolicy{ LogOverflowPolicy::Block };
+
+		detail::LogRingBuffer m_buffer;
+
+		// LogOverflowPolicy::Drop で破棄したログの数
+		std::atomic<size_t> m_droppedCount{ 0 };
+
+		std::thread m_thread;
+
 		std::mutex m_mutex;
 
-		std::atomic<bool> m_enabled{ true };
+		std::condition_variable m_condition;
+
+		std::condition_variable m_flushedCondition;
+
+		std::atomic<bool> m_sleeping{ false };
+
+		bool m_abort = false;
+
+		uint64 m_flushRequested = 0;
+
+		uint64 m_flushCompleted = 0;
+
+		void wakeUp();
+
+		void run();
 
 	public:
 
@@ -33,5 +125,9 @@ namespace s3d
 		void write(LogType type, StringView s) override;
 
 		void setEnabled(bool enabled) override;
+
+		void flush() override;
+
+		void setOverflowPolicy(LogOverflowPolicy policy) override;
 	};
 }
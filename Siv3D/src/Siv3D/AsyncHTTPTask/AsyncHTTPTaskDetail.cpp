@@ -63,7 +63,8 @@ namespace s3d
 	{
 		m_writer.open(path);
 
-		m_task = Async(&AsyncHTTPTaskDetail::run, this);
+		// ダウンロード中はブロックするため、スレッドプールではなく専用のスレッドで実行する
+		m_task = std::async(std::launch::async, &AsyncHTTPTaskDetail::run, this);
 	}
 
 	AsyncHTTPTaskDetail::~AsyncHTTPTaskDetail()
@@ -519,6 +519,29 @@ namespace s3d
 		return *this;
 	}
 
+	namespace detail
+	{
+		static void DrawCircleBatch(const Circle* circles, const size_t size, const ColorF* colors, const size_t num_colors)
+		{
+			SIV3D_ENGINE(Renderer2D)->addBatch([=](const BufferCreatorFunc& bufferCreator, Array<Vertex2DBatchOffset>& offsetBuffer, const float scale, size_t& offset)
+			{
+				return Vertex2DBuilder::BuildCircles(bufferCreator, offsetBuffer, circles, size, colors, num_colors, scale, offset);
+			});
+		}
+	}
+
+	void Circle::DrawBatch(const Array<Circle>& circles, const ColorF& color)
+	{
+		detail::DrawCircleBatch(circles.data(), circles.size(), &color, 1);
+	}
+
+	void Circle::DrawBatch(const Array<Circle>& circles, const Array<ColorF>& colors)
+	{
+		const size_t size = Min(circles.size(), colors.size());
+
+		detail::DrawCircleBatch(circles.data(), size, colors.data(), size);
+	}
+
 	TexturedCircle Circle::operator ()(const Texture& texture) const
 	{
 		return{ texture,
@@ -122,6 +122,11 @@ namespace s3d
 		return SIV3D_ENGINE(Font)->getXAdvances(font.id(), text, clusters, size);
 	}
 
+	PreparedText DrawableText::prepare() const
+	{
+		return PreparedText{ *this };
+	}
+
 	RectF DrawableText::region(const double x, const double y) const
 	{
 		return region(font.fontSize(), Vec2{ x, y });
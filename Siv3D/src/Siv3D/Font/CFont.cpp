@@ -21,6 +21,7 @@
 # include <Siv3D/EngineLog.hpp>
 # include "CFont.hpp"
 # include "GlyphCache/IGlyphCache.hpp"
+# include "GlyphCache/GlyphJobQueue.hpp"
 # include "FontCommon.hpp"
 
 namespace s3d
@@ -188,6 +189,25 @@ namespace s3d
 		return m_fonts.size();
 	}
 
+	GlyphShapingCacheStat CFont::takeShapingCacheStat()
+	{
+		GlyphShapingCacheStat result;
+
+		for (const auto& font : m_fonts)
+		{
+			const GlyphShapingCacheStat stat = font.second->takeShapingCacheStat();
+			result.hits += stat.hits;
+			result.misses += stat.misses;
+		}
+
+		return result;
+	}
+
+	size_t CFont::getPendingGlyphCount() const
+	{
+		return GlyphJobQueue::GetPendingJobCount();
+	}
+
 	Font::IDType CFont::create(const FilePathView path, const size_t faceIndex, const FontMethod fontMethod, const int32 fontSize, const FontStyle style)
 	{
 		// Font を作成
@@ -248,6 +268,16 @@ namespace s3d
 		return m_fonts[handleID]->getGlyphCache().getBufferWidth();
 	}
 
+	void CFont::setGlyphCacheMemoryBudget(const Font::IDType handleID, const size_t bytes)
+	{
+		m_fonts[handleID]->getGlyphCache().setMemoryBudget(bytes);
+	}
+
+	size_t CFont::getGlyphCacheMemoryBudget(const Font::IDType handleID)
+	{
+		return m_fonts[handleID]->getGlyphCache().getMemoryBudget();
+	}
+
 	bool CFont::hasGlyph(const Font::IDType handleID, StringView ch)
 	{
 		return m_fonts[handleID]->hasGlyph(ch);
@@ -352,6 +382,20 @@ namespace s3d
 		return font->getGlyphCache().preload(*font, chars);
 	}
 
+	bool CFont::preloadAsync(const Font::IDType handleID, const StringView chars)
+	{
+		const auto& font = m_fonts[handleID];
+
+		return font->getGlyphCache().preloadAsync(*font, chars);
+	}
+
+	bool CFont::saveGlyphCache(const Font::IDType handleID)
+	{
+		const auto& font = m_fonts[handleID];
+
+		return font->getGlyphCache().saveCacheFile(*font);
+	}
+
 	const Texture& CFont::getTexture(const Font::IDType handleID)
 	{
 		return m_fonts[handleID]->getGlyphCache().getTexture();
@@ -374,7 +418,8 @@ namespace s3d
 	Array<Glyph> CFont::getGlyphs(const Font::IDType handleID, const StringView s, const Ligature ligature)
 	{
 		const auto& font = m_fonts[handleID];
-		const Array<GlyphCluster> clusters = font->getGlyphClusters(s, false, ligature);
+		const auto pClusters = font->getGlyphClustersShared(s, false, ligature);
+		const Array<GlyphCluster>& clusters = *pClusters;
 
 		Array<Glyph> glyphs(Arg::reserve = clusters.size());
 		for (const auto& cluster : clusters)
@@ -577,6 +622,42 @@ namespace s3d
 		}
 	}
 
+	bool CFont::prepare(const Font::IDType handleID, const StringView s, const Array<GlyphCluster>& clusters, const size_t firstCluster, PreparedTextLayout& layout)
+	{
+		const auto& font = m_fonts[handleID];
+		{
+			return m_fonts[handleID]->getGlyphCache().prepare(*font, s, clusters, firstCluster, layout);
+		}
+	}
+
+	RectF CFont::drawPrepared(const Font::IDType handleID, const StringView s, const Array<GlyphCluster>& clusters, PreparedTextLayout& layout, const Vec2& pos, const double fontSize, const TextStyle& textStyle, const ColorF& color)
+	{
+		const auto& font = m_fonts[handleID];
+		const HasColor hasColor{ font->getProperty().hasColor };
+
+		if (textStyle.type != TextStyle::Type::Default && (not hasColor))
+		{
+			if (font->getMethod() == FontMethod::SDF)
+			{
+				Graphics2D::SetSDFParameters(textStyle);
+			}
+			else
+			{
+				Graphics2D::SetMSDFParameters(textStyle);
+			}
+		}
+
+		if (textStyle.type == TextStyle::Type::CustomShader)
+		{
+			return m_fonts[handleID]->getGlyphCache().drawPrepared(*font, s, clusters, layout, pos, fontSize, textStyle, (hasColor ? ColorF{ 1.0, color.a } : color));
+		}
+		else
+		{
+			ScopedCustomShader2D ps{ m_shader->getFontShader(font->getMethod(), textStyle.type, hasColor) };
+			return m_fonts[handleID]->getGlyphCache().drawPrepared(*font, s, clusters, layout, pos, fontSize, textStyle, (hasColor ? ColorF{ 1.0, color.a } : color));
+		}
+	}
+
 
 	bool CFont::hasEmoji(const StringView emoji)
 	{
@@ -53,6 +53,10 @@ namespace s3d
 
 		size_t getFontCount() const override;
 
+		GlyphShapingCacheStat takeShapingCacheStat() override;
+
+		size_t getPendingGlyphCount() const override;
+
 		Font::IDType create(FilePathView path, size_t faceIndex, FontMethod fontMethod, int32 fontSize, FontStyle style) override;
 
 		Font::IDType create(Typeface typeface, FontMethod fontMethod, int32 fontSize, FontStyle style) override;
@@ -71,6 +75,10 @@ namespace s3d
 
 		int32 getBufferThickness(Font::IDType handleID) override;
 
+		void setGlyphCacheMemoryBudget(Font::IDType handleID, size_t bytes) override;
+
+		size_t getGlyphCacheMemoryBudget(Font::IDType handleID) override;
+
 		bool hasGlyph(Font::IDType handleID, StringView ch) override;
 
 		GlyphIndex getGlyphIndex(Font::IDType handleID, StringView ch) override;
@@ -107,6 +115,10 @@ namespace s3d
 	
 		bool preload(Font::IDType handleID, StringView chars) override;
 
+		bool preloadAsync(Font::IDType handleID, StringView chars) override;
+
+		bool saveGlyphCache(Font::IDType handleID) override;
+
 		const Texture& getTexture(Font::IDType handleID) override;
 
 		Glyph getGlyph(Font::IDType handleID, StringView ch) override;
@@ -135,6 +147,10 @@ namespace s3d
 	
 		double xAdvanceFallback(Font::IDType handleID, const GlyphCluster& cluster, double fontSize) override;
 
+		bool prepare(Font::IDType handleID, StringView s, const Array<GlyphCluster>& clusters, size_t firstCluster, PreparedTextLayout& layout) override;
+
+		RectF drawPrepared(Font::IDType handleID, StringView s, const Array<GlyphCluster>& clusters, PreparedTextLayout& layout, const Vec2& pos, double fontSize, const TextStyle& textStyle, const ColorF& color) override;
+
 
 		bool hasEmoji(StringView emoji) override;
 
@@ -18,6 +18,7 @@
 # include <Siv3D/EngineLog.hpp>
 # include "CFont_Headless.hpp"
 # include "GlyphCache/IGlyphCache.hpp"
+# include "GlyphCache/GlyphJobQueue.hpp"
 # include "FontCommon.hpp"
 
 namespace s3d
@@ -104,6 +105,25 @@ namespace s3d
 		return m_fonts.size();
 	}
 
+	GlyphShapingCacheStat CFont_Headless::takeShapingCacheStat()
+	{
+		GlyphShapingCacheStat result;
+
+		for (const auto& font : m_fonts)
+		{
+			const GlyphShapingCacheStat stat = font.second->takeShapingCacheStat();
+			result.hits += stat.hits;
+			result.misses += stat.misses;
+		}
+
+		return result;
+	}
+
+	size_t CFont_Headless::getPendingGlyphCount() const
+	{
+		return GlyphJobQueue::GetPendingJobCount();
+	}
+
 	Font::IDType CFont_Headless::create(const FilePathView path, const size_t faceIndex, const FontMethod fontMethod, const int32 fontSize, const FontStyle style)
 	{
 		// Font を作成
@@ -164,6 +184,16 @@ namespace s3d
 		return m_fonts[handleID]->getGlyphCache().getBufferWidth();
 	}
 
+	void CFont_Headless::setGlyphCacheMemoryBudget(const Font::IDType handleID, const size_t bytes)
+	{
+		m_fonts[handleID]->getGlyphCache().setMemoryBudget(bytes);
+	}
+
+	size_t CFont_Headless::getGlyphCacheMemoryBudget(const Font::IDType handleID)
+	{
+		return m_fonts[handleID]->getGlyphCache().getMemoryBudget();
+	}
+
 	bool CFont_Headless::hasGlyph(const Font::IDType handleID, StringView ch)
 	{
 		return m_fonts[handleID]->hasGlyph(ch);
@@ -268,6 +298,20 @@ namespace s3d
 		return font->getGlyphCache().preload(*font, chars);
 	}
 
+	bool CFont_Headless::preloadAsync(const Font::IDType handleID, const StringView chars)
+	{
+		const auto& font = m_fonts[handleID];
+
+		return font->getGlyphCache().preloadAsync(*font, chars);
+	}
+
+	bool CFont_Headless::saveGlyphCache(const Font::IDType handleID)
+	{
+		const auto& font = m_fonts[handleID];
+
+		return font->getGlyphCache().saveCacheFile(*font);
+	}
+
 	const Texture& CFont_Headless::getTexture(const Font::IDType handleID)
 	{
 		return m_fonts[handleID]->getGlyphCache().getTexture();
@@ -289,7 +333,8 @@ namespace s3d
 	Array<Glyph> CFont_Headless::getGlyphs(const Font::IDType handleID, const StringView s, const Ligature ligature)
 	{
 		const auto& font = m_fonts[handleID];
-		const Array<GlyphCluster> clusters = font->getGlyphClusters(s, false, ligature);
+		const auto pClusters = font->getGlyphClustersShared(s, false, ligature);
+		const Array<GlyphCluster>& clusters = *pClusters;
 		
 		Array<Glyph> glyphs(Arg::reserve = clusters.size());
 		for(const auto& cluster : clusters)
@@ -388,6 +433,22 @@ namespace s3d
 		}
 	}
 
+	bool CFont_Headless::prepare(const Font::IDType handleID, const StringView s, const Array<GlyphCluster>& clusters, const size_t firstCluster, PreparedTextLayout& layout)
+	{
+		const auto& font = m_fonts[handleID];
+		{
+			return m_fonts[handleID]->getGlyphCache().prepare(*font, s, clusters, firstCluster, layout);
+		}
+	}
+
+	RectF CFont_Headless::drawPrepared(const Font::IDType handleID, const StringView, const Array<GlyphCluster>&, PreparedTextLayout& layout, const Vec2& pos, const double fontSize, const TextStyle&, const ColorF&)
+	{
+		const auto& font = m_fonts[handleID];
+		{
+			return GetPreparedTextRegion(*font, layout, pos, fontSize);
+		}
+	}
+
 
 	bool CFont_Headless::hasEmoji(const StringView emoji)
 	{
@@ -10,6 +10,8 @@
 //-----------------------------------------------
 
 # include <Siv3D/FileSystem.hpp>
+# include <Siv3D/Hash.hpp>
+# include <Siv3D/MemoryMappedFileView.hpp>
 # include <Siv3D/PolygonGlyph.hpp>
 # include <Siv3D/Font/IFont.hpp>
 # include <Siv3D/Common/Siv3DEngine.hpp>
@@ -85,6 +87,10 @@ namespace s3d
 
 		m_method = fontMethod;
 
+		m_path = path;
+
+		m_faceIndex = faceIndex;
+
 		m_initialized = true;
 	}
 
@@ -113,6 +119,39 @@ namespace s3d
 		return m_method;
 	}
 
+	size_t FontData::getFaceIndex() const noexcept
+	{
+		return m_faceIndex;
+	}
+
+	uint64 FontData::getFontFileHash() const
+	{
+		if (m_fontFileHash)
+		{
+			return *m_fontFileHash;
+		}
+
+		m_fontFileHash = 0;
+
+	# if SIV3D_PLATFORM(WINDOWS)
+
+		if (m_resource.size())
+		{
+			m_fontFileHash = Hash::XXHash3(m_resource.data(), static_cast<size_t>(m_resource.size()));
+			return *m_fontFileHash;
+		}
+
+	# endif
+
+		if (const MemoryMappedFileView view{ m_path };
+			view)
+		{
+			m_fontFileHash = Hash::XXHash3(view.data(), view.mappedSize());
+		}
+
+		return *m_fontFileHash;
+	}
+
 	bool FontData::hasGlyph(const StringView ch)
 	{
 		const HBGlyphInfo glyphInfo = m_fontFace.getHBGlyphInfo(ch, Ligature::Yes);
@@ -142,6 +181,33 @@ namespace s3d
 	}
 
 	Array<GlyphCluster> FontData::getGlyphClusters(const StringView s, const bool recursive, const Ligature ligature) const
+	{
+		return *getGlyphClustersShared(s, recursive, ligature);
+	}
+
+	GlyphShapingCache::ClustersPtr FontData::getGlyphClustersShared(const StringView s, const bool recursive, const Ligature ligature) const
+	{
+		// フォールバックフォントを使わない場合、結果はフォールバックフォントの状態に依存しない
+		const uint64 fallbackState = ((recursive && m_fallbackFonts) ? getFallbackState() : 0);
+
+		if (auto clusters = m_shapingCache.find(s, recursive, ligature, fallbackState))
+		{
+			return clusters;
+		}
+
+		auto clusters = std::make_shared<const Array<GlyphCluster>>(shapeGlyphClusters(s, recursive, ligature));
+
+		m_shapingCache.insert(s, recursive, ligature, fallbackState, clusters);
+
+		return clusters;
+	}
+
+	GlyphShapingCacheStat FontData::takeShapingCacheStat() const
+	{
+		return m_shapingCache.takeStat();
+	}
+
+	Array<GlyphCluster> FontData::shapeGlyphClusters(const StringView s, const bool recursive, const Ligature ligature) const
 	{
 		const HBGlyphInfo glyphInfo = m_fontFace.getHBGlyphInfo(s, ligature);
 
@@ -321,6 +387,16 @@ namespace s3d
 		return RenderMSDFGlyph(m_fontFace.getFT_Face(), glyphIndex, buffer, m_fontFace.getProperty());
 	}
 
+	std::pair<SDFGlyph, std::function<Image()>> FontData::prepareSDFByGlyphIndex(const GlyphIndex glyphIndex, const int32 buffer) const
+	{
+		return PrepareSDFGlyph(m_fontFace.getFT_Face(), glyphIndex, buffer, m_fontFace.getProperty());
+	}
+
+	std::pair<MSDFGlyph, std::function<Image()>> FontData::prepareMSDFByGlyphIndex(const GlyphIndex glyphIndex, const int32 buffer) const
+	{
+		return PrepareMSDFGlyph(m_fontFace.getFT_Face(), glyphIndex, buffer, m_fontFace.getProperty());
+	}
+
 	IGlyphCache& FontData::getGlyphCache() const
 	{
 		return *m_glyphCache;
@@ -330,6 +406,10 @@ namespace s3d
 	{
 		m_fallbackFonts.push_back(font);
 
+		++m_fallbackVersion;
+
+		m_shapingCache.clear();
+
 		return true;
 	}
 
@@ -337,4 +417,20 @@ namespace s3d
 	{
 		return m_fallbackFonts[index];
 	}
+
+	uint64 FontData::getFallbackState() const noexcept
+	{
+		// フォールバックフォントが解放されると結果が変わるため、解放済みのフォントも状態に含める
+		uint64 expiredMask = 0;
+
+		for (size_t i = 0; i < m_fallbackFonts.size(); ++i)
+		{
+			if (m_fallbackFonts[i].expired())
+			{
+				expiredMask |= (1ull << (i % 32));
+			}
+		}
+
+		return ((static_cast<uint64>(m_fallbackVersion) << 32) | expiredMask);
+	}
 }
@@ -10,11 +10,13 @@
 //-----------------------------------------------
 
 # pragma once
+# include <functional>
 # include <Siv3D/Common.hpp>
 # include <Siv3D/StringView.hpp>
 # include <Siv3D/Font.hpp>
 # include "FontResourceHolder.hpp"
 # include "FontFace.hpp"
+# include "GlyphShapingCache.hpp"
 
 namespace s3d
 {
@@ -45,6 +47,15 @@ namespace s3d
 		[[nodiscard]]
 		FontMethod getMethod() const;
 
+		[[nodiscard]]
+		size_t getFaceIndex() const noexcept;
+
+		/// @brief フォントファイルの XXHash3 ハッシュ値を返します。
+		/// @return フォントファイルのハッシュ値。読み込めない場合は 0
+		/// @remark 初回の呼び出しでフォントファイル全体を読み込みます。
+		[[nodiscard]]
+		uint64 getFontFileHash() const;
+
 		[[nodiscard]]
 		bool hasGlyph(StringView ch);
 
@@ -54,6 +65,14 @@ namespace s3d
 		[[nodiscard]]
 		Array<GlyphCluster> getGlyphClusters(StringView s, bool recursive, Ligature ligature) const;
 
+		/// @brief シェーピング結果を返します。同じ文字列に対してはキャッシュした結果を共有します。
+		[[nodiscard]]
+		GlyphShapingCache::ClustersPtr getGlyphClustersShared(StringView s, bool recursive, Ligature ligature) const;
+
+		/// @brief シェーピングキャッシュのヒット数とミス数を返し、0 にリセットします。
+		[[nodiscard]]
+		GlyphShapingCacheStat takeShapingCacheStat() const;
+
 		[[nodiscard]]
 		GlyphInfo getGlyphInfoByGlyphIndex(GlyphIndex glyphIndex) const;
 
@@ -78,6 +97,14 @@ namespace s3d
 		[[nodiscard]]
 		MSDFGlyph renderMSDFByGlyphIndex(GlyphIndex glyphIndex, int32 buffer) const;
 
+		/// @brief SDF グリフの画像以外の情報と、画像を生成する関数を返します。画像の生成は別のスレッドで行えます。
+		[[nodiscard]]
+		std::pair<SDFGlyph, std::function<Image()>> prepareSDFByGlyphIndex(GlyphIndex glyphIndex, int32 buffer) const;
+
+		/// @brief MSDF グリフの画像以外の情報と、画像を生成する関数を返します。画像の生成は別のスレッドで行えます。
+		[[nodiscard]]
+		std::pair<MSDFGlyph, std::function<Image()>> prepareMSDFByGlyphIndex(GlyphIndex glyphIndex, int32 buffer) const;
+
 		[[nodiscard]]
 		IGlyphCache& getGlyphCache() const;
 
@@ -97,12 +124,29 @@ namespace s3d
 
 		FontFace m_fontFace;
 
+		FilePath m_path;
+
+		size_t m_faceIndex = 0;
+
+		mutable Optional<uint64> m_fontFileHash;
+
 		Array<std::weak_ptr<AssetHandle<Font>::AssetIDWrapperType>> m_fallbackFonts;
 
 		FontMethod m_method = FontMethod::Bitmap;
 
 		std::unique_ptr<IGlyphCache> m_glyphCache;
 
+		mutable GlyphShapingCache m_shapingCache;
+
+		// フォールバックフォントを追加するたびに増える
+		uint32 m_fallbackVersion = 0;
+
 		bool m_initialized = false;
+
+		[[nodiscard]]
+		Array<GlyphCluster> shapeGlyphClusters(StringView s, bool recursive, Ligature ligature) const;
+
+		[[nodiscard]]
+		uint64 getFallbackState() const noexcept;
 	};
 }
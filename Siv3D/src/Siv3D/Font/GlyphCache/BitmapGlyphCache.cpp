@@ -25,7 +25,7 @@ namespace s3d
 		{
 			return RectF::Empty();
 		}
-		updateTexture();
+		m_atlas.update();
 
 		const auto& prop = font.getProperty();
 		const double scale = (size / prop.fontPixelSize);
@@ -64,9 +64,9 @@ namespace s3d
 				continue;
 			}
 
-			const auto& cache = m_glyphTable.find(cluster.glyphIndex)->second;
+			const auto& cache = m_atlas.get(cluster.glyphIndex);
 			{
-				const TextureRegion textureRegion = m_texture(cache.textureRegionLeft, cache.textureRegionTop, cache.textureRegionWidth, cache.textureRegionHeight);
+				const TextureRegion textureRegion = m_atlas.getTextureRegion(cache);
 				const Vec2 posOffset = usebasePos ? cache.info.getBase(scale) : cache.info.getOffset(scale);
 				const Vec2 drawPos = (penPos + posOffset);
 
@@ -104,9 +104,9 @@ namespace s3d
 		{
 			// do tnohing
 		}
-		updateTexture();
+		m_atlas.update();
 
-		const double dotXAdvance = m_glyphTable.find(dotGlyphCluster[0].glyphIndex)->second.info.xAdvance;
+		const double dotXAdvance = m_atlas.get(dotGlyphCluster[0].glyphIndex).info.xAdvance;
 		const Vec2 areaBottomRight = area.br();
 
 		const auto& prop = font.getProperty();
@@ -157,7 +157,7 @@ namespace s3d
 				}
 				else
 				{
-					const auto& cache = m_glyphTable.find(cluster.glyphIndex)->second;
+					const auto& cache = m_atlas.get(cluster.glyphIndex);
 					xAdvance = (cache.info.xAdvance * scale);
 				}
 
@@ -254,9 +254,9 @@ namespace s3d
 			}
 			else
 			{
-				const auto& cache = m_glyphTable.find(cluster.glyphIndex)->second;
+				const auto& cache = m_atlas.get(cluster.glyphIndex);
 				{
-					const TextureRegion textureRegion = m_texture(cache.textureRegionLeft, cache.textureRegionTop, cache.textureRegionWidth, cache.textureRegionHeight);
+					const TextureRegion textureRegion = m_atlas.getTextureRegion(cache);
 					const Vec2 posOffset = cache.info.getOffset(scale);
 					const Vec2 drawPos = (newPenPositions[i] + posOffset);
 
@@ -284,7 +284,7 @@ namespace s3d
 		{
 			return RectF::Empty();
 		}
-		updateTexture();
+		m_atlas.update();
 
 		const auto& prop = font.getProperty();
 		const double scale = (size / prop.fontPixelSize);
@@ -295,9 +295,9 @@ namespace s3d
 		double xMax = basePos.x;
 
 		{
-			const auto& cache = m_glyphTable.find(cluster.glyphIndex)->second;
+			const auto& cache = m_atlas.get(cluster.glyphIndex);
 			{
-				const TextureRegion textureRegion = m_texture(cache.textureRegionLeft, cache.textureRegionTop, cache.textureRegionWidth, cache.textureRegionHeight);
+				const TextureRegion textureRegion = m_atlas.getTextureRegion(cache);
 				const Vec2 posOffset = usebasePos ? cache.info.getBase(scale) : cache.info.getOffset(scale);
 				const Vec2 drawPos = (penPos + posOffset);
 
@@ -370,7 +370,7 @@ namespace s3d
 				continue;
 			}
 
-			const auto& cache = m_glyphTable.find(cluster.glyphIndex)->second;
+			const auto& cache = m_atlas.get(cluster.glyphIndex);
 			const double xAdvance = (cache.info.xAdvance * scale);
 			xAdvances << xAdvance;
 			penPosX += xAdvance;
@@ -388,7 +388,7 @@ namespace s3d
 
 		const auto& prop = font.getProperty();
 		const double scale = (fontSize / prop.fontPixelSize);
-		const auto& cache = m_glyphTable.find(cluster.glyphIndex)->second;
+		const auto& cache = m_atlas.get(cluster.glyphIndex);
 		return (cache.info.xAdvance * scale);
 	}
 
@@ -435,7 +435,7 @@ namespace s3d
 				continue;
 			}
 
-			const auto& cache = m_glyphTable.find(cluster.glyphIndex)->second;
+			const auto& cache = m_atlas.get(cluster.glyphIndex);
 			penPos.x += (cache.info.xAdvance * scale);
 			xMax = Max(xMax, penPos.x);
 		}
@@ -459,7 +459,7 @@ namespace s3d
 		double xMax = basePos.x;
 
 		{
-			const auto& cache = m_glyphTable.find(cluster.glyphIndex)->second;
+			const auto& cache = m_atlas.get(cluster.glyphIndex);
 			penPos.x += (cache.info.xAdvance * scale);
 			xMax = Max(xMax, penPos.x);
 		}
@@ -478,16 +478,32 @@ namespace s3d
 		return 0;
 	}
 
+	void BitmapGlyphCache::setMemoryBudget(const size_t bytes)
+	{
+		m_atlas.setMemoryBudget(bytes);
+	}
+
+	size_t BitmapGlyphCache::getMemoryBudget() const noexcept
+	{
+		return m_atlas.getMemoryBudget();
+	}
+
 	bool BitmapGlyphCache::preload(const FontData& font, const StringView s)
 	{
 		return prerender(font, font.getGlyphClusters(s, false, Ligature::Yes), true);
 	}
 
+	bool BitmapGlyphCache::preloadAsync(const FontData& font, const StringView s)
+	{
+		// ビットマップの生成は軽いため、その場で行う
+		return preload(font, s);
+	}
+
 	const Texture& BitmapGlyphCache::getTexture() noexcept
 	{
-		updateTexture();
+		m_atlas.update();
 
-		return m_texture;
+		return m_atlas.getTexture();
 	}
 
 	TextureRegion BitmapGlyphCache::getTextureRegion(const FontData& font, const GlyphIndex glyphIndex)
@@ -496,10 +512,10 @@ namespace s3d
 		{
 			return{};
 		}
-		updateTexture();
+		m_atlas.update();
 
-		const auto& cache = m_glyphTable.find(glyphIndex)->second;
-		return m_texture(cache.textureRegionLeft, cache.textureRegionTop, cache.textureRegionWidth, cache.textureRegionHeight);
+		const auto& cache = m_atlas.get(glyphIndex);
+		return m_atlas.getTextureRegion(cache);
 	}
 
 	int32 BitmapGlyphCache::getBufferThickness(const GlyphIndex)
@@ -507,18 +523,51 @@ namespace s3d
 		return 0;
 	}
 
+	bool BitmapGlyphCache::prepare(const FontData& font, const StringView s, const Array<GlyphCluster>& clusters, const size_t firstCluster, PreparedTextLayout& layout)
+	{
+		if (not prerender(font, clusters, true))
+		{
+			layout.clear();
+			return false;
+		}
+		m_atlas.update();
+
+		LayoutPreparedText(font, m_atlas, s, clusters, firstCluster, layout);
+		return true;
+	}
+
+	RectF BitmapGlyphCache::drawPrepared(const FontData& font, const StringView s, const Array<GlyphCluster>& clusters, PreparedTextLayout& layout, const Vec2& pos, const double size, const TextStyle& textStyle, const ColorF& color)
+	{
+		m_atlas.update();
+
+		// グリフが追い出されたり、テクスチャが作り直されたりした場合は配置し直す
+		if (layout.generation != m_atlas.getGeneration())
+		{
+			if (not prepare(font, s, clusters, 0, layout))
+			{
+				return RectF::Empty();
+			}
+		}
+
+		return DrawPreparedText(font, m_atlas, clusters, layout, pos, size, textStyle, color, true);
+	}
+
+	bool BitmapGlyphCache::saveCacheFile(const FontData&)
+	{
+		// Bitmap はグリフの生成が軽いため、キャッシュファイルを使わない
+		return false;
+	}
+
 	bool BitmapGlyphCache::prerender(const FontData& font, const Array<GlyphCluster>& clusters, const bool isMainFont)
 	{
-		if (m_glyphTable.empty())
+		if (m_atlas.empty())
 		{
 			const BitmapGlyph glyph = font.renderBitmapByGlyphIndex(0);
 
-			if (not CacheGlyph(font, glyph.image, glyph, m_buffer, m_glyphTable))
+			if (not m_atlas.add(font, glyph.image, glyph))
 			{
 				return false;
 			}
-
-			m_hasDirty = true;
 		}
 
 		for (const auto& cluster : clusters)
@@ -528,51 +577,30 @@ namespace s3d
 				continue;
 			}
 
-			if (m_glyphTable.contains(cluster.glyphIndex))
+			if (m_atlas.touch(cluster.glyphIndex))
 			{
 				continue;
 			}
 
 			const BitmapGlyph glyph = font.renderBitmapByGlyphIndex(cluster.glyphIndex);
 
-			if (m_glyphTable.contains(glyph.glyphIndex))
+			if (m_atlas.touch(glyph.glyphIndex))
 			{
 				continue;
 			}
 
-			if (not CacheGlyph(font, glyph.image, glyph, m_buffer, m_glyphTable))
+			if (not m_atlas.add(font, glyph.image, glyph))
 			{
 				return false;
 			}
-
-			m_hasDirty = true;
 		}
 
 		// texture content can be updated in a different thread
 		if (System::GetRendererType() == EngineOption::Renderer::Direct3D11)
 		{
-			updateTexture();
+			m_atlas.update();
 		}
 
 		return true;
 	}
-
-	void BitmapGlyphCache::updateTexture()
-	{
-		if (not m_hasDirty)
-		{
-			return;
-		}
-
-		if (m_texture.size() == m_buffer.image.size())
-		{
-			m_texture.fill(m_buffer.image);
-		}
-		else
-		{
-			m_texture = DynamicTexture{ m_buffer.image };
-		}
-
-		m_hasDirty = false;
-	}
 }
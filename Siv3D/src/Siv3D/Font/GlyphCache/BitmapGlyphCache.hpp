@@ -15,6 +15,7 @@
 # include <Siv3D/DynamicTexture.hpp>
 # include "IGlyphCache.hpp"
 # include "GlyphCacheCommon.hpp"
+# include "GlyphAtlas.hpp"
 
 namespace s3d
 {
@@ -48,8 +49,15 @@ namespace s3d
 		[[nodiscard]]
 		int32 getBufferWidth() const noexcept override;
 
+		void setMemoryBudget(size_t bytes) override;
+
+		[[nodiscard]]
+		size_t getMemoryBudget() const noexcept override;
+
 		bool preload(const FontData & font, StringView s) override;
 
+		bool preloadAsync(const FontData& font, StringView s) override;
+
 		[[nodiscard]]
 		const Texture& getTexture() noexcept override;
 
@@ -59,19 +67,17 @@ namespace s3d
 		[[nodiscard]]
 		int32 getBufferThickness(GlyphIndex glyphIndex) override;
 
-	private:
+		bool prepare(const FontData& font, StringView s, const Array<GlyphCluster>& clusters, size_t firstCluster, PreparedTextLayout& layout) override;
 
-		HashTable<GlyphIndex, GlyphCache> m_glyphTable;
+		RectF drawPrepared(const FontData& font, StringView s, const Array<GlyphCluster>& clusters, PreparedTextLayout& layout, const Vec2& pos, double size, const TextStyle& textStyle, const ColorF& color) override;
 
-		DynamicTexture m_texture;
+		bool saveCacheFile(const FontData& font) override;
 
-		bool m_hasDirty = false;
+	private:
 
-		BufferImage m_buffer = {};
+		GlyphAtlas m_atlas{ Color{ 255, 0 } };
 
 		[[nodiscard]]
 		bool prerender(const FontData& font, const Array<GlyphCluster>& clusters, bool isMainFont);
-
-		void updateTexture();
 	};
 }
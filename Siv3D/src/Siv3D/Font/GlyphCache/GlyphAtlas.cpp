@@ -0,0 +1,921 @@
+﻿//-----------------------------------------------
+//
+//	This file is part of the Siv3D Engine.
+//
+//	Copyright (c) 2008-2022 Ryo Suzuki
+//	Copyright (c) 2016-2022 OpenSiv3D Project
+//
+//	Licensed under the MIT License.
+//
+//-----------------------------------------------
+
+# include <Siv3D/Hash.hpp>
+# include <Siv3D/BinaryWriter.hpp>
+# include <Siv3D/FileSystem.hpp>
+# include <Siv3D/MemoryMappedFileView.hpp>
+# include <Siv3D/EngineLog.hpp>
+# include <Siv3D/Scene/IScene.hpp>
+# include <Siv3D/CacheDirectory/CacheDirectory.hpp>
+# include <Siv3D/Common/Siv3DEngine.hpp>
+# include "GlyphAtlas.hpp"
+
+namespace s3d
+{
+	namespace detail
+	{
+		static void AddDirtyRect(Rect& dirtyRect, const Rect& rect) noexcept
+		{
+			if (dirtyRect.isEmpty())
+			{
+				dirtyRect = rect;
+				return;
+			}
+
+			const int32 left	= Min(dirtyRect.x, rect.x);
+			const int32 top		= Min(dirtyRect.y, rect.y);
+			const int32 right	= Max((dirtyRect.x + dirtyRect.w), (rect.x + rect.w));
+			const int32 bottom	= Max((dirtyRect.y + dirtyRect.h), (rect.y + rect.h));
+			dirtyRect.set(left, top, (right - left), (bottom - top));
+		}
+
+		// キャッシュファイルの形式が変わったら更新する
+		constexpr uint32 GlyphAtlasFileVersion = 2;
+
+		constexpr char GlyphAtlasFileSignature[8] = { 'S', '3', 'D', 'G', 'L', 'Y', 'P', 'H' };
+
+		/// @brief 構造体のパディングを含めないよう、値を 1 つずつバイト列に書き込む
+		class FileDataWriter
+		{
+		public:
+
+			template <class Type, std::enable_if_t<std::is_arithmetic_v<Type>>* = nullptr>
+			void write(const Type value)
+			{
+				const Byte* p = reinterpret_cast<const Byte*>(&value);
+				m_data.insert(m_data.end(), p, (p + sizeof(Type)));
+			}
+
+			void write(const GlyphAtlas::FileKey& key)
+			{
+				write(key.fontFileHash);
+				write(key.faceIndex);
+				write(key.fontSize);
+				write(key.bufferWidth);
+				write(key.method);
+				write(key.style);
+				write(key.reserved);
+			}
+
+			void write(const GlyphCache& cache)
+			{
+				write(cache.info.glyphIndex);
+				write(cache.info.buffer);
+				write(cache.info.left);
+				write(cache.info.top);
+				write(cache.info.width);
+				write(cache.info.height);
+				write(cache.info.ascender);
+				write(cache.info.descender);
+				write(cache.info.xAdvance);
+				write(cache.info.yAdvance);
+				write(cache.textureRegionLeft);
+				write(cache.textureRegionTop);
+				write(cache.textureRegionWidth);
+				write(cache.textureRegionHeight);
+				write(cache.page);
+			}
+
+			/// @brief 書き込んだバイト列をファイルに書き込み、空にします。
+			/// @return ファイルへの書き込みに成功した場合 true, それ以外の場合は false
+			[[nodiscard]]
+			bool flush(BinaryWriter& writer)
+			{
+				const int64 size = static_cast<int64>(m_data.size());
+				const bool result = (writer.write(m_data.data(), size) == size);
+				m_data.clear();
+				return result;
+			}
+
+		private:
+
+			Array<Byte> m_data;
+		};
+
+		/// @brief FileDataWriter で書き込んだ値を 1 つずつ読み込む
+		class MappedFileReader
+		{
+		public:
+
+			explicit MappedFileReader(const MemoryMappedFileView& view) noexcept
+				: m_pos{ view.data() }
+				, m_end{ view.data() + view.mappedSize() } {}
+
+			[[nodiscard]]
+			bool read(void* dst, const size_t size) noexcept
+			{
+				if (static_cast<size_t>(m_end - m_pos) < size)
+				{
+					return false;
+				}
+
+				std::memcpy(dst, m_pos, size);
+				m_pos += size;
+				return true;
+			}
+
+			template <class Type, std::enable_if_t<std::is_arithmetic_v<Type>>* = nullptr>
+			[[nodiscard]]
+			bool read(Type& dst) noexcept
+			{
+				return read(&dst, sizeof(Type));
+			}
+
+			[[nodiscard]]
+			bool read(GlyphAtlas::FileKey& key) noexcept
+			{
+				return (read(key.fontFileHash)
+					&& read(key.faceIndex)
+					&& read(key.fontSize)
+					&& read(key.bufferWidth)
+					&& read(key.method)
+					&& read(key.style)
+					&& read(key.reserved));
+			}
+
+			[[nodiscard]]
+			bool read(GlyphCache& cache) noexcept
+			{
+				return (read(cache.info.glyphIndex)
+					&& read(cache.info.buffer)
+					&& read(cache.info.left)
+					&& read(cache.info.top)
+					&& read(cache.info.width)
+					&& read(cache.info.height)
+					&& read(cache.info.ascender)
+					&& read(cache.info.descender)
+					&& read(cache.info.xAdvance)
+					&& read(cache.info.yAdvance)
+					&& read(cache.textureRegionLeft)
+					&& read(cache.textureRegionTop)
+					&& read(cache.textureRegionWidth)
+					&& read(cache.textureRegionHeight)
+					&& read(cache.page));
+			}
+
+			/// @brief 残りのバイト数を返します。
+			[[nodiscard]]
+			size_t remaining() const noexcept
+			{
+				return static_cast<size_t>(m_end - m_pos);
+			}
+
+		private:
+
+			const Byte* m_pos;
+
+			const Byte* m_end;
+		};
+
+		// キャッシュファイルにおける GlyphCache 1 つのバイト数
+		constexpr size_t GlyphCacheFileSize = (sizeof(GlyphIndex) + sizeof(int32) + (sizeof(int16) * 6) + (sizeof(double) * 2) + (sizeof(int16) * 4) + sizeof(uint16));
+	}
+
+	GlyphAtlas::GlyphAtlas(const Color& backgroundColor)
+		: m_backgroundColor{ backgroundColor } {}
+
+	bool GlyphAtlas::empty() const noexcept
+	{
+		return m_glyphTable.empty();
+	}
+
+	bool GlyphAtlas::touch(const GlyphIndex glyphIndex)
+	{
+		const auto it = m_glyphTable.find(glyphIndex);
+
+		if (it == m_glyphTable.end())
+		{
+			return false;
+		}
+
+		if (const uint16 page = it->second.page;
+			page != PlaceholderPage)
+		{
+			m_pages[page].lastUsedFrame = GetCurrentFrame();
+		}
+
+		return true;
+	}
+
+	void GlyphAtlas::touchPage(const uint16 pageIndex)
+	{
+		if (pageIndex < m_pages.size())
+		{
+			m_pages[pageIndex].lastUsedFrame = GetCurrentFrame();
+		}
+	}
+
+	const GlyphCache& GlyphAtlas::get(const GlyphIndex glyphIndex) const
+	{
+		return m_glyphTable.find(glyphIndex)->second;
+	}
+
+	const GlyphCache* GlyphAtlas::find(const GlyphIndex glyphIndex) const
+	{
+		if (const auto it = m_glyphTable.find(glyphIndex);
+			it != m_glyphTable.end())
+		{
+			return &(it->second);
+		}
+
+		return nullptr;
+	}
+
+	bool GlyphAtlas::add(const FontData& font, const Image& image, const GlyphInfo& glyphInfo)
+	{
+		if (m_initialPageSize.isZero())
+		{
+			initPageSize(font);
+		}
+
+		const Size allocSize{ (image.width() + m_padding), (image.height() + m_padding) };
+
+		if ((m_initialPageSize.x < (allocSize.x + m_padding))
+			|| (MaxPageHeight < (allocSize.y + m_padding)))
+		{
+			return false;
+		}
+
+		const uint64 currentFrame = GetCurrentFrame();
+		size_t pageIndex = 0;
+		Optional<Point> pos;
+
+		for (; pageIndex < m_pages.size(); ++pageIndex)
+		{
+			if ((pos = allocate(m_pages[pageIndex], allocSize)))
+			{
+				break;
+			}
+		}
+
+		if (not pos)
+		{
+			const size_t newPageBytes = (m_initialPageSize.x * m_initialPageSize.y * sizeof(Color));
+			Optional<size_t> evictable;
+
+			if (m_memoryBudget < (getMemoryUsage() + newPageBytes))
+			{
+				evictable = findEvictablePage(currentFrame);
+			}
+
+			if (evictable)
+			{
+				pageIndex = *evictable;
+				evictPage(pageIndex);
+			}
+			else if ((MaxPages <= m_pages.size())
+				|| ((MinPagesOverBudget <= m_pages.size())
+					&& (m_memoryBudget < ((getMemoryUsage() + newPageBytes) / 2))))
+			{
+				// 使用中のページしか無く、予算を大きく超える場合は、次のフレームでページを再利用できるまで追加しない
+				return false;
+			}
+			else
+			{
+				// 予算を超えていても、現在のフレームで使用中のページしか無い場合は新しいページを作る
+				pageIndex = createPage();
+			}
+
+			pos = allocate(m_pages[pageIndex], allocSize);
+
+			if (not pos)
+			{
+				return false;
+			}
+		}
+
+		Page& page = m_pages[pageIndex];
+
+		if (const int32 requiredHeight = (pos->y + allocSize.y);
+			page.image.height() < requiredHeight)
+		{
+			const int32 newHeight = Min(((requiredHeight + 255) / 256 * 256), MaxPageHeight);
+			page.image.resizeRows(newHeight, m_backgroundColor);
+			page.resized = true;
+		}
+
+		image.overwrite(page.image, *pos);
+
+		detail::AddDirtyRect(page.dirtyRect, Rect{ *pos, image.size() });
+		page.glyphs << glyphInfo.glyphIndex;
+		page.lastUsedFrame = currentFrame;
+		m_hasDirty = true;
+		m_modified = true;
+
+		GlyphCache cache;
+		cache.info					= glyphInfo;
+		cache.textureRegionLeft		= static_cast<int16>(pos->x);
+		cache.textureRegionTop		= static_cast<int16>(pos->y);
+		cache.textureRegionWidth	= static_cast<int16>(image.width());
+		cache.textureRegionHeight	= static_cast<int16>(image.height());
+		cache.page					= static_cast<uint16>(pageIndex);
+
+		if (const auto [it, inserted] = m_glyphTable.insert_or_assign(glyphInfo.glyphIndex, cache);
+			not inserted)
+		{
+			// 画像の無いグリフが置き換えられた
+			++m_generation;
+		}
+
+		return true;
+	}
+
+	void GlyphAtlas::addPlaceholder(const GlyphInfo& glyphInfo)
+	{
+		GlyphCache cache;
+		cache.info = glyphInfo;
+		cache.page = PlaceholderPage;
+		m_glyphTable.emplace(glyphInfo.glyphIndex, cache);
+	}
+
+	bool GlyphAtlas::isPlaceholder(const GlyphIndex glyphIndex) const
+	{
+		if (const auto it = m_glyphTable.find(glyphIndex);
+			it != m_glyphTable.end())
+		{
+			return (it->second.page == PlaceholderPage);
+		}
+
+		return false;
+	}
+
+	void GlyphAtlas::removePlaceholder(const GlyphIndex glyphIndex)
+	{
+		if (isPlaceholder(glyphIndex))
+		{
+			m_glyphTable.erase(glyphIndex);
+
+			// 配置済みのテキストに、グリフを改めて生成させる
+			++m_generation;
+		}
+	}
+
+	TextureRegion GlyphAtlas::getTextureRegion(const GlyphCache& cache) const
+	{
+		if (cache.page == PlaceholderPage)
+		{
+			return{};
+		}
+
+		return m_pages[cache.page].texture(cache.textureRegionLeft, cache.textureRegionTop, cache.textureRegionWidth, cache.textureRegionHeight);
+	}
+
+	void GlyphAtlas::update()
+	{
+		if (not m_hasDirty)
+		{
+			return;
+		}
+
+		for (auto& page : m_pages)
+		{
+			if (page.resized || (page.texture.size() != page.image.size()))
+			{
+				page.texture = DynamicTexture{ page.image };
+				++m_generation;
+			}
+			else if (not page.dirtyRect.isEmpty())
+			{
+				// 変更された領域だけを転送する
+				if (not page.texture.fillRegion(page.image, page.dirtyRect))
+				{
+					page.texture.fill(page.image);
+				}
+			}
+
+			page.dirtyRect.set(0, 0, 0, 0);
+			page.resized = false;
+		}
+
+		m_hasDirty = false;
+	}
+
+	const Texture& GlyphAtlas::getTexture() const noexcept
+	{
+		static const Texture emptyTexture;
+
+		if (not m_pages)
+		{
+			return emptyTexture;
+		}
+
+		return m_pages.front().texture;
+	}
+
+	void GlyphAtlas::setMemoryBudget(const size_t bytes) noexcept
+	{
+		m_memoryBudget = bytes;
+	}
+
+	size_t GlyphAtlas::getMemoryBudget() const noexcept
+	{
+		return m_memoryBudget;
+	}
+
+	size_t GlyphAtlas::getMemoryUsage() const noexcept
+	{
+		size_t bytes = 0;
+
+		for (const auto& page : m_pages)
+		{
+			bytes += page.image.size_bytes();
+		}
+
+		return bytes;
+	}
+
+	size_t GlyphAtlas::num_pages() const noexcept
+	{
+		return m_pages.size();
+	}
+
+	uint64 GlyphAtlas::getGeneration() const noexcept
+	{
+		return m_generation;
+	}
+
+	bool GlyphAtlas::load(const FontData& font, const FileKey& key)
+	{
+		m_fileKey = key;
+
+		if (not empty())
+		{
+			return false;
+		}
+
+		const FilePath path = GetFilePath(key);
+		const MemoryMappedFileView view{ path };
+
+		if (not view)
+		{
+			return false;
+		}
+
+		if (m_initialPageSize.isZero())
+		{
+			initPageSize(font);
+		}
+
+		detail::MappedFileReader reader{ view };
+		char signature[8];
+		uint32 version = 0;
+		FileKey fileKey;
+		int32 pageWidth = 0, padding = 0;
+		uint32 numPages = 0, numGlyphs = 0;
+
+		if ((not reader.read(signature, sizeof(signature)))
+			|| (std::memcmp(signature, detail::GlyphAtlasFileSignature, sizeof(signature)) != 0)
+			|| (not reader.read(version))
+			|| (version != detail::GlyphAtlasFileVersion)
+			|| (not reader.read(fileKey))
+			|| (fileKey != key)
+			|| (not reader.read(pageWidth))
+			|| (pageWidth != m_initialPageSize.x)
+			|| (not reader.read(padding))
+			|| (padding != m_padding))
+		{
+			LOG_WARNING(U"GlyphAtlas::load(): `{}` is not compatible"_fmt(path));
+			return false;
+		}
+
+		const auto onBroken = [&path]()
+		{
+			LOG_WARNING(U"GlyphAtlas::load(): `{}` is broken"_fmt(path));
+			return false;
+		};
+
+		// 1 ページは少なくとも 1 行の画素を持つ
+		if ((not reader.read(numPages))
+			|| (not reader.read(numGlyphs))
+			|| ((reader.remaining() / (pageWidth * sizeof(Color))) < numPages))
+		{
+			return onBroken();
+		}
+
+		Array<Page> pages(numPages);
+
+		for (auto& page : pages)
+		{
+			int32 height = 0;
+			uint32 numSkylineNodes = 0;
+
+			if ((not reader.read(height))
+				|| (not InRange(height, 1, MaxPageHeight))
+				|| (not reader.read(numSkylineNodes))
+				|| (not InRange<uint32>(numSkylineNodes, 1, static_cast<uint32>(pageWidth))))
+			{
+				return onBroken();
+			}
+
+			page.skyline.resize(numSkylineNodes);
+
+			for (auto& node : page.skyline)
+			{
+				if ((not reader.read(node.x))
+					|| (not reader.read(node.y))
+					|| (not reader.read(node.width)))
+				{
+					return onBroken();
+				}
+			}
+
+			if (not isValidSkyline(page.skyline, height))
+			{
+				return onBroken();
+			}
+
+			page.image.resize(pageWidth, height);
+
+			// ファイルの画素を、テクスチャの作成に使う画像へ直接読み込む
+			if (not reader.read(page.image.data(), page.image.size_bytes()))
+			{
+				return onBroken();
+			}
+		}
+
+		if ((reader.remaining() / detail::GlyphCacheFileSize) < numGlyphs)
+		{
+			return onBroken();
+		}
+
+		HashTable<GlyphIndex, GlyphCache> glyphTable;
+		glyphTable.reserve(numGlyphs);
+
+		for (uint32 i = 0; i < numGlyphs; ++i)
+		{
+			GlyphCache cache;
+
+			if ((not reader.read(cache))
+				|| (pages.size() <= cache.page))
+			{
+				return onBroken();
+			}
+
+			// テクスチャ領域がページに収まっているか
+			const Size pageSize = pages[cache.page].image.size();
+
+			if ((cache.textureRegionLeft < 0)
+				|| (cache.textureRegionTop < 0)
+				|| (cache.textureRegionWidth < 0)
+				|| (cache.textureRegionHeight < 0)
+				|| (pageSize.x < (cache.textureRegionLeft + cache.textureRegionWidth))
+				|| (pageSize.y < (cache.textureRegionTop + cache.textureRegionHeight)))
+			{
+				return onBroken();
+			}
+
+			if (not glyphTable.emplace(cache.info.glyphIndex, cache).second)
+			{
+				return onBroken();
+			}
+
+			pages[cache.page].glyphs << cache.info.glyphIndex;
+		}
+
+		LOG_TRACE(U"GlyphAtlas::load(): {} glyphs loaded from `{}`"_fmt(glyphTable.size(), path));
+
+		m_pages = std::move(pages);
+		m_glyphTable = std::move(glyphTable);
+		m_hasDirty = true;
+		m_modified = false;
+		++m_generation;
+		return true;
+	}
+
+	bool GlyphAtlas::save()
+	{
+		if ((not m_fileKey) || (not m_modified))
+		{
+			return false;
+		}
+
+		Array<GlyphCache> glyphs(Arg::reserve = m_glyphTable.size());
+
+		for (const auto& [glyphIndex, cache] : m_glyphTable)
+		{
+			if (cache.page != PlaceholderPage)
+			{
+				glyphs << cache;
+			}
+		}
+
+		if (not glyphs)
+		{
+			return false;
+		}
+
+		const FilePath path = GetFilePath(*m_fileKey);
+		bool result = false;
+		{
+			BinaryWriter writer{ path };
+
+			if (not writer)
+			{
+				return false;
+			}
+
+			detail::FileDataWriter data;
+
+			for (const char ch : detail::GlyphAtlasFileSignature)
+			{
+				data.write(ch);
+			}
+
+			data.write(detail::GlyphAtlasFileVersion);
+			data.write(*m_fileKey);
+			data.write(m_initialPageSize.x);
+			data.write(m_padding);
+			data.write(static_cast<uint32>(m_pages.size()));
+			data.write(static_cast<uint32>(glyphs.size()));
+			result = data.flush(writer);
+
+			for (const auto& page : m_pages)
+			{
+				if (not result)
+				{
+					break;
+				}
+
+				data.write(page.image.height());
+				data.write(static_cast<uint32>(page.skyline.size()));
+
+				for (const auto& node : page.skyline)
+				{
+					data.write(node.x);
+					data.write(node.y);
+					data.write(node.width);
+				}
+
+				const int64 imageSize = static_cast<int64>(page.image.size_bytes());
+				result = (data.flush(writer)
+					&& (writer.write(page.image.data(), imageSize) == imageSize));
+			}
+
+			if (result)
+			{
+				for (const auto& cache : glyphs)
+				{
+					data.write(cache);
+				}
+
+				result = data.flush(writer);
+			}
+		}
+
+		if (not result)
+		{
+			// 途中までしか書き込めなかったファイルは残さない
+			LOG_WARNING(U"GlyphAtlas::save(): failed to write `{}`"_fmt(path));
+			FileSystem::Remove(path);
+			return false;
+		}
+
+		LOG_TRACE(U"GlyphAtlas::save(): {} glyphs saved to `{}`"_fmt(glyphs.size(), path));
+
+		m_modified = false;
+		return true;
+	}
+
+	bool GlyphAtlas::isValidSkyline(const Array<SkylineNode>& skyline, const int32 pageHeight) const
+	{
+		// ノードは左端の余白から右端まで、隙間なく並んでいる
+		int32 x = m_padding;
+
+		for (const auto& node : skyline)
+		{
+			if ((node.x != x)
+				|| (node.width <= 0)
+				|| (not InRange(node.y, 0, pageHeight)))
+			{
+				return false;
+			}
+
+			x += node.width;
+
+			if (m_initialPageSize.x < x)
+			{
+				return false;
+			}
+		}
+
+		return (x == m_initialPageSize.x);
+	}
+
+	void GlyphAtlas::initPageSize(const FontData& font)
+	{
+		const int32 fontSize = font.getProperty().fontPixelSize;
+		const int32 baseWidth =
+			fontSize <= 16 ? 512 :
+			fontSize <= 32 ? 768 :
+			fontSize <= 48 ? 1024 :
+			fontSize <= 64 ? 1536 :
+			fontSize <= 256 ? 2048 : 4096;
+		const int32 baseHeight = (fontSize <= 256 ? 256 : 512);
+		m_initialPageSize.set(baseWidth, baseHeight);
+	}
+
+	size_t GlyphAtlas::createPage()
+	{
+		Page page;
+		page.image.resize(m_initialPageSize, m_backgroundColor);
+		resetSkyline(page);
+		m_pages << std::move(page);
+		return (m_pages.size() - 1);
+	}
+
+	Optional<size_t> GlyphAtlas::findEvictablePage(const uint64 currentFrame) const
+	{
+		// .notdef (グリフ 0) は、キャッシュが空になったときにしか追加し直されないため、そのページは追い出さない
+		size_t pinnedPage = m_pages.size();
+
+		if (const GlyphCache* notdef = find(0);
+			notdef && (notdef->page != PlaceholderPage))
+		{
+			pinnedPage = notdef->page;
+		}
+
+		Optional<size_t> result;
+
+		for (size_t i = 0; i < m_pages.size(); ++i)
+		{
+			if (i == pinnedPage)
+			{
+				continue;
+			}
+
+			const uint64 lastUsedFrame = m_pages[i].lastUsedFrame;
+
+			// 現在のフレームで描画に使われたページは、描画コマンドが参照しているため追い出さない
+			if (lastUsedFrame == currentFrame)
+			{
+				continue;
+			}
+
+			if ((not result) || (lastUsedFrame < m_pages[*result].lastUsedFrame))
+			{
+				result = i;
+			}
+		}
+
+		return result;
+	}
+
+	void GlyphAtlas::evictPage(const size_t pageIndex)
+	{
+		Page& page = m_pages[pageIndex];
+
+		for (const auto& glyphIndex : page.glyphs)
+		{
+			m_glyphTable.erase(glyphIndex);
+		}
+
+		page.glyphs.clear();
+		page.image.fill(m_backgroundColor);
+		++m_generation;
+		page.dirtyRect = Rect{ page.image.size() };
+		resetSkyline(page);
+		m_hasDirty = true;
+		m_modified = true;
+	}
+
+	void GlyphAtlas::resetSkyline(Page& page) const
+	{
+		page.skyline.clear();
+		page.skyline.push_back({ m_padding, m_padding, (m_initialPageSize.x - m_padding) });
+	}
+
+	Optional<Point> GlyphAtlas::allocate(Page& page, const Size size) const
+	{
+		Array<SkylineNode>& skyline = page.skyline;
+		const int32 pageWidth = m_initialPageSize.x;
+
+		size_t bestIndex = skyline.size();
+		int32 bestBottom = MaxPageHeight;
+		int32 bestWidth = pageWidth;
+		Point bestPos{ 0, 0 };
+
+		// 置いたときの下端が最も上になり、同じ場合は隙間が少なくなる位置を探す (Bottom-Left)
+		for (size_t i = 0; i < skyline.size(); ++i)
+		{
+			const int32 x = skyline[i].x;
+
+			if (pageWidth < (x + size.x))
+			{
+				break;
+			}
+
+			int32 y = 0;
+			int32 widthLeft = size.x;
+
+			for (size_t k = i; 0 < widthLeft; ++k)
+			{
+				y = Max(y, skyline[k].y);
+				widthLeft -= skyline[k].width;
+			}
+
+			const int32 bottom = (y + size.y);
+
+			if (MaxPageHeight < bottom)
+			{
+				continue;
+			}
+
+			if ((bottom < bestBottom)
+				|| ((bottom == bestBottom) && (skyline[i].width < bestWidth)))
+			{
+				bestIndex = i;
+				bestBottom = bottom;
+				bestWidth = skyline[i].width;
+				bestPos.set(x, y);
+			}
+		}
+
+		if (bestIndex == skyline.size())
+		{
+			return none;
+		}
+
+		skyline.insert((skyline.begin() + bestIndex), SkylineNode{ bestPos.x, bestBottom, size.x });
+
+		// 新しいノードに覆われた部分を取り除く
+		for (size_t i = (bestIndex + 1); i < skyline.size();)
+		{
+			const SkylineNode& previous = skyline[i - 1];
+			SkylineNode& node = skyline[i];
+			const int32 previousRight = (previous.x + previous.width);
+
+			if (previousRight <= node.x)
+			{
+				break;
+			}
+
+			const int32 shrink = (previousRight - node.x);
+
+			if (node.width <= shrink)
+			{
+				skyline.erase(skyline.begin() + i);
+				continue;
+			}
+
+			node.x += shrink;
+			node.width -= shrink;
+			break;
+		}
+
+		// 同じ高さのノードをまとめる
+		for (size_t i = 0; (i + 1) < skyline.size();)
+		{
+			if (skyline[i].y == skyline[i + 1].y)
+			{
+				skyline[i].width += skyline[i + 1].width;
+				skyline.erase(skyline.begin() + (i + 1));
+			}
+			else
+			{
+				++i;
+			}
+		}
+
+		return bestPos;
+	}
+
+	uint64 GlyphAtlas::GetCurrentFrame() noexcept
+	{
+		return SIV3D_ENGINE(Scene)->getFrameCounter().getSystemFrameCount();
+	}
+
+	Optional<GlyphAtlas::FileKey> GlyphAtlas::MakeFileKey(const FontData& font, const int32 bufferWidth)
+	{
+		const uint64 fontFileHash = font.getFontFileHash();
+
+		if (fontFileHash == 0)
+		{
+			return none;
+		}
+
+		const auto& prop = font.getProperty();
+
+		FileKey key;
+		key.fontFileHash	= fontFileHash;
+		key.faceIndex		= static_cast<uint32>(font.getFaceIndex());
+		key.fontSize		= prop.fontPixelSize;
+		key.bufferWidth		= bufferWidth;
+		key.method			= static_cast<uint8>(font.getMethod());
+		key.style			= static_cast<uint8>(prop.style);
+		return key;
+	}
+
+	FilePath GlyphAtlas::GetFilePath(const FileKey& key)
+	{
+		return CacheDirectory::Engine() + U"font/{:016X}.glyphatlas"_fmt(Hash::XXHash3(key));
+	}
+}
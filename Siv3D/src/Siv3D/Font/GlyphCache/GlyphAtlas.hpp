@@ -0,0 +1,236 @@
+﻿//-----------------------------------------------
+//
+//	This file is part of the Siv3D Engine.
+//
+//	Copyright (c) 2008-2022 Ryo Suzuki
+//	Copyright (c) 2016-2022 OpenSiv3D Project
+//
+//	Licensed under the MIT License.
+//
+//-----------------------------------------------
+
+# pragma once
+# include <Siv3D/Common.hpp>
+# include <Siv3D/Image.hpp>
+# include <Siv3D/DynamicTexture.hpp>
+# include <Siv3D/TextureRegion.hpp>
+# include <Siv3D/HashTable.hpp>
+# include "GlyphCacheCommon.hpp"
+
+namespace s3d
+{
+	/// @brief グリフをキャッシュする、複数ページのテクスチャアトラス
+	/// @remark ページ内はスカイライン法でグリフを詰めます。
+	/// @remark 使用メモリが予算を超える場合は、最も長く使われていないページを空にして再利用します。.notdef (グリフ 0) のページは再利用しません。
+	/// @remark 現在のフレームで使用中のページしか無い場合は予算を超えてページを作りますが、予算の 2 倍を超える場合は、ページを再利用できるようになるまでグリフを追加しません。
+	class GlyphAtlas
+	{
+	public:
+
+		/// @brief 使用メモリの予算のデフォルト値（バイト）
+		static constexpr size_t DefaultMemoryBudget = (64 * 1024 * 1024);
+
+		/// @brief 1 ページの高さの最大値
+		static constexpr int32 MaxPageHeight = 4096;
+
+		/// @brief 画像の無いグリフのページ番号
+		static constexpr uint16 PlaceholderPage = 0xFFFF;
+
+		/// @brief ページ数の上限
+		/// @remark ページ番号は uint16 で表し、PlaceholderPage は使えません。
+		static constexpr size_t MaxPages = PlaceholderPage;
+
+		/// @brief 使用メモリが予算の 2 倍を超える場合でも作ることのできるページ数
+		static constexpr size_t MinPagesOverBudget = 4;
+
+		/// @brief キャッシュファイルを識別する情報
+		struct FileKey
+		{
+			/// @brief フォントファイルのハッシュ値
+			uint64 fontFileHash = 0;
+
+			uint32 faceIndex = 0;
+
+			int32 fontSize = 0;
+
+			int32 bufferWidth = 0;
+
+			uint8 method = 0;
+
+			uint8 style = 0;
+
+			uint16 reserved = 0;
+
+			[[nodiscard]]
+			friend bool operator ==(const FileKey&, const FileKey&) = default;
+		};
+
+		explicit GlyphAtlas(const Color& backgroundColor);
+
+		/// @brief キャッシュされているグリフが無いかを返します。
+		[[nodiscard]]
+		bool empty() const noexcept;
+
+		/// @brief グリフがキャッシュされているかを返します。キャッシュされている場合、そのページを現在のフレームで使用中にします。
+		/// @remark 現在のフレームで使用中のページは追い出されません。
+		[[nodiscard]]
+		bool touch(GlyphIndex glyphIndex);
+
+		/// @brief ページを現在のフレームで使用中にします。
+		/// @param pageIndex ページ番号
+		void touchPage(uint16 pageIndex);
+
+		/// @brief キャッシュされているグリフを返します。
+		/// @remark グリフがキャッシュされている必要があります。
+		[[nodiscard]]
+		const GlyphCache& get(GlyphIndex glyphIndex) const;
+
+		/// @brief キャッシュされているグリフを返します。
+		/// @return キャッシュされているグリフ。無い場合は nullptr
+		[[nodiscard]]
+		const GlyphCache* find(GlyphIndex glyphIndex) const;
+
+		/// @brief グリフをキャッシュに追加します。
+		/// @return 追加に成功した場合 true, グリフがページに収まらない場合や、ページ数が上限に達している場合は false
+		[[nodiscard]]
+		bool add(const FontData& font, const Image& image, const GlyphInfo& glyphInfo);
+
+		/// @brief 画像の生成を待っているグリフを、画像の無いグリフとして追加します。
+		/// @remark add() で画像が追加されるまで、グリフのテクスチャ領域は空になります。
+		void addPlaceholder(const GlyphInfo& glyphInfo);
+
+		/// @brief 画像の無いグリフであるかを返します。
+		[[nodiscard]]
+		bool isPlaceholder(GlyphIndex glyphIndex) const;
+
+		/// @brief 画像の無いグリフを取り除きます。
+		/// @remark 画像を追加できなかったグリフを、次に必要になったときに改めて生成するために使います。
+		void removePlaceholder(GlyphIndex glyphIndex);
+
+		/// @brief キャッシュされているグリフのテクスチャ領域を返します。
+		[[nodiscard]]
+		TextureRegion getTextureRegion(const GlyphCache& cache) const;
+
+		/// @brief 変更された領域をテクスチャに転送します。
+		void update();
+
+		/// @brief 最初のページのテクスチャを返します。
+		[[nodiscard]]
+		const Texture& getTexture() const noexcept;
+
+		void setMemoryBudget(size_t bytes) noexcept;
+
+		[[nodiscard]]
+		size_t getMemoryBudget() const noexcept;
+
+		/// @brief すべてのページが使用しているメモリ（バイト）を返します。
+		[[nodiscard]]
+		size_t getMemoryUsage() const noexcept;
+
+		[[nodiscard]]
+		size_t num_pages() const noexcept;
+
+		/// @brief 以前に取得したテクスチャ領域が無効になるたびに増える番号を返します。
+		/// @remark グリフの追い出し、ページのテクスチャの作り直し、画像の無いグリフへの画像の追加で増えます。
+		[[nodiscard]]
+		uint64 getGeneration() const noexcept;
+
+		/// @brief キャッシュファイルからグリフを読み込みます。
+		/// @param font フォント
+		/// @param key キャッシュファイルを識別する情報
+		/// @return 読み込みに成功した場合 true, それ以外の場合は false
+		/// @remark 以降の save() は、読み込みに失敗した場合も key のキャッシュファイルに書き込みます。
+		bool load(const FontData& font, const FileKey& key);
+
+		/// @brief load() の後にキャッシュの内容が変わった場合、キャッシュファイルに書き込みます。
+		/// @return 書き込んだ場合 true, それ以外の場合は false
+		/// @remark 画像の無いグリフは書き込みません。
+		bool save();
+
+		/// @brief 現在のフレームの番号を返します。
+		[[nodiscard]]
+		static uint64 GetCurrentFrame() noexcept;
+
+		/// @brief キャッシュファイルを識別する情報を作成します。
+		/// @return キャッシュファイルを識別する情報。フォントファイルを読み込めない場合は none
+		[[nodiscard]]
+		static Optional<FileKey> MakeFileKey(const FontData& font, int32 bufferWidth);
+
+		/// @brief キャッシュファイルのパスを返します。
+		[[nodiscard]]
+		static FilePath GetFilePath(const FileKey& key);
+
+	private:
+
+		struct SkylineNode
+		{
+			int32 x = 0;
+
+			int32 y = 0;
+
+			int32 width = 0;
+		};
+
+		struct Page
+		{
+			Image image;
+
+			DynamicTexture texture;
+
+			Array<SkylineNode> skyline;
+
+			// このページにキャッシュされているグリフ
+			Array<GlyphIndex> glyphs;
+
+			// テクスチャへの転送が必要な領域
+			Rect dirtyRect{ 0, 0, 0, 0 };
+
+			// 画像のサイズが変わり、テクスチャの作り直しが必要か
+			bool resized = true;
+
+			// 最後に使われたフレーム
+			uint64 lastUsedFrame = 0;
+		};
+
+		HashTable<GlyphIndex, GlyphCache> m_glyphTable;
+
+		Array<Page> m_pages;
+
+		Color m_backgroundColor;
+
+		int32 m_padding = 1;
+
+		Size m_initialPageSize{ 0, 0 };
+
+		size_t m_memoryBudget = DefaultMemoryBudget;
+
+		bool m_hasDirty = false;
+
+		Optional<FileKey> m_fileKey;
+
+		// キャッシュファイルに書き込まれていない変更があるか
+		bool m_modified = false;
+
+		// getTextureRegion() で返したテクスチャ領域の世代
+		uint64 m_generation = 0;
+
+		void initPageSize(const FontData& font);
+
+		[[nodiscard]]
+		size_t createPage();
+
+		[[nodiscard]]
+		Optional<size_t> findEvictablePage(uint64 currentFrame) const;
+
+		void evictPage(size_t pageIndex);
+
+		void resetSkyline(Page& page) const;
+
+		/// @brief キャッシュファイルから読み込んだスカイラインが、ページの大きさに収まっているかを返します。
+		[[nodiscard]]
+		bool isValidSkyline(const Array<SkylineNode>& skyline, int32 pageHeight) const;
+
+		[[nodiscard]]
+		Optional<Point> allocate(Page& page, Size size) const;
+	};
+}
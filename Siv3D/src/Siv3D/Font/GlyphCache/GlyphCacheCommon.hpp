@@ -30,23 +30,9 @@ namespace s3d
 		int16 textureRegionWidth = 0;
 
 		int16 textureRegionHeight = 0;
-	};
-
-	struct BufferImage
-	{
-		static constexpr int32 MaxImageHeight = 4096;
-
-		Image image;
-
-		Color backgroundColor{ 255, 0 };
 
-		int32 bufferWidth = 2;
-
-		int32 padding = 1;
-
-		Point penPos = { 0, padding };
-
-		int32 currentMaxHeight = 0;
+		// グリフを格納しているアトラスのページ
+		uint16 page = 0;
 	};
 
 	[[nodiscard]]
@@ -54,8 +40,4 @@ namespace s3d
 
 	[[nodiscard]]
 	bool ProcessControlCharacter(char32 ch, Vec2& penPos, int32& line, const Vec2& basePos, double scale, double lineHeightScale, const FontFaceProperty& prop);
-
-	[[nodiscard]]
-	bool CacheGlyph(const FontData& font, const Image& image, const GlyphInfo& glyphInfo,
-		BufferImage& buffer, HashTable<GlyphIndex, GlyphCache>& glyphTable);
 }
@@ -0,0 +1,68 @@
+﻿//-----------------------------------------------
+//
+//	This file is part of the Siv3D Engine.
+//
+//	Copyright (c) 2008-2022 Ryo Suzuki
+//	Copyright (c) 2016-2022 OpenSiv3D Project
+//
+//	Licensed under the MIT License.
+//
+//-----------------------------------------------
+
+# include "GlyphJobQueue.hpp"
+
+namespace s3d
+{
+	namespace detail
+	{
+		static std::atomic<size_t> g_pendingGlyphJobCount{ 0 };
+	}
+
+	GlyphJobQueue::GlyphJobQueue()
+		: m_shared{ std::make_shared<Shared>() } {}
+
+	void GlyphJobQueue::submit(const GlyphInfo& info, std::function<Image()> generator)
+	{
+		++detail::g_pendingGlyphJobCount;
+
+		Threading::GetDefaultPool().submit(m_shared->waitGroup, [shared = m_shared, info, generator = std::move(generator)]()
+		{
+			Result result{ info, generator() };
+
+			{
+				std::lock_guard lock{ shared->mutex };
+				shared->completed << std::move(result);
+				shared->hasCompleted.store(true, std::memory_order_release);
+			}
+
+			--detail::g_pendingGlyphJobCount;
+		});
+	}
+
+	bool GlyphJobQueue::hasCompleted() const noexcept
+	{
+		return m_shared->hasCompleted.load(std::memory_order_acquire);
+	}
+
+	Array<GlyphJobQueue::Result> GlyphJobQueue::takeCompleted()
+	{
+		Array<Result> results;
+		{
+			std::lock_guard lock{ m_shared->mutex };
+			results.swap(m_shared->completed);
+			m_shared->hasCompleted.store(false, std::memory_order_relaxed);
+		}
+
+		return results;
+	}
+
+	void GlyphJobQueue::wait()
+	{
+		Threading::GetDefaultPool().wait(m_shared->waitGroup);
+	}
+
+	size_t GlyphJobQueue::GetPendingJobCount() noexcept
+	{
+		return detail::g_pendingGlyphJobCount.load(std::memory_order_relaxed);
+	}
+}
@@ -0,0 +1,76 @@
+﻿//-----------------------------------------------
+//
+//	This file is part of the Siv3D Engine.
+//
+//	Copyright (c) 2008-2022 Ryo Suzuki
+//	Copyright (c) 2016-2022 OpenSiv3D Project
+//
+//	Licensed under the MIT License.
+//
+//-----------------------------------------------
+
+# pragma once
+# include <atomic>
+# include <mutex>
+# include <memory>
+# include <functional>
+# include <Siv3D/Common.hpp>
+# include <Siv3D/Array.hpp>
+# include <Siv3D/GlyphInfo.hpp>
+# include <Siv3D/Image.hpp>
+# include <Siv3D/ThreadPool.hpp>
+
+namespace s3d
+{
+	/// @brief グリフの画像をワーカースレッドで生成するジョブキュー
+	/// @remark submit(), takeCompleted(), wait() はメインスレッドから呼びます。
+	class GlyphJobQueue
+	{
+	public:
+
+		struct Result
+		{
+			GlyphInfo info;
+
+			Image image;
+		};
+
+		GlyphJobQueue();
+
+		/// @brief グリフの画像を生成するジョブを追加します。
+		/// @param info グリフの画像以外の情報
+		/// @param generator 画像を生成する関数。ワーカースレッドで実行されます。
+		void submit(const GlyphInfo& info, std::function<Image()> generator);
+
+		/// @brief 完了したジョブがあるかを返します。
+		[[nodiscard]]
+		bool hasCompleted() const noexcept;
+
+		/// @brief 完了したジョブの結果を取り出します。
+		[[nodiscard]]
+		Array<Result> takeCompleted();
+
+		/// @brief 追加したすべてのジョブが完了するまで待機します。
+		void wait();
+
+		/// @brief すべてのフォントで生成中のグリフの数を返します。
+		[[nodiscard]]
+		static size_t GetPendingJobCount() noexcept;
+
+	private:
+
+		// ワーカースレッドと共有する。フォントが先に破棄されてもジョブが安全に完了できるよう shared_ptr で持つ
+		struct Shared
+		{
+			std::mutex mutex;
+
+			Array<Result> completed;
+
+			std::atomic<bool> hasCompleted{ false };
+
+			WaitGroup waitGroup;
+		};
+
+		std::shared_ptr<Shared> m_shared;
+	};
+}
@@ -15,6 +15,7 @@
 # include <Siv3D/Texture.hpp>
 # include <Siv3D/Font.hpp>
 # include "../FontData.hpp"
+# include "../PreparedTextLayout.hpp"
 
 namespace s3d
 {
@@ -46,8 +47,15 @@ namespace s3d
 
 		virtual int32 getBufferWidth() const noexcept = 0;
 
+		virtual void setMemoryBudget(size_t bytes) = 0;
+
+		[[nodiscard]]
+		virtual size_t getMemoryBudget() const noexcept = 0;
+
 		virtual bool preload(const FontData& font, StringView s) = 0;
 
+		virtual bool preloadAsync(const FontData& font, StringView s) = 0;
+
 		[[nodiscard]]
 		virtual const Texture& getTexture() noexcept = 0;
 
@@ -56,5 +64,17 @@ namespace s3d
 
 		[[nodiscard]]
 		virtual int32 getBufferThickness(GlyphIndex glyphIndex) = 0;
+
+		/// @brief テキストのグリフをキャッシュし、フォントの基本サイズで配置します。
+		/// @param firstCluster 配置をやり直す最初のクラスタ。それより前のクラスタは以前の配置を再利用します。
+		virtual bool prepare(const FontData& font, StringView s, const Array<GlyphCluster>& clusters, size_t firstCluster, PreparedTextLayout& layout) = 0;
+
+		/// @brief prepare() で配置したテキストを描画します。
+		/// @remark アトラスのテクスチャ領域が無効になっている場合は、配置をやり直してから描画します。
+		virtual RectF drawPrepared(const FontData& font, StringView s, const Array<GlyphCluster>& clusters, PreparedTextLayout& layout, const Vec2& pos, double size, const TextStyle& textStyle, const ColorF& color) = 0;
+
+		/// @brief キャッシュしたグリフを、次回の実行で再利用できるようキャッシュファイルに書き込みます。
+		/// @return 書き込んだ場合 true, それ以外の場合は false
+		virtual bool saveCacheFile(const FontData& font) = 0;
 	};
 }
@@ -24,7 +24,7 @@ namespace s3d
 		{
 			return RectF::Empty();
 		}
-		updateTexture();
+		m_atlas.update();
 
 		const auto& prop = font.getProperty();
 		const double scale = (size / prop.fontPixelSize);
@@ -63,9 +63,9 @@ namespace s3d
 				continue;
 			}
 
-			const auto& cache = m_glyphTable.find(cluster.glyphIndex)->second;
+			const auto& cache = m_atlas.get(cluster.glyphIndex);
 			{
-				const TextureRegion textureRegion = m_texture(cache.textureRegionLeft, cache.textureRegionTop, cache.textureRegionWidth, cache.textureRegionHeight);
+				const TextureRegion textureRegion = m_atlas.getTextureRegion(cache);
 				const Vec2 posOffset = usebasePos ? cache.info.getBase(scale) : cache.info.getOffset(scale);
 				const Vec2 drawPos = (penPos + posOffset);
 
@@ -103,9 +103,9 @@ namespace s3d
 		{
 			// do tnohing
 		}
-		updateTexture();
+		m_atlas.update();
 
-		const double dotXAdvance = m_glyphTable.find(dotGlyphCluster[0].glyphIndex)->second.info.xAdvance;
+		const double dotXAdvance = m_atlas.get(dotGlyphCluster[0].glyphIndex).info.xAdvance;
 		const Vec2 areaBottomRight = area.br();
 
 		const auto& prop = font.getProperty();
@@ -156,7 +156,7 @@ namespace s3d
 				}
 				else
 				{
-					const auto& cache = m_glyphTable.find(cluster.glyphIndex)->second;
+					const auto& cache = m_atlas.get(cluster.glyphIndex);
 					xAdvance = (cache.info.xAdvance * scale);
 				}
 
@@ -253,9 +253,9 @@ namespace s3d
 			}
 			else
 			{
-				const auto& cache = m_glyphTable.find(cluster.glyphIndex)->second;
+				const auto& cache = m_atlas.get(cluster.glyphIndex);
 				{
-					const TextureRegion textureRegion = m_texture(cache.textureRegionLeft, cache.textureRegionTop, cache.textureRegionWidth, cache.textureRegionHeight);
+					const TextureRegion textureRegion = m_atlas.getTextureRegion(cache);
 					const Vec2 posOffset = cache.info.getOffset(scale);
 					const Vec2 drawPos = (newPenPositions[i] + posOffset);
 
@@ -283,7 +283,7 @@ namespace s3d
 		{
 			return RectF::Empty();
 		}
-		updateTexture();
+		m_atlas.update();
 
 		const auto& prop = font.getProperty();
 		const double scale = (size / prop.fontPixelSize);
@@ -294,9 +294,9 @@ namespace s3d
 		double xMax = basePos.x;
 
 		{
-			const auto& cache = m_glyphTable.find(cluster.glyphIndex)->second;
+			const auto& cache = m_atlas.get(cluster.glyphIndex);
 			{
-				const TextureRegion textureRegion = m_texture(cache.textureRegionLeft, cache.textureRegionTop, cache.textureRegionWidth, cache.textureRegionHeight);
+				const TextureRegion textureRegion = m_atlas.getTextureRegion(cache);
 				const Vec2 posOffset = usebasePos ? cache.info.getBase(scale) : cache.info.getOffset(scale);
 				const Vec2 drawPos = (penPos + posOffset);
 				RectF rect;
@@ -370,7 +370,7 @@ namespace s3d
 				continue;
 			}
 
-			const auto& cache = m_glyphTable.find(cluster.glyphIndex)->second;
+			const auto& cache = m_atlas.get(cluster.glyphIndex);
 			const double xAdvance = (cache.info.xAdvance * scale);
 			xAdvances << xAdvance;
 			penPosX += xAdvance;
@@ -388,7 +388,7 @@ namespace s3d
 
 		const auto& prop = font.getProperty();
 		const double scale = (fontSize / prop.fontPixelSize);
-		const auto& cache = m_glyphTable.find(cluster.glyphIndex)->second;
+		const auto& cache = m_atlas.get(cluster.glyphIndex);
 		return (cache.info.xAdvance * scale);
 	}
 
@@ -435,7 +435,7 @@ namespace s3d
 				continue;
 			}
 
-			const auto& cache = m_glyphTable.find(cluster.glyphIndex)->second;
+			const auto& cache = m_atlas.get(cluster.glyphIndex);
 			penPos.x += (cache.info.xAdvance * scale);
 			xMax = Max(xMax, penPos.x);
 		}
@@ -459,7 +459,7 @@ namespace s3d
 		double xMax = basePos.x;
 
 		{
-			const auto& cache = m_glyphTable.find(cluster.glyphIndex)->second;
+			const auto& cache = m_atlas.get(cluster.glyphIndex);
 			penPos.x += (cache.info.xAdvance * scale);
 			xMax = Max(xMax, penPos.x);
 		}
@@ -470,61 +470,160 @@ namespace s3d
 
 	void SDFGlyphCache::setBufferWidth(const int32 width)
 	{
-		m_buffer.bufferWidth = Max(width, 0);
+		m_bufferWidth = Max(width, 0);
 	}
 
 	int32 SDFGlyphCache::getBufferWidth() const noexcept
 	{
-		return m_buffer.bufferWidth;
+		return m_bufferWidth;
+	}
+
+	void SDFGlyphCache::setMemoryBudget(const size_t bytes)
+	{
+		m_atlas.setMemoryBudget(bytes);
+	}
+
+	size_t SDFGlyphCache::getMemoryBudget() const noexcept
+	{
+		return m_atlas.getMemoryBudget();
 	}
 
 	bool SDFGlyphCache::preload(const FontData& font, const StringView s)
 	{
+		finishPendingGlyphs(font);
+
 		return prerender(font, font.getGlyphClusters(s, false, Ligature::Yes), true);
 	}
 
+	bool SDFGlyphCache::preloadAsync(const FontData& font, const StringView s)
+	{
+		// .notdef は同期的に生成する
+		if (not prerender(font, {}, true))
+		{
+			return false;
+		}
+
+		for (const auto& cluster : *font.getGlyphClustersShared(s, false, Ligature::Yes))
+		{
+			if (m_atlas.touch(cluster.glyphIndex))
+			{
+				continue;
+			}
+
+			auto [glyph, generator] = font.prepareSDFByGlyphIndex(cluster.glyphIndex, m_bufferWidth);
+
+			// 輪郭を読み込めないグリフは、描画時に生成する
+			if (not generator)
+			{
+				continue;
+			}
+
+			// 画像が生成されるまでは、画像の無いグリフとして扱う
+			m_atlas.addPlaceholder(glyph);
+			m_jobs.submit(glyph, std::move(generator));
+		}
+
+		return true;
+	}
+
 	const Texture& SDFGlyphCache::getTexture() noexcept
 	{
-		updateTexture();
+		m_atlas.update();
 
-		return m_texture;
+		return m_atlas.getTexture();
 	}
 
 	TextureRegion SDFGlyphCache::getTextureRegion(const FontData& font, const GlyphIndex glyphIndex)
 	{
+		if (m_atlas.isPlaceholder(glyphIndex))
+		{
+			finishPendingGlyphs(font);
+		}
+
 		if (not prerender(font, { GlyphCluster{.glyphIndex = glyphIndex } }, true))
 		{
 			return{};
 		}
-		updateTexture();
+		m_atlas.update();
 
-		const auto& cache = m_glyphTable.find(glyphIndex)->second;
-		return m_texture(cache.textureRegionLeft, cache.textureRegionTop, cache.textureRegionWidth, cache.textureRegionHeight);
+		const auto& cache = m_atlas.get(glyphIndex);
+		return m_atlas.getTextureRegion(cache);
 	}
 
 	int32 SDFGlyphCache::getBufferThickness(const GlyphIndex glyphIndex)
 	{
-		if (auto it = m_glyphTable.find(glyphIndex);
-			it != m_glyphTable.end())
+		if (const GlyphCache* cache = m_atlas.find(glyphIndex))
 		{
-			return it->second.info.buffer;
+			return cache->info.buffer;
 		}
 
 		return 0;
 	}
 
+	bool SDFGlyphCache::prepare(const FontData& font, const StringView s, const Array<GlyphCluster>& clusters, const size_t firstCluster, PreparedTextLayout& layout)
+	{
+		if (not prerender(font, clusters, true))
+		{
+			layout.clear();
+			return false;
+		}
+		m_atlas.update();
+
+		LayoutPreparedText(font, m_atlas, s, clusters, firstCluster, layout);
+		return true;
+	}
+
+	RectF SDFGlyphCache::drawPrepared(const FontData& font, const StringView s, const Array<GlyphCluster>& clusters, PreparedTextLayout& layout, const Vec2& pos, const double size, const TextStyle& textStyle, const ColorF& color)
+	{
+		mergeCompletedGlyphs(font, false);
+		m_atlas.update();
+
+		// グリフが追い出されたり、テクスチャが作り直されたりした場合は配置し直す
+		if (layout.generation != m_atlas.getGeneration())
+		{
+			if (not prepare(font, s, clusters, 0, layout))
+			{
+				return RectF::Empty();
+			}
+		}
+
+		return DrawPreparedText(font, m_atlas, clusters, layout, pos, size, textStyle, color, false);
+	}
+
+	bool SDFGlyphCache::saveCacheFile(const FontData& font)
+	{
+		// 生成が完了しているグリフも書き込む
+		mergeCompletedGlyphs(font, true);
+
+		return m_atlas.save();
+	}
+
 	bool SDFGlyphCache::prerender(const FontData& font, const Array<GlyphCluster>& clusters, const bool isMainFont)
 	{
-		if (m_glyphTable.empty())
+		mergeCompletedGlyphs(font, false);
+
+		// 前回の実行で書き込んだキャッシュファイルがあれば、グリフを生成せずに使う
+		if (not m_cacheFileOpened)
 		{
-			const SDFGlyph glyph = font.renderSDFByGlyphIndex(0, m_buffer.bufferWidth);
+			m_cacheFileOpened = true;
 
-			if (not CacheGlyph(font, glyph.image, glyph, m_buffer, m_glyphTable))
+			if (const auto key = GlyphAtlas::MakeFileKey(font, m_bufferWidth))
 			{
-				return false;
+				if (not m_atlas.load(font, *key))
+				{
+					// do nothing
+				}
 			}
+		}
+
+		if (m_atlas.empty())
+		{
+			const SDFGlyph glyph = font.renderSDFByGlyphIndex(0, m_bufferWidth);
 
-			m_hasDirty = true;
+			if (not m_atlas.add(font, glyph.image, glyph))
+			{
+				return false;
+			}
 		}
 
 		for (const auto& cluster : clusters)
@@ -534,51 +633,68 @@ namespace s3d
 				continue;
 			}
 
-			if (m_glyphTable.contains(cluster.glyphIndex))
+			if (m_atlas.touch(cluster.glyphIndex))
 			{
 				continue;
 			}
 
-			const SDFGlyph glyph = font.renderSDFByGlyphIndex(cluster.glyphIndex, m_buffer.bufferWidth);
+			const SDFGlyph glyph = font.renderSDFByGlyphIndex(cluster.glyphIndex, m_bufferWidth);
 
-			if (m_glyphTable.contains(glyph.glyphIndex))
+			if (m_atlas.touch(glyph.glyphIndex))
 			{
 				continue;
 			}
 
-			if (not CacheGlyph(font, glyph.image, glyph, m_buffer, m_glyphTable))
+			if (not m_atlas.add(font, glyph.image, glyph))
 			{
 				return false;
 			}
-
-			m_hasDirty = true;
 		}
 
 		// texture content can be updated in a different thread
 		if (System::GetRendererType() == EngineOption::Renderer::Direct3D11)
 		{
-			updateTexture();
+			m_atlas.update();
 		}
 
 		return true;
 	}
 
-	void SDFGlyphCache::updateTexture()
+	void SDFGlyphCache::mergeCompletedGlyphs(const FontData& font, const bool force)
 	{
-		if (not m_hasDirty)
+		if (not m_jobs.hasCompleted())
 		{
 			return;
 		}
 
-		if (m_texture.size() == m_buffer.image.size())
+		// 生成が完了したグリフは、各フレームの最初の描画の前にまとめて追加する
+		if (const uint64 currentFrame = GlyphAtlas::GetCurrentFrame();
+			force || (m_mergedFrame != currentFrame))
 		{
-			m_texture.fill(m_buffer.image);
+			m_mergedFrame = currentFrame;
 		}
 		else
 		{
-			m_texture = DynamicTexture{ m_buffer.image };
+			return;
+		}
+
+		for (const auto& result : m_jobs.takeCompleted())
+		{
+			if (m_atlas.isPlaceholder(result.info.glyphIndex))
+			{
+				// ページ数が上限に達している場合は、次に必要になったときに改めて生成する
+				if (not m_atlas.add(font, result.image, result.info))
+				{
+					m_atlas.removePlaceholder(result.info.glyphIndex);
+				}
+			}
 		}
+	}
+
+	void SDFGlyphCache::finishPendingGlyphs(const FontData& font)
+	{
+		m_jobs.wait();
 
-		m_hasDirty = false;
+		mergeCompletedGlyphs(font, true);
 	}
 }
@@ -15,6 +15,8 @@
 # include <Siv3D/HashTable.hpp>
 # include "IGlyphCache.hpp"
 # include "GlyphCacheCommon.hpp"
+# include "GlyphAtlas.hpp"
+# include "GlyphJobQueue.hpp"
 
 namespace s3d
 {
@@ -48,8 +50,15 @@ namespace s3d
 		[[nodiscard]]
 		int32 getBufferWidth() const noexcept override;
 
+		void setMemoryBudget(size_t bytes) override;
+
+		[[nodiscard]]
+		size_t getMemoryBudget() const noexcept override;
+
 		bool preload(const FontData& font, StringView s) override;
 
+		bool preloadAsync(const FontData& font, StringView s) override;
+
 		[[nodiscard]]
 		const Texture& getTexture() noexcept override;
 
@@ -59,19 +68,32 @@ namespace s3d
 		[[nodiscard]]
 		int32 getBufferThickness(GlyphIndex glyphIndex) override;
 
+		bool prepare(const FontData& font, StringView s, const Array<GlyphCluster>& clusters, size_t firstCluster, PreparedTextLayout& layout) override;
+
+		RectF drawPrepared(const FontData& font, StringView s, const Array<GlyphCluster>& clusters, PreparedTextLayout& layout, const Vec2& pos, double size, const TextStyle& textStyle, const ColorF& color) override;
+
+		bool saveCacheFile(const FontData& font) override;
+
 	private:
 
-		HashTable<GlyphIndex, GlyphCache> m_glyphTable;
+		GlyphAtlas m_atlas{ Color{ 255, 0 } };
+
+		int32 m_bufferWidth = 2;
 
-		DynamicTexture m_texture;
+		GlyphJobQueue m_jobs;
 
-		bool m_hasDirty = false;
+		// 生成が完了したグリフを最後に追加したフレーム
+		uint64 m_mergedFrame = Largest<uint64>;
+
+		// キャッシュファイルの読み込みを試みたか
+		bool m_cacheFileOpened = false;
 
-		BufferImage m_buffer = {};
-	
 		[[nodiscard]]
 		bool prerender(const FontData& font, const Array<GlyphCluster>& clusters, bool isMainFont);
 
-		void updateTexture();
+		void mergeCompletedGlyphs(const FontData& font, bool force);
+
+		/// @brief 生成中のグリフをすべて待って追加します。
+		void finishPendingGlyphs(const FontData& font);
 	};
 }
@@ -139,7 +139,20 @@ namespace s3d
 		}
 	}
 
-	MSDFGlyph RenderMSDFGlyph(FT_Face face, const GlyphIndex glyphIndex, int32 buffer, const FontFaceProperty& prop)
+	MSDFGlyph RenderMSDFGlyph(FT_Face face, const GlyphIndex glyphIndex, const int32 buffer, const FontFaceProperty& prop)
+	{
+		auto [result, generator] = PrepareMSDFGlyph(face, glyphIndex, buffer, prop);
+
+		if (not generator)
+		{
+			return{};
+		}
+
+		result.image = generator();
+		return result;
+	}
+
+	std::pair<MSDFGlyph, std::function<Image()>> PrepareMSDFGlyph(FT_Face face, const GlyphIndex glyphIndex, int32 buffer, const FontFaceProperty& prop)
 	{
 		if (not LoadOutlineGlyph(face, glyphIndex, prop.style))
 		{
@@ -148,20 +161,17 @@ namespace s3d
 
 		buffer = Max(buffer, 0);
 
-		msdfgen::Shape shape;
-		if (not detail::GetShape(face, shape))
+		auto shape = std::make_shared<msdfgen::Shape>();
+		if (not detail::GetShape(face, *shape))
 		{
 			return{};
 		}
 
-		const GlyphBBox bbox	= detail::GetBound(shape);
+		const GlyphBBox bbox	= detail::GetBound(*shape);
 		const int32 width		= static_cast<int32>(bbox.xMax - bbox.xMin);
 		const int32 height		= static_cast<int32>(bbox.yMax - bbox.yMin);
 		const Vec2 offset{ (-bbox.xMin+ buffer), (-bbox.yMin + buffer) };
 
-		msdfgen::Bitmap<float, 3> bitmap{ (width + (2 * buffer)), (height + (2 * buffer)) };
-		msdfgen::generateMSDF(bitmap, shape, 4.0, 1.0, msdfgen::Vector2(offset.x, offset.y));
-
 		MSDFGlyph result;
 		result.glyphIndex	= glyphIndex;
 		result.buffer		= buffer;
@@ -173,7 +183,15 @@ namespace s3d
 		result.yAdvance		= (face->glyph->metrics.vertAdvance / 64.0);
 		result.ascender		= prop.ascender;
 		result.descender	= prop.descender;
-		result.image		= detail::RenderMSDF(bitmap);
-		return result;
+
+		// 画像の生成には FT_Face を使わず、読み込んだ輪郭だけを使う
+		auto generator = [shape, bitmapSize = Size{ (width + (2 * buffer)), (height + (2 * buffer)) }, offset]()
+		{
+			msdfgen::Bitmap<float, 3> bitmap{ bitmapSize.x, bitmapSize.y };
+			msdfgen::generateMSDF(bitmap, *shape, 4.0, 1.0, msdfgen::Vector2(offset.x, offset.y));
+			return detail::RenderMSDF(bitmap);
+		};
+
+		return{ result, generator };
 	}
 }
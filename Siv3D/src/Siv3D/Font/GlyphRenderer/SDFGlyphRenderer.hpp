@@ -10,6 +10,7 @@
 //-----------------------------------------------
 
 # pragma once
+# include <functional>
 # include <Siv3D/Common.hpp>
 # include <Siv3D/SDFGlyph.hpp>
 
@@ -22,4 +23,10 @@ namespace s3d
 
 	[[nodiscard]]
 	SDFGlyph RenderSDFGlyph(FT_Face face, GlyphIndex glyphIndex, int32 buffer, const FontFaceProperty& prop);
+
+	/// @brief グリフの輪郭を読み込み、画像以外の情報を設定したグリフと、画像を生成する関数を返します。
+	/// @remark 返される関数は FT_Face を使わないため、別のスレッドで実行できます。
+	/// @return 画像以外の情報を設定したグリフと、画像を生成する関数。輪郭を読み込めなかった場合、関数は空です。
+	[[nodiscard]]
+	std::pair<SDFGlyph, std::function<Image()>> PrepareSDFGlyph(FT_Face face, GlyphIndex glyphIndex, int32 buffer, const FontFaceProperty& prop);
 }
@@ -0,0 +1,125 @@
+﻿//-----------------------------------------------
+//
+//	This file is part of the Siv3D Engine.
+//
+//	Copyright (c) 2008-2022 Ryo Suzuki
+//	Copyright (c) 2016-2022 OpenSiv3D Project
+//
+//	Licensed under the MIT License.
+//
+//-----------------------------------------------
+
+# include <iterator>
+# include <utility>
+# include "GlyphShapingCache.hpp"
+
+namespace s3d
+{
+	GlyphShapingCache::GlyphShapingCache(const size_t capacity)
+		: m_capacity{ capacity } {}
+
+	GlyphShapingCache::ClustersPtr GlyphShapingCache::find(const StringView s, const bool recursive, const Ligature ligature, const uint64 fallbackState)
+	{
+		if (MaxTextLength < s.size())
+		{
+			return nullptr;
+		}
+
+		const uint64 key = MakeKey(s, recursive, ligature);
+
+		std::lock_guard lock{ m_mutex };
+
+		auto it = m_table.find(key);
+
+		if (it == m_table.end())
+		{
+			++m_stat.misses;
+			return nullptr;
+		}
+
+		const Entry& entry = *(it->second);
+
+		// ハッシュの衝突や、フォールバックフォントの変化に備えて確認する
+		if ((entry.text != s)
+			|| (entry.recursive != recursive)
+			|| (entry.ligature != ligature.getBool())
+			|| (entry.fallbackState != fallbackState))
+		{
+			++m_stat.misses;
+			return nullptr;
+		}
+
+		m_entries.splice(m_entries.begin(), m_entries, it->second);
+
+		++m_stat.hits;
+		return entry.clusters;
+	}
+
+	void GlyphShapingCache::insert(const StringView s, const bool recursive, const Ligature ligature, const uint64 fallbackState, const ClustersPtr& clusters)
+	{
+		if ((MaxTextLength < s.size()) || (m_capacity == 0))
+		{
+			return;
+		}
+
+		const uint64 key = MakeKey(s, recursive, ligature);
+
+		std::lock_guard lock{ m_mutex };
+
+		if (auto it = m_table.find(key);
+			it != m_table.end())
+		{
+			Entry& entry = *(it->second);
+			entry.text.assign(s);
+			entry.fallbackState = fallbackState;
+			entry.recursive = recursive;
+			entry.ligature = ligature.getBool();
+			entry.clusters = clusters;
+			m_entries.splice(m_entries.begin(), m_entries, it->second);
+			return;
+		}
+
+		if (m_capacity <= m_entries.size())
+		{
+			// 最も長く使われていない要素を再利用する
+			m_table.erase(m_entries.back().key);
+			m_entries.splice(m_entries.begin(), m_entries, std::prev(m_entries.end()));
+		}
+		else
+		{
+			m_entries.emplace_front();
+		}
+
+		Entry& entry = m_entries.front();
+		entry.key = key;
+		entry.text.assign(s);
+		entry.fallbackState = fallbackState;
+		entry.recursive = recursive;
+		entry.ligature = ligature.getBool();
+		entry.clusters = clusters;
+
+		m_table.emplace(key, m_entries.begin());
+	}
+
+	void GlyphShapingCache::clear()
+	{
+		std::lock_guard lock{ m_mutex };
+
+		m_entries.clear();
+		m_table.clear();
+	}
+
+	GlyphShapingCacheStat GlyphShapingCache::takeStat()
+	{
+		std::lock_guard lock{ m_mutex };
+
+		return std::exchange(m_stat, GlyphShapingCacheStat{});
+	}
+
+	uint64 GlyphShapingCache::MakeKey(const StringView s, const bool recursive, const Ligature ligature) noexcept
+	{
+		const uint64 flags = ((static_cast<uint64>(recursive) << 1) | static_cast<uint64>(ligature.getBool()));
+
+		return (s.hash() ^ (flags * 0x9E3779B97F4A7C15ull));
+	}
+}
@@ -0,0 +1,98 @@
+﻿//-----------------------------------------------
+//
+//	This file is part of the Siv3D Engine.
+//
+//	Copyright (c) 2008-2022 Ryo Suzuki
+//	Copyright (c) 2016-2022 OpenSiv3D Project
+//
+//	Licensed under the MIT License.
+//
+//-----------------------------------------------
+
+# pragma once
+# include <list>
+# include <mutex>
+# include <memory>
+# include <Siv3D/Common.hpp>
+# include <Siv3D/String.hpp>
+# include <Siv3D/Array.hpp>
+# include <Siv3D/HashTable.hpp>
+# include <Siv3D/GlyphCluster.hpp>
+# include <Siv3D/Font.hpp>
+
+namespace s3d
+{
+	struct GlyphShapingCacheStat
+	{
+		uint64 hits = 0;
+
+		uint64 misses = 0;
+	};
+
+	/// @brief シェーピング結果 (GlyphCluster の配列) を文字列ごとに保持する LRU キャッシュ
+	/// @remark 同じ文字列を毎フレーム描く場合に、HarfBuzz によるシェーピングを省略します。
+	class GlyphShapingCache
+	{
+	public:
+
+		using ClustersPtr = std::shared_ptr<const Array<GlyphCluster>>;
+
+		/// @brief キャッシュする文字列の最大の長さ
+		static constexpr size_t MaxTextLength = 4096;
+
+		/// @param capacity キャッシュする文字列の最大数
+		explicit GlyphShapingCache(size_t capacity = 256);
+
+		/// @brief キャッシュされたシェーピング結果を返します。
+		/// @param s 文字列
+		/// @param recursive フォールバックフォントを使うか
+		/// @param ligature リガチャを有効にするか
+		/// @param fallbackState フォールバックフォントの状態。変化した場合は以前の結果を使いません。
+		/// @return キャッシュされたシェーピング結果。無い場合は nullptr
+		[[nodiscard]]
+		ClustersPtr find(StringView s, bool recursive, Ligature ligature, uint64 fallbackState);
+
+		/// @brief シェーピング結果をキャッシュに追加します。
+		void insert(StringView s, bool recursive, Ligature ligature, uint64 fallbackState, const ClustersPtr& clusters);
+
+		/// @brief キャッシュを空にします。
+		void clear();
+
+		/// @brief ヒット数とミス数を返し、0 にリセットします。
+		[[nodiscard]]
+		GlyphShapingCacheStat takeStat();
+
+	private:
+
+		struct Entry
+		{
+			uint64 key = 0;
+
+			String text;
+
+			uint64 fallbackState = 0;
+
+			bool recursive = false;
+
+			bool ligature = true;
+
+			ClustersPtr clusters;
+		};
+
+		using EntryList = std::list<Entry>;
+
+		std::mutex m_mutex;
+
+		// 先頭ほど最近使われた要素
+		EntryList m_entries;
+
+		HashTable<uint64, EntryList::iterator> m_table;
+
+		size_t m_capacity = 0;
+
+		GlyphShapingCacheStat m_stat;
+
+		[[nodiscard]]
+		static uint64 MakeKey(StringView s, bool recursive, Ligature ligature) noexcept;
+	};
+}
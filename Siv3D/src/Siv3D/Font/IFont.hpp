@@ -15,6 +15,8 @@
 # include <Siv3D/TextStyle.hpp>
 # include <Siv3D/Icon.hpp>
 # include "FontFaceProperty.hpp"
+# include "GlyphShapingCache.hpp"
+# include "PreparedTextLayout.hpp"
 
 namespace s3d
 {
@@ -30,6 +32,12 @@ namespace s3d
 
 		virtual size_t getFontCount() const = 0;
 
+		/// @brief すべてのフォントのシェーピングキャッシュのヒット数とミス数の合計を返し、0 にリセットします。
+		virtual GlyphShapingCacheStat takeShapingCacheStat() = 0;
+
+		/// @brief ワーカースレッドで生成中のグリフの数を返します。
+		virtual size_t getPendingGlyphCount() const = 0;
+
 		virtual Font::IDType create(FilePathView path, size_t faceIndex, FontMethod fontMethod, int32 fontSize, FontStyle style) = 0;
 
 		virtual Font::IDType create(Typeface typeface, FontMethod fontMethod, int32 fontSize, FontStyle style) = 0;
@@ -48,6 +56,10 @@ namespace s3d
 
 		virtual int32 getBufferThickness(Font::IDType handleID) = 0;
 
+		virtual void setGlyphCacheMemoryBudget(Font::IDType handleID, size_t bytes) = 0;
+
+		virtual size_t getGlyphCacheMemoryBudget(Font::IDType handleID) = 0;
+
 		virtual bool hasGlyph(Font::IDType handleID, StringView ch) = 0;
 
 		virtual GlyphIndex getGlyphIndex(Font::IDType handleID, StringView ch) = 0;
@@ -84,6 +96,10 @@ namespace s3d
 
 		virtual bool preload(Font::IDType handleID, StringView chars) = 0;
 
+		virtual bool preloadAsync(Font::IDType handleID, StringView chars) = 0;
+
+		virtual bool saveGlyphCache(Font::IDType handleID) = 0;
+
 		virtual const Texture& getTexture(Font::IDType handleID) = 0;
 
 		virtual Glyph getGlyph(Font::IDType handleID, StringView ch) = 0;
@@ -112,6 +128,13 @@ namespace s3d
 	
 		virtual double xAdvanceFallback(Font::IDType handleID, const GlyphCluster& cluster, double fontSize) = 0;
 
+		/// @brief テキストのグリフをキャッシュし、フォントの基本サイズで配置します。
+		/// @param firstCluster 配置をやり直す最初のクラスタ。それより前のクラスタは以前の配置を再利用します。
+		virtual bool prepare(Font::IDType handleID, StringView s, const Array<GlyphCluster>& clusters, size_t firstCluster, PreparedTextLayout& layout) = 0;
+
+		/// @brief prepare() で配置したテキストを描画します。
+		virtual RectF drawPrepared(Font::IDType handleID, StringView s, const Array<GlyphCluster>& clusters, PreparedTextLayout& layout, const Vec2& pos, double fontSize, const TextStyle& textStyle, const ColorF& color) = 0;
+
 
 		virtual bool hasEmoji(StringView emoji) = 0;
 
@@ -0,0 +1,191 @@
+﻿//-----------------------------------------------
+//
+//	This file is part of the Siv3D Engine.
+//
+//	Copyright (c) 2008-2022 Ryo Suzuki
+//	Copyright (c) 2016-2022 OpenSiv3D Project
+//
+//	Licensed under the MIT License.
+//
+//-----------------------------------------------
+
+# include <Siv3D/Math.hpp>
+# include <Siv3D/Font/IFont.hpp>
+# include <Siv3D/Common/Siv3DEngine.hpp>
+# include "PreparedTextLayout.hpp"
+# include "FontData.hpp"
+# include "GlyphCache/GlyphAtlas.hpp"
+
+namespace s3d
+{
+	size_t PreparedTextLayout::num_clusters() const noexcept
+	{
+		return (penStates ? (penStates.size() - 1) : 0);
+	}
+
+	double PreparedTextLayout::width() const noexcept
+	{
+		return (penStates ? penStates.back().xMax : 0.0);
+	}
+
+	int32 PreparedTextLayout::lineCount() const noexcept
+	{
+		return (penStates ? penStates.back().lineCount : 1);
+	}
+
+	size_t PreparedTextLayout::memoryUsage() const noexcept
+	{
+		return ((glyphs.capacity() * sizeof(PreparedGlyph))
+			+ (penStates.capacity() * sizeof(PreparedPenState))
+			+ (pages.capacity() * sizeof(uint16)));
+	}
+
+	void PreparedTextLayout::clear()
+	{
+		glyphs.clear();
+		penStates.clear();
+		pages.clear();
+		generation = Largest<uint64>;
+		firstRelayoutCluster = 0;
+	}
+
+	void LayoutPreparedText(const FontData& font, const GlyphAtlas& atlas, const StringView s, const Array<GlyphCluster>& clusters, size_t firstCluster, PreparedTextLayout& layout)
+	{
+		if (layout.generation != atlas.getGeneration())
+		{
+			// 以前のテクスチャ領域は使えない
+			firstCluster = 0;
+		}
+
+		firstCluster = Min({ firstCluster, layout.num_clusters(), clusters.size() });
+		layout.firstRelayoutCluster = firstCluster;
+
+		PreparedPenState state;
+
+		if (firstCluster != 0)
+		{
+			state = layout.penStates[firstCluster];
+		}
+
+		layout.glyphs.resize(state.glyphOffset);
+		layout.penStates.resize(firstCluster);
+		layout.penStates.reserve(clusters.size() + 1);
+
+		const auto& prop = font.getProperty();
+		const Vec2 basePos{ 0, 0 };
+		Vec2 penPos{ state.penPos };
+		int32 lineCount = state.lineCount;
+		double xMax = state.xMax;
+
+		for (size_t i = firstCluster; i < clusters.size(); ++i)
+		{
+			const auto& cluster = clusters[i];
+			layout.penStates.push_back({ Float2{ penPos }, static_cast<float>(xMax), lineCount, static_cast<uint32>(layout.glyphs.size()) });
+
+			if (ProcessControlCharacter(s[cluster.pos], penPos, lineCount, basePos, 1.0, 1.0, prop))
+			{
+				xMax = Max(xMax, penPos.x);
+				continue;
+			}
+
+			if (cluster.fontIndex != 0)
+			{
+				// フォールバックフォントのグリフは、描画のたびにフォールバックフォントで描く
+				const auto fallbackFont = font.getFallbackFont(cluster.fontIndex - 1).lock();
+
+				PreparedGlyph glyph;
+				glyph.offset		= Float2{ penPos.movedBy(0, prop.ascender) };
+				glyph.clusterIndex	= static_cast<uint32>(i);
+				glyph.fontIndex		= static_cast<uint16>(cluster.fontIndex);
+				layout.glyphs << glyph;
+
+				penPos.x += SIV3D_ENGINE(Font)->xAdvanceFallback(fallbackFont->id(), cluster, prop.fontPixelSize);
+				xMax = Max(xMax, penPos.x);
+				continue;
+			}
+
+			const GlyphCache* cache = atlas.find(cluster.glyphIndex);
+
+			if (not cache)
+			{
+				continue;
+			}
+
+			// 画像の無いグリフは描かない
+			if ((cache->page != GlyphAtlas::PlaceholderPage)
+				&& (cache->textureRegionWidth != 0)
+				&& (cache->textureRegionHeight != 0))
+			{
+				PreparedGlyph glyph;
+				glyph.textureRegion	= atlas.getTextureRegion(*cache);
+				glyph.offset		= Float2{ penPos + cache->info.getOffset() };
+				glyph.clusterIndex	= static_cast<uint32>(i);
+				glyph.page			= cache->page;
+				layout.glyphs << glyph;
+			}
+
+			penPos.x += cache->info.xAdvance;
+			xMax = Max(xMax, penPos.x);
+		}
+
+		layout.penStates.push_back({ Float2{ penPos }, static_cast<float>(xMax), lineCount, static_cast<uint32>(layout.glyphs.size()) });
+
+		layout.pages.clear();
+
+		for (const auto& glyph : layout.glyphs)
+		{
+			if ((glyph.fontIndex == 0) && (not layout.pages.includes(glyph.page)))
+			{
+				layout.pages << glyph.page;
+			}
+		}
+
+		layout.generation = atlas.getGeneration();
+	}
+
+	RectF DrawPreparedText(const FontData& font, GlyphAtlas& atlas, const Array<GlyphCluster>& clusters, const PreparedTextLayout& layout, const Vec2& pos, const double size, const TextStyle& textStyle, const ColorF& color, const bool pixelAligned)
+	{
+		// グリフごとではなく、ページごとに使用中にする
+		for (const auto& page : layout.pages)
+		{
+			atlas.touchPage(page);
+		}
+
+		const auto& prop = font.getProperty();
+		const double scale = (size / prop.fontPixelSize);
+		const bool noScaling = (size == prop.fontPixelSize);
+
+		for (const auto& glyph : layout.glyphs)
+		{
+			const Vec2 drawPos = pos.movedBy((glyph.offset.x * scale), (glyph.offset.y * scale));
+
+			if (glyph.fontIndex != 0)
+			{
+				const auto fallbackFont = font.getFallbackFont(glyph.fontIndex - 1).lock();
+				SIV3D_ENGINE(Font)->drawBaseFallback(fallbackFont->id(), clusters[glyph.clusterIndex], drawPos, size, textStyle, color, 1.0);
+				continue;
+			}
+
+			if (noScaling)
+			{
+				glyph.textureRegion
+					.draw((pixelAligned ? Math::Round(drawPos) : drawPos), color);
+			}
+			else
+			{
+				glyph.textureRegion
+					.scaled(scale)
+					.draw(drawPos, color);
+			}
+		}
+
+		return GetPreparedTextRegion(font, layout, pos, size);
+	}
+
+	RectF GetPreparedTextRegion(const FontData& font, const PreparedTextLayout& layout, const Vec2& pos, const double size)
+	{
+		const auto& prop = font.getProperty();
+		const double scale = (size / prop.fontPixelSize);
+		return{ pos, (layout.width() * scale), (layout.lineCount() * prop.height() * scale) };
+	}
+}
@@ -0,0 +1,121 @@
+﻿//-----------------------------------------------
+//
+//	This file is part of the Siv3D Engine.
+//
+//	Copyright (c) 2008-2022 Ryo Suzuki
+//	Copyright (c) 2016-2022 OpenSiv3D Project
+//
+//	Licensed under the MIT License.
+//
+//-----------------------------------------------
+
+# pragma once
+# include <Siv3D/Common.hpp>
+# include <Siv3D/Array.hpp>
+# include <Siv3D/PointVector.hpp>
+# include <Siv3D/2DShapes.hpp>
+# include <Siv3D/TextureRegion.hpp>
+# include <Siv3D/GlyphCluster.hpp>
+# include <Siv3D/TextStyle.hpp>
+
+namespace s3d
+{
+	class FontData;
+	class GlyphAtlas;
+
+	/// @brief 配置済みのグリフ
+	struct PreparedGlyph
+	{
+		/// @brief グリフのテクスチャ領域（フォントの基本サイズ）
+		TextureRegion textureRegion;
+
+		/// @brief フォントの基本サイズで、テキストの左上を原点としたときの描画位置
+		/// @remark フォールバックフォントのグリフの場合はベースラインの位置
+		Float2 offset{ 0, 0 };
+
+		/// @brief グリフのクラスタの番号
+		uint32 clusterIndex = 0;
+
+		/// @brief 0 の場合はメインのフォント、それ以外の場合はフォールバックフォントの番号 + 1
+		uint16 fontIndex = 0;
+
+		/// @brief グリフを格納しているアトラスのページ
+		uint16 page = 0;
+	};
+
+	/// @brief クラスタを配置する直前のペンの状態
+	struct PreparedPenState
+	{
+		Float2 penPos{ 0, 0 };
+
+		float xMax = 0.0f;
+
+		int32 lineCount = 1;
+
+		/// @brief このクラスタ以降のグリフが始まる、PreparedTextLayout::glyphs の位置
+		uint32 glyphOffset = 0;
+	};
+
+	/// @brief フォントの基本サイズで配置したテキストのレイアウト
+	/// @remark テクスチャ領域はアトラスの世代が変わると無効になり、作り直しが必要です。
+	struct PreparedTextLayout
+	{
+		Array<PreparedGlyph> glyphs;
+
+		/// @brief 各クラスタの直前と、最後のクラスタの直後のペンの状態（クラスタ数 + 1 個）
+		Array<PreparedPenState> penStates;
+
+		/// @brief グリフが使用するアトラスのページ
+		Array<uint16> pages;
+
+		/// @brief テクスチャ領域を取得したときのアトラスの世代
+		uint64 generation = Largest<uint64>;
+
+		/// @brief 直前の配置で、配置をやり直した最初のクラスタ
+		size_t firstRelayoutCluster = 0;
+
+		[[nodiscard]]
+		size_t num_clusters() const noexcept;
+
+		/// @brief 配置が完了したテキストの幅（フォントの基本サイズ）を返します。
+		[[nodiscard]]
+		double width() const noexcept;
+
+		/// @brief 配置が完了したテキストの行数を返します。
+		[[nodiscard]]
+		int32 lineCount() const noexcept;
+
+		/// @brief レイアウトが使用しているメモリ（バイト）を返します。
+		[[nodiscard]]
+		size_t memoryUsage() const noexcept;
+
+		void clear();
+	};
+
+	/// @brief テキストのクラスタを配置します。
+	/// @param font フォント
+	/// @param atlas クラスタのグリフがすべてキャッシュされたアトラス
+	/// @param s テキスト
+	/// @param clusters テキストのクラスタ
+	/// @param firstCluster 配置をやり直す最初のクラスタ。それより前のクラスタは以前の配置を再利用します。
+	/// @param layout レイアウト
+	/// @remark アトラスの世代が変わっている場合は、すべてのクラスタを配置し直します。
+	void LayoutPreparedText(const FontData& font, const GlyphAtlas& atlas, StringView s, const Array<GlyphCluster>& clusters, size_t firstCluster, PreparedTextLayout& layout);
+
+	/// @brief 配置済みのテキストを描画します。
+	/// @param font フォント
+	/// @param atlas レイアウトを作成したアトラス
+	/// @param clusters テキストのクラスタ
+	/// @param layout レイアウト
+	/// @param pos 描画する左上の座標
+	/// @param size フォントのサイズ
+	/// @param textStyle テキストスタイル
+	/// @param color 色
+	/// @param pixelAligned 基本サイズで描く場合に、描画位置を整数に丸めるか
+	/// @return テキストが描画された領域
+	RectF DrawPreparedText(const FontData& font, GlyphAtlas& atlas, const Array<GlyphCluster>& clusters, const PreparedTextLayout& layout, const Vec2& pos, double size, const TextStyle& textStyle, const ColorF& color, bool pixelAligned);
+
+	/// @brief 配置済みのテキストが描画される領域を返します。
+	[[nodiscard]]
+	RectF GetPreparedTextRegion(const FontData& font, const PreparedTextLayout& layout, const Vec2& pos, double size);
+}
@@ -230,6 +230,18 @@ namespace s3d
 		return SIV3D_ENGINE(Font)->getBufferThickness(m_handle->id());
 	}
 
+	const Font& Font::setGlyphCacheMemoryBudget(const size_t bytes) const
+	{
+		SIV3D_ENGINE(Font)->setGlyphCacheMemoryBudget(m_handle->id(), bytes);
+
+		return *this;
+	}
+
+	size_t Font::getGlyphCacheMemoryBudget() const
+	{
+		return SIV3D_ENGINE(Font)->getGlyphCacheMemoryBudget(m_handle->id());
+	}
+
 	bool Font::hasGlyph(const char32 ch) const
 	{
 		return SIV3D_ENGINE(Font)->hasGlyph(m_handle->id(), StringView(&ch, 1));
@@ -393,6 +405,16 @@ namespace s3d
 		return SIV3D_ENGINE(Font)->preload(m_handle->id(), chars);
 	}
 
+	bool Font::preloadAsync(const StringView chars) const
+	{
+		return SIV3D_ENGINE(Font)->preloadAsync(m_handle->id(), chars);
+	}
+
+	bool Font::saveGlyphCache() const
+	{
+		return SIV3D_ENGINE(Font)->saveGlyphCache(m_handle->id());
+	}
+
 	const Texture& Font::getTexture() const
 	{
 		return SIV3D_ENGINE(Font)->getTexture(m_handle->id());
@@ -672,14 +672,14 @@ namespace s3d
 		}
 	}
 
-	bool Image::savePNG(const FilePathView path, const PNGFilter filter) const
+	bool Image::savePNG(const FilePathView path, const PNGFilter filter, const PNGCompression compression) const
 	{
-		return PNGEncoder{}.save(*this, path, filter);
+		return PNGEncoder{}.save(*this, path, filter, compression);
 	}
 
-	Blob Image::encodePNG(const PNGFilter filter) const
+	Blob Image::encodePNG(const PNGFilter filter, const PNGCompression compression) const
 	{
-		return PNGEncoder{}.encode(*this, filter);
+		return PNGEncoder{}.encode(*this, filter, compression);
 	}
 
 	bool Image::saveJPEG(const FilePathView path, const int32 quality) const
@@ -110,6 +110,48 @@ namespace s3d
 		return (*it)->decodeGray16(reader, pathHint);
 	}
 
+	Image CImageDecoder::decodeScaled(IReader& reader, const Size& targetSize, const FilePathView pathHint, const ImageFormat imageFormat)
+	{
+		LOG_SCOPED_TRACE(U"CImageDecoder::decodeScaled()");
+
+		auto it = findDecoder(imageFormat);
+
+		if (it == m_decoders.end())
+		{
+			it = findDecoder(reader, pathHint);
+
+			if (it == m_decoders.end())
+			{
+				return{};
+			}
+		}
+
+		LOG_TRACE(U"Image decoder name: {}"_fmt((*it)->name()));
+
+		return (*it)->decodeScaled(reader, targetSize, pathHint);
+	}
+
+	Image CImageDecoder::decodeRegion(IReader& reader, const Rect& region, const FilePathView pathHint, const ImageFormat imageFormat)
+	{
+		LOG_SCOPED_TRACE(U"CImageDecoder::decodeRegion()");
+
+		auto it = findDecoder(imageFormat);
+
+		if (it == m_decoders.end())
+		{
+			it = findDecoder(reader, pathHint);
+
+			if (it == m_decoders.end())
+			{
+				return{};
+			}
+		}
+
+		LOG_TRACE(U"Image decoder name: {}"_fmt((*it)->name()));
+
+		return (*it)->decodeRegion(reader, region, pathHint);
+	}
+
 	bool CImageDecoder::add(std::unique_ptr<IImageDecoder>&& decoder)
 	{
 		const StringView name = decoder->name();
@@ -41,6 +41,10 @@ namespace s3d
 
 		Grid<uint16> decodeGray16(IReader& reader, FilePathView pathHint, ImageFormat imageFormat) override;
 
+		Image decodeScaled(IReader& reader, const Size& targetSize, FilePathView pathHint, ImageFormat imageFormat) override;
+
+		Image decodeRegion(IReader& reader, const Rect& region, FilePathView pathHint, ImageFormat imageFormat) override;
+
 		bool add(std::unique_ptr<IImageDecoder>&& decoder) override;
 
 		void remove(StringView name) override;
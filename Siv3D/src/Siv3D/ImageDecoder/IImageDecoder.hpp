@@ -35,6 +35,10 @@ namespace s3d
 
 		virtual Grid<uint16> decodeGray16(IReader& reader, FilePathView pathHint, ImageFormat imageFormat) = 0;
 
+		virtual Image decodeScaled(IReader& reader, const Size& targetSize, FilePathView pathHint, ImageFormat imageFormat) = 0;
+
+		virtual Image decodeRegion(IReader& reader, const Rect& region, FilePathView pathHint, ImageFormat imageFormat) = 0;
+
 		virtual bool add(std::unique_ptr<IImageDecoder>&& decoder) = 0;
 
 		virtual void remove(StringView name) = 0;
@@ -74,6 +74,48 @@ namespace s3d
 			return SIV3D_ENGINE(ImageDecoder)->decodeGray16(reader, {}, imageFormat);
 		}
 
+		Image DecodeScaled(const FilePathView path, const Size& targetSize, const ImageFormat imageFormat)
+		{
+		# if SIV3D_PLATFORM(WEB)
+			Platform::Web::FetchFile(path);
+		# endif
+
+			BinaryReader reader(path);
+
+			if (not reader)
+			{
+				return{};
+			}
+
+			return SIV3D_ENGINE(ImageDecoder)->decodeScaled(reader, targetSize, path, imageFormat);
+		}
+
+		Image DecodeScaled(IReader& reader, const Size& targetSize, const ImageFormat imageFormat)
+		{
+			return SIV3D_ENGINE(ImageDecoder)->decodeScaled(reader, targetSize, {}, imageFormat);
+		}
+
+		Image DecodeRegion(const FilePathView path, const Rect& region, const ImageFormat imageFormat)
+		{
+		# if SIV3D_PLATFORM(WEB)
+			Platform::Web::FetchFile(path);
+		# endif
+
+			BinaryReader reader(path);
+
+			if (not reader)
+			{
+				return{};
+			}
+
+			return SIV3D_ENGINE(ImageDecoder)->decodeRegion(reader, region, path, imageFormat);
+		}
+
+		Image DecodeRegion(IReader& reader, const Rect& region, const ImageFormat imageFormat)
+		{
+			return SIV3D_ENGINE(ImageDecoder)->decodeRegion(reader, region, {}, imageFormat);
+		}
+
 		bool Add(std::unique_ptr<IImageDecoder>&& decoder)
 		{
 			return SIV3D_ENGINE(ImageDecoder)->add(std::move(decoder));
@@ -11,6 +11,8 @@
 
 # include <Siv3D/ImageFormat/JPEGDecoder.hpp>
 # include <Siv3D/EngineLog.hpp>
+# include <Siv3D/ScopeGuard.hpp>
+# include <Siv3D/Unicode.hpp>
 
 # if SIV3D_PLATFORM(WINDOWS) | SIV3D_PLATFORM(MACOS) | SIV3D_PLATFORM(WEB)
 #	include <ThirdParty-prebuilt/libjpeg-turbo/turbojpeg.h>
@@ -20,6 +22,34 @@
 
 namespace s3d
 {
+	namespace detail
+	{
+		[[nodiscard]]
+		static Array<uint8> ReadJPEGData(IReader& reader)
+		{
+			Array<uint8> buffer(static_cast<size_t>(reader.size()));
+
+			reader.read(buffer.data(), static_cast<int64>(buffer.size()));
+
+			return buffer;
+		}
+
+		[[nodiscard]]
+		static Image DecompressJPEG(tjhandle tj, const Array<uint8>& buffer, const Size& size)
+		{
+			Image image(size);
+
+			if (::tjDecompress2(tj, buffer.data(), static_cast<unsigned long>(buffer.size()),
+				image.dataAsUint8(), size.x, static_cast<int>(image.stride()), size.y, TJPF_RGBA, 0) != 0)
+			{
+				LOG_FAIL(U"tjDecompress2() failed: {}"_fmt(Unicode::Widen(::tjGetErrorStr2(tj))));
+				return{};
+			}
+
+			return image;
+		}
+	}
+
 	StringView JPEGDecoder::name() const
 	{
 		return U"JPEG"_sv;
@@ -157,4 +187,142 @@ namespace s3d
 
 		return image;
 	}
+
+	Image JPEGDecoder::decodeScaled(IReader& reader, const Size& targetSize, const FilePathView) const
+	{
+		LOG_SCOPED_TRACE(U"JPEGDecoder::decodeScaled()");
+
+		const Array<uint8> buffer = detail::ReadJPEGData(reader);
+
+		tjhandle tj = ::tjInitDecompress();
+
+		ScopeGuard cleanup = [&]()
+		{
+			::tjDestroy(tj);
+		};
+
+		int width, height, subsamp, colorspace;
+
+		if (::tjDecompressHeader3(tj, buffer.data(), static_cast<unsigned long>(buffer.size()), &width, &height, &subsamp, &colorspace) != 0)
+		{
+			return{};
+		}
+
+		const Size size = ScaledSize(Size{ width, height }, targetSize);
+
+		if ((size.x <= 0) || (size.y <= 0))
+		{
+			return{};
+		}
+
+		// size を下回らない、最も小さい DCT スケーリングの大きさでデコードする
+		Size decodeSize{ width, height };
+		{
+			int numScalingFactors = 0;
+			const tjscalingfactor* scalingFactors = ::tjGetScalingFactors(&numScalingFactors);
+
+			for (int i = 0; i < numScalingFactors; ++i)
+			{
+				const tjscalingfactor scalingFactor = scalingFactors[i];
+
+				if (scalingFactor.denom < scalingFactor.num)
+				{
+					continue;
+				}
+
+				const Size scaledSize{ TJSCALED(width, scalingFactor), TJSCALED(height, scalingFactor) };
+
+				if ((size.x <= scaledSize.x) && (size.y <= scaledSize.y)
+					&& (scaledSize.x < decodeSize.x))
+				{
+					decodeSize = scaledSize;
+				}
+			}
+		}
+
+		Image image = detail::DecompressJPEG(tj, buffer, decodeSize);
+
+		if (image && (image.size() != size))
+		{
+			image.scale(size, InterpolationAlgorithm::Area);
+		}
+
+		LOG_VERBOSE(U"Image ({}x{}) decoded from {}x{} at {}x{}"_fmt(
+			image.width(), image.height(), width, height, decodeSize.x, decodeSize.y));
+
+		return image;
+	}
+
+	Image JPEGDecoder::decodeRegion(IReader& reader, const Rect& region, const FilePathView) const
+	{
+		LOG_SCOPED_TRACE(U"JPEGDecoder::decodeRegion()");
+
+		const Array<uint8> buffer = detail::ReadJPEGData(reader);
+
+		// デコードとロスレス変換の両方に使える
+		tjhandle tj = ::tjInitTransform();
+
+		ScopeGuard cleanup = [&]()
+		{
+			::tjDestroy(tj);
+		};
+
+		int width, height, subsamp, colorspace;
+
+		if (::tjDecompressHeader3(tj, buffer.data(), static_cast<unsigned long>(buffer.size()), &width, &height, &subsamp, &colorspace) != 0)
+		{
+			return{};
+		}
+
+		const Rect bounds = region.getOverlap(Rect{ width, height });
+
+		if (not bounds.hasArea())
+		{
+			return{};
+		}
+
+		if ((subsamp < 0) || (TJ_NUMSAMP <= subsamp))
+		{
+			return detail::DecompressJPEG(tj, buffer, Size{ width, height }).clipped(bounds);
+		}
+
+		// 切り出しの左上は MCU ブロックの境界に揃える必要がある
+		tjtransform transform{};
+		transform.r.x		= (bounds.x / tjMCUWidth[subsamp] * tjMCUWidth[subsamp]);
+		transform.r.y		= (bounds.y / tjMCUHeight[subsamp] * tjMCUHeight[subsamp]);
+		transform.r.w		= (bounds.x + bounds.w - transform.r.x);
+		transform.r.h		= (bounds.y + bounds.h - transform.r.y);
+		transform.op		= TJXOP_NONE;
+		transform.options	= TJXOPT_CROP;
+
+		unsigned char* croppedData = nullptr;
+		unsigned long croppedSize = 0;
+
+		ScopeGuard cleanupCropped = [&]()
+		{
+			::tjFree(croppedData);
+		};
+
+		if (::tjTransform(tj, buffer.data(), static_cast<unsigned long>(buffer.size()), 1, &croppedData, &croppedSize, &transform, 0) != 0)
+		{
+			LOG_FAIL(U"tjTransform() failed: {}"_fmt(Unicode::Widen(::tjGetErrorStr2(tj))));
+			return detail::DecompressJPEG(tj, buffer, Size{ width, height }).clipped(bounds);
+		}
+
+		const Array<uint8> cropped(croppedData, (croppedData + croppedSize));
+
+		int croppedWidth, croppedHeight;
+
+		if (::tjDecompressHeader3(tj, cropped.data(), static_cast<unsigned long>(cropped.size()), &croppedWidth, &croppedHeight, &subsamp, &colorspace) != 0)
+		{
+			return{};
+		}
+
+		const Image image = detail::DecompressJPEG(tj, cropped, Size{ croppedWidth, croppedHeight });
+
+		LOG_VERBOSE(U"Image ({}x{}) decoded from {}x{}"_fmt(
+			bounds.w, bounds.h, width, height));
+
+		return image.clipped(Rect{ (bounds.x - transform.r.x), (bounds.y - transform.r.y), bounds.size });
+	}
 }
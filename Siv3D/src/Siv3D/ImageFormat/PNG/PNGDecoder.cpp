@@ -29,6 +29,183 @@ namespace s3d
 		reader->read(buf, length);
 	}
 
+	namespace detail
+	{
+		// 出力を 8-bit の RGBA にする変換を設定する
+		static void SetRGBA8Transforms(png_structp png_ptr, png_infop info_ptr, const int iBitDepth, const int iColorType)
+		{
+			if (iColorType == PNG_COLOR_TYPE_PALETTE)
+			{
+				LOG_VERBOSE(U"png_set_palette_to_rgb()");
+				::png_set_palette_to_rgb(png_ptr);
+			}
+
+			if (::png_get_valid(png_ptr, info_ptr, PNG_INFO_tRNS))
+			{
+				LOG_VERBOSE(U"png_set_tRNS_to_alpha()");
+				::png_set_tRNS_to_alpha(png_ptr);
+			}
+
+			if (iColorType == PNG_COLOR_TYPE_GRAY && iBitDepth < 8)
+			{
+				LOG_VERBOSE(U"png_set_expand_gray_1_2_4_to_8()");
+				::png_set_expand_gray_1_2_4_to_8(png_ptr);
+			}
+
+			if (iBitDepth == 16)
+			{
+				LOG_VERBOSE(U"png_set_scale_16()");
+				::png_set_scale_16(png_ptr);
+			}
+
+			if (iBitDepth < 8)
+			{
+				LOG_VERBOSE(U"png_set_packing()");
+				::png_set_packing(png_ptr);
+			}
+
+			if ((iColorType == PNG_COLOR_TYPE_GRAY)
+				|| (iColorType == PNG_COLOR_TYPE_GRAY_ALPHA))
+			{
+				LOG_VERBOSE(U"png_set_gray_to_rgb()");
+				::png_set_gray_to_rgb(png_ptr);
+			}
+
+			::png_set_add_alpha(png_ptr, 0xff, PNG_FILLER_AFTER);
+
+			double dGamma;
+
+			if (::png_get_gAMA(png_ptr, info_ptr, &dGamma))
+			{
+				LOG_VERBOSE(U"png_set_gamma()");
+				::png_set_gamma(png_ptr, 2.2, dGamma);
+			}
+		}
+
+		// 変換を設定し、読み込みの準備をする。画像の大きさを返す
+		[[nodiscard]]
+		static Size PrepareRGBA8(png_structp png_ptr, png_infop info_ptr, IReader& reader, bool& interlaced)
+		{
+			::png_set_read_fn(png_ptr, &reader, PngReadCallback);
+
+			::png_read_info(png_ptr, info_ptr);
+
+			png_uint_32 width = 0, height = 0;
+
+			int iBitDepth, iColorType, iInterlaceType;
+
+			::png_get_IHDR(png_ptr, info_ptr, &width, &height, &iBitDepth, &iColorType, &iInterlaceType, nullptr, nullptr);
+
+			if ((Image::MaxWidth < width) || (Image::MaxHeight < height))
+			{
+				LOG_FAIL(U"PNGDecoder: Image size {}x{} is not supported"_fmt(
+					width, height));
+				return{ 0, 0 };
+			}
+
+			SetRGBA8Transforms(png_ptr, info_ptr, iBitDepth, iColorType);
+
+			// インタレース PNG は行を順番に読めないため、画像全体を読む
+			interlaced = (iInterlaceType != PNG_INTERLACE_NONE);
+
+			if (interlaced)
+			{
+				::png_set_interlace_handling(png_ptr);
+			}
+
+			::png_read_update_info(png_ptr, info_ptr);
+
+			return{ static_cast<int32>(width), static_cast<int32>(height) };
+		}
+
+		[[nodiscard]]
+		static Image ReadRGBA8Image(png_structp png_ptr, const Size& size)
+		{
+			Image image(size);
+
+			Array<uint8*> ppbRowPointers(size.y);
+			{
+				for (int32 i = 0; i < size.y; ++i)
+				{
+					ppbRowPointers[i] = image.dataAsUint8() + (image.stride() * i);
+				}
+			}
+
+			::png_read_image(png_ptr, ppbRowPointers.data());
+
+			::png_read_end(png_ptr, nullptr);
+
+			return image;
+		}
+
+		// 1 行読み込むたびに factor x factor ピクセルの平均を計算する
+		[[nodiscard]]
+		static Image ReadRGBA8ImageDecimated(png_structp png_ptr, const Size& size, const int32 factor)
+		{
+			const int32 dstW = ((size.x + factor - 1) / factor);
+			const int32 dstH = ((size.y + factor - 1) / factor);
+
+			Image image(dstW, dstH);
+			Array<uint8> row(size.x * 4);
+			Array<uint32> sums(dstW * 4, 0);
+
+			for (int32 y = 0; y < size.y; ++y)
+			{
+				::png_read_row(png_ptr, row.data(), nullptr);
+
+				{
+					const uint8* pSrc = row.data();
+					uint32* pSum = sums.data();
+
+					for (int32 x = 0; x < size.x; x += factor)
+					{
+						const int32 xEnd = Min((x + factor), size.x);
+
+						for (int32 sx = x; sx < xEnd; ++sx)
+						{
+							pSum[0] += pSrc[0];
+							pSum[1] += pSrc[1];
+							pSum[2] += pSrc[2];
+							pSum[3] += pSrc[3];
+							pSrc += 4;
+						}
+
+						pSum += 4;
+					}
+				}
+
+				const int32 rows = ((y % factor) + 1);
+
+				if ((rows != factor) && (y != (size.y - 1)))
+				{
+					continue;
+				}
+
+				Color* pDst = image[y / factor];
+				uint32* pSum = sums.data();
+
+				for (int32 x = 0; x < dstW; ++x)
+				{
+					const uint32 count = (rows * Min(factor, (size.x - x * factor)));
+
+					pDst[x].set(
+						static_cast<uint8>((pSum[0] + count / 2) / count),
+						static_cast<uint8>((pSum[1] + count / 2) / count),
+						static_cast<uint8>((pSum[2] + count / 2) / count),
+						static_cast<uint8>((pSum[3] + count / 2) / count));
+
+					pSum += 4;
+				}
+
+				std::fill(sums.begin(), sums.end(), 0);
+			}
+
+			::png_read_end(png_ptr, nullptr);
+
+			return image;
+		}
+	}
+
 	StringView PNGDecoder::name() const
 	{
 		return U"PNG"_sv;
@@ -184,52 +361,7 @@ namespace s3d
 			return{};
 		}
 
-		if (iColorType == PNG_COLOR_TYPE_PALETTE)
-		{
-			LOG_VERBOSE(U"png_set_palette_to_rgb()");
-			::png_set_palette_to_rgb(png_ptr);
-		}
-
-		if (::png_get_valid(png_ptr, info_ptr, PNG_INFO_tRNS))
-		{
-			LOG_VERBOSE(U"png_set_tRNS_to_alpha()");
-			::png_set_tRNS_to_alpha(png_ptr);
-		}
-
-		if (iColorType == PNG_COLOR_TYPE_GRAY && iBitDepth < 8)
-		{
-			LOG_VERBOSE(U"png_set_expand_gray_1_2_4_to_8()");
-			::png_set_expand_gray_1_2_4_to_8(png_ptr);
-		}
-
-		if (iBitDepth == 16)
-		{
-			LOG_VERBOSE(U"png_set_scale_16()");
-			::png_set_scale_16(png_ptr);
-		}
-
-		if (iBitDepth < 8)
-		{
-			LOG_VERBOSE(U"png_set_packing()");
-			::png_set_packing(png_ptr);
-		}
-
-		if ((iColorType == PNG_COLOR_TYPE_GRAY)
-			|| (iColorType == PNG_COLOR_TYPE_GRAY_ALPHA))
-		{
-			LOG_VERBOSE(U"png_set_gray_to_rgb()");
-			::png_set_gray_to_rgb(png_ptr);
-		}
-
-		::png_set_add_alpha(png_ptr, 0xff, PNG_FILLER_AFTER);
-
-		double dGamma;
-
-		if (::png_get_gAMA(png_ptr, info_ptr, &dGamma))
-		{
-			LOG_VERBOSE(U"png_set_gamma()");
-			::png_set_gamma(png_ptr, 2.2, dGamma);
-		}
+		detail::SetRGBA8Transforms(png_ptr, info_ptr, iBitDepth, iColorType);
 
 		::png_read_update_info(png_ptr, info_ptr);
 
@@ -382,4 +514,138 @@ namespace s3d
 
 		return image;
 	}
+
+	Image PNGDecoder::decodeScaled(IReader& reader, const Size& targetSize, const FilePathView) const
+	{
+		LOG_SCOPED_TRACE(U"PNGDecoder::decodeScaled()");
+
+		// png_ptr
+		png_structp png_ptr = ::png_create_read_struct(PNG_LIBPNG_VER_STRING, nullptr, nullptr, nullptr);
+		{
+			if (!png_ptr)
+			{
+				return{};
+			}
+		}
+
+		ScopeGuard cleanup_struct = [&]()
+		{
+			::png_destroy_read_struct(&png_ptr, nullptr, nullptr);
+		};
+
+		// info_ptr
+		png_infop info_ptr = ::png_create_info_struct(png_ptr);
+		{
+			if (!info_ptr)
+			{
+				return{};
+			}
+		}
+
+		ScopeGuard cleanup_info = [&]()
+		{
+			::png_destroy_info_struct(png_ptr, &info_ptr);
+		};
+
+		// decode
+		bool interlaced = false;
+
+		const Size imageSize = detail::PrepareRGBA8(png_ptr, info_ptr, reader, interlaced);
+
+		const Size size = ScaledSize(imageSize, targetSize);
+
+		if ((size.x <= 0) || (size.y <= 0))
+		{
+			return{};
+		}
+
+		// 縮小後の大きさを下回らない、最大の整数倍で間引く
+		const int32 factor = Max(Min((imageSize.x / size.x), (imageSize.y / size.y)), 1);
+
+		Image image = (((factor == 1) || interlaced)
+			? detail::ReadRGBA8Image(png_ptr, imageSize)
+			: detail::ReadRGBA8ImageDecimated(png_ptr, imageSize, factor));
+
+		if (image.size() != size)
+		{
+			image.scale(size, InterpolationAlgorithm::Area);
+		}
+
+		LOG_VERBOSE(U"Image ({}x{}) decoded from {}x{}"_fmt(
+			size.x, size.y, imageSize.x, imageSize.y));
+
+		return image;
+	}
+
+	Image PNGDecoder::decodeRegion(IReader& reader, const Rect& region, const FilePathView) const
+	{
+		LOG_SCOPED_TRACE(U"PNGDecoder::decodeRegion()");
+
+		// png_ptr
+		png_structp png_ptr = ::png_create_read_struct(PNG_LIBPNG_VER_STRING, nullptr, nullptr, nullptr);
+		{
+			if (!png_ptr)
+			{
+				return{};
+			}
+		}
+
+		ScopeGuard cleanup_struct = [&]()
+		{
+			::png_destroy_read_struct(&png_ptr, nullptr, nullptr);
+		};
+
+		// info_ptr
+		png_infop info_ptr = ::png_create_info_struct(png_ptr);
+		{
+			if (!info_ptr)
+			{
+				return{};
+			}
+		}
+
+		ScopeGuard cleanup_info = [&]()
+		{
+			::png_destroy_info_struct(png_ptr, &info_ptr);
+		};
+
+		// decode
+		bool interlaced = false;
+
+		const Size imageSize = detail::PrepareRGBA8(png_ptr, info_ptr, reader, interlaced);
+
+		const Rect bounds = region.getOverlap(Rect{ imageSize });
+
+		if (not bounds.hasArea())
+		{
+			return{};
+		}
+
+		if (interlaced)
+		{
+			return detail::ReadRGBA8Image(png_ptr, imageSize).clipped(bounds);
+		}
+
+		Image image(bounds.size);
+
+		// 各行は前の行に依存してフィルタされているため、領域より上の行も読む必要がある
+		Array<uint8> row(imageSize.x * 4);
+
+		for (int32 y = 0; y < (bounds.y + bounds.h); ++y)
+		{
+			::png_read_row(png_ptr, row.data(), nullptr);
+
+			if (bounds.y <= y)
+			{
+				std::memcpy(image[y - bounds.y], (row.data() + bounds.x * 4), (bounds.w * sizeof(Color)));
+			}
+		}
+
+		// 領域より下の行は読まない
+
+		LOG_VERBOSE(U"Image ({}x{}) decoded from {}x{}"_fmt(
+			bounds.w, bounds.h, imageSize.x, imageSize.y));
+
+		return image;
+	}
 }
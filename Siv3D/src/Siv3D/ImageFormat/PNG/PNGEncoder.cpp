@@ -11,8 +11,10 @@
 
 # include <Siv3D/ImageFormat/PNGEncoder.hpp>
 # include <Siv3D/BinaryWriter.hpp>
+# include <Siv3D/MemoryWriter.hpp>
 # include <Siv3D/Image.hpp>
 # include <Siv3D/EngineLog.hpp>
+# include "ParallelPNGEncoder.hpp"
 
 # if SIV3D_PLATFORM(WINDOWS) | SIV3D_PLATFORM(MACOS) | SIV3D_PLATFORM(WEB)
 #	include <ThirdParty-prebuilt/libpng/png.h>
@@ -59,6 +61,11 @@ namespace s3d
 	}
 
 	bool PNGEncoder::save(const Image& image, const FilePathView path, const PNGFilter filter) const
+	{
+		return save(image, path, filter, DefaultCompression);
+	}
+
+	bool PNGEncoder::save(const Image& image, const FilePathView path, const PNGFilter filter, const PNGCompression compression) const
 	{
 		BinaryWriter writer{ path };
 
@@ -67,7 +74,7 @@ namespace s3d
 			return false;
 		}
 
-		return encode(image, writer, filter);
+		return encode(image, writer, filter, compression);
 	}
 
 	bool PNGEncoder::save(const Grid<uint16>& image, const FilePathView path, const PNGFilter filter) const
@@ -89,53 +96,17 @@ namespace s3d
 
 	bool PNGEncoder::encode(const Image& image, IWriter& writer, const PNGFilter filter) const
 	{
-		if (not writer.isOpen())
-		{
-			return false;
-		}
-
-		png_structp png_ptr = ::png_create_write_struct(PNG_LIBPNG_VER_STRING, nullptr, nullptr, nullptr);
-
-		if (not png_ptr)
-		{
-			return false;
-		}
-
-		png_infop info_ptr = ::png_create_info_struct(png_ptr);
+		return encode(image, writer, filter, DefaultCompression);
+	}
 
-		if (not info_ptr)
+	bool PNGEncoder::encode(const Image& image, IWriter& writer, const PNGFilter filter, const PNGCompression compression) const
+	{
+		if (not writer.isOpen())
 		{
-			::png_destroy_write_struct(&png_ptr, nullptr);
-
 			return false;
 		}
 
-		::png_set_write_fn(png_ptr, &writer, PngWriteCallbackIWriter, nullptr);
-
-		const png_uint_32 width = image.width();
-
-		const png_uint_32 height = image.height();
-
-		::png_set_IHDR(png_ptr, info_ptr, width, height, 8, PNG_COLOR_TYPE_RGB_ALPHA, PNG_INTERLACE_NONE, PNG_COMPRESSION_TYPE_DEFAULT, PNG_FILTER_TYPE_DEFAULT);
-
-		::png_set_filter(png_ptr, 0, FromEnum(filter));
-
-		::png_write_info(png_ptr, info_ptr);
-
-		const uint8* pRow = image.dataAsUint8();
-
-		for (uint32 y = 0; y < height; ++y)
-		{
-			::png_write_row(png_ptr, pRow);
-
-			pRow += image.stride();
-		}
-
-		::png_write_end(png_ptr, info_ptr);
-
-		::png_destroy_write_struct(&png_ptr, &info_ptr);
-
-		return true;
+		return ParallelPNGEncoder::Encode(image, writer, filter, compression);
 	}
 
 	bool PNGEncoder::encode(const Grid<uint16>& image, IWriter& writer, const PNGFilter filter) const
@@ -202,50 +173,19 @@ namespace s3d
 
 	Blob PNGEncoder::encode(const Image& image, const PNGFilter filter) const
 	{
-		png_structp png_ptr = ::png_create_write_struct(PNG_LIBPNG_VER_STRING, nullptr, nullptr, nullptr);
-
-		if (not png_ptr)
-		{
-			return{};
-		}
+		return encode(image, filter, DefaultCompression);
+	}
 
-		png_infop info_ptr = ::png_create_info_struct(png_ptr);
+	Blob PNGEncoder::encode(const Image& image, const PNGFilter filter, const PNGCompression compression) const
+	{
+		MemoryWriter writer;
 
-		if (not info_ptr)
+		if (not ParallelPNGEncoder::Encode(image, writer, filter, compression))
 		{
-			::png_destroy_write_struct(&png_ptr, nullptr);
-
 			return{};
 		}
 
-		Blob blob;
-
-		::png_set_write_fn(png_ptr, &blob, PngWriteCallbackBlob, nullptr);
-
-		const png_uint_32 width = image.width();
-
-		const png_uint_32 height = image.height();
-
-		::png_set_IHDR(png_ptr, info_ptr, width, height, 8, PNG_COLOR_TYPE_RGB_ALPHA, PNG_INTERLACE_NONE, PNG_COMPRESSION_TYPE_DEFAULT, PNG_FILTER_TYPE_DEFAULT);
-
-		::png_set_filter(png_ptr, 0, FromEnum(filter));
-
-		::png_write_info(png_ptr, info_ptr);
-
-		const uint8* pRow = image.dataAsUint8();
-
-		for (uint32 y = 0; y < height; ++y)
-		{
-			::png_write_row(png_ptr, pRow);
-
-			pRow += image.stride();
-		}
-
-		::png_write_end(png_ptr, info_ptr);
-
-		::png_destroy_write_struct(&png_ptr, &info_ptr);
-
-		return blob;
+		return writer.retrieve();
 	}
 
 	Blob PNGEncoder::encode(const Grid<uint16>& image, const PNGFilter filter) const
@@ -0,0 +1,478 @@
+﻿//-----------------------------------------------
+//
+//	This file is part of the Siv3D Engine.
+//
+//	Copyright (c) 2008-2022 Ryo Suzuki
+//	Copyright (c) 2016-2022 OpenSiv3D Project
+//
+//	Licensed under the MIT License.
+//
+//-----------------------------------------------
+
+
+# include <Siv3D/ThreadPool.hpp>
+# include <Siv3D/EngineLog.hpp>
+# include <ThirdParty/zlib/zlib.h>
+# include "ParallelPNGEncoder.hpp"
+
+namespace s3d
+{
+	namespace detail
+	{
+		// 1 つの帯に含める、フィルタ後のデータの大きさの目安
+		static constexpr size_t PNGBandSizeBytes = (1 << 20);
+
+		// 帯の圧縮の前に、直前の帯の末尾のこの大きさのデータを辞書として与える
+		static constexpr size_t PNGDictionarySize = (32 * 1024);
+
+		// 1 ピクセルのバイト数 (RGBA)
+		static constexpr size_t PNGBytesPerPixel = 4;
+
+		enum class PNGFilterType : uint8
+		{
+			None,
+
+			Sub,
+
+			Up,
+
+			Average,
+
+			Paeth,
+		};
+
+		struct PNGCompressionParameters
+		{
+			int32 level;
+
+			int32 strategy;
+
+			PNGFilter filter;
+		};
+
+		[[nodiscard]]
+		static PNGCompressionParameters GetCompressionParameters(const PNGCompression compression, const PNGFilter filter) noexcept
+		{
+			// libpng と同じく、フィルタを使う場合は Z_FILTERED にする
+			const int32 strategy = ((filter == PNGFilter::None_) ? Z_DEFAULT_STRATEGY : Z_FILTERED);
+
+			switch (compression)
+			{
+			case PNGCompression::Store:
+				return{ 0, Z_DEFAULT_STRATEGY, PNGFilter::None_ };
+			case PNGCompression::Fastest:
+				return{ 1, Z_RLE, PNGFilter::Sub };
+			case PNGCompression::Fast:
+				return{ 1, strategy, filter };
+			case PNGCompression::Best:
+				return{ 9, strategy, filter };
+			default:
+				return{ 6, strategy, filter };
+			}
+		}
+
+		[[nodiscard]]
+		static Array<PNGFilterType> GetFilterTypes(const PNGFilter filter)
+		{
+			Array<PNGFilterType> types;
+
+			if (FromEnum(filter) & FromEnum(PNGFilter::None_))
+			{
+				types << PNGFilterType::None;
+			}
+
+			if (FromEnum(filter) & FromEnum(PNGFilter::Sub))
+			{
+				types << PNGFilterType::Sub;
+			}
+
+			if (FromEnum(filter) & FromEnum(PNGFilter::Up))
+			{
+				types << PNGFilterType::Up;
+			}
+
+			if (FromEnum(filter) & FromEnum(PNGFilter::Avg))
+			{
+				types << PNGFilterType::Average;
+			}
+
+			if (FromEnum(filter) & FromEnum(PNGFilter::Paeth))
+			{
+				types << PNGFilterType::Paeth;
+			}
+
+			if (not types)
+			{
+				types << PNGFilterType::None;
+			}
+
+			return types;
+		}
+
+		[[nodiscard]]
+		static uint8 PaethPredictor(const int32 a, const int32 b, const int32 c) noexcept
+		{
+			const int32 p = (a + b - c);
+			const int32 pa = std::abs(p - a);
+			const int32 pb = std::abs(p - b);
+			const int32 pc = std::abs(p - c);
+
+			if ((pa <= pb) && (pa <= pc))
+			{
+				return static_cast<uint8>(a);
+			}
+			else if (pb <= pc)
+			{
+				return static_cast<uint8>(b);
+			}
+			else
+			{
+				return static_cast<uint8>(c);
+			}
+		}
+
+		// pPrev は前の行。最初の行の場合はすべて 0 の行
+		static void FilterRow(const PNGFilterType type, const uint8* pCurrent, const uint8* pPrev, uint8* pDst, const size_t rowBytes) noexcept
+		{
+			constexpr size_t bpp = PNGBytesPerPixel;
+
+			switch (type)
+			{
+			case PNGFilterType::None:
+				std::memcpy(pDst, pCurrent, rowBytes);
+				break;
+			case PNGFilterType::Sub:
+				std::memcpy(pDst, pCurrent, bpp);
+
+				for (size_t i = bpp; i < rowBytes; ++i)
+				{
+					pDst[i] = static_cast<uint8>(pCurrent[i] - pCurrent[i - bpp]);
+				}
+
+				break;
+			case PNGFilterType::Up:
+				for (size_t i = 0; i < rowBytes; ++i)
+				{
+					pDst[i] = static_cast<uint8>(pCurrent[i] - pPrev[i]);
+				}
+
+				break;
+			case PNGFilterType::Average:
+				for (size_t i = 0; i < bpp; ++i)
+				{
+					pDst[i] = static_cast<uint8>(pCurrent[i] - (pPrev[i] / 2));
+				}
+
+				for (size_t i = bpp; i < rowBytes; ++i)
+				{
+					pDst[i] = static_cast<uint8>(pCurrent[i] - ((pCurrent[i - bpp] + pPrev[i]) / 2));
+				}
+
+				break;
+			case PNGFilterType::Paeth:
+				for (size_t i = 0; i < bpp; ++i)
+				{
+					pDst[i] = static_cast<uint8>(pCurrent[i] - pPrev[i]);
+				}
+
+				for (size_t i = bpp; i < rowBytes; ++i)
+				{
+					pDst[i] = static_cast<uint8>(pCurrent[i] - PaethPredictor(pCurrent[i - bpp], pPrev[i], pPrev[i - bpp]));
+				}
+
+				break;
+			}
+		}
+
+		// 符号付きの値とみなした絶対値の合計。libpng と同じく、小さいほど圧縮しやすいとみなす
+		[[nodiscard]]
+		static uint64 SumOfAbsoluteValues(const uint8* pData, const size_t size) noexcept
+		{
+			uint64 sum = 0;
+
+			for (size_t i = 0; i < size; ++i)
+			{
+				sum += std::abs(static_cast<int8>(pData[i]));
+			}
+
+			return sum;
+		}
+
+		// 各行の先頭にフィルタの種類を付けて pDst に書き込む
+		static void FilterRows(const Image& image, const size_t firstRow, const size_t lastRow, const Array<PNGFilterType>& types, uint8* pDst)
+		{
+			const size_t rowBytes = (image.width() * PNGBytesPerPixel);
+			const Array<uint8> zeroRow(rowBytes, 0);
+			Array<uint8> candidate((types.size() == 1) ? 0 : rowBytes);
+
+			for (size_t y = firstRow; y < lastRow; ++y)
+			{
+				const uint8* pCurrent = (image.dataAsUint8() + (y * image.stride()));
+				const uint8* pPrev = ((y == 0) ? zeroRow.data() : (pCurrent - image.stride()));
+				uint8* pRow = (pDst + ((y - firstRow) * (rowBytes + 1)));
+
+				if (types.size() == 1)
+				{
+					pRow[0] = FromEnum(types.front());
+					FilterRow(types.front(), pCurrent, pPrev, (pRow + 1), rowBytes);
+					continue;
+				}
+
+				uint64 minSum = UINT64_MAX;
+
+				for (const auto type : types)
+				{
+					FilterRow(type, pCurrent, pPrev, candidate.data(), rowBytes);
+
+					if (const uint64 sum = SumOfAbsoluteValues(candidate.data(), rowBytes);
+						sum < minSum)
+					{
+						minSum = sum;
+						pRow[0] = FromEnum(type);
+						std::memcpy((pRow + 1), candidate.data(), rowBytes);
+					}
+				}
+			}
+		}
+
+		struct PNGBand
+		{
+			size_t offset = 0;
+
+			size_t size = 0;
+
+			Array<uint8> compressed;
+
+			uLong adler = 0;
+
+			bool succeeded = false;
+		};
+
+		// 帯を raw deflate で圧縮する。最後の帯以外はバイト境界で終わるよう Z_SYNC_FLUSH する
+		static void CompressBand(const Array<uint8>& filtered, PNGBand& band, const bool isLast, const PNGCompressionParameters& parameters)
+		{
+			const uint8* pSrc = (filtered.data() + band.offset);
+
+			band.adler = ::adler32(::adler32(0L, Z_NULL, 0), pSrc, static_cast<uInt>(band.size));
+
+			z_stream z{};
+
+			if (::deflateInit2(&z, parameters.level, Z_DEFLATED, -MAX_WBITS, 8, parameters.strategy) != Z_OK)
+			{
+				return;
+			}
+
+			if ((0 < band.offset) && (0 < parameters.level))
+			{
+				const size_t dictionarySize = Min(band.offset, PNGDictionarySize);
+
+				::deflateSetDictionary(&z, (pSrc - dictionarySize), static_cast<uInt>(dictionarySize));
+			}
+
+			band.compressed.resize(::deflateBound(&z, static_cast<uLong>(band.size)) + 64);
+
+			z.next_in = const_cast<Bytef*>(pSrc);
+			z.avail_in = static_cast<uInt>(band.size);
+			z.next_out = band.compressed.data();
+			z.avail_out = static_cast<uInt>(band.compressed.size());
+
+			const int32 flush = (isLast ? Z_FINISH : Z_SYNC_FLUSH);
+
+			for (;;)
+			{
+				const int32 result = ::deflate(&z, flush);
+
+				if ((result != Z_OK) && (result != Z_STREAM_END) && (result != Z_BUF_ERROR))
+				{
+					::deflateEnd(&z);
+					return;
+				}
+
+				if ((result == Z_STREAM_END)
+					|| ((not isLast) && (z.avail_in == 0) && (z.avail_out != 0)))
+				{
+					break;
+				}
+
+				// 出力先が足りない場合は拡張する
+				const size_t written = (band.compressed.size() - z.avail_out);
+				band.compressed.resize(band.compressed.size() * 2);
+				z.next_out = (band.compressed.data() + written);
+				z.avail_out = static_cast<uInt>(band.compressed.size() - written);
+			}
+
+			band.compressed.resize(band.compressed.size() - z.avail_out);
+
+			::deflateEnd(&z);
+
+			band.succeeded = true;
+		}
+
+		static void WriteUint32BE(uint8* pDst, const uint32 value) noexcept
+		{
+			pDst[0] = static_cast<uint8>(value >> 24);
+			pDst[1] = static_cast<uint8>(value >> 16);
+			pDst[2] = static_cast<uint8>(value >> 8);
+			pDst[3] = static_cast<uint8>(value);
+		}
+
+		struct PNGChunkData
+		{
+			const uint8* data;
+
+			size_t size;
+		};
+
+		static void WriteChunk(IWriter& writer, const char(&type)[5], std::initializer_list<PNGChunkData> pieces)
+		{
+			size_t length = 0;
+
+			for (const auto& piece : pieces)
+			{
+				length += piece.size;
+			}
+
+			uint8 header[8];
+			WriteUint32BE(header, static_cast<uint32>(length));
+			std::memcpy((header + 4), type, 4);
+			writer.write(header, sizeof(header));
+
+			uLong crc = ::crc32(::crc32(0L, Z_NULL, 0), (header + 4), 4);
+
+			for (const auto& piece : pieces)
+			{
+				if (piece.size == 0)
+				{
+					continue;
+				}
+
+				writer.write(piece.data, piece.size);
+				crc = ::crc32(crc, piece.data, static_cast<uInt>(piece.size));
+			}
+
+			uint8 footer[4];
+			WriteUint32BE(footer, static_cast<uint32>(crc));
+			writer.write(footer, sizeof(footer));
+		}
+	}
+
+	namespace ParallelPNGEncoder
+	{
+		bool Encode(const Image& image, IWriter& writer, const PNGFilter filter, const PNGCompression compression)
+		{
+			if ((not image) || (not writer.isOpen()))
+			{
+				return false;
+			}
+
+			const detail::PNGCompressionParameters parameters = detail::GetCompressionParameters(compression, filter);
+			const Array<detail::PNGFilterType> filterTypes = detail::GetFilterTypes(parameters.filter);
+			const size_t width = image.width();
+			const size_t height = image.height();
+			const size_t filteredRowBytes = (width * detail::PNGBytesPerPixel + 1);
+			const size_t rowsPerBand = Max<size_t>((detail::PNGBandSizeBytes / filteredRowBytes), 1);
+			const size_t numBands = ((height + rowsPerBand - 1) / rowsPerBand);
+
+			// 1. フィルタ
+			Array<uint8> filtered(height * filteredRowBytes);
+			{
+				const auto filterRows = [&](const size_t begin, const size_t end)
+				{
+					detail::FilterRows(image, begin, end, filterTypes, (filtered.data() + begin * filteredRowBytes));
+				};
+
+			# if defined(SIV3D_NO_CONCURRENT_API)
+
+				filterRows(0, height);
+
+			# else
+
+				Threading::GetDefaultPool().parallel_for(0, height, rowsPerBand, filterRows);
+
+			# endif
+			}
+
+			// 2. 帯ごとの圧縮
+			Array<detail::PNGBand> bands(numBands);
+			{
+				for (size_t i = 0; i < numBands; ++i)
+				{
+					bands[i].offset = (i * rowsPerBand * filteredRowBytes);
+					bands[i].size = (Min(rowsPerBand, (height - i * rowsPerBand)) * filteredRowBytes);
+				}
+
+				const auto compressBands = [&](const size_t begin, const size_t end)
+				{
+					for (size_t i = begin; i < end; ++i)
+					{
+						detail::CompressBand(filtered, bands[i], (i == (numBands - 1)), parameters);
+					}
+				};
+
+			# if defined(SIV3D_NO_CONCURRENT_API)
+
+				compressBands(0, numBands);
+
+			# else
+
+				Threading::GetDefaultPool().parallel_for(0, numBands, 1, compressBands);
+
+			# endif
+
+				if (not bands.all([](const detail::PNGBand& band) { return band.succeeded; }))
+				{
+					LOG_FAIL(U"ParallelPNGEncoder::Encode(): deflate failed");
+					return false;
+				}
+			}
+
+			// 3. 書き出し
+			{
+				static constexpr uint8 Signature[8] = { 0x89, 'P', 'N', 'G', 0x0D, 0x0A, 0x1A, 0x0A };
+				writer.write(Signature, sizeof(Signature));
+
+				uint8 ihdr[13];
+				detail::WriteUint32BE(ihdr, static_cast<uint32>(width));
+				detail::WriteUint32BE((ihdr + 4), static_cast<uint32>(height));
+				ihdr[8] = 8; // bit depth
+				ihdr[9] = 6; // color type: RGBA
+				ihdr[10] = 0; // compression method
+				ihdr[11] = 0; // filter method
+				ihdr[12] = 0; // interlace method
+				detail::WriteChunk(writer, "IHDR", { { ihdr, sizeof(ihdr) } });
+
+				// zlib ヘッダ (32KiB のウィンドウ、圧縮レベルのヒント)
+				const uint8 flevel = ((parameters.level < 2) ? 0 : (parameters.level < 6) ? 1 : (parameters.level == 6) ? 2 : 3);
+				uint8 zlibHeader[2] = { 0x78, static_cast<uint8>(flevel << 6) };
+				zlibHeader[1] += static_cast<uint8>(31 - (((zlibHeader[0] << 8) | zlibHeader[1]) % 31));
+
+				// 各帯の Adler-32 を結合する
+				uLong adler = bands.front().adler;
+
+				for (size_t i = 1; i < numBands; ++i)
+				{
+					adler = ::adler32_combine(adler, bands[i].adler, static_cast<z_off_t>(bands[i].size));
+				}
+
+				uint8 zlibFooter[4];
+				detail::WriteUint32BE(zlibFooter, static_cast<uint32>(adler));
+
+				// 帯ごとに 1 つの IDAT チャンクにする
+				for (size_t i = 0; i < numBands; ++i)
+				{
+					const bool isFirst = (i == 0);
+					const bool isLast = (i == (numBands - 1));
+
+					detail::WriteChunk(writer, "IDAT", {
+						{ zlibHeader, (isFirst ? sizeof(zlibHeader) : 0) },
+						{ bands[i].compressed.data(), bands[i].compressed.size() },
+						{ zlibFooter, (isLast ? sizeof(zlibFooter) : 0) } });
+				}
+
+				detail::WriteChunk(writer, "IEND", {});
+			}
+
+			return true;
+		}
+	}
+}
@@ -0,0 +1,33 @@
+﻿//-----------------------------------------------
+//
+//	This file is part of the Siv3D Engine.
+//
+//	Copyright (c) 2008-2022 Ryo Suzuki
+//	Copyright (c) 2016-2022 OpenSiv3D Project
+//
+//	Licensed under the MIT License.
+//
+//-----------------------------------------------
+
+
+# pragma once
+# include <Siv3D/Common.hpp>
+# include <Siv3D/Image.hpp>
+# include <Siv3D/IWriter.hpp>
+# include <Siv3D/PNGFilter.hpp>
+# include <Siv3D/PNGCompression.hpp>
+
+namespace s3d
+{
+	namespace ParallelPNGEncoder
+	{
+		/// @brief Image を RGBA 8-bit の PNG 形式でエンコードして書き出します。
+		/// @param image エンコードする Image
+		/// @param writer 書き出し先の IWriter インタフェース
+		/// @param filter 使用するフィルタ
+		/// @param compression 圧縮のプリセット
+		/// @return 書き出しに成功した場合 true, それ以外の場合は false
+		/// @remark 画像を行の帯に分割し、フィルタと deflate 圧縮を帯ごとに並列に行います。帯の圧縮結果はつなげて 1 つの zlib ストリームにするため、出力は標準的な PNG です。
+		bool Encode(const Image& image, IWriter& writer, PNGFilter filter, PNGCompression compression);
+	}
+}
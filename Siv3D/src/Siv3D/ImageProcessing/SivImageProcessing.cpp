@@ -11,71 +11,170 @@
 
 # include <Siv3D/ImageProcessing.hpp>
 # include <Siv3D/OpenCV_Bridge.hpp>
+# include <Siv3D/SIMD.hpp>
+# include <Siv3D/ThreadPool.hpp>
 
 namespace s3d
 {
 	namespace detail
 	{
-		static Image GenerateMip(const Image& src)
+		// 並列に処理する場合の、1 つのタスクが担当する出力のピクセル数の目安
+		static constexpr size_t MipGrainPixels = (1 << 16);
+
+		// sRGB と線形な色空間との変換テーブル
+		struct SRGBTable
 		{
-			if (not src)
+			// sRGB の値 -> 線形な値 (0-65535)
+			std::array<uint16, 256> toLinear;
+
+			// 線形な値 4 つの合計 / 64 -> sRGB の値
+			std::array<uint8, 4097> toSRGB;
+
+			SRGBTable()
 			{
-				return{};
+				for (size_t i = 0; i < toLinear.size(); ++i)
+				{
+					const double linear = ColorF{ (i / 255.0) }.removeSRGBCurve().r;
+					toLinear[i] = static_cast<uint16>(std::lround(linear * 65535.0));
+				}
+
+				for (size_t i = 0; i < toSRGB.size(); ++i)
+				{
+					const double linear = Min(((i * 16.0) / 65535.0), 1.0);
+					toSRGB[i] = static_cast<uint8>(std::lround(ColorF{ linear }.applySRGBCurve().r * 255.0));
+				}
 			}
+		};
 
-			const Color* pSrc = src.data();
-			const int32 srcW = src.width();
-			const int32 srcH = src.height();
+		[[nodiscard]]
+		static const SRGBTable& GetSRGBTable()
+		{
+			static const SRGBTable table;
+			return table;
+		}
+
+		// 2 行 x 4 ピクセルを、横に隣り合う 2 ピクセルずつ合計し、出力の 2 ピクセル分 (uint16 x 8) を返す
+		[[nodiscard]]
+		static __m128i Sum2x2(const Color* pRow0, const Color* pRow1) noexcept
+		{
+			const __m128i zero = _mm_setzero_si128();
+			const __m128i a = _mm_loadu_si128(reinterpret_cast<const __m128i*>(pRow0));
+			const __m128i b = _mm_loadu_si128(reinterpret_cast<const __m128i*>(pRow1));
+			const __m128i lo = _mm_add_epi16(_mm_unpacklo_epi8(a, zero), _mm_unpacklo_epi8(b, zero));
+			const __m128i hi = _mm_add_epi16(_mm_unpackhi_epi8(a, zero), _mm_unpackhi_epi8(b, zero));
+			return _mm_add_epi16(_mm_unpacklo_epi64(lo, hi), _mm_unpackhi_epi64(lo, hi));
+		}
+
+		// 2 行を 2x2 の平均で縮小し、出力の 1 行を作成する
+		static void DownsampleRow(const Color* pRow0, const Color* pRow1, Color* pDst, const int32 srcW, const int32 dstW) noexcept
+		{
+			int32 x = 0;
+
+			if (2 <= srcW)
+			{
+				const __m128i rounding = _mm_set1_epi16(2);
+
+				for (; (x + 4) <= dstW; x += 4)
+				{
+					const __m128i s0 = _mm_add_epi16(Sum2x2((pRow0 + x * 2), (pRow1 + x * 2)), rounding);
+					const __m128i s1 = _mm_add_epi16(Sum2x2((pRow0 + x * 2 + 4), (pRow1 + x * 2 + 4)), rounding);
+					_mm_storeu_si128(reinterpret_cast<__m128i*>(pDst + x), _mm_packus_epi16(_mm_srli_epi16(s0, 2), _mm_srli_epi16(s1, 2)));
+				}
+			}
 
-			const int32 targetWidth = Max(src.width() / 2, 1);
-			const int32 targetHeight = Max(src.height() / 2, 1);
-			
-			if ((targetWidth <= 4) && (targetHeight <= 4))
+			for (; x < dstW; ++x)
 			{
-				return src.scaled(targetWidth, targetHeight, InterpolationAlgorithm::Area);
+				const int32 x0 = Min((x * 2), (srcW - 1));
+				const int32 x1 = Min((x * 2 + 1), (srcW - 1));
+				const Color& c0 = pRow0[x0];
+				const Color& c1 = pRow0[x1];
+				const Color& c2 = pRow1[x0];
+				const Color& c3 = pRow1[x1];
+
+				pDst[x].set(
+					static_cast<uint8>((c0.r + c1.r + c2.r + c3.r + 2) / 4),
+					static_cast<uint8>((c0.g + c1.g + c2.g + c3.g + 2) / 4),
+					static_cast<uint8>((c0.b + c1.b + c2.b + c3.b + 2) / 4),
+					static_cast<uint8>((c0.a + c1.a + c2.a + c3.a + 2) / 4));
 			}
-			
-			Image result(targetWidth, targetHeight);
-			Color* pDst = result.data();
+		}
 
-			const float sddx = (srcW - 1.0f) / Max(targetWidth - 1, 1);
-			const float sddy = (srcH - 1.0f) / Max(targetHeight - 1, 1);
+		// RGB を線形な色空間で平均する。アルファはそのまま平均する
+		static void DownsampleRowSRGB(const Color* pRow0, const Color* pRow1, Color* pDst, const int32 srcW, const int32 dstW, const SRGBTable& table) noexcept
+		{
+			const auto average = [&](const uint8 v0, const uint8 v1, const uint8 v2, const uint8 v3)
+			{
+				const uint32 sum = (table.toLinear[v0] + table.toLinear[v1] + table.toLinear[v2] + table.toLinear[v3]);
+				return table.toSRGB[(sum + 32) >> 6];
+			};
 
-			for (int32 y = 0; y < targetHeight; ++y)
+			for (int32 x = 0; x < dstW; ++x)
 			{
-				float sy = y * sddy;
+				const int32 x0 = Min((x * 2), (srcW - 1));
+				const int32 x1 = Min((x * 2 + 1), (srcW - 1));
+				const Color& c0 = pRow0[x0];
+				const Color& c1 = pRow0[x1];
+				const Color& c2 = pRow1[x0];
+				const Color& c3 = pRow1[x1];
+
+				pDst[x].set(
+					average(c0.r, c1.r, c2.r, c3.r),
+					average(c0.g, c1.g, c2.g, c3.g),
+					average(c0.b, c1.b, c2.b, c3.b),
+					static_cast<uint8>((c0.a + c1.a + c2.a + c3.a + 2) / 4));
+			}
+		}
 
-				const int32 dy = static_cast<int32>(sy);
+		static void GenerateMip(const Image& src, Image& dst, const IsSRGB isSRGB)
+		{
+			const int32 srcW = src.width();
+			const int32 srcH = src.height();
+			const int32 dstW = Max((srcW / 2), 1);
+			const int32 dstH = Max((srcH / 2), 1);
 
-				sy -= dy;
+			dst.resize(dstW, dstH);
 
-				const int32 dyO = Min(dy + 1, srcH - 1);
+			const Color* pSrc = src.data();
+			Color* pDst = dst.data();
+			const SRGBTable* pTable = (isSRGB ? &GetSRGBTable() : nullptr);
 
-				for (int32 x = 0; x < targetWidth; ++x)
+			const auto downsampleRows = [=](const size_t begin, const size_t end)
+			{
+				for (size_t y = begin; y < end; ++y)
 				{
-					float sx = x * sddx;
-
-					const int32 dx = static_cast<int32>(sx);
+					const Color* pRow0 = (pSrc + Min((static_cast<int32>(y) * 2), (srcH - 1)) * srcW);
+					const Color* pRow1 = (pSrc + Min((static_cast<int32>(y) * 2 + 1), (srcH - 1)) * srcW);
+
+					if (pTable)
+					{
+						DownsampleRowSRGB(pRow0, pRow1, (pDst + y * dstW), srcW, dstW, *pTable);
+					}
+					else
+					{
+						DownsampleRow(pRow0, pRow1, (pDst + y * dstW), srcW, dstW);
+					}
+				}
+			};
 
-					sx -= dx;
+			const size_t grainRows = Max<size_t>((MipGrainPixels / dstW), 1);
 
-					const int32 dxO = Min(dx + 1, srcW - 1);
+		# if defined(SIV3D_NO_CONCURRENT_API)
 
-					const Color& c0 = pSrc[dy * srcW + dx];
-					const Color& c1 = pSrc[dy * srcW + dxO];
-					const Color& c2 = pSrc[dyO * srcW + dx];
-					const Color& c3 = pSrc[dyO * srcW + dxO];
+			downsampleRows(0, dstH);
 
-					const uint8 r = static_cast<uint8>((c0.r * (1 - sx) + c1.r * sx) * (1 - sy) + (c2.r * (1 - sx) + c3.r * sx) * sy);
-					const uint8 g = static_cast<uint8>((c0.g * (1 - sx) + c1.g * sx) * (1 - sy) + (c2.g * (1 - sx) + c3.g * sx) * sy);
-					const uint8 b = static_cast<uint8>((c0.b * (1 - sx) + c1.b * sx) * (1 - sy) + (c2.b * (1 - sx) + c3.b * sx) * sy);
-					const uint8 a = static_cast<uint8>((c0.a * (1 - sx) + c1.a * sx) * (1 - sy) + (c2.a * (1 - sx) + c3.a * sx) * sy);
+		# else
 
-					(pDst++)->set(r, g, b, a);
-				}
+			// 小さなレベルは、タスクの分配のコストのほうが大きい
+			if (static_cast<size_t>(dstH) <= grainRows)
+			{
+				downsampleRows(0, dstH);
+			}
+			else
+			{
+				Threading::GetDefaultPool().parallel_for(0, dstH, grainRows, downsampleRows);
 			}
 
-			return result;
+		# endif
 		}
 	}
 
@@ -87,6 +186,11 @@ namespace s3d
 		}
 
 		Array<Image> GenerateMips(const Image& src, const size_t maxLevel)
+		{
+			return GenerateMips(src, maxLevel, IsSRGB::No);
+		}
+
+		Array<Image> GenerateMips(const Image& src, const size_t maxLevel, const IsSRGB isSRGB)
 		{
 			const size_t mipCount = std::min(maxLevel, (CalculateMipCount(src.width(), src.height()) - 1));
 
@@ -97,11 +201,11 @@ namespace s3d
 
 			Array<Image> mipImages(mipCount);
 
-			mipImages[0] = detail::GenerateMip(src);
+			detail::GenerateMip(src, mipImages[0], isSRGB);
 
 			for (size_t i = 1; i < mipCount; ++i)
 			{
-				mipImages[i] = detail::GenerateMip(mipImages[i - 1]);
+				detail::GenerateMip(mipImages[i - 1], mipImages[i], isSRGB);
 			}
 
 			return mipImages;
@@ -0,0 +1,427 @@
+﻿//-----------------------------------------------
+//
+//	This file is part of the Siv3D Engine.
+//
+//	Copyright (c) 2008-2022 Ryo Suzuki
+//	Copyright (c) 2016-2022 OpenSiv3D Project
+//
+//	Licensed under the MIT License.
+//
+//-----------------------------------------------
+
+# pragma once
+# include <streambuf>
+# include <charconv>
+# include <vector>
+# include <functional>
+# include <Siv3D/Common.hpp>
+# include <Siv3D/Optional.hpp>
+# include <Siv3D/IReader.hpp>
+# include <ThirdParty/nlohmann/json.hpp>
+
+namespace s3d
+{
+	namespace detail
+	{
+		/// @brief IReader から一定サイズずつ読み込む std::streambuf
+		class IReaderStreamBuffer : public std::streambuf
+		{
+		public:
+
+			static constexpr size_t BufferSize = (64 * 1024);
+
+			explicit IReaderStreamBuffer(IReader& reader)
+				: m_reader{ reader }
+				, m_buffer(BufferSize) {}
+
+		protected:
+
+			int_type underflow() override
+			{
+				if (gptr() < egptr())
+				{
+					return traits_type::to_int_type(*gptr());
+				}
+
+				const int64 readSize = m_reader.read(m_buffer.data(), static_cast<int64>(m_buffer.size()));
+
+				if (readSize <= 0)
+				{
+					return traits_type::eof();
+				}
+
+				setg(m_buffer.data(), m_buffer.data(), (m_buffer.data() + readSize));
+
+				return traits_type::to_int_type(*gptr());
+			}
+
+		private:
+
+			IReader& m_reader;
+
+			std::vector<char> m_buffer;
+		};
+
+		/// @brief JSON Pointer の 1 要素
+		struct JSONPointerToken
+		{
+			std::string name;
+
+			Optional<size_t> index;
+		};
+
+		/// @brief JSON Pointer を要素ごとに分割します。
+		/// @param jsonPointer UTF-8 の JSON Pointer
+		/// @return 分割された要素。JSON Pointer が不正な場合は none
+		[[nodiscard]]
+		inline Optional<std::vector<JSONPointerToken>> SplitJSONPointer(const std::string& jsonPointer)
+		{
+			std::vector<JSONPointerToken> tokens;
+
+			if (jsonPointer.empty())
+			{
+				return tokens;
+			}
+
+			if (jsonPointer.front() != '/')
+			{
+				return none;
+			}
+
+			size_t pos = 1;
+
+			for (;;)
+			{
+				const size_t next = jsonPointer.find('/', pos);
+				std::string token = jsonPointer.substr(pos, (next == std::string::npos) ? std::string::npos : (next - pos));
+
+				// ~1 -> '/', ~0 -> '~'
+				for (size_t i = 0; i < token.size(); ++i)
+				{
+					if (token[i] != '~')
+					{
+						continue;
+					}
+
+					if (((i + 1) == token.size()) || ((token[i + 1] != '0') && (token[i + 1] != '1')))
+					{
+						return none;
+					}
+
+					token.replace(i, 2, ((token[i + 1] == '0') ? "~" : "/"));
+				}
+
+				JSONPointerToken t;
+				t.name = std::move(token);
+
+				if ((not t.name.empty())
+					&& std::all_of(t.name.begin(), t.name.end(), [](char ch) { return (('0' <= ch) && (ch <= '9')); })
+					&& ((t.name.size() == 1) || (t.name.front() != '0')))
+				{
+					// size_t に収まらない番号は、オブジェクトのキーとしてのみ一致する
+					const char* const last = (t.name.data() + t.name.size());
+					size_t index = 0;
+
+					if (const auto [ptr, ec] = std::from_chars(t.name.data(), last, index);
+						(ec == std::errc{}) && (ptr == last))
+					{
+						t.index = index;
+					}
+				}
+
+				tokens.push_back(std::move(t));
+
+				if (next == std::string::npos)
+				{
+					break;
+				}
+
+				pos = (next + 1);
+			}
+
+			return tokens;
+		}
+
+		/// @brief JSON Pointer が指す配列の要素だけを展開する SAX ハンドラ
+		class JSONForEachSAX
+		{
+		public:
+
+			using json = nlohmann::json;
+
+			JSONForEachSAX(const std::vector<JSONPointerToken>& target, std::function<bool(json&&)> callback)
+				: m_target{ target }
+				, m_callback{ std::move(callback) } {}
+
+			bool null()
+			{
+				return onScalar([](auto& builder) { return builder.null(); });
+			}
+
+			bool boolean(const bool value)
+			{
+				return onScalar([=](auto& builder) { return builder.boolean(value); });
+			}
+
+			bool number_integer(const json::number_integer_t value)
+			{
+				return onScalar([=](auto& builder) { return builder.number_integer(value); });
+			}
+
+			bool number_unsigned(const json::number_unsigned_t value)
+			{
+				return onScalar([=](auto& builder) { return builder.number_unsigned(value); });
+			}
+
+			bool number_float(const json::number_float_t value, const json::string_t& s)
+			{
+				return onScalar([&](auto& builder) { return builder.number_float(value, s); });
+			}
+
+			bool string(json::string_t& value)
+			{
+				return onScalar([&](auto& builder) { return builder.string(value); });
+			}
+
+			bool binary(json::binary_t& value)
+			{
+				return onScalar([&](auto& builder) { return builder.binary(value); });
+			}
+
+			bool start_object(const std::size_t n)
+			{
+				return onStartContainer(false, [=](auto& builder) { return builder.start_object(n); });
+			}
+
+			bool key(json::string_t& value)
+			{
+				if (m_builder)
+				{
+					return m_builder->key(value);
+				}
+
+				// 対象より深い階層のキーは照合に使わないので保持しない
+				if (m_stack.size() <= m_target.size())
+				{
+					m_stack.back().key = value;
+				}
+
+				return true;
+			}
+
+			bool end_object()
+			{
+				return onEndContainer([](auto& builder) { return builder.end_object(); });
+			}
+
+			bool start_array(const std::size_t n)
+			{
+				return onStartContainer(true, [=](auto& builder) { return builder.start_array(n); });
+			}
+
+			bool end_array()
+			{
+				return onEndContainer([](auto& builder) { return builder.end_array(); });
+			}
+
+			bool parse_error(std::size_t, const std::string&, const nlohmann::detail::exception& e)
+			{
+				m_error = e.what();
+				return false;
+			}
+
+			/// @brief 対象の処理を終えた、または関数によって中断されたために読み込みを止めたかを返します。
+			[[nodiscard]]
+			bool isFinished() const noexcept
+			{
+				return m_finished;
+			}
+
+			[[nodiscard]]
+			const std::string& getError() const noexcept
+			{
+				return m_error;
+			}
+
+		private:
+
+			struct Frame
+			{
+				bool isArray = false;
+
+				size_t index = 0;
+
+				std::string key;
+			};
+
+			enum class Action
+			{
+				Skip,
+
+				Build,
+
+				EnterTargetArray,
+			};
+
+			const std::vector<JSONPointerToken>& m_target;
+
+			std::function<bool(json&&)> m_callback;
+
+			std::vector<Frame> m_stack;
+
+			// 対象の配列の内側にいるときの m_stack の深さ（0 の場合は配列の外側）
+			size_t m_targetArrayDepth = 0;
+
+			json m_element;
+
+			Optional<nlohmann::detail::json_sax_dom_parser<json>> m_builder;
+
+			size_t m_builderDepth = 0;
+
+			bool m_finished = false;
+
+			std::string m_error;
+
+			[[nodiscard]]
+			bool pathMatches() const
+			{
+				for (size_t i = 0; i < m_target.size(); ++i)
+				{
+					const Frame& frame = m_stack[i];
+					const JSONPointerToken& token = m_target[i];
+
+					if (frame.isArray ? (token.index != frame.index) : (frame.key != token.name))
+					{
+						return false;
+					}
+				}
+
+				return true;
+			}
+
+			[[nodiscard]]
+			Action classify(const bool isArrayStart) const
+			{
+				if (m_targetArrayDepth)
+				{
+					return ((m_stack.size() == m_targetArrayDepth) ? Action::Build : Action::Skip);
+				}
+
+				if ((m_stack.size() == m_target.size()) && pathMatches())
+				{
+					return (isArrayStart ? Action::EnterTargetArray : Action::Build);
+				}
+
+				return Action::Skip;
+			}
+
+			void endValue() noexcept
+			{
+				if ((not m_stack.empty()) && m_stack.back().isArray)
+				{
+					++m_stack.back().index;
+				}
+			}
+
+			bool emitElement()
+			{
+				m_builder.reset();
+
+				const bool isArrayElement = (m_targetArrayDepth != 0);
+
+				if (not m_callback(std::move(m_element)))
+				{
+					m_finished = true;
+					return false;
+				}
+
+				m_element = json{};
+
+				endValue();
+
+				// 配列でない値を対象にしていた場合は、1 回で終了
+				if (not isArrayElement)
+				{
+					m_finished = true;
+					return false;
+				}
+
+				return true;
+			}
+
+			template <class Fty>
+			bool onScalar(Fty f)
+			{
+				if (m_builder)
+				{
+					return f(*m_builder);
+				}
+
+				if (classify(false) == Action::Build)
+				{
+					m_builder.emplace(m_element, false);
+					f(*m_builder);
+					return emitElement();
+				}
+
+				endValue();
+				return true;
+			}
+
+			template <class Fty>
+			bool onStartContainer(const bool isArray, Fty f)
+			{
+				if (m_builder)
+				{
+					++m_builderDepth;
+					return f(*m_builder);
+				}
+
+				switch (classify(isArray))
+				{
+				case Action::Build:
+					m_builder.emplace(m_element, false);
+					m_builderDepth = 1;
+					return f(*m_builder);
+				case Action::EnterTargetArray:
+					m_stack.emplace_back().isArray = true;
+					m_targetArrayDepth = m_stack.size();
+					return true;
+				default:
+					m_stack.emplace_back().isArray = isArray;
+					return true;
+				}
+			}
+
+			template <class Fty>
+			bool onEndContainer(Fty f)
+			{
+				if (m_builder)
+				{
+					if (not f(*m_builder))
+					{
+						return false;
+					}
+
+					if (--m_builderDepth == 0)
+					{
+						return emitElement();
+					}
+
+					return true;
+				}
+
+				// 対象の配列を読み終えたら、残りは読まない
+				if (m_targetArrayDepth == m_stack.size())
+				{
+					m_finished = true;
+					return false;
+				}
+
+				m_stack.pop_back();
+				endValue();
+				return true;
+			}
+		};
+	}
+}
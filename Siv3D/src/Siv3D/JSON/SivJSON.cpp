@@ -10,16 +10,123 @@
 //-----------------------------------------------
 
 # include <variant>
+# include <cstring>
 # include <Siv3D/JSON.hpp>
 # include <Siv3D/TextReader.hpp>
 # include <Siv3D/TextWriter.hpp>
+# include <Siv3D/BinaryReader.hpp>
+# include <Siv3D/MemoryMappedFileView.hpp>
+# include <Siv3D/FileSystem.hpp>
+# include <Siv3D/TextEncoding.hpp>
 # include <Siv3D/Unicode.hpp>
 # include <ThirdParty/nlohmann/json.hpp>
+# include "JSONForEachSAX.hpp"
 
 namespace s3d
 {
 	namespace detail
 	{
+		[[nodiscard]]
+		static bool IsUTF8BOM(const char* begin, const char* end) noexcept
+		{
+			return ((3 <= (end - begin))
+				&& (static_cast<uint8>(begin[0]) == 0xEF)
+				&& (static_cast<uint8>(begin[1]) == 0xBB)
+				&& (static_cast<uint8>(begin[2]) == 0xBF));
+		}
+
+		[[nodiscard]]
+		static bool IsUTF16BOM(const char* begin, const char* end) noexcept
+		{
+			if ((end - begin) < 2)
+			{
+				return false;
+			}
+
+			const uint8 b0 = static_cast<uint8>(begin[0]);
+			const uint8 b1 = static_cast<uint8>(begin[1]);
+
+			return (((b0 == 0xFF) && (b1 == 0xFE))
+				|| ((b0 == 0xFE) && (b1 == 0xFF)));
+		}
+
+		/// @brief TextReader::readAll() と同様に、NUL 文字以降を読み込まないよう終端を調整します。
+		[[nodiscard]]
+		static const char* FindTextEnd(const char* begin, const char* end) noexcept
+		{
+			if (const void* nul = std::memchr(begin, '\0', (end - begin)))
+			{
+				return static_cast<const char*>(nul);
+			}
+
+			return end;
+		}
+
+		/// @brief 範囲が妥当な UTF-8 であるかを返します。
+		[[nodiscard]]
+		static bool IsValidUTF8(const char* begin, const char* end) noexcept
+		{
+			const uint8* p = reinterpret_cast<const uint8*>(begin);
+			const uint8* const pEnd = reinterpret_cast<const uint8*>(end);
+
+			while (p != pEnd)
+			{
+				const uint8 c = *p;
+
+				if (c < 0x80)
+				{
+					++p;
+					continue;
+				}
+
+				size_t length;
+				uint8 lower = 0x80, upper = 0xBF;
+
+				if ((0xC2 <= c) && (c <= 0xDF))
+				{
+					length = 2;
+				}
+				else if ((0xE0 <= c) && (c <= 0xEF))
+				{
+					length = 3;
+					lower = ((c == 0xE0) ? 0xA0 : 0x80); // 冗長な表現
+					upper = ((c == 0xED) ? 0x9F : 0xBF); // サロゲート
+				}
+				else if ((0xF0 <= c) && (c <= 0xF4))
+				{
+					length = 4;
+					lower = ((c == 0xF0) ? 0x90 : 0x80); // 冗長な表現
+					upper = ((c == 0xF4) ? 0x8F : 0xBF); // U+10FFFF 超
+				}
+				else
+				{
+					return false;
+				}
+
+				if (static_cast<size_t>(pEnd - p) < length)
+				{
+					return false;
+				}
+
+				if ((p[1] < lower) || (upper < p[1]))
+				{
+					return false;
+				}
+
+				for (size_t i = 2; i < length; ++i)
+				{
+					if ((p[i] & 0xC0) != 0x80)
+					{
+						return false;
+					}
+				}
+
+				p += length;
+			}
+
+			return true;
+		}
+
 		struct JSONIteratorDetail
 		{
 			nlohmann::json::iterator it;
@@ -1063,9 +1170,29 @@ namespace s3d
 
 	JSON JSON::Load(const FilePathView path, const AllowExceptions allowExceptions)
 	{
-		TextReader reader{ path };
+		// UTF-8 のファイルはメモリマップして、String を経由せずにパースする
+		if (not FileSystem::IsResourcePath(path))
+		{
+			if (MemoryMappedFileView view{ path }; view && view.mappedSize())
+			{
+				const char* begin = reinterpret_cast<const char*>(view.data());
+				const char* end = (begin + view.mappedSize());
+
+				if (not detail::IsUTF16BOM(begin, end))
+				{
+					if (detail::IsUTF8BOM(begin, end))
+					{
+						begin += Unicode::GetBOMSize(TextEncoding::UTF8_WITH_BOM);
+					}
+
+					return ParseUTF8(begin, detail::FindTextEnd(begin, end), allowExceptions);
+				}
+			}
+		}
+
+		auto reader = std::make_unique<BinaryReader>(path);
 
-		if (not reader)
+		if (not reader->isOpen())
 		{
 			if (allowExceptions)
 			{
@@ -1075,14 +1202,12 @@ namespace s3d
 			return JSON::Invalid();
 		}
 
-		return Parse(reader.readAll(), allowExceptions);
+		return LoadUTF8(std::move(reader), allowExceptions);
 	}
 
 	JSON JSON::Load(std::unique_ptr<IReader>&& reader, const AllowExceptions allowExceptions)
 	{
-		TextReader textReader{ std::move(reader) };
-
-		if (not textReader)
+		if ((not reader) || (not reader->isOpen()))
 		{
 			if (allowExceptions)
 			{
@@ -1092,16 +1217,51 @@ namespace s3d
 			return JSON::Invalid();
 		}
 
-		return Parse(textReader.readAll(), allowExceptions);
+		return LoadUTF8(std::move(reader), allowExceptions);
 	}
 
 	JSON JSON::Parse(const StringView str, const AllowExceptions allowExceptions)
 	{
+		const std::string utf8 = Unicode::ToUTF8(str);
+
+		return ParseUTF8(utf8.data(), (utf8.data() + utf8.size()), allowExceptions);
+	}
+
+	JSON JSON::LoadUTF8(std::unique_ptr<IReader>&& reader, const AllowExceptions allowExceptions)
+	{
+		const TextEncoding encoding = Unicode::GetTextEncoding(*reader);
+
+		// UTF-16 のファイルは従来どおり TextReader で変換してからパースする
+		if ((encoding == TextEncoding::UTF16LE) || (encoding == TextEncoding::UTF16BE))
+		{
+			return Parse(TextReader{ std::move(reader) }.readAll(), allowExceptions);
+		}
+
+		reader->skip(Unicode::GetBOMSize(encoding));
+
+		std::string buffer(static_cast<size_t>(Max<int64>(0, (reader->size() - reader->getPos()))), '\0');
+		buffer.resize(static_cast<size_t>(Max<int64>(0, reader->read(buffer.data(), static_cast<int64>(buffer.size())))));
+
+		return ParseUTF8(buffer.data(), detail::FindTextEnd(buffer.data(), (buffer.data() + buffer.size())), allowExceptions);
+	}
+
+	JSON JSON::ParseUTF8(const char* begin, const char* end, const AllowExceptions allowExceptions)
+	{
+		// 不正な UTF-8 は、TextReader と同様に U+FFFD に置き換えてからパースする
+		std::string replaced;
+
+		if (not detail::IsValidUTF8(begin, end))
+		{
+			replaced = Unicode::ToUTF8(Unicode::FromUTF8(std::string_view(begin, (end - begin))));
+			begin = replaced.data();
+			end = (replaced.data() + replaced.size());
+		}
+
 		JSON value{ Invalid_{} };
 
 		try
 		{
-			value.m_detail = std::make_shared<detail::JSONDetail>(detail::JSONDetail::Value(), nlohmann::json::parse(Unicode::ToUTF8(str)));
+			value.m_detail = std::make_shared<detail::JSONDetail>(detail::JSONDetail::Value(), nlohmann::json::parse(begin, end));
 			value.m_isValid = true;
 		}
 		catch (const std::exception& e)
@@ -1117,6 +1277,72 @@ namespace s3d
 		return value;
 	}
 
+	bool JSON::ForEachImpl(const FilePathView path, const StringView jsonPointer, const std::function<bool(const JSON&)>& callback, const AllowExceptions allowExceptions)
+	{
+		auto reader = std::make_unique<BinaryReader>(path);
+
+		if (not reader->isOpen())
+		{
+			if (allowExceptions)
+			{
+				throw Error{ U"JSON::ForEach(): failed to open `{}`"_fmt(path) };
+			}
+
+			return false;
+		}
+
+		return ForEachImpl(std::move(reader), jsonPointer, callback, allowExceptions);
+	}
+
+	bool JSON::ForEachImpl(std::unique_ptr<IReader>&& reader, const StringView jsonPointer, const std::function<bool(const JSON&)>& callback, const AllowExceptions allowExceptions)
+	{
+		const auto onError = [&](const String& message)
+		{
+			if (allowExceptions)
+			{
+				throw Error{ U"JSON::ForEach(): " + message };
+			}
+
+			return false;
+		};
+
+		if ((not reader) || (not reader->isOpen()))
+		{
+			return onError(U"failed to open from IReader");
+		}
+
+		const auto target = detail::SplitJSONPointer(Unicode::ToUTF8(jsonPointer));
+
+		if (not target)
+		{
+			return onError(U"invalid JSON Pointer `{}`"_fmt(jsonPointer));
+		}
+
+		const TextEncoding encoding = Unicode::GetTextEncoding(*reader);
+
+		if ((encoding == TextEncoding::UTF16LE) || (encoding == TextEncoding::UTF16BE))
+		{
+			return onError(U"UTF-16 is not supported");
+		}
+
+		reader->skip(Unicode::GetBOMSize(encoding));
+
+		detail::IReaderStreamBuffer buffer{ *reader };
+		std::istream stream{ &buffer };
+
+		detail::JSONForEachSAX sax{ *target, [&callback](nlohmann::json&& element)
+		{
+			return callback(JSON{ std::make_shared<detail::JSONDetail>(detail::JSONDetail::Value(), std::move(element)) });
+		} };
+
+		if (nlohmann::json::sax_parse(stream, &sax) || sax.isFinished())
+		{
+			return true;
+		}
+
+		return onError(Unicode::Widen(sax.getError()));
+	}
+
 	JSON JSON::FromBSON(const Blob& bson, const AllowExceptions allowExceptions)
 	{
 		JSON value{ Invalid_{} };
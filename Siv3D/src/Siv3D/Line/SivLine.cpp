@@ -296,6 +296,29 @@ namespace s3d
 		return *this;
 	}
 
+	namespace detail
+	{
+		static void DrawLineBatch(const Line* lines, const size_t size, const float thickness, const ColorF* colors, const size_t num_colors)
+		{
+			SIV3D_ENGINE(Renderer2D)->addBatch([=](const BufferCreatorFunc& bufferCreator, Array<Vertex2DBatchOffset>&, const float, size_t& offset)
+			{
+				return Vertex2DBuilder::BuildLines(bufferCreator, lines, size, thickness, colors, num_colors, offset);
+			});
+		}
+	}
+
+	void Line::DrawBatch(const Array<Line>& lines, const double thickness, const ColorF& color)
+	{
+		detail::DrawLineBatch(lines.data(), lines.size(), static_cast<float>(thickness), &color, 1);
+	}
+
+	void Line::DrawBatch(const Array<Line>& lines, const double thickness, const Array<ColorF>& colors)
+	{
+		const size_t size = Min(lines.size(), colors.size());
+
+		detail::DrawLineBatch(lines.data(), size, static_cast<float>(thickness), colors.data(), size);
+	}
+
 	void Formatter(FormatData& formatData, const Line& value)
 	{
 		formatData.string.append(U"(("_sv);
@@ -81,5 +81,18 @@ namespace s3d
 		{
 			SIV3D_ENGINE(Logger)->setEnabled(true);
 		}
+
+		void Logger_impl::flush() const
+		{
+			if (Siv3DEngine::isActive())
+			{
+				SIV3D_ENGINE(Logger)->flush();
+			}
+		}
+
+		void Logger_impl::setOverflowPolicy(const LogOverflowPolicy policy) const
+		{
+			SIV3D_ENGINE(Logger)->setOverflowPolicy(policy);
+		}
 	}
 }
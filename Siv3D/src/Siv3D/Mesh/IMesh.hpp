@@ -10,6 +10,7 @@
 //-----------------------------------------------
 
 # pragma once
+# include <span>
 # include <Siv3D/Common.hpp>
 # include <Siv3D/Mesh.hpp>
 # include <Siv3D/MeshData.hpp>
@@ -28,6 +29,8 @@ namespace s3d
 
 		virtual Mesh::IDType create(const MeshData& meshData) = 0;
 
+		virtual Mesh::IDType create(std::span<const Vertex3D> vertices, std::span<const TriangleIndex32> indices) = 0;
+
 		virtual Mesh::IDType createDynamic(size_t vertexCount, size_t triangleCount) = 0;
 
 		virtual Mesh::IDType createDynamic(const MeshData& meshData) = 0;
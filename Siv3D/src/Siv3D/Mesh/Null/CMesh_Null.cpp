@@ -35,6 +35,11 @@ namespace s3d
 		return Mesh::IDType::NullAsset();
 	}
 
+	Mesh::IDType CMesh_Null::create(std::span<const Vertex3D>, std::span<const TriangleIndex32>)
+	{
+		return Mesh::IDType::NullAsset();
+	}
+
 	Mesh::IDType CMesh_Null::createDynamic(size_t, size_t)
 	{
 		return Mesh::IDType::NullAsset();
@@ -27,6 +27,8 @@ namespace s3d
 
 		Mesh::IDType create(const MeshData& meshData) override;
 
+		Mesh::IDType create(std::span<const Vertex3D> vertices, std::span<const TriangleIndex32> indices) override;
+
 		Mesh::IDType createDynamic(size_t vertexCount, size_t triangleCount) override;
 
 		Mesh::IDType createDynamic(const MeshData& meshData) override;
@@ -51,6 +51,12 @@ namespace s3d
 		SIV3D_ENGINE(AssetMonitor)->created();
 	}
 
+	Mesh::Mesh(const std::span<const Vertex3D> vertices, const std::span<const TriangleIndex32> indices)
+		: AssetHandle{ std::make_shared<AssetIDWrapperType>(SIV3D_ENGINE(Mesh)->create(vertices, indices)) }
+	{
+		SIV3D_ENGINE(AssetMonitor)->created();
+	}
+
 	Mesh::Mesh(Dynamic, const size_t vertexCount, const size_t triangleCount)
 		: AssetHandle{ std::make_shared<AssetIDWrapperType>(SIV3D_ENGINE(Mesh)->createDynamic(vertexCount, triangleCount)) }
 	{
@@ -601,6 +607,49 @@ namespace s3d
 	}
 
 
+	void Mesh::drawInstanced(const std::span<const Mat4x4> transforms, const ColorF& color) const
+	{
+		drawInstanced(transforms, PhongMaterial{ color, HasDiffuseTexture::No });
+	}
+
+	void Mesh::drawInstanced(const std::span<const Mat4x4> transforms, const std::span<const ColorF> colors) const
+	{
+		assert(transforms.size() == colors.size());
+
+		const uint32 indexCount = static_cast<uint32>(SIV3D_ENGINE(Mesh)->getIndexCount(m_handle->id()));
+
+		SIV3D_ENGINE(Renderer3D)->addMeshInstanced(0, indexCount, *this, PhongMaterial{ Palette::White, HasDiffuseTexture::No }, transforms, colors);
+	}
+
+	void Mesh::drawInstanced(const std::span<const Mat4x4> transforms, const PhongMaterial& material) const
+	{
+		const uint32 indexCount = static_cast<uint32>(SIV3D_ENGINE(Mesh)->getIndexCount(m_handle->id()));
+
+		SIV3D_ENGINE(Renderer3D)->addMeshInstanced(0, indexCount, *this, material, transforms, {});
+	}
+
+	void Mesh::drawInstanced(const std::span<const Mat4x4> transforms, const Texture& texture, const ColorF& color) const
+	{
+		drawInstanced(transforms, texture, PhongMaterial{ color, HasDiffuseTexture::Yes });
+	}
+
+	void Mesh::drawInstanced(const std::span<const Mat4x4> transforms, const Texture& texture, const std::span<const ColorF> colors) const
+	{
+		assert(transforms.size() == colors.size());
+
+		const uint32 indexCount = static_cast<uint32>(SIV3D_ENGINE(Mesh)->getIndexCount(m_handle->id()));
+
+		SIV3D_ENGINE(Renderer3D)->addTexturedMeshInstanced(0, indexCount, *this, texture, PhongMaterial{ Palette::White, HasDiffuseTexture::Yes }, transforms, colors);
+	}
+
+	void Mesh::drawInstanced(const std::span<const Mat4x4> transforms, const Texture& texture, const PhongMaterial& material) const
+	{
+		const uint32 indexCount = static_cast<uint32>(SIV3D_ENGINE(Mesh)->getIndexCount(m_handle->id()));
+
+		SIV3D_ENGINE(Renderer3D)->addTexturedMeshInstanced(0, indexCount, *this, texture, material, transforms, {});
+	}
+
+
 	void Mesh::swap(Mesh& other) noexcept
 	{
 		m_handle.swap(other.m_handle);
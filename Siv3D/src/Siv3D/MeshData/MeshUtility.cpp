@@ -1327,5 +1327,441 @@ namespace s3d
 		//
 		//
 		///////////////////////////////////////////////////////////////
+
+		namespace
+		{
+			// Forsyth の方法で使う LRU キャッシュのサイズ
+			constexpr size_t ForsythCacheSize = 32;
+
+			// 残りの三角形の数によるスコアを表で持つ上限
+			constexpr size_t ForsythMaxValence = 32;
+
+			[[nodiscard]]
+			float ComputeVertexScore(const int32 cachePosition, const uint32 remainingValence) noexcept
+			{
+				static const auto tables = []()
+				{
+					std::pair<std::array<float, ForsythCacheSize>, std::array<float, (ForsythMaxValence + 1)>> result{};
+
+					for (size_t i = 0; i < ForsythCacheSize; ++i)
+					{
+						// 直前の三角形の頂点は、どれを選んでも同じなので固定のスコア
+						result.first[i] = (i < 3) ? 0.75f
+							: std::pow((1.0f - static_cast<float>(i - 3) / static_cast<float>(ForsythCacheSize - 3)), 1.5f);
+					}
+
+					for (size_t i = 1; i <= ForsythMaxValence; ++i)
+					{
+						// 残りの三角形が少ない頂点を優先して使い切る
+						result.second[i] = (2.0f / std::sqrt(static_cast<float>(i)));
+					}
+
+					return result;
+				}();
+
+				if (remainingValence == 0)
+				{
+					return -1.0f;
+				}
+
+				const float cacheScore = (0 <= cachePosition) ? tables.first[cachePosition] : 0.0f;
+				const float valenceScore = tables.second[Min<size_t>(remainingValence, ForsythMaxValence)];
+				return (cacheScore + valenceScore);
+			}
+
+			// 直近 cacheSize 回に読み込まれた頂点をキャッシュにあるとみなす FIFO キャッシュ
+			class FIFOVertexCache
+			{
+			public:
+
+				FIFOVertexCache(const size_t vertexCount, const size_t cacheSize)
+					: m_timestamps(vertexCount, 0)
+					, m_cacheSize{ static_cast<uint32>(cacheSize) }
+					, m_timestamp{ static_cast<uint32>(cacheSize + 1) } {}
+
+				[[nodiscard]]
+				uint32 access(const TriangleIndex32& triangle) noexcept
+				{
+					return (access(triangle.i0) + access(triangle.i1) + access(triangle.i2));
+				}
+
+				void flush() noexcept
+				{
+					m_timestamp += (m_cacheSize + 1);
+				}
+
+			private:
+
+				Array<uint32> m_timestamps;
+
+				uint32 m_cacheSize;
+
+				uint32 m_timestamp;
+
+				[[nodiscard]]
+				uint32 access(const uint32 vertex) noexcept
+				{
+					if (m_cacheSize < (m_timestamp - m_timestamps[vertex]))
+					{
+						m_timestamps[vertex] = m_timestamp++;
+						return 1;
+					}
+
+					return 0;
+				}
+			};
+		}
+
+		void OptimizeFacesForVertexCache(Array<TriangleIndex32>& indices, const size_t vertexCount)
+		{
+			const size_t triangleCount = indices.size();
+
+			if ((triangleCount == 0) || (vertexCount == 0))
+			{
+				return;
+			}
+
+			// 頂点ごとに、その頂点を使う三角形の一覧を作る
+			Array<uint32> remainingValence(vertexCount, 0);
+			{
+				for (const auto& triangle : indices)
+				{
+					++remainingValence[triangle.i0];
+					++remainingValence[triangle.i1];
+					++remainingValence[triangle.i2];
+				}
+			}
+
+			Array<uint32> triangleOffsets(vertexCount, 0);
+			{
+				uint32 offset = 0;
+
+				for (size_t i = 0; i < vertexCount; ++i)
+				{
+					triangleOffsets[i] = offset;
+					offset += remainingValence[i];
+				}
+			}
+
+			Array<uint32> vertexTriangles(triangleCount * 3);
+			{
+				Array<uint32> counts(vertexCount, 0);
+
+				for (uint32 t = 0; t < triangleCount; ++t)
+				{
+					for (const uint32 v : { indices[t].i0, indices[t].i1, indices[t].i2 })
+					{
+						vertexTriangles[triangleOffsets[v] + counts[v]++] = t;
+					}
+				}
+			}
+
+			Array<int32> cachePositions(vertexCount, -1);
+			Array<float> vertexScores(vertexCount);
+			{
+				for (size_t i = 0; i < vertexCount; ++i)
+				{
+					vertexScores[i] = ComputeVertexScore(-1, remainingValence[i]);
+				}
+			}
+
+			Array<float> triangleScores(triangleCount);
+			Array<bool> triangleAdded(triangleCount, false);
+			size_t bestTriangle = 0;
+			{
+				for (size_t t = 0; t < triangleCount; ++t)
+				{
+					const auto& triangle = indices[t];
+					triangleScores[t] = (vertexScores[triangle.i0] + vertexScores[triangle.i1] + vertexScores[triangle.i2]);
+
+					if (triangleScores[bestTriangle] < triangleScores[t])
+					{
+						bestTriangle = t;
+					}
+				}
+			}
+
+			Array<TriangleIndex32> result(Arg::reserve = triangleCount);
+			Array<uint32> cache(Arg::reserve = (ForsythCacheSize + 3));
+			Array<uint32> newCache(Arg::reserve = (ForsythCacheSize + 3));
+			size_t nextTriangle = 0;
+
+			while (result.size() < triangleCount)
+			{
+				// キャッシュ内の頂点からつながる三角形が無い場合は、入力の順で次の三角形を使う
+				if (bestTriangle == triangleCount)
+				{
+					while (triangleAdded[nextTriangle])
+					{
+						++nextTriangle;
+					}
+
+					bestTriangle = nextTriangle;
+				}
+
+				const TriangleIndex32 triangle = indices[bestTriangle];
+				triangleAdded[bestTriangle] = true;
+				result.push_back(triangle);
+
+				newCache.clear();
+
+				for (const uint32 v : { triangle.i0, triangle.i1, triangle.i2 })
+				{
+					// 頂点の三角形の一覧から、追加した三角形を取り除く
+					uint32* const pBegin = (vertexTriangles.data() + triangleOffsets[v]);
+					uint32* const pEnd = (pBegin + remainingValence[v]);
+					std::iter_swap(std::find(pBegin, pEnd, static_cast<uint32>(bestTriangle)), (pEnd - 1));
+					--remainingValence[v];
+
+					newCache.push_back(v);
+				}
+
+				for (const uint32 v : cache)
+				{
+					if ((v != triangle.i0) && (v != triangle.i1) && (v != triangle.i2))
+					{
+						newCache.push_back(v);
+					}
+				}
+
+				// キャッシュからあふれた頂点も含めてスコアを更新する
+				for (size_t i = 0; i < newCache.size(); ++i)
+				{
+					const uint32 v = newCache[i];
+					cachePositions[v] = (i < ForsythCacheSize) ? static_cast<int32>(i) : -1;
+					vertexScores[v] = ComputeVertexScore(cachePositions[v], remainingValence[v]);
+				}
+
+				bestTriangle = triangleCount;
+				float bestScore = -1.0f;
+
+				for (const uint32 v : newCache)
+				{
+					const uint32* const pBegin = (vertexTriangles.data() + triangleOffsets[v]);
+					const uint32* const pEnd = (pBegin + remainingValence[v]);
+
+					for (const uint32* p = pBegin; p != pEnd; ++p)
+					{
+						const auto& t = indices[*p];
+						const float score = (vertexScores[t.i0] + vertexScores[t.i1] + vertexScores[t.i2]);
+						triangleScores[*p] = score;
+
+						if (bestScore < score)
+						{
+							bestTriangle = *p;
+							bestScore = score;
+						}
+					}
+				}
+
+				newCache.resize(Min(newCache.size(), ForsythCacheSize));
+				cache.swap(newCache);
+			}
+
+			indices = std::move(result);
+		}
+
+		void OptimizeFacesForOverdraw(Array<TriangleIndex32>& indices, const Array<Vertex3D>& vertices, const float threshold)
+		{
+			const size_t triangleCount = indices.size();
+
+			if (triangleCount == 0)
+			{
+				return;
+			}
+
+			// キャッシュがほぼ空になった位置 (3 頂点ともミスした三角形) で分割する
+			Array<size_t> hardBoundaries;
+			{
+				FIFOVertexCache fifo{ vertices.size(), DefaultVertexCacheSize };
+
+				for (size_t t = 0; t < triangleCount; ++t)
+				{
+					if ((fifo.access(indices[t]) == 3) || (t == 0))
+					{
+						hardBoundaries << t;
+					}
+				}
+
+				hardBoundaries << triangleCount;
+			}
+
+			// ACMR の悪化が threshold 倍に収まる範囲で、さらに細かく分割する
+			Array<size_t> clusters;
+			{
+				FIFOVertexCache fifo{ vertices.size(), DefaultVertexCacheSize };
+
+				for (size_t i = 0; (i + 1) < hardBoundaries.size(); ++i)
+				{
+					const size_t begin = hardBoundaries[i];
+					const size_t end = hardBoundaries[i + 1];
+
+					size_t clusterMisses = 0;
+					{
+						fifo.flush();
+
+						for (size_t t = begin; t < end; ++t)
+						{
+							clusterMisses += fifo.access(indices[t]);
+						}
+					}
+
+					const double limit = (threshold * static_cast<double>(clusterMisses) / static_cast<double>(end - begin));
+					size_t subBegin = begin;
+					size_t subMisses = 0;
+					fifo.flush();
+					clusters << begin;
+
+					for (size_t t = begin; (t + 1) < end; ++t)
+					{
+						subMisses += fifo.access(indices[t]);
+
+						if ((static_cast<double>(subMisses) / static_cast<double>(t + 1 - subBegin)) <= limit)
+						{
+							clusters << (t + 1);
+							subBegin = (t + 1);
+							subMisses = 0;
+							fifo.flush();
+						}
+					}
+				}
+
+				clusters << triangleCount;
+			}
+
+			Float3 meshCentroid{ 0, 0, 0 };
+			{
+				for (const auto& vertex : vertices)
+				{
+					meshCentroid += vertex.pos;
+				}
+
+				meshCentroid /= static_cast<float>(vertices.size());
+			}
+
+			// メッシュの中心から見て外側を向いているまとまりほど、先に描く
+			const size_t clusterCount = (clusters.size() - 1);
+			Array<std::pair<float, size_t>> order(clusterCount);
+			{
+				for (size_t i = 0; i < clusterCount; ++i)
+				{
+					Float3 centroid{ 0, 0, 0 };
+					Float3 normal{ 0, 0, 0 };
+					float area = 0.0f;
+
+					for (size_t t = clusters[i]; t < clusters[i + 1]; ++t)
+					{
+						const Float3& p0 = vertices[indices[t].i0].pos;
+						const Float3& p1 = vertices[indices[t].i1].pos;
+						const Float3& p2 = vertices[indices[t].i2].pos;
+						const Float3 n = (p1 - p0).cross(p2 - p0);
+						const float triangleArea = n.length();
+
+						centroid += ((p0 + p1 + p2) * (triangleArea / 3.0f));
+						normal += n;
+						area += triangleArea;
+					}
+
+					float score = 0.0f;
+
+					if ((0.0f < area) && (not normal.isZero()))
+					{
+						score = ((centroid / area) - meshCentroid).dot(normal.normalized());
+					}
+
+					order[i] = { score, i };
+				}
+
+				std::stable_sort(order.begin(), order.end(), [](const auto& a, const auto& b) { return (b.first < a.first); });
+			}
+
+			Array<TriangleIndex32> result(Arg::reserve = triangleCount);
+			{
+				for (const auto& [score, i] : order)
+				{
+					result.insert(result.end(), (indices.begin() + clusters[i]), (indices.begin() + clusters[i + 1]));
+				}
+			}
+
+			indices = std::move(result);
+		}
+
+		bool OptimizeVertexOrder(MeshData& meshData)
+		{
+			const size_t nFaces = meshData.indices.size();
+			const size_t nVerts = meshData.vertices.size();
+
+			if ((nFaces == 0) || (nVerts == 0))
+			{
+				return false;
+			}
+
+			Array<uint32> vertexRemap(nVerts);
+			size_t trailingUnused = 0;
+
+			if (not OptimizeVertices(&meshData.indices.front().i0, nFaces, nVerts, vertexRemap.data(), &trailingUnused))
+			{
+				return false;
+			}
+
+			Array<Vertex3D> vertices(nVerts - trailingUnused);
+
+			if (not CompactVB(meshData.vertices.data(), sizeof(Vertex3D), nVerts, trailingUnused, vertexRemap.data(), vertices.data()))
+			{
+				return false;
+			}
+
+			// vertexRemap は [新しいインデックス] = 元のインデックス なので、逆引きの表を作る
+			Array<uint32> newIndices(nVerts, UNUSED32);
+			{
+				for (uint32 i = 0; i < vertices.size(); ++i)
+				{
+					newIndices[vertexRemap[i]] = i;
+				}
+			}
+
+			for (auto& triangle : meshData.indices)
+			{
+				triangle.i0 = newIndices[triangle.i0];
+				triangle.i1 = newIndices[triangle.i1];
+				triangle.i2 = newIndices[triangle.i2];
+			}
+
+			meshData.vertices = std::move(vertices);
+
+			return true;
+		}
+
+		void OptimizeMesh(MeshData& meshData)
+		{
+			if (not meshData.indices)
+			{
+				return;
+			}
+
+			OptimizeFacesForVertexCache(meshData.indices, meshData.vertices.size());
+
+			OptimizeFacesForOverdraw(meshData.indices, meshData.vertices);
+
+			OptimizeVertexOrder(meshData);
+		}
+
+		double ComputeACMR(const Array<TriangleIndex32>& indices, const size_t vertexCount, const size_t cacheSize)
+		{
+			if (not indices)
+			{
+				return 0.0;
+			}
+
+			FIFOVertexCache fifo{ vertexCount, cacheSize };
+			size_t misses = 0;
+
+			for (const auto& triangle : indices)
+			{
+				misses += fifo.access(triangle);
+			}
+
+			return (static_cast<double>(misses) / static_cast<double>(indices.size()));
+		}
 	}
 }
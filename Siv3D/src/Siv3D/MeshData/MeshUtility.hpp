@@ -93,5 +93,38 @@ namespace s3d
 		//
 		//
 		///////////////////////////////////////////////////////////////
+
+		/// @brief 頂点キャッシュの効率を調べるときの、標準的な FIFO キャッシュのサイズ
+		inline constexpr size_t DefaultVertexCacheSize = 16;
+
+		/// @brief 頂点キャッシュのヒット率が高くなるように、三角形の順番を並べ替えます。
+		/// @param indices 三角形のインデックス
+		/// @param vertexCount 頂点の個数
+		/// @remark Tom Forsyth, "Linear-Speed Vertex Cache Optimisation" の方法を使います。
+		void OptimizeFacesForVertexCache(Array<TriangleIndex32>& indices, size_t vertexCount);
+
+		/// @brief 頂点キャッシュの効率を保ちながら、外側を向いた三角形のまとまりが先に描かれるように並べ替えます。
+		/// @param indices OptimizeFacesForVertexCache() で並べ替えた三角形のインデックス
+		/// @param vertices 頂点
+		/// @param threshold まとまりを分割するときに許容する ACMR の悪化の割合
+		/// @remark Sander et al., "Fast Triangle Reordering for Vertex Locality and Reduced Overdraw" の方法を使います。
+		void OptimizeFacesForOverdraw(Array<TriangleIndex32>& indices, const Array<Vertex3D>& vertices, float threshold = 1.05f);
+
+		/// @brief 三角形から最初に参照される順に頂点を並べ替え、使われていない頂点を削除します。
+		/// @param meshData メッシュ
+		/// @return 並べ替えに成功した場合 true, それ以外の場合は false
+		bool OptimizeVertexOrder(MeshData& meshData);
+
+		/// @brief 三角形の並べ替えと頂点の並べ替えを順に行い、描画に適した順番にします。
+		/// @param meshData メッシュ
+		void OptimizeMesh(MeshData& meshData);
+
+		/// @brief FIFO 頂点キャッシュでの、三角形あたりの平均キャッシュミス数 (ACMR) を返します。
+		/// @param indices 三角形のインデックス
+		/// @param vertexCount 頂点の個数
+		/// @param cacheSize キャッシュのサイズ
+		/// @return ACMR. 最良で 0.5 前後、最悪で 3.0
+		[[nodiscard]]
+		double ComputeACMR(const Array<TriangleIndex32>& indices, size_t vertexCount, size_t cacheSize = DefaultVertexCacheSize);
 	}
 }
@@ -47,13 +47,13 @@ namespace s3d
 		}
 	}
 
-	Model::IDType CModel::create(const FilePathView path, const ColorOption colorOption)
+	Model::IDType CModel::create(const FilePathView path, const ColorOption colorOption, const UseCache useCache)
 	{
 	# if SIV3D_PLATFORM(WEB)
 		Platform::Web::FetchFile(path);
 	# endif
 
-		auto model = std::make_unique<ModelData>(path, colorOption);
+		auto model = std::make_unique<ModelData>(path, colorOption, useCache);
 
 		if (not model->isInitialized())
 		{
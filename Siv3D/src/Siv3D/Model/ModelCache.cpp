@@ -0,0 +1,612 @@
+﻿//-----------------------------------------------
+//
+//	This file is part of the Siv3D Engine.
+//
+//	Copyright (c) 2008-2022 Ryo Suzuki
+//	Copyright (c) 2016-2022 OpenSiv3D Project
+//
+//	Licensed under the MIT License.
+//
+//-----------------------------------------------
+
+# include <Siv3D/FileSystem.hpp>
+# include <Siv3D/MemoryMappedFileView.hpp>
+# include <Siv3D/BinaryReader.hpp>
+# include <Siv3D/BinaryWriter.hpp>
+# include <Siv3D/Unicode.hpp>
+# include <Siv3D/Hash.hpp>
+# include <Siv3D/Mesh.hpp>
+# include <Siv3D/EngineLog.hpp>
+# include "ModelCache.hpp"
+
+namespace s3d
+{
+	namespace detail
+	{
+		// キャッシュファイルの形式が変わったら更新する
+		constexpr uint32 ModelCacheFileVersion = 1;
+
+		constexpr char ModelCacheFileSignature[8] = { 'S', '3', 'D', 'M', 'O', 'D', 'E', 'L' };
+
+		// 頂点とインデックスの配置の境界
+		constexpr uint64 ModelCacheDataAlignment = 16;
+
+		struct ModelCacheFileHeader
+		{
+			char signature[8];
+
+			uint32 version;
+
+			// 構造体のレイアウトが異なる環境で書き込まれたファイルを区別する
+			uint32 vertexSize;
+
+			ModelCache::SourceKey key;
+
+			uint32 numMaterials;
+
+			uint32 numObjects;
+
+			// 頂点とインデックスのデータの、ファイルの先頭からの位置
+			uint64 dataOffset;
+
+			uint64 dataSize;
+
+			Sphere boundingSphere;
+
+			Box boundingBox;
+		};
+
+		struct ModelCacheMaterialHeader
+		{
+			ColorF ambient;
+
+			ColorF diffuse;
+
+			ColorF specular;
+
+			ColorF transmittance;
+
+			ColorF emission;
+
+			float shininess;
+
+			float ior;
+
+			float dissolve;
+
+			int32 illum;
+
+			// テクスチャのパスが、キャッシュファイルからの相対パスであるかを表すビット（ambient, diffuse, specular, normal の順）
+			uint32 relativeTextureMask;
+
+			uint32 padding;
+		};
+
+		struct ModelCacheObjectHeader
+		{
+			Sphere boundingSphere;
+
+			Box boundingBox;
+
+			uint32 numParts;
+
+			uint32 padding;
+		};
+
+		struct ModelCachePartHeader
+		{
+			// マテリアルが無い場合は -1
+			int64 materialID;
+
+			uint32 numVertices;
+
+			uint32 numTriangles;
+
+			// データの開始位置からのオフセット
+			uint64 vertexOffset;
+
+			uint64 indexOffset;
+		};
+
+		class MappedFileReader
+		{
+		public:
+
+			explicit MappedFileReader(const MemoryMappedFileView& view) noexcept
+				: m_pos{ view.data() }
+				, m_end{ view.data() + view.mappedSize() } {}
+
+			[[nodiscard]]
+			bool read(void* dst, const size_t size) noexcept
+			{
+				if (static_cast<size_t>(m_end - m_pos) < size)
+				{
+					return false;
+				}
+
+				std::memcpy(dst, m_pos, size);
+				m_pos += size;
+				return true;
+			}
+
+			template <class Type>
+			[[nodiscard]]
+			bool read(Type& dst) noexcept
+			{
+				return read(&dst, sizeof(Type));
+			}
+
+			[[nodiscard]]
+			bool readString(String& dst)
+			{
+				uint32 length = 0;
+
+				if ((not read(length))
+					|| (static_cast<size_t>(m_end - m_pos) < length))
+				{
+					return false;
+				}
+
+				dst = Unicode::FromUTF8(std::string_view{ reinterpret_cast<const char*>(m_pos), length });
+				m_pos += length;
+				return true;
+			}
+
+			/// @brief まだ読み込んでいないサイズ（バイト）を返します。
+			[[nodiscard]]
+			size_t remaining() const noexcept
+			{
+				return static_cast<size_t>(m_end - m_pos);
+			}
+
+		private:
+
+			const Byte* m_pos;
+
+			const Byte* m_end;
+		};
+
+		// 1 つのマテリアルが占める最小のサイズ（ヘッダと、空の名前 5 つ）
+		constexpr size_t ModelCacheMinMaterialSize = (sizeof(ModelCacheMaterialHeader) + sizeof(uint32) * 5);
+
+		// 1 つのオブジェクトが占める最小のサイズ（空の名前とヘッダ）
+		constexpr size_t ModelCacheMinObjectSize = (sizeof(uint32) + sizeof(ModelCacheObjectHeader));
+
+		[[nodiscard]]
+		static bool WriteBytes(BinaryWriter& writer, const void* src, const size_t size)
+		{
+			return (writer.write(src, static_cast<int64>(size)) == static_cast<int64>(size));
+		}
+
+		[[nodiscard]]
+		static bool WriteString(BinaryWriter& writer, const StringView s)
+		{
+			const std::string utf8 = Unicode::ToUTF8(s);
+			return (writer.write(static_cast<uint32>(utf8.size()))
+				&& WriteBytes(writer, utf8.data(), utf8.size()));
+		}
+
+		[[nodiscard]]
+		static bool WritePadding(BinaryWriter& writer, const uint64 alignedPos)
+		{
+			constexpr Byte Zeros[ModelCacheDataAlignment]{};
+			return WriteBytes(writer, Zeros, static_cast<size_t>(alignedPos - writer.getPos()));
+		}
+
+		[[nodiscard]]
+		static constexpr uint64 AlignData(const uint64 offset) noexcept
+		{
+			return ((offset + (ModelCacheDataAlignment - 1)) / ModelCacheDataAlignment * ModelCacheDataAlignment);
+		}
+
+		// OBJ ファイルの mtllib 行に書かれた MTL ファイルの名前を返す
+		[[nodiscard]]
+		static Array<std::string> GetMaterialLibraries(const char* pos, const char* const end)
+		{
+			constexpr auto IsSpace = [](const char ch) { return ((ch == ' ') || (ch == '\t')); };
+			constexpr auto IsLineEnd = [](const char ch) { return ((ch == '\n') || (ch == '\r')); };
+
+			Array<std::string> results;
+
+			while (pos < end)
+			{
+				while ((pos < end) && IsSpace(*pos))
+				{
+					++pos;
+				}
+
+				if ((6 < (end - pos)) && (std::memcmp(pos, "mtllib", 6) == 0) && IsSpace(pos[6]))
+				{
+					pos += 6;
+
+					while ((pos < end) && (not IsLineEnd(*pos)))
+					{
+						while ((pos < end) && IsSpace(*pos))
+						{
+							++pos;
+						}
+
+						const char* const nameBegin = pos;
+
+						while ((pos < end) && (not IsSpace(*pos)) && (not IsLineEnd(*pos)))
+						{
+							++pos;
+						}
+
+						if (nameBegin != pos)
+						{
+							results.emplace_back(nameBegin, pos);
+						}
+					}
+				}
+
+				while ((pos < end) && (not IsLineEnd(*pos)))
+				{
+					++pos;
+				}
+
+				while ((pos < end) && IsLineEnd(*pos))
+				{
+					++pos;
+				}
+			}
+
+			return results;
+		}
+
+		[[nodiscard]]
+		static uint64 HashFile(const FilePathView path)
+		{
+			const MemoryMappedFileView view{ path };
+
+			if (not view)
+			{
+				return 0;
+			}
+
+			return Hash::XXHash3(view.data(), view.mappedSize());
+		}
+
+		[[nodiscard]]
+		static bool WriteModelCache(BinaryWriter& writer, const ModelSource& source, const ModelCache::SourceKey& key, const FilePathView sourcePath, uint64& fileSize)
+		{
+			// ヘッダは最後に書き込む。途中で失敗したファイルはシグネチャが一致しない
+			ModelCacheFileHeader header{};
+
+			if (not writer.write(header))
+			{
+				return false;
+			}
+
+			const FilePath baseDirectory = FileSystem::ParentPath(sourcePath);
+
+			for (const auto& material : source.materials)
+			{
+				const String* textureNames[4] = { &material.ambientTextureName, &material.diffuseTextureName, &material.specularTextureName, &material.normalTextureName };
+
+				ModelCacheMaterialHeader materialHeader{};
+				materialHeader.ambient			= material.ambient;
+				materialHeader.diffuse			= material.diffuse;
+				materialHeader.specular			= material.specular;
+				materialHeader.transmittance	= material.transmittance;
+				materialHeader.emission			= material.emission;
+				materialHeader.shininess		= material.shininess;
+				materialHeader.ior				= material.ior;
+				materialHeader.dissolve			= material.dissolve;
+				materialHeader.illum			= material.illum;
+
+				for (size_t i = 0; i < std::size(textureNames); ++i)
+				{
+					if (baseDirectory && textureNames[i]->starts_with(baseDirectory))
+					{
+						materialHeader.relativeTextureMask |= (1u << i);
+					}
+				}
+
+				if ((not writer.write(materialHeader))
+					|| (not WriteString(writer, material.name)))
+				{
+					return false;
+				}
+
+				for (size_t i = 0; i < std::size(textureNames); ++i)
+				{
+					const StringView name = *textureNames[i];
+
+					if (not WriteString(writer, ((materialHeader.relativeTextureMask >> i) & 1u) ? name.substr(baseDirectory.size()) : name))
+					{
+						return false;
+					}
+				}
+			}
+
+			uint64 dataSize = 0;
+
+			for (const auto& object : source.objects)
+			{
+				if ((not WriteString(writer, object.name))
+					|| (not writer.write(ModelCacheObjectHeader{ object.boundingSphere, object.boundingBox, static_cast<uint32>(object.parts.size()), 0 })))
+				{
+					return false;
+				}
+
+				for (const auto& part : object.parts)
+				{
+					ModelCachePartHeader partHeader{};
+					partHeader.materialID	= (part.materialID ? static_cast<int64>(*part.materialID) : -1);
+					partHeader.numVertices	= static_cast<uint32>(part.meshData.vertices.size());
+					partHeader.numTriangles	= static_cast<uint32>(part.meshData.indices.size());
+					partHeader.vertexOffset	= dataSize;
+					dataSize = AlignData(dataSize + part.meshData.vertices.size_bytes());
+					partHeader.indexOffset	= dataSize;
+					dataSize = AlignData(dataSize + part.meshData.indices.size_bytes());
+
+					if (not writer.write(partHeader))
+					{
+						return false;
+					}
+				}
+			}
+
+			const uint64 dataOffset = AlignData(writer.getPos());
+
+			if (not WritePadding(writer, dataOffset))
+			{
+				return false;
+			}
+
+			for (const auto& object : source.objects)
+			{
+				for (const auto& part : object.parts)
+				{
+					if ((not WriteBytes(writer, part.meshData.vertices.data(), part.meshData.vertices.size_bytes()))
+						|| (not WritePadding(writer, AlignData(writer.getPos())))
+						|| (not WriteBytes(writer, part.meshData.indices.data(), part.meshData.indices.size_bytes()))
+						|| (not WritePadding(writer, AlignData(writer.getPos()))))
+					{
+						return false;
+					}
+				}
+			}
+
+			std::memcpy(header.signature, ModelCacheFileSignature, sizeof(header.signature));
+			header.version			= ModelCacheFileVersion;
+			header.vertexSize		= sizeof(Vertex3D);
+			header.key				= key;
+			header.numMaterials		= static_cast<uint32>(source.materials.size());
+			header.numObjects		= static_cast<uint32>(source.objects.size());
+			header.dataOffset		= dataOffset;
+			header.dataSize			= dataSize;
+			header.boundingSphere	= source.boundingSphere;
+			header.boundingBox		= source.boundingBox;
+
+			if ((not writer.setPos(0))
+				|| (not writer.write(header)))
+			{
+				return false;
+			}
+
+			writer.flush();
+			fileSize = (dataOffset + dataSize);
+			return true;
+		}
+	}
+
+	namespace ModelCache
+	{
+		Optional<SourceKey> MakeSourceKey(const FilePathView sourcePath, const ColorOption colorOption)
+		{
+			const MemoryMappedFileView view{ sourcePath };
+
+			if (not view)
+			{
+				return none;
+			}
+
+			// OBJ ファイルと MTL ファイルのどれかが変更されたら、キーも変わる
+			Array<uint64> hashes = { Hash::XXHash3(view.data(), view.mappedSize()) };
+			{
+				const char* const pBegin = reinterpret_cast<const char*>(view.data());
+				const FilePath baseDirectory = FileSystem::ParentPath(sourcePath);
+
+				for (const auto& name : detail::GetMaterialLibraries(pBegin, (pBegin + view.mappedSize())))
+				{
+					hashes << detail::HashFile(baseDirectory + Unicode::FromUTF8(name));
+				}
+			}
+
+			return SourceKey{ .sourceHash = Hash::XXHash3(hashes.data(), hashes.size_bytes()), .colorOption = static_cast<uint32>(colorOption) };
+		}
+
+		FilePath GetCachePath(const FilePathView sourcePath)
+		{
+			return (FilePath{ sourcePath } + U'.' + Extension);
+		}
+
+		bool IsCacheFile(const FilePathView path)
+		{
+			BinaryReader reader{ path };
+			char signature[8];
+
+			return (reader.read(signature)
+				&& (std::memcmp(signature, detail::ModelCacheFileSignature, sizeof(signature)) == 0));
+		}
+
+		bool Save(const FilePathView path, const ModelSource& source, const SourceKey& key, const FilePathView sourcePath)
+		{
+			uint64 fileSize = 0;
+			bool result = false;
+			{
+				BinaryWriter writer{ path };
+
+				if (not writer)
+				{
+					LOG_FAIL(U"ModelCache::Save(): Failed to open `{}`"_fmt(path));
+					return false;
+				}
+
+				result = detail::WriteModelCache(writer, source, key, sourcePath, fileSize);
+			}
+
+			if (not result)
+			{
+				// 途中までしか書き込めなかったファイルは残さない
+				LOG_FAIL(U"ModelCache::Save(): Failed to write `{}`"_fmt(path));
+				FileSystem::Remove(path);
+				return false;
+			}
+
+			LOG_TRACE(U"ModelCache::Save(): `{}` saved ({} bytes)"_fmt(path, fileSize));
+			return true;
+		}
+
+		bool Load(const FilePathView path, const Optional<SourceKey>& expectedKey,
+			Array<ModelObject>& objects, Array<Material>& materials, Sphere& boundingSphere, Box& boundingBox)
+		{
+			const MemoryMappedFileView view{ path };
+
+			if (not view)
+			{
+				return false;
+			}
+
+			detail::MappedFileReader reader{ view };
+			detail::ModelCacheFileHeader header;
+
+			if ((not reader.read(header))
+				|| (std::memcmp(header.signature, detail::ModelCacheFileSignature, sizeof(header.signature)) != 0)
+				|| (header.version != detail::ModelCacheFileVersion)
+				|| (header.vertexSize != sizeof(Vertex3D))
+				|| (header.dataOffset % detail::ModelCacheDataAlignment)
+				|| (view.mappedSize() < header.dataOffset)
+				|| ((view.mappedSize() - header.dataOffset) < header.dataSize))
+			{
+				LOG_WARNING(U"ModelCache::Load(): `{}` is not compatible"_fmt(path));
+				return false;
+			}
+
+			if (expectedKey && (std::memcmp(&header.key, &(*expectedKey), sizeof(SourceKey)) != 0))
+			{
+				LOG_TRACE(U"ModelCache::Load(): `{}` is out of date"_fmt(path));
+				return false;
+			}
+
+			// 壊れたファイルで巨大な配列を確保しないよう、個数を残りのサイズで制限する
+			if ((reader.remaining() / detail::ModelCacheMinMaterialSize) < header.numMaterials)
+			{
+				LOG_WARNING(U"ModelCache::Load(): `{}` is broken"_fmt(path));
+				return false;
+			}
+
+			const FilePath baseDirectory = FileSystem::ParentPath(path);
+			Array<Material> loadedMaterials(header.numMaterials);
+
+			for (auto& material : loadedMaterials)
+			{
+				detail::ModelCacheMaterialHeader materialHeader;
+				String* textureNames[4] = { &material.ambientTextureName, &material.diffuseTextureName, &material.specularTextureName, &material.normalTextureName };
+
+				if ((not reader.read(materialHeader))
+					|| (not reader.readString(material.name)))
+				{
+					LOG_WARNING(U"ModelCache::Load(): `{}` is broken"_fmt(path));
+					return false;
+				}
+
+				material.ambient		= materialHeader.ambient;
+				material.diffuse		= materialHeader.diffuse;
+				material.specular		= materialHeader.specular;
+				material.transmittance	= materialHeader.transmittance;
+				material.emission		= materialHeader.emission;
+				material.shininess		= materialHeader.shininess;
+				material.ior			= materialHeader.ior;
+				material.dissolve		= materialHeader.dissolve;
+				material.illum			= materialHeader.illum;
+
+				for (size_t i = 0; i < std::size(textureNames); ++i)
+				{
+					if (not reader.readString(*textureNames[i]))
+					{
+						LOG_WARNING(U"ModelCache::Load(): `{}` is broken"_fmt(path));
+						return false;
+					}
+
+					if ((materialHeader.relativeTextureMask >> i) & 1u)
+					{
+						textureNames[i]->insert(0, baseDirectory);
+					}
+				}
+			}
+
+			if ((reader.remaining() / detail::ModelCacheMinObjectSize) < header.numObjects)
+			{
+				LOG_WARNING(U"ModelCache::Load(): `{}` is broken"_fmt(path));
+				return false;
+			}
+
+			const Byte* const pData = (view.data() + header.dataOffset);
+			Array<ModelObject> loadedObjects(header.numObjects);
+
+			for (auto& object : loadedObjects)
+			{
+				detail::ModelCacheObjectHeader objectHeader;
+
+				if ((not reader.readString(object.name))
+					|| (not reader.read(objectHeader)))
+				{
+					LOG_WARNING(U"ModelCache::Load(): `{}` is broken"_fmt(path));
+					return false;
+				}
+
+				object.boundingSphere = objectHeader.boundingSphere;
+				object.boundingBox = objectHeader.boundingBox;
+
+				for (uint32 i = 0; i < objectHeader.numParts; ++i)
+				{
+					detail::ModelCachePartHeader partHeader;
+
+					if ((not reader.read(partHeader))
+						|| (partHeader.numVertices == 0)
+						|| (partHeader.numTriangles == 0)
+						|| (not InRange<int64>(partHeader.materialID, -1, (static_cast<int64>(header.numMaterials) - 1)))
+						|| (partHeader.vertexOffset % detail::ModelCacheDataAlignment)
+						|| (partHeader.indexOffset % detail::ModelCacheDataAlignment)
+						|| (header.dataSize < partHeader.vertexOffset)
+						|| ((header.dataSize - partHeader.vertexOffset) < (uint64{ partHeader.numVertices } * sizeof(Vertex3D)))
+						|| (header.dataSize < partHeader.indexOffset)
+						|| ((header.dataSize - partHeader.indexOffset) < (uint64{ partHeader.numTriangles } * sizeof(TriangleIndex32))))
+					{
+						LOG_WARNING(U"ModelCache::Load(): `{}` is broken"_fmt(path));
+						return false;
+					}
+
+					// ファイルのマップは 16 バイト境界にそろっているので、そのまま頂点とインデックスとして扱える
+					const std::span<const Vertex3D> vertices{ reinterpret_cast<const Vertex3D*>(pData + partHeader.vertexOffset), partHeader.numVertices };
+					const std::span<const TriangleIndex32> indices{ reinterpret_cast<const TriangleIndex32*>(pData + partHeader.indexOffset), partHeader.numTriangles };
+
+					// 壊れたインデックスを GPU に渡さない
+					const TriangleIndex32::value_type* const pIndices = &indices.front().i0;
+
+					if (std::any_of(pIndices, (pIndices + (indices.size() * 3)), [n = partHeader.numVertices](const uint32 index) { return (n <= index); }))
+					{
+						LOG_WARNING(U"ModelCache::Load(): `{}` is broken"_fmt(path));
+						return false;
+					}
+
+					object.parts.push_back(ModelMeshPart{
+						.mesh = Mesh{ vertices, indices },
+						.materialID = ((partHeader.materialID < 0) ? none : Optional<size_t>{ static_cast<size_t>(partHeader.materialID) }),
+					});
+				}
+			}
+
+			LOG_TRACE(U"ModelCache::Load(): `{}` loaded"_fmt(path));
+
+			objects = std::move(loadedObjects);
+			materials = std::move(loadedMaterials);
+			boundingSphere = header.boundingSphere;
+			boundingBox = header.boundingBox;
+			return true;
+		}
+	}
+}
@@ -0,0 +1,112 @@
+﻿//-----------------------------------------------
+//
+//	This file is part of the Siv3D Engine.
+//
+//	Copyright (c) 2008-2022 Ryo Suzuki
+//	Copyright (c) 2016-2022 OpenSiv3D Project
+//
+//	Licensed under the MIT License.
+//
+//-----------------------------------------------
+
+# pragma once
+# include <Siv3D/Common.hpp>
+# include <Siv3D/Array.hpp>
+# include <Siv3D/String.hpp>
+# include <Siv3D/Optional.hpp>
+# include <Siv3D/MeshData.hpp>
+# include <Siv3D/ModelObject.hpp>
+# include <Siv3D/Material.hpp>
+# include <Siv3D/ColorOption.hpp>
+
+namespace s3d
+{
+	/// @brief GPU に転送する前の 3D モデルのデータ
+	struct ModelSource
+	{
+		struct Part
+		{
+			MeshData meshData;
+
+			Optional<size_t> materialID;
+		};
+
+		struct Object
+		{
+			String name;
+
+			Array<Part> parts;
+
+			Sphere boundingSphere{ 0.0 };
+
+			Box boundingBox{ 0.0 };
+		};
+
+		Array<Object> objects;
+
+		Array<Material> materials;
+
+		Sphere boundingSphere{ 0.0 };
+
+		Box boundingBox{ 0.0 };
+	};
+
+	/// @brief 3D モデルのキャッシュファイル（.s3dmodel）
+	/// @remark ヘッダ、マテリアル、オブジェクトとパーツの情報の後に、16 バイト境界にそろえた頂点とインデックスを並べます。
+	namespace ModelCache
+	{
+		/// @brief キャッシュファイルの拡張子
+		inline constexpr StringView Extension = U"s3dmodel";
+
+		/// @brief キャッシュが作成元のファイルに対応しているかを調べるためのキー
+		struct SourceKey
+		{
+			/// @brief OBJ ファイルと、それが参照する MTL ファイルの内容のハッシュ値
+			uint64 sourceHash = 0;
+
+			uint32 colorOption = 0;
+
+			uint32 reserved = 0;
+		};
+
+		/// @brief 作成元のファイルのキーを計算します。
+		/// @param sourcePath OBJ ファイルのパス
+		/// @param colorOption 色空間
+		/// @return キー。ファイルが読み込めない場合は none
+		[[nodiscard]]
+		Optional<SourceKey> MakeSourceKey(FilePathView sourcePath, ColorOption colorOption);
+
+		/// @brief 作成元のファイルと同じフォルダに置く、キャッシュファイルのパスを返します。
+		/// @param sourcePath OBJ ファイルのパス
+		/// @return キャッシュファイルのパス
+		[[nodiscard]]
+		FilePath GetCachePath(FilePathView sourcePath);
+
+		/// @brief ファイルがキャッシュファイルの形式であるかを返します。
+		/// @param path ファイルのパス
+		/// @return キャッシュファイルの形式である場合 true, それ以外の場合は false
+		[[nodiscard]]
+		bool IsCacheFile(FilePathView path);
+
+		/// @brief モデルをキャッシュファイルに書き出します。
+		/// @param path 書き出すファイルのパス
+		/// @param source モデルのデータ
+		/// @param key 作成元のファイルのキー
+		/// @param sourcePath 作成元のファイルのパス（テクスチャのパスを、このファイルからの相対パスで保存します）
+		/// @return 書き出しに成功した場合 true, それ以外の場合は false
+		bool Save(FilePathView path, const ModelSource& source, const SourceKey& key, FilePathView sourcePath);
+
+		/// @brief キャッシュファイルを読み込みます。
+		/// @param path キャッシュファイルのパス
+		/// @param expectedKey 作成元のファイルのキー。none の場合は調べません。
+		/// @param objects 読み込んだオブジェクトの格納先
+		/// @param materials 読み込んだマテリアルの格納先
+		/// @param boundingSphere 読み込んだバウンディングスフィアの格納先
+		/// @param boundingBox 読み込んだバウンディングボックスの格納先
+		/// @return 読み込みに成功した場合 true, それ以外の場合は false
+		/// @remark 頂点とインデックスは、ファイルをマップしたメモリから直接 GPU に転送します。
+		[[nodiscard]]
+		bool Load(FilePathView path, const Optional<SourceKey>& expectedKey,
+			Array<ModelObject>& objects, Array<Material>& materials, Sphere& boundingSphere, Box& boundingBox);
+	}
+}
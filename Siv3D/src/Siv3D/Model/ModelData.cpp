@@ -10,271 +10,390 @@
 //-----------------------------------------------
 
 # include "ModelData.hpp"
+# include "ModelCache.hpp"
 # include <Siv3D/FileSystem.hpp>
 # include <Siv3D/Unicode.hpp>
 # include <Siv3D/MeshData.hpp>
 # include <Siv3D/Geometry3D.hpp>
 # include <Siv3D/SIMDCollision.hpp>
 # include <Siv3D/EngineLog.hpp>
+# include <Siv3D/HashTable.hpp>
+# include <Siv3D/Hash.hpp>
+# include <Siv3D/Stopwatch.hpp>
+# include <Siv3D/MeshData/MeshUtility.hpp>
 # include <ThirdParty/tinyobjloader/tiny_obj_loader.h>
 
 namespace s3d
 {
-	ModelData::ModelData()
+	namespace detail
 	{
-		// [Siv3D ToDo]
+		/// @brief OBJ の頂点を区別するキー
+		struct ObjVertexKey
+		{
+			int32 position;
 
-		m_initialized = true;
-	}
+			int32 normal;
 
-	ModelData::ModelData(const FilePathView path, const ColorOption colorOption)
-	{
-		tinyobj::ObjReaderConfig reader_config;
+			int32 texcoord;
+
+			[[nodiscard]]
+			friend constexpr bool operator ==(const ObjVertexKey&, const ObjVertexKey&) noexcept = default;
+		};
+
+		struct ObjVertexKeyHash
 		{
-			reader_config.vertex_color = false;
-			reader_config.mtl_search_path = FileSystem::ParentPath(path).narrow();
-		}
+			[[nodiscard]]
+			size_t operator()(const ObjVertexKey& key) const noexcept
+			{
+				return Hash::FNV1a(key);
+			}
+		};
 
-		tinyobj::ObjReader reader;
+		/// @brief 同じ頂点を共有しながら、メッシュを組み立てるクラス
+		class ObjMeshBuilder
 		{
-			if (not reader.ParseFromFile(path.narrow(), reader_config))
+		public:
+
+			void addTriangle(const ObjVertexKey(&keys)[3], const Vertex3D(&vertices)[3], const TriangleIndex32& order)
 			{
-				if (not reader.Error().empty())
+				Vertex3D::IndexType indices[3];
+
+				for (size_t i = 0; i < 3; ++i)
 				{
-					LOG_FAIL(U"TinyObjReader: " + Unicode::Widen(reader.Error()));
+					const auto [it, inserted] = m_table.try_emplace(keys[i], static_cast<Vertex3D::IndexType>(m_meshData.vertices.size()));
 
-					return;
+					if (inserted)
+					{
+						m_meshData.vertices << vertices[i];
+					}
+
+					indices[i] = it->second;
 				}
+
+				m_meshData.indices.push_back({ indices[order.i0], indices[order.i1], indices[order.i2] });
 			}
 
-			if (not reader.Warning().empty())
+			[[nodiscard]]
+			MeshData& meshData() noexcept
 			{
-				LOG_WARNING(U"TinyObjReader: " + Unicode::Widen(reader.Warning()));
+				return m_meshData;
 			}
-		}
 
+		private:
+
+			MeshData m_meshData;
+
+			HashTable<ObjVertexKey, Vertex3D::IndexType, ObjVertexKeyHash> m_table;
+		};
+
+		[[nodiscard]]
+		static bool LoadObj(const FilePathView path, const ColorOption colorOption, ModelSource& source)
 		{
-			const auto& materials = reader.GetMaterials();
-			m_materials.reserve(materials.size());
+			const Stopwatch stopwatch{ StartImmediately::Yes };
 
-			for (const auto& m : materials)
+			tinyobj::ObjReaderConfig reader_config;
 			{
-				Material mtl;
-				mtl.name = Unicode::Widen(m.name);
-				mtl.ambient.set(m.ambient[0], m.ambient[1], m.ambient[2]);
-				mtl.diffuse.set(m.diffuse[0], m.diffuse[1], m.diffuse[2]);
-				mtl.specular.set(m.specular[0], m.specular[1], m.specular[2]);
-				mtl.transmittance.set(m.transmittance[0], m.transmittance[1], m.transmittance[2]);
-				mtl.emission.set(m.emission[0], m.emission[1], m.emission[2]);
-				mtl.shininess = m.shininess;
-				mtl.ior = m.ior;
-				mtl.dissolve = m.dissolve;
-				mtl.illum = m.illum;
-
-				if (colorOption == ColorOption::ApplySRGBCurve)
-				{
-					mtl.ambient = mtl.ambient.applySRGBCurve();
-					mtl.diffuse = mtl.diffuse.applySRGBCurve();
-					mtl.specular = mtl.specular.applySRGBCurve();
-					mtl.emission = mtl.emission.applySRGBCurve();
-				}
+				reader_config.vertex_color = false;
+				reader_config.mtl_search_path = FileSystem::ParentPath(path).narrow();
+			}
 
-				if (not m.ambient_texname.empty())
+			tinyobj::ObjReader reader;
+			{
+				if (not reader.ParseFromFile(path.narrow(), reader_config))
 				{
-					mtl.ambientTextureName = Unicode::FromUTF8(reader_config.mtl_search_path + m.ambient_texname);
-				}
+					if (not reader.Error().empty())
+					{
+						LOG_FAIL(U"TinyObjReader: " + Unicode::Widen(reader.Error()));
 
-				if (not m.diffuse_texname.empty())
-				{
-					mtl.diffuseTextureName = Unicode::FromUTF8(reader_config.mtl_search_path + m.diffuse_texname);
+						return false;
+					}
 				}
 
-				if (not m.specular_texname.empty())
+				if (not reader.Warning().empty())
 				{
-					mtl.specularTextureName = Unicode::FromUTF8(reader_config.mtl_search_path + m.specular_texname);
+					LOG_WARNING(U"TinyObjReader: " + Unicode::Widen(reader.Warning()));
 				}
+			}
 
-				if (not m.normal_texname.empty())
+			{
+				const auto& materials = reader.GetMaterials();
+				source.materials.reserve(materials.size());
+
+				for (const auto& m : materials)
 				{
-					mtl.normalTextureName = Unicode::FromUTF8(reader_config.mtl_search_path + m.normal_texname);
-				}
+					Material mtl;
+					mtl.name = Unicode::Widen(m.name);
+					mtl.ambient.set(m.ambient[0], m.ambient[1], m.ambient[2]);
+					mtl.diffuse.set(m.diffuse[0], m.diffuse[1], m.diffuse[2]);
+					mtl.specular.set(m.specular[0], m.specular[1], m.specular[2]);
+					mtl.transmittance.set(m.transmittance[0], m.transmittance[1], m.transmittance[2]);
+					mtl.emission.set(m.emission[0], m.emission[1], m.emission[2]);
+					mtl.shininess = m.shininess;
+					mtl.ior = m.ior;
+					mtl.dissolve = m.dissolve;
+					mtl.illum = m.illum;
+
+					if (colorOption == ColorOption::ApplySRGBCurve)
+					{
+						mtl.ambient = mtl.ambient.applySRGBCurve();
+						mtl.diffuse = mtl.diffuse.applySRGBCurve();
+						mtl.specular = mtl.specular.applySRGBCurve();
+						mtl.emission = mtl.emission.applySRGBCurve();
+					}
 
-				m_materials << mtl;
-			}
-		}
+					if (not m.ambient_texname.empty())
+					{
+						mtl.ambientTextureName = Unicode::FromUTF8(reader_config.mtl_search_path + m.ambient_texname);
+					}
 
-		{
-			const auto& attrib = reader.GetAttrib();
-			const auto& shapes = reader.GetShapes();
-			m_objects.resize(shapes.size());
+					if (not m.diffuse_texname.empty())
+					{
+						mtl.diffuseTextureName = Unicode::FromUTF8(reader_config.mtl_search_path + m.diffuse_texname);
+					}
+
+					if (not m.specular_texname.empty())
+					{
+						mtl.specularTextureName = Unicode::FromUTF8(reader_config.mtl_search_path + m.specular_texname);
+					}
+
+					if (not m.normal_texname.empty())
+					{
+						mtl.normalTextureName = Unicode::FromUTF8(reader_config.mtl_search_path + m.normal_texname);
+					}
+
+					source.materials << mtl;
+				}
+			}
 
-			for (size_t s = 0; s < shapes.size(); ++s)
 			{
-				const auto& shape = shapes[s];
-				m_objects[s].name = Unicode::FromUTF8(shape.name);
+				const auto& attrib = reader.GetAttrib();
+				const auto& shapes = reader.GetShapes();
+				source.objects.resize(shapes.size());
 
-				Array<MeshData> objMeshes(m_materials.size());
-				MeshData noMaterialObjMesh;
-				Vertex3D::IndexType index_offset = 0;
+				size_t numVertices = 0;
+				size_t numTriangles = 0;
+				double numCacheMisses = 0.0;
 
-				for (size_t f = 0; f < shape.mesh.num_face_vertices.size(); ++f)
+				for (size_t s = 0; s < shapes.size(); ++s)
 				{
-					const Vertex3D::IndexType fv = Vertex3D::IndexType(shape.mesh.num_face_vertices[f]);
+					const auto& shape = shapes[s];
+					source.objects[s].name = Unicode::FromUTF8(shape.name);
 
-					Vertex3D vertices[3];
+					Array<detail::ObjMeshBuilder> objMeshes(source.materials.size());
+					detail::ObjMeshBuilder noMaterialObjMesh;
+					Vertex3D::IndexType index_offset = 0;
 
-					// Loop over vertices in the face.
-					for (Vertex3D::IndexType v = 0; v < fv; v++)
+					for (size_t f = 0; f < shape.mesh.num_face_vertices.size(); ++f)
 					{
-						auto& vertex = vertices[v];
+						const Vertex3D::IndexType fv = Vertex3D::IndexType(shape.mesh.num_face_vertices[f]);
 
-						// access to vertex
-						const tinyobj::index_t idx = shape.mesh.indices[index_offset + v];
-						const tinyobj::real_t vx = attrib.vertices[3 * size_t(idx.vertex_index) + 0];
-						const tinyobj::real_t vy = attrib.vertices[3 * size_t(idx.vertex_index) + 1];
-						const tinyobj::real_t vz = -attrib.vertices[3 * size_t(idx.vertex_index) + 2];
+						Vertex3D vertices[3];
+						detail::ObjVertexKey keys[3];
 
-						vertex.pos.set(vx, vy, vz);
-
-						// Check if `normal_index` is zero or positive. negative = no normal data
-						if (idx.normal_index >= 0)
-						{
-							const tinyobj::real_t nx = attrib.normals[3 * size_t(idx.normal_index) + 0];
-							const tinyobj::real_t ny = attrib.normals[3 * size_t(idx.normal_index) + 1];
-							const tinyobj::real_t nz = -attrib.normals[3 * size_t(idx.normal_index) + 2];
-
-							vertex.normal.set(nx, ny, nz);
-						}
-						else
+						// Loop over vertices in the face.
+						for (Vertex3D::IndexType v = 0; v < fv; v++)
 						{
-							vertex.normal.set(0.0f, 0.0f, 0.0f);
+							auto& vertex = vertices[v];
+
+							// access to vertex
+							const tinyobj::index_t idx = shape.mesh.indices[index_offset + v];
+							const tinyobj::real_t vx = attrib.vertices[3 * size_t(idx.vertex_index) + 0];
+							const tinyobj::real_t vy = attrib.vertices[3 * size_t(idx.vertex_index) + 1];
+							const tinyobj::real_t vz = -attrib.vertices[3 * size_t(idx.vertex_index) + 2];
+
+							vertex.pos.set(vx, vy, vz);
+
+							// Check if `normal_index` is zero or positive. negative = no normal data
+							if (idx.normal_index >= 0)
+							{
+								const tinyobj::real_t nx = attrib.normals[3 * size_t(idx.normal_index) + 0];
+								const tinyobj::real_t ny = attrib.normals[3 * size_t(idx.normal_index) + 1];
+								const tinyobj::real_t nz = -attrib.normals[3 * size_t(idx.normal_index) + 2];
+
+								vertex.normal.set(nx, ny, nz);
+							}
+							else
+							{
+								vertex.normal.set(0.0f, 0.0f, 0.0f);
+							}
+
+							// Check if `texcoord_index` is zero or positive. negative = no texcoord data
+							if (idx.texcoord_index >= 0)
+							{
+								const tinyobj::real_t tx = attrib.texcoords[2 * size_t(idx.texcoord_index) + 0];
+								const tinyobj::real_t ty = (1.0f - attrib.texcoords[2 * size_t(idx.texcoord_index) + 1]);
+
+								vertex.tex.set(tx, ty);
+							}
+							else
+							{
+								vertex.tex.set(0.0f, 0.0f);
+							}
+
+							// 法線が無い頂点は面ごとに別の頂点とし、computeNormals() の結果を従来と同じフラットな法線にする
+							keys[v] =
+							{
+								.position = idx.vertex_index,
+								.normal = ((idx.normal_index >= 0) ? idx.normal_index : -1 - static_cast<int32>(f)),
+								.texcoord = idx.texcoord_index,
+							};
 						}
 
-						// Check if `texcoord_index` is zero or positive. negative = no texcoord data
-						if (idx.texcoord_index >= 0)
+						// per-face material
+						if (const int32 materialID = shape.mesh.material_ids[f];
+							0 <= materialID)
 						{
-							const tinyobj::real_t tx = attrib.texcoords[2 * size_t(idx.texcoord_index) + 0];
-							const tinyobj::real_t ty = (1.0f - attrib.texcoords[2 * size_t(idx.texcoord_index) + 1]);
-
-							vertex.tex.set(tx, ty);
+							objMeshes[materialID].addTriangle(keys, vertices, { 0, 2, 1 });
 						}
 						else
 						{
-							vertex.tex.set(0.0f, 0.0f);
+							noMaterialObjMesh.addTriangle(keys, vertices, { 0, 1, 2 });
 						}
-					}
 
-					// per-face material
-					if (const int32 materialID = shape.mesh.material_ids[f];
-						0 <= materialID)
-					{
-						auto& meshData = objMeshes[materialID];
-						const Vertex3D::IndexType baseIndex = static_cast<Vertex3D::IndexType>(meshData.vertices.size());
-						meshData.vertices.insert(meshData.vertices.end(), std::begin(vertices), std::end(vertices));
-						meshData.indices.insert(meshData.indices.end(), { baseIndex, baseIndex + 2, baseIndex + 1 });
+						index_offset += fv;
 					}
-					else
+
+					for (size_t materialID = 0; materialID < source.materials.size(); ++materialID)
 					{
-						auto& meshData = noMaterialObjMesh;
-						const Vertex3D::IndexType baseIndex = static_cast<Vertex3D::IndexType>(meshData.vertices.size());
-						meshData.vertices.insert(meshData.vertices.end(), std::begin(vertices), std::end(vertices));
-						meshData.indices.insert(meshData.indices.end(), { baseIndex, baseIndex + 1, baseIndex + 2 });
-					}
+						auto& meshData = objMeshes[materialID].meshData();
 
-					index_offset += fv;
-				}
+						if (meshData.vertices)
+						{
+							if (meshData.vertices.any([](const Vertex3D& v) { return v.normal.isZero(); }))
+							{
+								meshData.computeNormals();
+							}
 
-				for (size_t materialID = 0; materialID < m_materials.size(); ++materialID)
-				{
-					auto& meshData = objMeshes[materialID];
+							MeshUtility::OptimizeMesh(meshData);
+							numVertices += meshData.vertices.size();
+							numTriangles += meshData.indices.size();
+							numCacheMisses += (MeshUtility::ComputeACMR(meshData.indices, meshData.vertices.size()) * meshData.indices.size());
 
-					if (meshData.vertices)
-					{
-						if (meshData.vertices.any([](const Vertex3D& v) { return v.normal.isZero(); }))
-						{
-							meshData.computeNormals();
+							source.objects[s].parts.push_back({ .meshData = std::move(meshData), .materialID = materialID });
 						}
+					}
 
-						ModelMeshPart part
+					{
+						auto& meshData = noMaterialObjMesh.meshData();
+
+						if (meshData.vertices)
 						{
-							.mesh = Mesh{ meshData },
-							.materialID = materialID,
-						};
+							if (meshData.vertices.any([](const Vertex3D& v) { return v.normal.isZero(); }))
+							{
+								meshData.computeNormals();
+							}
+
+							MeshUtility::OptimizeMesh(meshData);
+							numVertices += meshData.vertices.size();
+							numTriangles += meshData.indices.size();
+							numCacheMisses += (MeshUtility::ComputeACMR(meshData.indices, meshData.vertices.size()) * meshData.indices.size());
 
-						m_objects[s].parts.push_back(std::move(part));
+							source.objects[s].parts.push_back({ .meshData = std::move(meshData), .materialID = none });
+						}
 					}
 				}
 
+				LOG_INFO(U"ModelData: `{}` loaded in {:.1f} ms ({} vertices, {} triangles, ACMR: {:.3f})"_fmt(
+					path, stopwatch.msF(), numVertices, numTriangles, (numTriangles ? (numCacheMisses / numTriangles) : 0.0)));
+			}
+
+			// bounding spheres & boxes (per object)
+			for (auto& object : source.objects)
+			{
+				if (object.parts)
 				{
-					if (noMaterialObjMesh.vertices)
-					{
-						if (noMaterialObjMesh.vertices.any([](const Vertex3D& v) { return v.normal.isZero(); }))
-						{
-							noMaterialObjMesh.computeNormals();
-						}
+					DirectX::BoundingSphere sphere = 
+						detail::FromSphere(Geometry3D::BoundingSphere(object.parts[0].meshData.vertices));
+					DirectX::BoundingBox box =
+						detail::FromBox(Geometry3D::BoundingBox(object.parts[0].meshData.vertices));
 
-						ModelMeshPart part
-						{
-							.mesh = Mesh{ noMaterialObjMesh },
-							.materialID = none,
-						};
+					for (size_t i = 1; i < object.parts.size(); ++i)
+					{
+						const auto& vertices = object.parts[i].meshData.vertices;
+						const DirectX::BoundingSphere currentSphere = detail::FromSphere(Geometry3D::BoundingSphere(vertices));	
+						const DirectX::BoundingBox currentBox = detail::FromBox(Geometry3D::BoundingBox(vertices));
 
-						m_objects[s].parts.push_back(std::move(part));
+						DirectX::BoundingSphere::CreateMerged(sphere, sphere, currentSphere);
+						DirectX::BoundingBox::CreateMerged(box, box, currentBox);
 					}
+
+					object.boundingSphere = detail::ToSphere(sphere);
+					object.boundingBox = detail::ToBox(box);
 				}
 			}
-		}
 
-		// bounding spheres & boxes (per object)
-		for (auto& object : m_objects)
-		{
-			if (object.parts)
+			// bounding spheres & boxes (model)
 			{
-				DirectX::BoundingSphere sphere = 
-					detail::FromSphere(object.parts[0].mesh.boundingSphere());
-				DirectX::BoundingBox box =
-					detail::FromBox(object.parts[0].mesh.boundingBox());
-
-				for (size_t i = 1; i < object.parts.size(); ++i)
+				if (source.objects)
 				{
-					const auto& mesh = object.parts[i].mesh;
-					const DirectX::BoundingSphere currentSphere = detail::FromSphere(mesh.boundingSphere());	
-					const DirectX::BoundingBox currentBox = detail::FromBox(mesh.boundingBox());
+					DirectX::BoundingSphere sphere =
+						detail::FromSphere(source.objects[0].boundingSphere);
+					DirectX::BoundingBox box =
+						detail::FromBox(source.objects[0].boundingBox);
 
-					DirectX::BoundingSphere::CreateMerged(sphere, sphere, currentSphere);
-					DirectX::BoundingBox::CreateMerged(box, box, currentBox);
-				}
+					for (size_t i = 1; i < source.objects.size(); ++i)
+					{
+						const auto& object = source.objects[i];
+						const DirectX::BoundingSphere currentSphere = detail::FromSphere(object.boundingSphere);
+						const DirectX::BoundingBox currentBox = detail::FromBox(object.boundingBox);
 
-				object.boundingSphere = detail::ToSphere(sphere);
-				object.boundingBox = detail::ToBox(box);
+						DirectX::BoundingSphere::CreateMerged(sphere, sphere, currentSphere);
+						DirectX::BoundingBox::CreateMerged(box, box, currentBox);
+					}
+
+					source.boundingSphere = detail::ToSphere(sphere);
+					source.boundingBox = detail::ToBox(box);
+				}
 			}
+
+			return true;
 		}
+	}
+
+	ModelData::ModelData()
+	{
+		// [Siv3D ToDo]
 
-		// bounding spheres & boxes (model)
+		m_initialized = true;
+	}
+
+	ModelData::ModelData(const FilePathView path, const ColorOption colorOption, const UseCache useCache)
+	{
+		// Model::Bake() で作成したファイル
+		if (ModelCache::IsCacheFile(path))
 		{
-			if (m_objects)
-			{
-				DirectX::BoundingSphere sphere =
-					detail::FromSphere(m_objects[0].boundingSphere);
-				DirectX::BoundingBox box =
-					detail::FromBox(m_objects[0].boundingBox);
+			m_initialized = ModelCache::Load(path, none, m_objects, m_materials, m_boundingSphere, m_boundingBox);
+			return;
+		}
 
-				for (size_t i = 1; i < m_objects.size(); ++i)
-				{
-					const auto& object = m_objects[i];
-					const DirectX::BoundingSphere currentSphere = detail::FromSphere(object.boundingSphere);
-					const DirectX::BoundingBox currentBox = detail::FromBox(object.boundingBox);
+		Optional<ModelCache::SourceKey> key;
+		FilePath cachePath;
 
-					DirectX::BoundingSphere::CreateMerged(sphere, sphere, currentSphere);
-					DirectX::BoundingBox::CreateMerged(box, box, currentBox);
-				}
+		if (useCache)
+		{
+			key = ModelCache::MakeSourceKey(path, colorOption);
+			cachePath = ModelCache::GetCachePath(path);
 
-				m_boundingSphere = detail::ToSphere(sphere);
-				m_boundingBox = detail::ToBox(box);
+			if (key && ModelCache::Load(cachePath, key, m_objects, m_materials, m_boundingSphere, m_boundingBox))
+			{
+				m_initialized = true;
+				return;
 			}
 		}
 
-		m_initialized = true;
+		ModelSource source;
+
+		if (not detail::LoadObj(path, colorOption, source))
+		{
+			return;
+		}
+
+		if (key)
+		{
+			ModelCache::Save(cachePath, source, *key, path);
+		}
+
+		init(source);
 	}
 
 	ModelData::~ModelData()
@@ -306,4 +425,49 @@ namespace s3d
 	{
 		return m_boundingBox;
 	}
+
+	bool ModelData::Bake(const FilePathView sourcePath, const FilePathView outputPath, const ColorOption colorOption)
+	{
+		const Optional<ModelCache::SourceKey> key = ModelCache::MakeSourceKey(sourcePath, colorOption);
+
+		if (not key)
+		{
+			return false;
+		}
+
+		ModelSource source;
+
+		if (not detail::LoadObj(sourcePath, colorOption, source))
+		{
+			return false;
+		}
+
+		return ModelCache::Save(outputPath, source, *key, sourcePath);
+	}
+
+	void ModelData::init(ModelSource& source)
+	{
+		m_objects.resize(source.objects.size());
+
+		for (size_t i = 0; i < source.objects.size(); ++i)
+		{
+			auto& object = source.objects[i];
+			m_objects[i].name = std::move(object.name);
+			m_objects[i].boundingSphere = object.boundingSphere;
+			m_objects[i].boundingBox = object.boundingBox;
+
+			for (auto& part : object.parts)
+			{
+				m_objects[i].parts.push_back({ .mesh = Mesh{ part.meshData }, .materialID = part.materialID });
+
+				// GPU に転送したデータは、すぐに解放する
+				part.meshData = MeshData{};
+			}
+		}
+
+		m_materials = std::move(source.materials);
+		m_boundingSphere = source.boundingSphere;
+		m_boundingBox = source.boundingBox;
+		m_initialized = true;
+	}
 }
@@ -15,9 +15,12 @@
 # include <Siv3D/ModelObject.hpp>
 # include <Siv3D/Material.hpp>
 # include <Siv3D/ColorOption.hpp>
+# include <Siv3D/PredefinedYesNo.hpp>
 
 namespace s3d
 {
+	struct ModelSource;
+
 	class ModelData
 	{
 	public:
@@ -26,7 +29,7 @@ namespace s3d
 		explicit ModelData();
 
 		SIV3D_NODISCARD_CXX20
-		ModelData(FilePathView path, ColorOption colorOption);
+		ModelData(FilePathView path, ColorOption colorOption, UseCache useCache);
 
 		~ModelData();
 
@@ -45,6 +48,14 @@ namespace s3d
 		[[nodiscard]]
 		const Box& getBoundingBox() const noexcept;
 
+		/// @brief OBJ ファイルを読み込み、キャッシュファイルの形式で書き出します。
+		/// @param sourcePath OBJ ファイルのパス
+		/// @param outputPath 書き出すファイルのパス
+		/// @param colorOption 色空間
+		/// @return 書き出しに成功した場合 true, それ以外の場合は false
+		[[nodiscard]]
+		static bool Bake(FilePathView sourcePath, FilePathView outputPath, ColorOption colorOption);
+
 	private:
 
 		Array<ModelObject> m_objects;
@@ -56,5 +67,7 @@ namespace s3d
 		Box m_boundingBox{ 0.0 };
 
 		bool m_initialized = false;
+
+		void init(ModelSource& source);
 	};
 }
@@ -13,6 +13,7 @@
 # include <Siv3D/TextureAsset.hpp>
 # include <Siv3D/Transformer3D.hpp>
 # include <Siv3D/Model/IModel.hpp>
+# include <Siv3D/Model/ModelData.hpp>
 # include <Siv3D/AssetMonitor/IAssetMonitor.hpp>
 # include <Siv3D/Renderer3D/IRenderer3D.hpp>
 # include <Siv3D/Common/Siv3DEngine.hpp>
@@ -47,7 +48,10 @@ namespace s3d
 	Model::Model() {}
 
 	Model::Model(const FilePathView path, const ColorOption colorOption)
-		: AssetHandle{ std::make_shared<AssetIDWrapperType>(SIV3D_ENGINE(Model)->create(path, colorOption)) }
+		: Model{ path, colorOption, UseCache::No } {}
+
+	Model::Model(const FilePathView path, const ColorOption colorOption, const UseCache useCache)
+		: AssetHandle{ std::make_shared<AssetIDWrapperType>(SIV3D_ENGINE(Model)->create(path, colorOption, useCache)) }
 	{
 		SIV3D_ENGINE(AssetMonitor)->created();
 	}
@@ -150,4 +154,9 @@ namespace s3d
 
 		return result;
 	}
+
+	bool Model::Bake(const FilePathView sourcePath, const FilePathView outputPath, const ColorOption colorOption)
+	{
+		return ModelData::Bake(sourcePath, outputPath, colorOption);
+	}
 }
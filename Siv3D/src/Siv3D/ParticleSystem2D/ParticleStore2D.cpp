@@ -0,0 +1,367 @@
+﻿//-----------------------------------------------
+//
+//	This file is part of the Siv3D Engine.
+//
+//	Copyright (c) 2008-2022 Ryo Suzuki
+//	Copyright (c) 2016-2022 OpenSiv3D Project
+//
+//	Licensed under the MIT License.
+//
+//-----------------------------------------------
+
+# include <Siv3D/Platform.hpp>
+
+// <Siv3D/SIMD.hpp> が SIMDe の別名を定義する前に読み込む
+# if (defined(_M_X64) || defined(__x86_64__)) && (not SIV3D_PLATFORM(WEB))
+#	define SIV3D_PARTICLE_SIMD 1
+#	include <immintrin.h>
+#	if defined(_MSC_VER)
+#		define SIV3D_TARGET_AVX
+#	else
+#		define SIV3D_TARGET_AVX __attribute__((target("avx")))
+#	endif
+# else
+#	define SIV3D_PARTICLE_SIMD 0
+# endif
+
+# include <algorithm>
+# include <functional>
+# include <Siv3D/CPUInfo.hpp>
+# include "ParticleStore2D.hpp"
+
+namespace s3d
+{
+	namespace detail
+	{
+		namespace
+		{
+			struct ParticleUpdateArgs
+			{
+				float* pPositionX;
+				float* pPositionY;
+				float* pVelocityX;
+				float* pVelocityY;
+				float* pRotation;
+				const float* pAngularVelocity;
+				float* pRemainingLifeTime;
+				float deltaTime;
+				Float2 deltaVelocity;
+			};
+
+			// Particle2D::update() と同じ順序で計算する
+			void UpdateParticles_Reference(const ParticleUpdateArgs& args, size_t i, const size_t size) noexcept
+			{
+				for (; i < size; ++i)
+				{
+					args.pRemainingLifeTime[i] -= args.deltaTime;
+					args.pVelocityX[i] += args.deltaVelocity.x;
+					args.pVelocityY[i] += args.deltaVelocity.y;
+					args.pPositionX[i] += (args.pVelocityX[i] * args.deltaTime);
+					args.pPositionY[i] += (args.pVelocityY[i] * args.deltaTime);
+					args.pRotation[i] += (args.pAngularVelocity[i] * args.deltaTime);
+				}
+			}
+
+		# if SIV3D_PARTICLE_SIMD
+
+			void UpdateParticles_SSE(const ParticleUpdateArgs& args, const size_t size) noexcept
+			{
+				const __m128 dt = _mm_set1_ps(args.deltaTime);
+				const __m128 dvx = _mm_set1_ps(args.deltaVelocity.x);
+				const __m128 dvy = _mm_set1_ps(args.deltaVelocity.y);
+				size_t i = 0;
+
+				for (; (i + 4) <= size; i += 4)
+				{
+					_mm_storeu_ps((args.pRemainingLifeTime + i), _mm_sub_ps(_mm_loadu_ps(args.pRemainingLifeTime + i), dt));
+
+					const __m128 vx = _mm_add_ps(_mm_loadu_ps(args.pVelocityX + i), dvx);
+					const __m128 vy = _mm_add_ps(_mm_loadu_ps(args.pVelocityY + i), dvy);
+					_mm_storeu_ps((args.pVelocityX + i), vx);
+					_mm_storeu_ps((args.pVelocityY + i), vy);
+					_mm_storeu_ps((args.pPositionX + i), _mm_add_ps(_mm_loadu_ps(args.pPositionX + i), _mm_mul_ps(vx, dt)));
+					_mm_storeu_ps((args.pPositionY + i), _mm_add_ps(_mm_loadu_ps(args.pPositionY + i), _mm_mul_ps(vy, dt)));
+					_mm_storeu_ps((args.pRotation + i), _mm_add_ps(_mm_loadu_ps(args.pRotation + i), _mm_mul_ps(_mm_loadu_ps(args.pAngularVelocity + i), dt)));
+				}
+
+				UpdateParticles_Reference(args, i, size);
+			}
+
+			SIV3D_TARGET_AVX
+			void UpdateParticles_AVX(const ParticleUpdateArgs& args, const size_t size) noexcept
+			{
+				const __m256 dt = _mm256_set1_ps(args.deltaTime);
+				const __m256 dvx = _mm256_set1_ps(args.deltaVelocity.x);
+				const __m256 dvy = _mm256_set1_ps(args.deltaVelocity.y);
+				size_t i = 0;
+
+				for (; (i + 8) <= size; i += 8)
+				{
+					_mm256_storeu_ps((args.pRemainingLifeTime + i), _mm256_sub_ps(_mm256_loadu_ps(args.pRemainingLifeTime + i), dt));
+
+					const __m256 vx = _mm256_add_ps(_mm256_loadu_ps(args.pVelocityX + i), dvx);
+					const __m256 vy = _mm256_add_ps(_mm256_loadu_ps(args.pVelocityY + i), dvy);
+					_mm256_storeu_ps((args.pVelocityX + i), vx);
+					_mm256_storeu_ps((args.pVelocityY + i), vy);
+					_mm256_storeu_ps((args.pPositionX + i), _mm256_add_ps(_mm256_loadu_ps(args.pPositionX + i), _mm256_mul_ps(vx, dt)));
+					_mm256_storeu_ps((args.pPositionY + i), _mm256_add_ps(_mm256_loadu_ps(args.pPositionY + i), _mm256_mul_ps(vy, dt)));
+					_mm256_storeu_ps((args.pRotation + i), _mm256_add_ps(_mm256_loadu_ps(args.pRotation + i), _mm256_mul_ps(_mm256_loadu_ps(args.pAngularVelocity + i), dt)));
+				}
+
+				_mm256_zeroupper();
+
+				UpdateParticles_Reference(args, i, size);
+			}
+
+		# endif
+
+			void UpdateParticles(const ParticleUpdateArgs& args, const size_t size) noexcept
+			{
+			# if SIV3D_PARTICLE_SIMD
+
+				static const bool hasAVX = GetCPUInfo().features.avx;
+
+				if (hasAVX)
+				{
+					return UpdateParticles_AVX(args, size);
+				}
+				else
+				{
+					// SSE は x64 では常に使える
+					return UpdateParticles_SSE(args, size);
+				}
+
+			# else
+
+				UpdateParticles_Reference(args, 0, size);
+
+			# endif
+			}
+		}
+	}
+
+	template <class Fty>
+	void ParticleStore2D::forEachChannel(Fty f)
+	{
+		f(m_positionX);
+		f(m_positionY);
+		f(m_velocityX);
+		f(m_velocityY);
+		f(m_rotation);
+		f(m_angularVelocity);
+		f(m_startSize);
+		f(m_startLifeTime);
+		f(m_remainingLifeTime);
+		f(m_colorR);
+		f(m_colorG);
+		f(m_colorB);
+		f(m_colorA);
+	}
+
+	size_t ParticleStore2D::size() const noexcept
+	{
+		return m_positionX.size();
+	}
+
+	bool ParticleStore2D::isEmpty() const noexcept
+	{
+		return m_positionX.isEmpty();
+	}
+
+	void ParticleStore2D::clear() noexcept
+	{
+		forEachChannel([](Array<float>& channel) { channel.clear(); });
+	}
+
+	void ParticleStore2D::reserve(const size_t n)
+	{
+		forEachChannel([=](Array<float>& channel) { channel.reserve(n); });
+	}
+
+	void ParticleStore2D::push_back(const Particle2D& particle)
+	{
+		m_positionX.push_back(particle.position.x);
+		m_positionY.push_back(particle.position.y);
+		m_velocityX.push_back(particle.velocity.x);
+		m_velocityY.push_back(particle.velocity.y);
+		m_rotation.push_back(particle.rotation);
+		m_angularVelocity.push_back(particle.startAngularVelocity);
+		m_startSize.push_back(particle.startSize);
+		m_startLifeTime.push_back(particle.startLifeTime);
+		m_remainingLifeTime.push_back(particle.remainingLifeTime);
+		m_colorR.push_back(particle.startColor.x);
+		m_colorG.push_back(particle.startColor.y);
+		m_colorB.push_back(particle.startColor.z);
+		m_colorA.push_back(particle.startColor.w);
+	}
+
+	void ParticleStore2D::update(const float deltaTime, const Float2& deltaVelocity)
+	{
+		const detail::ParticleUpdateArgs args
+		{
+			.pPositionX			= m_positionX.data(),
+			.pPositionY			= m_positionY.data(),
+			.pVelocityX			= m_velocityX.data(),
+			.pVelocityY			= m_velocityY.data(),
+			.pRotation			= m_rotation.data(),
+			.pAngularVelocity	= m_angularVelocity.data(),
+			.pRemainingLifeTime	= m_remainingLifeTime.data(),
+			.deltaTime			= deltaTime,
+			.deltaVelocity		= deltaVelocity,
+		};
+
+		detail::UpdateParticles(args, size());
+
+		// 寿命が尽きたパーティクルの位置に、末尾のパーティクルを移す
+		size_t count = size();
+
+		for (size_t i = 0; i < count;)
+		{
+			if (m_remainingLifeTime[i] < 0.0f)
+			{
+				moveParticle(--count, i);
+			}
+			else
+			{
+				++i;
+			}
+		}
+
+		resize(count);
+	}
+
+	void ParticleStore2D::removeOldest(const size_t count)
+	{
+		if (count == 0)
+		{
+			return;
+		}
+
+		const size_t num = size();
+
+		if (num <= count)
+		{
+			clear();
+			return;
+		}
+
+		// 削除する count 個のうち、最も新しいパーティクルの経過時間を求める
+		m_ages.resize(num);
+
+		for (size_t i = 0; i < num; ++i)
+		{
+			m_ages[i] = getAge(i);
+		}
+
+		std::nth_element(m_ages.begin(), (m_ages.begin() + (count - 1)), m_ages.end(), std::greater<>{});
+
+		const float threshold = m_ages[count - 1];
+
+		// 経過時間が threshold と等しいパーティクルのうち、削除する個数
+		size_t numEquals = (count - static_cast<size_t>(std::count_if(m_ages.begin(), (m_ages.begin() + count), [=](const float age) { return (threshold < age); })));
+
+		size_t n = num;
+
+		for (size_t i = 0; i < n;)
+		{
+			const float age = getAge(i);
+			bool remove = (threshold < age);
+
+			if ((not remove) && (age == threshold) && numEquals)
+			{
+				remove = true;
+				--numEquals;
+			}
+
+			if (remove)
+			{
+				moveParticle(--n, i);
+			}
+			else
+			{
+				++i;
+			}
+		}
+
+		resize(n);
+	}
+
+	Particle2D ParticleStore2D::operator [](const size_t i) const noexcept
+	{
+		Particle2D particle;
+		particle.position.set(m_positionX[i], m_positionY[i]);
+		particle.velocity.set(m_velocityX[i], m_velocityY[i]);
+		particle.startColor.set(m_colorR[i], m_colorG[i], m_colorB[i], m_colorA[i]);
+		particle.startSize = m_startSize[i];
+		particle.rotation = m_rotation[i];
+		particle.startAngularVelocity = m_angularVelocity[i];
+		particle.startLifeTime = m_startLifeTime[i];
+		particle.remainingLifeTime = m_remainingLifeTime[i];
+		return particle;
+	}
+
+	const float* ParticleStore2D::positionX() const noexcept
+	{
+		return m_positionX.data();
+	}
+
+	const float* ParticleStore2D::positionY() const noexcept
+	{
+		return m_positionY.data();
+	}
+
+	const float* ParticleStore2D::rotation() const noexcept
+	{
+		return m_rotation.data();
+	}
+
+	const float* ParticleStore2D::startSize() const noexcept
+	{
+		return m_startSize.data();
+	}
+
+	const float* ParticleStore2D::startLifeTime() const noexcept
+	{
+		return m_startLifeTime.data();
+	}
+
+	const float* ParticleStore2D::remainingLifeTime() const noexcept
+	{
+		return m_remainingLifeTime.data();
+	}
+
+	const float* ParticleStore2D::colorR() const noexcept
+	{
+		return m_colorR.data();
+	}
+
+	const float* ParticleStore2D::colorG() const noexcept
+	{
+		return m_colorG.data();
+	}
+
+	const float* ParticleStore2D::colorB() const noexcept
+	{
+		return m_colorB.data();
+	}
+
+	const float* ParticleStore2D::colorA() const noexcept
+	{
+		return m_colorA.data();
+	}
+
+	void ParticleStore2D::resize(const size_t n)
+	{
+		forEachChannel([=](Array<float>& channel) { channel.resize(n); });
+	}
+
+	void ParticleStore2D::moveParticle(const size_t from, const size_t to) noexcept
+	{
+		forEachChannel([=](Array<float>& channel) { channel[to] = channel[from]; });
+	}
+
+	float ParticleStore2D::getAge(const size_t i) const noexcept
+	{
+		return (m_startLifeTime[i] - m_remainingLifeTime[i]);
+	}
+}
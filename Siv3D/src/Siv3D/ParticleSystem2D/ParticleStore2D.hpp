@@ -0,0 +1,112 @@
+﻿//-----------------------------------------------
+//
+//	This file is part of the Siv3D Engine.
+//
+//	Copyright (c) 2008-2022 Ryo Suzuki
+//	Copyright (c) 2016-2022 OpenSiv3D Project
+//
+//	Licensed under the MIT License.
+//
+//-----------------------------------------------
+
+# pragma once
+# include <Siv3D/Common.hpp>
+# include <Siv3D/Array.hpp>
+# include <Siv3D/Particle2D.hpp>
+
+namespace s3d
+{
+	/// @brief パーティクルの状態を、要素ごとの配列 (SoA) で保持するクラス
+	/// @remark 削除は末尾の要素との入れ替えで行うため、パーティクルの並び順は保たれません。
+	class ParticleStore2D
+	{
+	public:
+
+		[[nodiscard]]
+		size_t size() const noexcept;
+
+		[[nodiscard]]
+		bool isEmpty() const noexcept;
+
+		void clear() noexcept;
+
+		void reserve(size_t n);
+
+		void push_back(const Particle2D& particle);
+
+		/// @brief すべてのパーティクルを deltaTime だけ進め、寿命が尽きたものを削除します。
+		/// @param deltaTime 経過時間（秒）
+		/// @param deltaVelocity この時間での速度の変化
+		/// @remark 実行時に CPU の対応命令セット (AVX / SSE) を調べて、最適な実装を使います。
+		void update(float deltaTime, const Float2& deltaVelocity);
+
+		/// @brief 生成されてからの時間が長い順に、count 個のパーティクルを削除します。
+		/// @param count 削除するパーティクルの個数
+		void removeOldest(size_t count);
+
+		/// @brief i 番目のパーティクルを返します。
+		/// @param i インデックス
+		/// @return i 番目のパーティクル
+		[[nodiscard]]
+		Particle2D operator [](size_t i) const noexcept;
+
+		[[nodiscard]]
+		const float* positionX() const noexcept;
+
+		[[nodiscard]]
+		const float* positionY() const noexcept;
+
+		[[nodiscard]]
+		const float* rotation() const noexcept;
+
+		[[nodiscard]]
+		const float* startSize() const noexcept;
+
+		[[nodiscard]]
+		const float* startLifeTime() const noexcept;
+
+		[[nodiscard]]
+		const float* remainingLifeTime() const noexcept;
+
+		[[nodiscard]]
+		const float* colorR() const noexcept;
+
+		[[nodiscard]]
+		const float* colorG() const noexcept;
+
+		[[nodiscard]]
+		const float* colorB() const noexcept;
+
+		[[nodiscard]]
+		const float* colorA() const noexcept;
+
+	private:
+
+		Array<float> m_positionX;
+		Array<float> m_positionY;
+		Array<float> m_velocityX;
+		Array<float> m_velocityY;
+		Array<float> m_rotation;
+		Array<float> m_angularVelocity;
+		Array<float> m_startSize;
+		Array<float> m_startLifeTime;
+		Array<float> m_remainingLifeTime;
+		Array<float> m_colorR;
+		Array<float> m_colorG;
+		Array<float> m_colorB;
+		Array<float> m_colorA;
+
+		// removeOldest() で使う作業用のバッファ
+		Array<float> m_ages;
+
+		template <class Fty>
+		void forEachChannel(Fty f);
+
+		void resize(size_t n);
+
+		void moveParticle(size_t from, size_t to) noexcept;
+
+		[[nodiscard]]
+		float getAge(size_t i) const noexcept;
+	};
+}
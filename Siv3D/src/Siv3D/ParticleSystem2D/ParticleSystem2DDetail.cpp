@@ -11,6 +11,8 @@
 
 # include <Siv3D/ScopedRenderStates2D.hpp>
 # include <Siv3D/Math.hpp>
+# include <Siv3D/ThreadPool.hpp>
+# include <Siv3D/Renderer2D/Vertex2DBuilder.hpp>
 # include <Siv3D/Renderer2D/IRenderer2D.hpp>
 # include <Siv3D/Common/Siv3DEngine.hpp>
 # include "ParticleSystem2DDetail.hpp"
@@ -30,6 +32,51 @@ namespace s3d
 		{
 			return startColor;
 		};
+
+		/// @brief スコープの間、現在のスレッドの乱数エンジンを、パーティクルシステム専用の乱数エンジンと入れ替えます。
+		/// @remark エミッターや Random() が、パーティクルシステムごとに決まった乱数列を使うようにします。
+		class ScopedRNGSwap
+		{
+		public:
+
+			explicit ScopedRNGSwap(DefaultRNG& rng) noexcept
+				: m_rng{ rng }
+			{
+				std::swap(m_rng, GetDefaultRNG());
+			}
+
+			~ScopedRNGSwap()
+			{
+				std::swap(m_rng, GetDefaultRNG());
+			}
+
+			ScopedRNGSwap(const ScopedRNGSwap&) = delete;
+
+			ScopedRNGSwap& operator =(const ScopedRNGSwap&) = delete;
+
+		private:
+
+			DefaultRNG& m_rng;
+		};
+
+		[[nodiscard]]
+		static const TriangleIndex* GetParticleIndices()
+		{
+			static const Array<TriangleIndex> indices = []()
+			{
+				Array<TriangleIndex> result(Arg::reserve = (Vertex2DBuilder::MaxParticlesPerBatch * 2));
+
+				for (Vertex2D::IndexType i = 0; i < static_cast<Vertex2D::IndexType>(Vertex2DBuilder::MaxParticlesPerBatch * 4); i += 4)
+				{
+					result.push_back({ i, static_cast<Vertex2D::IndexType>(i + 1), static_cast<Vertex2D::IndexType>(i + 2) });
+					result.push_back({ static_cast<Vertex2D::IndexType>(i + 2), static_cast<Vertex2D::IndexType>(i + 1), static_cast<Vertex2D::IndexType>(i + 3) });
+				}
+
+				return result;
+			}();
+
+			return indices.data();
+		}
 	}
 
 	ParticleSystem2D::ParticleSystem2DDetail::ParticleSystem2DDetail() {}
@@ -73,11 +120,28 @@ namespace s3d
 		m_particleTexture = texture;
 	}
 
+	void ParticleSystem2D::ParticleSystem2DDetail::setSeed(const uint64 seed) noexcept
+	{
+		m_rng.seed(seed);
+	}
+
 	size_t ParticleSystem2D::ParticleSystem2DDetail::num_particles() const noexcept
 	{
 		return m_particles.size();
 	}
 
+	Array<Particle2D> ParticleSystem2D::ParticleSystem2DDetail::getParticles() const
+	{
+		Array<Particle2D> particles(Arg::reserve = m_particles.size());
+
+		for (size_t i = 0; i < m_particles.size(); ++i)
+		{
+			particles.push_back(m_particles[i]);
+		}
+
+		return particles;
+	}
+
 	void ParticleSystem2D::ParticleSystem2DDetail::prewarm()
 	{
 		if (not m_emitter)
@@ -142,82 +206,172 @@ namespace s3d
 		drawDebugParticle();
 	}
 
-	void ParticleSystem2D::ParticleSystem2DDetail::updateCurrentparticles(float deltaTime)
+	void ParticleSystem2D::ParticleSystem2DDetail::DrawAll(const std::span<const ParticleSystem2D> systems)
 	{
-		const Float2 deltaVelocity = (m_force * deltaTime);
+		// 1 回のバッファの確保に収まる、パーティクルの範囲
+		struct Chunk
+		{
+			const ParticleSystem2DDetail* pSystem;
+
+			size_t begin;
+
+			size_t end;
+
+			size_t vertexOffset;
+		};
+
+		// 描画はメインスレッドからのみ行われるため、作業用のバッファを使い回す
+		static Array<Chunk> chunks;
+		static Array<Vertex2D> vertices;
 
-		for (auto& particle : m_particles)
+		chunks.clear();
+
+		size_t numVertices = 0;
+
+		for (const auto& system : systems)
 		{
-			particle.update(deltaTime, deltaVelocity);
+			const ParticleSystem2DDetail* pSystem = system.pImpl.get();
+			const size_t num = pSystem->m_particles.size();
+
+			for (size_t begin = 0; begin < num; begin += Vertex2DBuilder::MaxParticlesPerBatch)
+			{
+				const size_t end = Min((begin + Vertex2DBuilder::MaxParticlesPerBatch), num);
+				chunks.push_back({ pSystem, begin, end, numVertices });
+				numVertices += ((end - begin) * 4);
+			}
 		}
 
-		m_particles.remove_if([](const Particle2D& p) { return p.isDead(); });
-	}
+		if (chunks.isEmpty())
+		{
+			return;
+		}
 
-	void ParticleSystem2D::ParticleSystem2DDetail::addParticles(const ParticleSystem2DParameters& params)
-	{
-		const double timePerParticle = (1.0 / params.rate);
+		if (vertices.size() < numVertices)
+		{
+			vertices.resize(numVertices);
+		}
 
-		while (m_remainingTime > timePerParticle)
+		const auto writeChunk = [](const Chunk& chunk)
 		{
-			m_remainingTime -= timePerParticle;
-			const double remainigLifeTime = (params.startLifeTime - m_remainingTime);
+			const ParticleSystem2DParameters& params = chunk.pSystem->m_parameters;
+			Vertex2DBuilder::WriteParticleVertices((vertices.data() + chunk.vertexOffset), chunk.pSystem->m_particles,
+				chunk.begin, chunk.end, params.sizeOverLifeTimeFunc, params.colorOverLifeTimeFunc);
+		};
+
+	# if defined(SIV3D_NO_CONCURRENT_API)
+
+		chunks.each(writeChunk);
 
-			if (remainigLifeTime <= 0.0)
+	# else
+
+		// ユーザーのコールバックはスレッドセーフとは限らないため、呼び出し元のスレッドで処理する
+		Threading::GetDefaultPool().parallel_for(0, chunks.size(), 1, [&](const size_t begin, const size_t end)
+		{
+			for (size_t i = begin; i < end; ++i)
 			{
-				continue;
+				if (not chunks[i].pSystem->hasOverLifeTimeFunc())
+				{
+					writeChunk(chunks[i]);
+				}
 			}
+		});
 
-			const double startRotationDeg = params.startRotationDeg + Random(-params.randomStartRotationDeg * 0.5, params.randomStartRotationDeg * 0.5);
-			const double angularVelocityDeg = params.startAngularVelocityDeg + Random(-params.randomStartAngularVelocityDeg * 0.5, params.randomStartAngularVelocityDeg * 0.5);
+		for (const auto& chunk : chunks)
+		{
+			if (chunk.pSystem->hasOverLifeTimeFunc())
+			{
+				writeChunk(chunk);
+			}
+		}
 
-			Particle2D particle(
-				m_emitter->emit(m_position, params.startSpeed),
-				params.startColor.toFloat4(),
-				static_cast<float>(params.startSize),
-				static_cast<float>(Math::ToRadians(startRotationDeg)),
-				static_cast<float>(Math::ToRadians(angularVelocityDeg)),
-				static_cast<float>(params.startLifeTime),
-				static_cast<float>(remainigLifeTime)
-			);
+	# endif
 
-			const float perParticledeltaTime = (particle.startLifeTime - particle.remainingLifeTime);
-			particle.advance(perParticledeltaTime, m_force * perParticledeltaTime);
-			m_particles << particle;
-		}
+		// 配列の順に送信する
+		const TriangleIndex* pIndices = detail::GetParticleIndices();
 
-		if (const size_t maxParticles = static_cast<size_t>(params.maxParticles); m_particles.size() > maxParticles)
+		for (const auto& chunk : chunks)
 		{
-			m_particles.erase(m_particles.begin(), m_particles.begin() + (m_particles.size() - maxParticles));
+			const ParticleSystem2DDetail& system = *chunk.pSystem;
+			const Vertex2D* pVertex = (vertices.data() + chunk.vertexOffset);
+			const size_t num = (chunk.end - chunk.begin);
+
+			ScopedRenderStates2D blend{ system.m_parameters.blendState };
+
+			if (system.m_particleTexture)
+			{
+				SIV3D_ENGINE(Renderer2D)->addTexturedVertices(system.m_particleTexture, pVertex, (num * 4), pIndices, (num * 2));
+			}
+			else
+			{
+				SIV3D_ENGINE(Renderer2D)->addPolygon(pVertex, (num * 4), pIndices, (num * 2));
+			}
 		}
 	}
 
-	void ParticleSystem2D::ParticleSystem2DDetail::drawParticle() const
+	void ParticleSystem2D::ParticleSystem2DDetail::updateCurrentparticles(float deltaTime)
 	{
-		const ParticleSystem2DParameters::SizeOverLifeTimeFunc sizeOverLifeTimeFunc =
-			m_parameters.sizeOverLifeTimeFunc ? m_parameters.sizeOverLifeTimeFunc : detail::DefaultSizeOverLifeTimeFunc;
-		const ParticleSystem2DParameters::ColorOverLifeTimeFunc colorOverLifeTimeFunc =
-			m_parameters.colorOverLifeTimeFunc ? m_parameters.colorOverLifeTimeFunc : detail::DefaultColorOverLifeTimeFunc;
+		const Float2 deltaVelocity = (m_force * deltaTime);
 
-		for (const auto& particle : m_particles)
+		m_particles.update(deltaTime, deltaVelocity);
+	}
+
+	void ParticleSystem2D::ParticleSystem2DDetail::addParticles(const ParticleSystem2DParameters& params)
+	{
+		const double timePerParticle = (1.0 / params.rate);
+
+		// エミッターと Random() は、このパーティクルシステム専用の乱数エンジンを使う
+		if (m_remainingTime > timePerParticle)
 		{
-			const float size = sizeOverLifeTimeFunc(particle.startSize, particle.startLifeTime, particle.remainingLifeTime);
-			const Float4 color = colorOverLifeTimeFunc(particle.startColor, particle.startLifeTime, particle.remainingLifeTime);
+			const detail::ScopedRNGSwap rngSwap{ m_rng };
 
-			RectF{ Arg::center = particle.position, size }
-				.rotated(particle.rotation)
-				.draw(ColorF{ color });
+			while (m_remainingTime > timePerParticle)
+			{
+				m_remainingTime -= timePerParticle;
+				const double remainigLifeTime = (params.startLifeTime - m_remainingTime);
+
+				if (remainigLifeTime <= 0.0)
+				{
+					continue;
+				}
+
+				const double startRotationDeg = params.startRotationDeg + Random(-params.randomStartRotationDeg * 0.5, params.randomStartRotationDeg * 0.5);
+				const double angularVelocityDeg = params.startAngularVelocityDeg + Random(-params.randomStartAngularVelocityDeg * 0.5, params.randomStartAngularVelocityDeg * 0.5);
+
+				Particle2D particle(
+					m_emitter->emit(m_position, params.startSpeed),
+					params.startColor.toFloat4(),
+					static_cast<float>(params.startSize),
+					static_cast<float>(Math::ToRadians(startRotationDeg)),
+					static_cast<float>(Math::ToRadians(angularVelocityDeg)),
+					static_cast<float>(params.startLifeTime),
+					static_cast<float>(remainigLifeTime)
+				);
+
+				const float perParticledeltaTime = (particle.startLifeTime - particle.remainingLifeTime);
+				particle.advance(perParticledeltaTime, m_force * perParticledeltaTime);
+				m_particles.push_back(particle);
+			}
 		}
+
+		if (const size_t maxParticles = static_cast<size_t>(params.maxParticles); m_particles.size() > maxParticles)
+		{
+			m_particles.removeOldest(m_particles.size() - maxParticles);
+		}
+	}
+
+	void ParticleSystem2D::ParticleSystem2DDetail::drawParticle() const
+	{
+		SIV3D_ENGINE(Renderer2D)->addParticles(m_particles, m_parameters.sizeOverLifeTimeFunc, m_parameters.colorOverLifeTimeFunc);
 	}
 
 	void ParticleSystem2D::ParticleSystem2DDetail::drawTexturedParticle() const
 	{
-		const ParticleSystem2DParameters::SizeOverLifeTimeFunc sizeOverLifeTimeFunc =
-			m_parameters.sizeOverLifeTimeFunc ? m_parameters.sizeOverLifeTimeFunc : detail::DefaultSizeOverLifeTimeFunc;
-		const ParticleSystem2DParameters::ColorOverLifeTimeFunc colorOverLifeTimeFunc =
-			m_parameters.colorOverLifeTimeFunc ? m_parameters.colorOverLifeTimeFunc : detail::DefaultColorOverLifeTimeFunc;
+		SIV3D_ENGINE(Renderer2D)->addTexturedParticles(m_particleTexture, m_particles, m_parameters.sizeOverLifeTimeFunc, m_parameters.colorOverLifeTimeFunc);
+	}
 
-		SIV3D_ENGINE(Renderer2D)->addTexturedParticles(m_particleTexture, m_particles, sizeOverLifeTimeFunc, colorOverLifeTimeFunc);
+	bool ParticleSystem2D::ParticleSystem2DDetail::hasOverLifeTimeFunc() const noexcept
+	{
+		return (m_parameters.sizeOverLifeTimeFunc || m_parameters.colorOverLifeTimeFunc);
 	}
 
 	void ParticleSystem2D::ParticleSystem2DDetail::drawDebugParticle() const
@@ -227,8 +381,9 @@ namespace s3d
 		const ParticleSystem2DParameters::ColorOverLifeTimeFunc colorOverLifeTimeFunc =
 			m_parameters.colorOverLifeTimeFunc ? m_parameters.colorOverLifeTimeFunc : detail::DefaultColorOverLifeTimeFunc;
 
-		for (const auto& particle : m_particles)
+		for (size_t i = 0; i < m_particles.size(); ++i)
 		{
+			const Particle2D particle = m_particles[i];
 			const float size = sizeOverLifeTimeFunc(particle.startSize, particle.startLifeTime, particle.remainingLifeTime);
 			const Float4 color = colorOverLifeTimeFunc(particle.startColor, particle.startLifeTime, particle.remainingLifeTime);
 
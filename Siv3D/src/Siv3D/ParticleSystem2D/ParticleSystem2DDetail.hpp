@@ -12,6 +12,8 @@
 # pragma once
 # include <Siv3D/ParticleSystem2D.hpp>
 # include <Siv3D/Particle2D.hpp>
+# include <Siv3D/Random.hpp>
+# include "ParticleStore2D.hpp"
 
 namespace s3d
 {
@@ -38,8 +40,12 @@ namespace s3d
 
 		void setTexture(const Texture& texture) noexcept;
 
+		void setSeed(uint64 seed) noexcept;
+
 		size_t num_particles() const noexcept;
 
+		Array<Particle2D> getParticles() const;
+
 		void prewarm();
 
 		void update(double deltaTime);
@@ -48,9 +54,11 @@ namespace s3d
 
 		void drawDebug() const;
 
+		static void DrawAll(std::span<const ParticleSystem2D> systems);
+
 	private:
 
-		Array<Particle2D> m_particles;
+		ParticleStore2D m_particles;
 		double m_remainingTime = 0.0;
 
 		Vec2 m_position = Vec2(0, 0);
@@ -60,6 +68,9 @@ namespace s3d
 		std::unique_ptr<IEmitter2D> m_emitter;
 		Texture m_particleTexture;
 
+		// パーティクルの放出に使う、このパーティクルシステム専用の乱数エンジン
+		DefaultRNG m_rng{ GetDefaultRNG()() };
+
 		void updateCurrentparticles(float deltaTime);
 
 		void addParticles(const ParticleSystem2DParameters& params);
@@ -69,5 +80,8 @@ namespace s3d
 		void drawTexturedParticle() const;
 
 		void drawDebugParticle() const;
+
+		[[nodiscard]]
+		bool hasOverLifeTimeFunc() const noexcept;
 	};
 }
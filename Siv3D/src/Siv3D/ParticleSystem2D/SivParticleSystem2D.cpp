@@ -10,6 +10,7 @@
 //-----------------------------------------------
 
 # include <Siv3D/ParticleSystem2D.hpp>
+# include <Siv3D/ThreadPool.hpp>
 # include <Siv3D/ParticleSystem2D/ParticleSystem2DDetail.hpp>
 
 namespace s3d
@@ -51,11 +52,21 @@ namespace s3d
 		pImpl->setTexture(texture);
 	}
 
+	void ParticleSystem2D::setSeed(const uint64 seed) noexcept
+	{
+		pImpl->setSeed(seed);
+	}
+
 	size_t ParticleSystem2D::num_particles() const noexcept
 	{
 		return pImpl->num_particles();
 	}
 
+	Array<Particle2D> ParticleSystem2D::getParticles() const
+	{
+		return pImpl->getParticles();
+	}
+
 	void ParticleSystem2D::prewarm()
 	{
 		pImpl->prewarm();
@@ -75,4 +86,32 @@ namespace s3d
 	{
 		pImpl->drawDebug();
 	}
+
+	void ParticleSystem2D::UpdateAll(const std::span<ParticleSystem2D> systems, const double deltaTime)
+	{
+	# if defined(SIV3D_NO_CONCURRENT_API)
+
+		for (auto& system : systems)
+		{
+			system.update(deltaTime);
+		}
+
+	# else
+
+		// 各パーティクルシステムは専用の乱数エンジンを使うので、どのスレッドで更新しても結果は変わらない
+		Threading::GetDefaultPool().parallel_for(0, systems.size(), 1, [=](const size_t begin, const size_t end)
+		{
+			for (size_t i = begin; i < end; ++i)
+			{
+				systems[i].pImpl->update(deltaTime);
+			}
+		});
+
+	# endif
+	}
+
+	void ParticleSystem2D::DrawAll(const std::span<const ParticleSystem2D> systems)
+	{
+		ParticleSystem2DDetail::DrawAll(systems);
+	}
 }
@@ -9,16 +9,53 @@
 //
 //-----------------------------------------------
 
+# include <algorithm>
 # include "P2BodyDetail.hpp"
 # include "P2ContactListener.hpp"
 
 namespace s3d
 {
+	void detail::P2ContactListener::setMode(const P2ContactMode mode, b2World& world)
+	{
+		if (mode == m_mode)
+		{
+			return;
+		}
+
+		m_mode = mode;
+		m_collisions.clear();
+		m_events.clear();
+		m_num_stepEvents = 0;
+		m_begunContacts.clear();
+
+		if (mode == P2ContactMode::Collisions)
+		{
+			// PostSolve() と EndContact() が参照できるよう、接触中のペアを登録し直す
+			for (b2Contact* contact = world.GetContactList(); contact; contact = contact->GetNext())
+			{
+				if (contact->IsTouching())
+				{
+					BeginContact(contact);
+				}
+			}
+		}
+	}
+
+	P2ContactMode detail::P2ContactListener::getMode() const noexcept
+	{
+		return m_mode;
+	}
+
 	void detail::P2ContactListener::BeginContact(b2Contact* contact)
 	{
-		const P2Body::P2BodyDetail* pBodyA = static_cast<const P2Body::P2BodyDetail*>(contact->GetFixtureA()->GetBody()->GetUserData().pBody);
-		const P2Body::P2BodyDetail* pBodyB = static_cast<const P2Body::P2BodyDetail*>(contact->GetFixtureB()->GetBody()->GetUserData().pBody);
-		const P2ContactPair pair{ pBodyA->id(), pBodyB->id() };
+		if (m_mode == P2ContactMode::Events)
+		{
+			// 接触点と力積はステップの終わりにまとめて取得する
+			m_begunContacts << contact;
+			return;
+		}
+
+		const P2ContactPair pair = GetContactPair(contact);
 
 		if (auto it = m_collisions.find(pair); it != m_collisions.end())
 		{
@@ -32,9 +69,12 @@ namespace s3d
 
 	void detail::P2ContactListener::PostSolve(b2Contact* contact, const b2ContactImpulse* impulse)
 	{
-		const P2Body::P2BodyDetail* pBodyA = static_cast<const P2Body::P2BodyDetail*>(contact->GetFixtureA()->GetBody()->GetUserData().pBody);
-		const P2Body::P2BodyDetail* pBodyB = static_cast<const P2Body::P2BodyDetail*>(contact->GetFixtureB()->GetBody()->GetUserData().pBody);
-		const P2ContactPair pair{ pBodyA->id(), pBodyB->id() };
+		if (m_mode == P2ContactMode::Events)
+		{
+			return;
+		}
+
+		const P2ContactPair pair = GetContactPair(contact);
 
 		auto& collision = m_collisions.find(pair)->second;
 		const uint32 current_num_contacts = static_cast<uint32>(contact->GetManifold()->pointCount);
@@ -63,8 +103,17 @@ namespace s3d
 
 	void detail::P2ContactListener::EndContact(b2Contact* contact)
 	{
-		const P2Body::P2BodyDetail* pBodyA = static_cast<const P2Body::P2BodyDetail*>(contact->GetFixtureA()->GetBody()->GetUserData().pBody);
-		const P2Body::P2BodyDetail* pBodyB = static_cast<const P2Body::P2BodyDetail*>(contact->GetFixtureB()->GetBody()->GetUserData().pBody);		const P2ContactPair pair{ pBodyA->id(), pBodyB->id() };
+		const P2ContactPair pair = GetContactPair(contact);
+
+		if (m_mode == P2ContactMode::Events)
+		{
+			P2ContactEvent& event = m_events.emplace_back();
+			event.pair = pair;
+			event.type = P2ContactEventType::End;
+			event.num_contacts = 0;
+			event.normal.set(0.0, 0.0);
+			return;
+		}
 
 		if (auto it = m_collisions.find(pair); it != m_collisions.end())
 		{
@@ -75,11 +124,85 @@ namespace s3d
 		}
 	}
 
+	P2ContactPair detail::P2ContactListener::GetContactPair(b2Contact* contact)
+	{
+		const P2Body::P2BodyDetail* pBodyA = static_cast<const P2Body::P2BodyDetail*>(contact->GetFixtureA()->GetBody()->GetUserData().pBody);
+		const P2Body::P2BodyDetail* pBodyB = static_cast<const P2Body::P2BodyDetail*>(contact->GetFixtureB()->GetBody()->GetUserData().pBody);
+		return{ pBodyA->id(), pBodyB->id() };
+	}
+
 	const HashTable<P2ContactPair, P2Collision>& detail::P2ContactListener::getCollisions() const noexcept
 	{
 		return m_collisions;
 	}
 
+	std::span<const P2ContactEvent> detail::P2ContactListener::getEvents() const noexcept
+	{
+		return{ m_events.data(), m_events.size() };
+	}
+
+	void detail::P2ContactListener::beginStep()
+	{
+		if (m_mode == P2ContactMode::Collisions)
+		{
+			clearContacts();
+			return;
+		}
+
+		// 直前のステップのイベントを取り除く。ステップの間に物体を削除して記録された End は残す
+		m_events.erase(m_events.begin(), (m_events.begin() + m_num_stepEvents));
+		m_num_stepEvents = 0;
+		m_begunContacts.clear();
+	}
+
+	void detail::P2ContactListener::endStep(b2World& world)
+	{
+		if (m_mode == P2ContactMode::Collisions)
+		{
+			return;
+		}
+
+		// ステップ中に破棄された接触のアドレスが再利用されることはあるが、
+		// そのアドレスの接触が接触中であれば、必ずこのステップで BeginContact() が呼ばれている
+		std::sort(m_begunContacts.begin(), m_begunContacts.end());
+
+		for (b2Contact* contact = world.GetContactList(); contact; contact = contact->GetNext())
+		{
+			if (not contact->IsTouching())
+			{
+				continue;
+			}
+
+			const bool begun = std::binary_search(m_begunContacts.begin(), m_begunContacts.end(), contact);
+			const b2Manifold* manifold = contact->GetManifold();
+			const uint32 num_contacts = static_cast<uint32>(manifold->pointCount);
+
+			P2ContactEvent& event = m_events.emplace_back();
+			event.pair = GetContactPair(contact);
+			event.type = (begun ? P2ContactEventType::Begin : P2ContactEventType::Persist);
+			event.num_contacts = num_contacts;
+			event.normal.set(0.0, 0.0);
+
+			if (num_contacts)
+			{
+				b2WorldManifold worldManifold;
+				contact->GetWorldManifold(&worldManifold);
+				event.normal = detail::ToVec2(worldManifold.normal);
+
+				// ソルバーが求めたこのステップの力積は、接触点に保存されている
+				for (uint32 i = 0; i < num_contacts; ++i)
+				{
+					auto& c = event.contacts[i];
+					c.point = detail::ToVec2(worldManifold.points[i]);
+					c.normalImpulse = manifold->points[i].normalImpulse;
+					c.tangentImpulse = manifold->points[i].tangentImpulse;
+				}
+			}
+		}
+
+		m_num_stepEvents = m_events.size();
+	}
+
 	void detail::P2ContactListener::clearContacts()
 	{
 		const auto itEnd = m_collisions.end();
@@ -10,9 +10,13 @@
 //-----------------------------------------------
 
 # pragma once
+# include <span>
+# include <Siv3D/Array.hpp>
 # include <Siv3D/HashTable.hpp>
 # include <Siv3D/Physics2D/P2ContactPair.hpp>
 # include <Siv3D/Physics2D/P2Collision.hpp>
+# include <Siv3D/Physics2D/P2ContactMode.hpp>
+# include <Siv3D/Physics2D/P2ContactEvent.hpp>
 # include "P2Common.hpp"
 
 namespace s3d
@@ -23,14 +27,43 @@ namespace s3d
 		{
 		public:
 
+			void setMode(P2ContactMode mode, b2World& world);
+
+			[[nodiscard]]
+			P2ContactMode getMode() const noexcept;
+
+			[[nodiscard]]
 			const HashTable<P2ContactPair, P2Collision>& getCollisions() const noexcept;
 
-			void clearContacts();
+			[[nodiscard]]
+			std::span<const P2ContactEvent> getEvents() const noexcept;
+
+			/// @brief b2World::Step() の直前に呼びます。
+			void beginStep();
+
+			/// @brief b2World::Step() の直後に呼びます。
+			void endStep(b2World& world);
 
 		private:
 
+			P2ContactMode m_mode = P2ContactMode::Collisions;
+
 			HashTable<P2ContactPair, P2Collision> m_collisions;
 
+			// 要素を使いまわすことで、ステップごとのメモリ確保を避ける
+			Array<P2ContactEvent> m_events;
+
+			// m_events のうち、直前のステップで記録したイベントの数
+			size_t m_num_stepEvents = 0;
+
+			// ステップ中に接触が始まった接触
+			Array<const b2Contact*> m_begunContacts;
+
+			void clearContacts();
+
+			[[nodiscard]]
+			static P2ContactPair GetContactPair(b2Contact* contact);
+
 			void BeginContact(b2Contact* contact) override;
 
 			void PostSolve(b2Contact* contact, const b2ContactImpulse* impulse) override;
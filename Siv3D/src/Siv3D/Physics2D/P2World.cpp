@@ -11,10 +11,26 @@
 
 # include <Siv3D/Physics2D/P2World.hpp>
 # include <Siv3D/MultiPolygon.hpp>
+# include <Siv3D/ThreadPool.hpp>
 # include "P2WorldDetail.hpp"
 
 namespace s3d
 {
+	namespace detail
+	{
+		// 1 つのタスクで処理するレイの数
+		constexpr size_t P2RaycastGrainSize = 256;
+
+		[[nodiscard]]
+		static b2AABB ToB2AABB(const RectF& rect) noexcept
+		{
+			b2AABB aabb;
+			aabb.lowerBound = ToB2Vec2(rect.tl());
+			aabb.upperBound = ToB2Vec2(rect.br());
+			return aabb;
+		}
+	}
+
 	P2World::P2World(const double gravity)
 		: P2World{ Vec2{ 0.0, gravity } } {}
 
@@ -26,6 +42,31 @@ namespace s3d
 		return pImpl->update(timeStep, velocityIterations, positionIterations);
 	}
 
+	size_t P2World::updateFixed(const double deltaTime, const double fixedTimeStep, const int32 maxSteps, const int32 velocityIterations, const int32 positionIterations) const
+	{
+		return pImpl->updateFixed(deltaTime, fixedTimeStep, maxSteps, velocityIterations, positionIterations);
+	}
+
+	double P2World::getInterpolationAlpha() const noexcept
+	{
+		return pImpl->getInterpolationAlpha();
+	}
+
+	void P2World::exportInterpolatedStates(P2BodyStates& states) const
+	{
+		pImpl->exportInterpolatedStates(states);
+	}
+
+	void P2World::setParallelSolveEnabled(const bool enabled)
+	{
+		pImpl->setParallelSolveEnabled(enabled);
+	}
+
+	bool P2World::getParallelSolveEnabled() const noexcept
+	{
+		return pImpl->getParallelSolveEnabled();
+	}
+
 	void P2World::setSleepEnabled(const bool enabled)
 	{
 		pImpl->getData().SetAllowSleeping(enabled);
@@ -190,4 +231,155 @@ namespace s3d
 	{
 		return pImpl->getCollisions();
 	}
+
+	void P2World::setContactMode(const P2ContactMode mode)
+	{
+		pImpl->setContactMode(mode);
+	}
+
+	P2ContactMode P2World::getContactMode() const noexcept
+	{
+		return pImpl->getContactMode();
+	}
+
+	std::span<const P2ContactEvent> P2World::getContactEvents() const noexcept
+	{
+		return pImpl->getContactEvents();
+	}
+
+	Array<P2BodyID> P2World::queryAABB(const RectF& rect) const
+	{
+		Array<P2BodyID> results;
+
+		queryAABB(rect, results);
+
+		return results;
+	}
+
+	void P2World::queryAABB(const RectF& rect, Array<P2BodyID>& results) const
+	{
+		results.clear();
+
+		pImpl->queryAABB(detail::ToB2AABB(rect), results);
+	}
+
+	void P2World::queryAABB(const Array<RectF>& rects, Array<P2BodyID>& results, Array<size_t>& offsets) const
+	{
+		results.clear();
+		offsets.resize(rects.size() + 1);
+
+		for (size_t i = 0; i < rects.size(); ++i)
+		{
+			offsets[i] = results.size();
+
+			pImpl->queryAABB(detail::ToB2AABB(rects[i]), results);
+		}
+
+		offsets.back() = results.size();
+	}
+
+	Optional<P2RaycastHit> P2World::raycast(const Vec2& start, const Vec2& end) const
+	{
+		return pImpl->raycast(start, end);
+	}
+
+	Optional<P2RaycastHit> P2World::raycast(const Line& ray) const
+	{
+		return pImpl->raycast(ray.begin, ray.end);
+	}
+
+	void P2World::raycast(const Array<Line>& rays, Array<Optional<P2RaycastHit>>& results) const
+	{
+		results.resize(rays.size());
+
+		const Line* pRays = rays.data();
+		Optional<P2RaycastHit>* pResults = results.data();
+		const detail::P2WorldDetail* pWorld = pImpl.get();
+
+		// ワールドを読むだけなので、複数のスレッドから同時に調べられる
+		const auto f = [=](const size_t begin, const size_t end)
+		{
+			for (size_t i = begin; i < end; ++i)
+			{
+				pResults[i] = pWorld->raycast(pRays[i].begin, pRays[i].end);
+			}
+		};
+
+	# if defined(SIV3D_NO_CONCURRENT_API)
+
+		f(0, rays.size());
+
+	# else
+
+		if (rays.size() < (detail::P2RaycastGrainSize * 2))
+		{
+			f(0, rays.size());
+		}
+		else
+		{
+			Threading::GetDefaultPool().parallel_for(0, rays.size(), detail::P2RaycastGrainSize, f);
+		}
+
+	# endif
+	}
+
+	Array<P2RaycastHit> P2World::raycastAll(const Line& ray) const
+	{
+		Array<P2RaycastHit> results;
+
+		raycastAll(ray, results);
+
+		return results;
+	}
+
+	void P2World::raycastAll(const Line& ray, Array<P2RaycastHit>& results) const
+	{
+		pImpl->raycastAll(ray.begin, ray.end, results);
+	}
+
+	Optional<P2RaycastHit> P2World::shapeCast(const Circle& circle, const Vec2& translation) const
+	{
+		b2CircleShape shape;
+		shape.m_p = detail::ToB2Vec2(circle.center);
+		shape.m_radius = static_cast<float>(circle.r);
+
+		return pImpl->shapeCast(shape, translation);
+	}
+
+	Optional<P2RaycastHit> P2World::shapeCast(const RectF& rect, const Vec2& translation) const
+	{
+		b2PolygonShape shape;
+		shape.SetAsBox(static_cast<float>(rect.w * 0.5), static_cast<float>(rect.h * 0.5), detail::ToB2Vec2(rect.center()), 0.0f);
+
+		return pImpl->shapeCast(shape, translation);
+	}
+
+	void P2World::exportStates(P2BodyStates& states) const
+	{
+		pImpl->exportStates(states);
+	}
+
+	size_t P2World::importStates(const P2BodyStates& states)
+	{
+		return pImpl->importStates(states);
+	}
+
+	Blob P2World::saveSnapshot() const
+	{
+		Blob blob;
+
+		saveSnapshot(blob);
+
+		return blob;
+	}
+
+	void P2World::saveSnapshot(Blob& blob) const
+	{
+		pImpl->saveSnapshot(blob);
+	}
+
+	bool P2World::loadSnapshot(const Blob& blob)
+	{
+		return pImpl->loadSnapshot(blob);
+	}
 }
@@ -9,12 +9,277 @@
 //
 //-----------------------------------------------
 
+# include <cmath>
+# include <algorithm>
+# include <numeric>
 # include <Siv3D/Physics2D/P2Body.hpp>
+# include <Siv3D/ThreadPool.hpp>
+# include <Siv3D/Interpolation.hpp>
 # include "P2WorldDetail.hpp"
+# include "P2BodyDetail.hpp"
 # include "P2Common.hpp"
+# include <ThirdParty/box2d/b2_distance.h>
 
 namespace s3d
 {
+	namespace detail
+	{
+		class P2QueryAABBCallback final : public b2QueryCallback
+		{
+		public:
+
+			P2QueryAABBCallback(const b2AABB& aabb, Array<P2BodyID>& results) noexcept
+				: m_aabb{ aabb }
+				, m_results{ results }
+				, m_first{ results.size() } {}
+
+			bool ReportFixture(b2Fixture* fixture) override
+			{
+				const P2BodyID id = P2WorldDetail::GetBodyID(fixture);
+
+				// 同じ部品が子の数だけ続けて報告される場合がある
+				if ((m_first < m_results.size()) && (m_results.back() == id))
+				{
+					return true;
+				}
+
+				// ブロードフェーズの AABB は余裕を持たせた大きさのため、部品の AABB で判定し直す
+				const int32 childCount = fixture->GetShape()->GetChildCount();
+
+				for (int32 i = 0; i < childCount; ++i)
+				{
+					if (b2TestOverlap(m_aabb, fixture->GetAABB(i)))
+					{
+						m_results << id;
+						break;
+					}
+				}
+
+				return true;
+			}
+
+		private:
+
+			b2AABB m_aabb;
+
+			Array<P2BodyID>& m_results;
+
+			// このクエリの結果が始まる位置
+			size_t m_first = 0;
+		};
+
+		class P2RaycastClosestCallback final : public b2RayCastCallback
+		{
+		public:
+
+			float ReportFixture(b2Fixture* fixture, const b2Vec2& point, const b2Vec2& normal, const float fraction) override
+			{
+				m_hit = P2RaycastHit{ P2WorldDetail::GetBodyID(fixture), ToVec2(point), ToVec2(normal), fraction };
+
+				// これより遠い部品は報告しない
+				return fraction;
+			}
+
+			[[nodiscard]]
+			const Optional<P2RaycastHit>& getHit() const noexcept
+			{
+				return m_hit;
+			}
+
+		private:
+
+			Optional<P2RaycastHit> m_hit;
+		};
+
+		class P2RaycastAllCallback final : public b2RayCastCallback
+		{
+		public:
+
+			explicit P2RaycastAllCallback(Array<P2RaycastHit>& results) noexcept
+				: m_results{ results } {}
+
+			float ReportFixture(b2Fixture* fixture, const b2Vec2& point, const b2Vec2& normal, const float fraction) override
+			{
+				m_results.push_back(P2RaycastHit{ P2WorldDetail::GetBodyID(fixture), ToVec2(point), ToVec2(normal), fraction });
+
+				// 線分を短くせずに続ける
+				return 1.0f;
+			}
+
+		private:
+
+			Array<P2RaycastHit>& m_results;
+		};
+
+		class P2ShapeCastCallback final : public b2QueryCallback
+		{
+		public:
+
+			P2ShapeCastCallback(const b2Shape& shape, const b2Vec2& translation) noexcept
+				: m_translation{ translation }
+			{
+				m_proxy.Set(&shape, 0);
+			}
+
+			bool ReportFixture(b2Fixture* fixture) override
+			{
+				// 同じ部品が子の数だけ続けて報告される場合がある
+				if (fixture == m_lastFixture)
+				{
+					return true;
+				}
+
+				m_lastFixture = fixture;
+
+				b2ShapeCastInput input;
+				input.proxyB = m_proxy;
+				input.transformA = fixture->GetBody()->GetTransform();
+				input.transformB.SetIdentity();
+				input.translationB = m_translation;
+
+				const b2Shape* shape = fixture->GetShape();
+				const int32 childCount = shape->GetChildCount();
+
+				for (int32 i = 0; i < childCount; ++i)
+				{
+					input.proxyA.Set(shape, i);
+
+					b2ShapeCastOutput output;
+
+					if (not b2ShapeCast(&output, &input))
+					{
+						continue;
+					}
+
+					if (m_hit && (m_hit->fraction <= output.lambda))
+					{
+						continue;
+					}
+
+					// 法線は移動してくる形状の側に向ける
+					const b2Vec2 normal = ((b2Dot(output.normal, m_translation) <= 0.0f) ? output.normal : -output.normal);
+					m_hit = P2RaycastHit{ P2WorldDetail::GetBodyID(fixture), ToVec2(output.point), ToVec2(normal), output.lambda };
+				}
+
+				return true;
+			}
+
+			[[nodiscard]]
+			const Optional<P2RaycastHit>& getHit() const noexcept
+			{
+				return m_hit;
+			}
+
+		private:
+
+			b2DistanceProxy m_proxy;
+
+			b2Vec2 m_translation;
+
+			const b2Fixture* m_lastFixture = nullptr;
+
+			Optional<P2RaycastHit> m_hit;
+		};
+
+		// スナップショットの先頭
+		struct P2SnapshotHeader
+		{
+			uint32 magic;
+
+			uint32 version;
+
+			uint32 num_bodies;
+
+			uint32 reserved;
+		};
+
+		constexpr uint32 P2SnapshotMagic = 0x53573250; // "P2WS"
+
+		constexpr uint32 P2SnapshotVersion = 1;
+
+		// ID, 座標, 角度, 速度, 角速度, スリープ状態
+		constexpr size_t P2SnapshotBodySize = (sizeof(P2BodyID) + sizeof(b2Vec2) + sizeof(float) + sizeof(b2Vec2) + sizeof(float) + sizeof(uint8));
+
+		/// @brief P2Body に対応する物体の数を返します。
+		[[nodiscard]]
+		static size_t CountP2Bodies(const b2World& world) noexcept
+		{
+			size_t count = 0;
+
+			for (const b2Body* body = world.GetBodyList(); body; body = body->GetNext())
+			{
+				count += P2WorldDetail::HasBodyID(*body);
+			}
+
+			return count;
+		}
+
+		/// @brief ID が一致する物体ごとに f(body, index) を呼びます。
+		/// @return f を呼んだ回数
+		template <class Fty>
+		static size_t ForEachMatchingBody(b2World& world, const P2BodyID* ids, const size_t size, Fty f)
+		{
+			// 物体のリストは作成の新しい順、つまり ID の降順に並んでいるため、昇順の ID と末尾から突き合わせる
+			const auto merge = [&](auto indexAt)
+			{
+				size_t k = size;
+				size_t count = 0;
+
+				for (b2Body* body = world.GetBodyList(); (body && (k != 0)); body = body->GetNext())
+				{
+					if (not P2WorldDetail::HasBodyID(*body))
+					{
+						continue;
+					}
+
+					const P2BodyID id = P2WorldDetail::GetBodyID(*body);
+
+					while ((k != 0) && (id < ids[indexAt(k - 1)]))
+					{
+						--k;
+					}
+
+					if ((k != 0) && (ids[indexAt(k - 1)] == id))
+					{
+						f(*body, indexAt(k - 1));
+						--k;
+						++count;
+					}
+				}
+
+				return count;
+			};
+
+			if (std::is_sorted(ids, (ids + size)))
+			{
+				return merge([](const size_t k) { return k; });
+			}
+
+			Array<size_t> order(size);
+			std::iota(order.begin(), order.end(), size_t{ 0 });
+			std::stable_sort(order.begin(), order.end(), [=](const size_t a, const size_t b) { return (ids[a] < ids[b]); });
+
+			return merge([&order](const size_t k) { return order[k]; });
+		}
+	}
+
+	void detail::P2ParallelForCallback::ParallelFor(const int32 count, b2ParallelForTask* task)
+	{
+	# if defined(SIV3D_NO_CONCURRENT_API)
+
+		task->Run(0, count);
+
+	# else
+
+		// アイランドのグループごとに負荷が大きく異なるため、細かく分割する
+		Threading::GetDefaultPool().parallel_for(0, static_cast<size_t>(count), 1, [task](const size_t begin, const size_t end)
+			{
+				task->Run(static_cast<int32>(begin), static_cast<int32>(end));
+			});
+
+	# endif
+	}
+
 	detail::P2WorldDetail::P2WorldDetail(const Vec2 gravity)
 		: m_world{ detail::ToB2Vec2(gravity) }
 	{
@@ -23,9 +288,92 @@ namespace s3d
 
 	void detail::P2WorldDetail::update(const double timeStep, const int32 velocityIterations, const int32 positionIterations)
 	{
-		m_contactListner.clearContacts();
+		m_contactListner.beginStep();
 
 		m_world.Step(static_cast<float>(timeStep), velocityIterations, positionIterations);
+
+		m_contactListner.endStep(m_world);
+	}
+
+	size_t detail::P2WorldDetail::updateFixed(const double deltaTime, const double fixedTimeStep, const int32 maxSteps, const int32 velocityIterations, const int32 positionIterations)
+	{
+		if (fixedTimeStep <= 0.0)
+		{
+			return 0;
+		}
+
+		m_accumulatedTime += Max(deltaTime, 0.0);
+
+		size_t steps = 0;
+
+		while ((fixedTimeStep <= m_accumulatedTime) && (steps < static_cast<size_t>(Max(maxSteps, 1))))
+		{
+			m_accumulatedTime -= fixedTimeStep;
+			++steps;
+
+			// 補間に使うため、最後のステップの直前の状態を保存する
+			if ((m_accumulatedTime < fixedTimeStep) || (steps == static_cast<size_t>(Max(maxSteps, 1))))
+			{
+				exportStates(m_previousStates);
+			}
+
+			update(fixedTimeStep, velocityIterations, positionIterations);
+		}
+
+		// 処理が追い付かない場合は、残りの時間を切り捨てる
+		if (fixedTimeStep <= m_accumulatedTime)
+		{
+			m_accumulatedTime = std::fmod(m_accumulatedTime, fixedTimeStep);
+		}
+
+		m_interpolationAlpha = (m_accumulatedTime / fixedTimeStep);
+
+		return steps;
+	}
+
+	double detail::P2WorldDetail::getInterpolationAlpha() const noexcept
+	{
+		return m_interpolationAlpha;
+	}
+
+	void detail::P2WorldDetail::exportInterpolatedStates(P2BodyStates& states) const
+	{
+		exportStates(states);
+
+		const double alpha = m_interpolationAlpha;
+		const size_t num_previous = m_previousStates.size();
+		size_t k = 0;
+
+		// どちらも ID の昇順に並んでいる
+		for (size_t i = 0; i < states.size(); ++i)
+		{
+			const P2BodyID id = states.ids[i];
+
+			while ((k < num_previous) && (m_previousStates.ids[k] < id))
+			{
+				++k;
+			}
+
+			if ((k == num_previous) || (m_previousStates.ids[k] != id))
+			{
+				// 直前のステップの後に作成された物体は、現在の状態のまま
+				continue;
+			}
+
+			states.positions[i] = m_previousStates.positions[k].lerp(states.positions[i], alpha);
+			states.angles[i] = Math::Lerp(m_previousStates.angles[k], states.angles[i], alpha);
+		}
+	}
+
+	void detail::P2WorldDetail::setParallelSolveEnabled(const bool enabled)
+	{
+		m_parallelSolveEnabled = enabled;
+		m_world.SetParallelForCallback(enabled ? &m_parallelForCallback : nullptr);
+	}
+
+	bool detail::P2WorldDetail::getParallelSolveEnabled() const noexcept
+	{
+		return m_parallelSolveEnabled;
 	}
 
 	P2Body detail::P2WorldDetail::createPlaceholder(const std::shared_ptr<P2WorldDetail>& world, const P2BodyType bodyType, const Vec2& center)
@@ -144,6 +492,217 @@ namespace s3d
 		return m_contactListner.getCollisions();
 	}
 
+	void detail::P2WorldDetail::setContactMode(const P2ContactMode mode)
+	{
+		m_contactListner.setMode(mode, m_world);
+	}
+
+	P2ContactMode detail::P2WorldDetail::getContactMode() const noexcept
+	{
+		return m_contactListner.getMode();
+	}
+
+	std::span<const P2ContactEvent> detail::P2WorldDetail::getContactEvents() const noexcept
+	{
+		return m_contactListner.getEvents();
+	}
+
+	void detail::P2WorldDetail::queryAABB(const b2AABB& aabb, Array<P2BodyID>& results) const
+	{
+		const size_t first = results.size();
+
+		P2QueryAABBCallback callback{ aabb, results };
+
+		m_world.QueryAABB(&callback, aabb);
+
+		// 複数の部品を持つ物体は複数回追加されている
+		const auto itBegin = (results.begin() + first);
+		std::sort(itBegin, results.end());
+		results.erase(std::unique(itBegin, results.end()), results.end());
+	}
+
+	Optional<P2RaycastHit> detail::P2WorldDetail::raycast(const Vec2& start, const Vec2& end) const
+	{
+		if (start == end)
+		{
+			return none;
+		}
+
+		P2RaycastClosestCallback callback;
+
+		m_world.RayCast(&callback, detail::ToB2Vec2(start), detail::ToB2Vec2(end));
+
+		return callback.getHit();
+	}
+
+	void detail::P2WorldDetail::raycastAll(const Vec2& start, const Vec2& end, Array<P2RaycastHit>& results) const
+	{
+		results.clear();
+
+		if (start == end)
+		{
+			return;
+		}
+
+		P2RaycastAllCallback callback{ results };
+
+		m_world.RayCast(&callback, detail::ToB2Vec2(start), detail::ToB2Vec2(end));
+
+		std::sort(results.begin(), results.end(), [](const P2RaycastHit& a, const P2RaycastHit& b) { return (a.fraction < b.fraction); });
+	}
+
+	Optional<P2RaycastHit> detail::P2WorldDetail::shapeCast(const b2Shape& shape, const Vec2& translation) const
+	{
+		b2Transform identity;
+		identity.SetIdentity();
+
+		b2AABB begin, end;
+		shape.ComputeAABB(&begin, identity, 0);
+		end = begin;
+		end.lowerBound += detail::ToB2Vec2(translation);
+		end.upperBound += detail::ToB2Vec2(translation);
+
+		// 移動の範囲全体を覆う AABB の中にある部品だけを調べる
+		b2AABB sweep;
+		sweep.Combine(begin, end);
+
+		P2ShapeCastCallback callback{ shape, detail::ToB2Vec2(translation) };
+
+		m_world.QueryAABB(&callback, sweep);
+
+		return callback.getHit();
+	}
+
+	void detail::P2WorldDetail::exportStates(P2BodyStates& states) const
+	{
+		const size_t num_bodies = detail::CountP2Bodies(m_world);
+
+		states.resize(num_bodies);
+
+		P2BodyID* pID = states.ids.data();
+		Vec2* pPosition = states.positions.data();
+		double* pAngle = states.angles.data();
+		Vec2* pLinearVelocity = states.linearVelocities.data();
+		double* pAngularVelocity = states.angularVelocities.data();
+
+		// ID の昇順にするため、末尾から書き込む
+		size_t i = num_bodies;
+
+		for (const b2Body* body = m_world.GetBodyList(); body; body = body->GetNext())
+		{
+			if (not HasBodyID(*body))
+			{
+				continue;
+			}
+
+			--i;
+			pID[i] = GetBodyID(*body);
+			pPosition[i] = detail::ToVec2(body->GetPosition());
+			pAngle[i] = body->GetAngle();
+			pLinearVelocity[i] = detail::ToVec2(body->GetLinearVelocity());
+			pAngularVelocity[i] = body->GetAngularVelocity();
+		}
+	}
+
+	size_t detail::P2WorldDetail::importStates(const P2BodyStates& states)
+	{
+		const size_t size = states.size();
+
+		if ((states.positions.size() != size)
+			|| (states.angles.size() != size)
+			|| (states.linearVelocities.size() != size)
+			|| (states.angularVelocities.size() != size))
+		{
+			return 0;
+		}
+
+		return detail::ForEachMatchingBody(m_world, states.ids.data(), size, [&](b2Body& body, const size_t i)
+			{
+				body.SetTransform(detail::ToB2Vec2(states.positions[i]), static_cast<float>(states.angles[i]));
+				body.SetLinearVelocity(detail::ToB2Vec2(states.linearVelocities[i]));
+				body.SetAngularVelocity(static_cast<float>(states.angularVelocities[i]));
+			});
+	}
+
+	void detail::P2WorldDetail::saveSnapshot(Blob& blob) const
+	{
+		const size_t num_bodies = detail::CountP2Bodies(m_world);
+
+		blob.resize(sizeof(detail::P2SnapshotHeader) + (num_bodies * detail::P2SnapshotBodySize));
+
+		Byte* p = blob.data();
+		{
+			const detail::P2SnapshotHeader header{ detail::P2SnapshotMagic, detail::P2SnapshotVersion, static_cast<uint32>(num_bodies), 0 };
+			std::memcpy(p, &header, sizeof(header));
+			p += sizeof(header);
+		}
+
+		// 要素ごとに連続して並べる（4 バイトの要素を先に置くことで、すべての要素が整列する）
+		P2BodyID* pID = reinterpret_cast<P2BodyID*>(p);
+		b2Vec2* pPosition = reinterpret_cast<b2Vec2*>(pID + num_bodies);
+		float* pAngle = reinterpret_cast<float*>(pPosition + num_bodies);
+		b2Vec2* pLinearVelocity = reinterpret_cast<b2Vec2*>(pAngle + num_bodies);
+		float* pAngularVelocity = reinterpret_cast<float*>(pLinearVelocity + num_bodies);
+		uint8* pAwake = reinterpret_cast<uint8*>(pAngularVelocity + num_bodies);
+
+		size_t i = num_bodies;
+
+		for (const b2Body* body = m_world.GetBodyList(); body; body = body->GetNext())
+		{
+			if (not HasBodyID(*body))
+			{
+				continue;
+			}
+
+			--i;
+			pID[i] = GetBodyID(*body);
+			pPosition[i] = body->GetPosition();
+			pAngle[i] = body->GetAngle();
+			pLinearVelocity[i] = body->GetLinearVelocity();
+			pAngularVelocity[i] = body->GetAngularVelocity();
+			pAwake[i] = body->IsAwake();
+		}
+	}
+
+	bool detail::P2WorldDetail::loadSnapshot(const Blob& blob)
+	{
+		if (blob.size() < sizeof(detail::P2SnapshotHeader))
+		{
+			return false;
+		}
+
+		const Byte* p = blob.data();
+
+		detail::P2SnapshotHeader header;
+		std::memcpy(&header, p, sizeof(header));
+		p += sizeof(header);
+
+		if ((header.magic != detail::P2SnapshotMagic)
+			|| (header.version != detail::P2SnapshotVersion)
+			|| (blob.size() != (sizeof(detail::P2SnapshotHeader) + (header.num_bodies * detail::P2SnapshotBodySize))))
+		{
+			return false;
+		}
+
+		const size_t num_bodies = header.num_bodies;
+		const P2BodyID* pID = reinterpret_cast<const P2BodyID*>(p);
+		const b2Vec2* pPosition = reinterpret_cast<const b2Vec2*>(pID + num_bodies);
+		const float* pAngle = reinterpret_cast<const float*>(pPosition + num_bodies);
+		const b2Vec2* pLinearVelocity = reinterpret_cast<const b2Vec2*>(pAngle + num_bodies);
+		const float* pAngularVelocity = reinterpret_cast<const float*>(pLinearVelocity + num_bodies);
+		const uint8* pAwake = reinterpret_cast<const uint8*>(pAngularVelocity + num_bodies);
+
+		detail::ForEachMatchingBody(m_world, pID, num_bodies, [&](b2Body& body, const size_t i)
+			{
+				body.SetTransform(pPosition[i], pAngle[i]);
+				body.SetLinearVelocity(pLinearVelocity[i]);
+				body.SetAngularVelocity(pAngularVelocity[i]);
+				body.SetAwake(pAwake[i] != 0);
+			});
+
+		return true;
+	}
+
 	b2World& detail::P2WorldDetail::getData() noexcept
 	{
 		return m_world;
@@ -159,6 +718,22 @@ namespace s3d
 		return &m_world;
 	}
 
+	P2BodyID detail::P2WorldDetail::GetBodyID(b2Fixture* fixture) noexcept
+	{
+		return static_cast<const P2Body::P2BodyDetail*>(fixture->GetBody()->GetUserData().pBody)->id();
+	}
+
+	P2BodyID detail::P2WorldDetail::GetBodyID(const b2Body& body) noexcept
+	{
+		// b2Body::GetUserData() には const 版が無い
+		return static_cast<const P2Body::P2BodyDetail*>(const_cast<b2Body&>(body).GetUserData().pBody)->id();
+	}
+
+	bool detail::P2WorldDetail::HasBodyID(const b2Body& body) noexcept
+	{
+		return (const_cast<b2Body&>(body).GetUserData().pBody != nullptr);
+	}
+
 	P2BodyID detail::P2WorldDetail::generateNextID() noexcept
 	{
 		return ++m_currentID;
@@ -16,6 +16,17 @@
 
 namespace s3d
 {
+	namespace detail
+	{
+		/// @brief Box2D のアイランドを、エンジンのスレッドプールで並列に解くためのコールバック
+		class P2ParallelForCallback final : public b2ParallelForCallback
+		{
+		public:
+
+			void ParallelFor(int32 count, b2ParallelForTask* task) override;
+		};
+	}
+
 	class detail::P2WorldDetail
 	{
 	public:
@@ -24,6 +35,18 @@ namespace s3d
 
 		void update(double timeStep, int32 velocityIterations, int32 positionIterations);
 
+		size_t updateFixed(double deltaTime, double fixedTimeStep, int32 maxSteps, int32 velocityIterations, int32 positionIterations);
+
+		[[nodiscard]]
+		double getInterpolationAlpha() const noexcept;
+
+		void exportInterpolatedStates(P2BodyStates& states) const;
+
+		void setParallelSolveEnabled(bool enabled);
+
+		[[nodiscard]]
+		bool getParallelSolveEnabled() const noexcept;
+
 		[[nodiscard]]
 		P2Body createPlaceholder(const std::shared_ptr<P2WorldDetail>& world, P2BodyType bodyType, const Vec2& worldPos);
 
@@ -72,6 +95,39 @@ namespace s3d
 		[[nodiscard]]
 		const HashTable<P2ContactPair, P2Collision>& getCollisions() const noexcept;
 
+		void setContactMode(P2ContactMode mode);
+
+		[[nodiscard]]
+		P2ContactMode getContactMode() const noexcept;
+
+		[[nodiscard]]
+		std::span<const P2ContactEvent> getContactEvents() const noexcept;
+
+		/// @brief 部品の AABB が aabb と交差する物体の ID を results の末尾に追加します。
+		/// @remark 追加した範囲は昇順に並べ、重複を取り除きます。
+		void queryAABB(const b2AABB& aabb, Array<P2BodyID>& results) const;
+
+		[[nodiscard]]
+		Optional<P2RaycastHit> raycast(const Vec2& start, const Vec2& end) const;
+
+		void raycastAll(const Vec2& start, const Vec2& end, Array<P2RaycastHit>& results) const;
+
+		/// @param shape ワールド座標での形状
+		[[nodiscard]]
+		Optional<P2RaycastHit> shapeCast(const b2Shape& shape, const Vec2& translation) const;
+
+		/// @brief すべての物体の状態を ID の昇順に取得します。
+		void exportStates(P2BodyStates& states) const;
+
+		/// @brief ID が一致する物体に状態を設定します。
+		/// @return 状態を設定した物体の数
+		size_t importStates(const P2BodyStates& states);
+
+		void saveSnapshot(Blob& blob) const;
+
+		[[nodiscard]]
+		bool loadSnapshot(const Blob& blob);
+
 		[[nodiscard]]
 		b2World& getData() noexcept;
 
@@ -81,12 +137,38 @@ namespace s3d
 		[[nodiscard]]
 		b2World* getWorldPtr() noexcept;
 
+		/// @brief 部品を持つ物体の ID を返します。
+		[[nodiscard]]
+		static P2BodyID GetBodyID(b2Fixture* fixture) noexcept;
+
+		/// @brief 物体の ID を返します。
+		/// @remark 物体が P2Body に対応している必要があります。
+		[[nodiscard]]
+		static P2BodyID GetBodyID(const b2Body& body) noexcept;
+
+		/// @brief 物体が P2Body に対応しているかを返します。
+		/// @remark P2MouseJoint が内部で作成する物体は P2Body に対応しません。
+		[[nodiscard]]
+		static bool HasBodyID(const b2Body& body) noexcept;
+
 	private:
 
 		b2World m_world;
 
 		P2ContactListener m_contactListner;
 
+		P2ParallelForCallback m_parallelForCallback;
+
+		bool m_parallelSolveEnabled = false;
+
+		// updateFixed() で、まだシミュレーションしていない時間（秒）
+		double m_accumulatedTime = 0.0;
+
+		double m_interpolationAlpha = 0.0;
+
+		// updateFixed() の最後のステップの直前の状態
+		P2BodyStates m_previousStates;
+
 		std::atomic<P2BodyID> m_currentID = { 0 };
 
 		[[nodiscard]]
@@ -0,0 +1,124 @@
+﻿//-----------------------------------------------
+//
+//	This file is part of the Siv3D Engine.
+//
+//	Copyright (c) 2008-2022 Ryo Suzuki
+//	Copyright (c) 2016-2022 OpenSiv3D Project
+//
+//	Licensed under the MIT License.
+//
+//-----------------------------------------------
+
+# include <Siv3D/Font/IFont.hpp>
+# include <Siv3D/Common/Siv3DEngine.hpp>
+# include "PreparedTextDetail.hpp"
+
+namespace s3d
+{
+	namespace detail
+	{
+		/// @brief 配置が同じになる先頭のクラスタの数を返します。
+		[[nodiscard]]
+		static size_t CountCommonClusters(const StringView oldText, const Array<GlyphCluster>& oldClusters, const StringView newText, const Array<GlyphCluster>& newClusters) noexcept
+		{
+			const size_t count = Min(oldClusters.size(), newClusters.size());
+
+			for (size_t i = 0; i < count; ++i)
+			{
+				const GlyphCluster& a = oldClusters[i];
+				const GlyphCluster& b = newClusters[i];
+
+				// 制御文字の場合は文字によって配置が変わる
+				if ((a.glyphIndex != b.glyphIndex)
+					|| (a.fontIndex != b.fontIndex)
+					|| (a.pos != b.pos)
+					|| (oldText[a.pos] != newText[b.pos]))
+				{
+					return i;
+				}
+			}
+
+			return count;
+		}
+	}
+
+	PreparedText::PreparedTextDetail::PreparedTextDetail(const Font& font, String text)
+		: m_font{ font }
+		, m_text{ std::move(text) }
+		, m_clusters{ m_font.getGlyphClusters(m_text) }
+	{
+		layout(0);
+	}
+
+	PreparedText::PreparedTextDetail::PreparedTextDetail(const Font& font, String text, Array<GlyphCluster> clusters)
+		: m_font{ font }
+		, m_text{ std::move(text) }
+		, m_clusters{ std::move(clusters) }
+	{
+		layout(0);
+	}
+
+	void PreparedText::PreparedTextDetail::setText(String text)
+	{
+		Array<GlyphCluster> clusters = m_font.getGlyphClusters(text);
+		const size_t firstCluster = detail::CountCommonClusters(m_text, m_clusters, text, clusters);
+
+		m_text = std::move(text);
+		m_clusters = std::move(clusters);
+		layout(firstCluster);
+	}
+
+	const Font& PreparedText::PreparedTextDetail::font() const noexcept
+	{
+		return m_font;
+	}
+
+	const String& PreparedText::PreparedTextDetail::text() const noexcept
+	{
+		return m_text;
+	}
+
+	size_t PreparedText::PreparedTextDetail::num_relayoutClusters() const noexcept
+	{
+		return m_relayoutClusters;
+	}
+
+	size_t PreparedText::PreparedTextDetail::num_glyphs() const noexcept
+	{
+		return m_layout.glyphs.size();
+	}
+
+	size_t PreparedText::PreparedTextDetail::memoryUsage() const noexcept
+	{
+		return (sizeof(PreparedTextDetail)
+			+ (m_text.capacity() * sizeof(char32))
+			+ (m_clusters.capacity() * sizeof(GlyphCluster))
+			+ m_layout.memoryUsage());
+	}
+
+	RectF PreparedText::PreparedTextDetail::region(const double size, const Vec2& pos) const
+	{
+		const double scale = (size / m_font.fontSize());
+		return{ pos, (m_layout.width() * scale), (m_layout.lineCount() * m_font.height(size)) };
+	}
+
+	RectF PreparedText::PreparedTextDetail::draw(const TextStyle& textStyle, const double size, const Vec2& pos, const ColorF& color) const
+	{
+		if (m_clusters.isEmpty())
+		{
+			return region(size, pos);
+		}
+
+		return SIV3D_ENGINE(Font)->drawPrepared(m_font.id(), m_text, m_clusters, m_layout, pos, size, textStyle, color);
+	}
+
+	void PreparedText::PreparedTextDetail::layout(const size_t firstCluster)
+	{
+		if (not SIV3D_ENGINE(Font)->prepare(m_font.id(), m_text, m_clusters, firstCluster, m_layout))
+		{
+			m_layout.clear();
+		}
+
+		m_relayoutClusters = (m_clusters.size() - Min(m_layout.firstRelayoutCluster, m_clusters.size()));
+	}
+}
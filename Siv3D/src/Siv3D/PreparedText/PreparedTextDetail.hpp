@@ -0,0 +1,65 @@
+﻿//-----------------------------------------------
+//
+//	This file is part of the Siv3D Engine.
+//
+//	Copyright (c) 2008-2022 Ryo Suzuki
+//	Copyright (c) 2016-2022 OpenSiv3D Project
+//
+//	Licensed under the MIT License.
+//
+//-----------------------------------------------
+
+# pragma once
+# include <Siv3D/PreparedText.hpp>
+# include <Siv3D/Font/PreparedTextLayout.hpp>
+
+namespace s3d
+{
+	class PreparedText::PreparedTextDetail
+	{
+	public:
+
+		PreparedTextDetail() = default;
+
+		PreparedTextDetail(const Font& font, String text);
+
+		PreparedTextDetail(const Font& font, String text, Array<GlyphCluster> clusters);
+
+		void setText(String text);
+
+		[[nodiscard]]
+		const Font& font() const noexcept;
+
+		[[nodiscard]]
+		const String& text() const noexcept;
+
+		[[nodiscard]]
+		size_t num_relayoutClusters() const noexcept;
+
+		[[nodiscard]]
+		size_t num_glyphs() const noexcept;
+
+		[[nodiscard]]
+		size_t memoryUsage() const noexcept;
+
+		[[nodiscard]]
+		RectF region(double size, const Vec2& pos) const;
+
+		RectF draw(const TextStyle& textStyle, double size, const Vec2& pos, const ColorF& color) const;
+
+	private:
+
+		Font m_font;
+
+		String m_text;
+
+		Array<GlyphCluster> m_clusters;
+
+		// 描画時にアトラスのテクスチャ領域が無効になっていた場合に作り直すため mutable
+		mutable PreparedTextLayout m_layout;
+
+		size_t m_relayoutClusters = 0;
+
+		void layout(size_t firstCluster);
+	};
+}
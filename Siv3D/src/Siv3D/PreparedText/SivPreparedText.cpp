@@ -0,0 +1,162 @@
+﻿//-----------------------------------------------
+//
+//	This file is part of the Siv3D Engine.
+//
+//	Copyright (c) 2008-2022 Ryo Suzuki
+//	Copyright (c) 2016-2022 OpenSiv3D Project
+//
+//	Licensed under the MIT License.
+//
+//-----------------------------------------------
+
+# include <Siv3D/PreparedText.hpp>
+# include <Siv3D/DrawableText.hpp>
+# include "PreparedTextDetail.hpp"
+
+namespace s3d
+{
+	PreparedText::PreparedText()
+		: pImpl{ std::make_unique<PreparedTextDetail>() } {}
+
+	PreparedText::PreparedText(const Font& font, String text)
+		: pImpl{ std::make_unique<PreparedTextDetail>(font, std::move(text)) } {}
+
+	PreparedText::PreparedText(const DrawableText& drawableText)
+		: pImpl{ std::make_unique<PreparedTextDetail>(drawableText.font, drawableText.text, drawableText.clusters) } {}
+
+	PreparedText::PreparedText(const PreparedText& other)
+		: pImpl{ std::make_unique<PreparedTextDetail>(*other.pImpl) } {}
+
+	PreparedText::PreparedText(PreparedText&& other) noexcept
+		: pImpl{ std::move(other.pImpl) }
+	{
+		other.pImpl = std::make_unique<PreparedTextDetail>();
+	}
+
+	PreparedText::~PreparedText() {}
+
+	PreparedText& PreparedText::operator =(const PreparedText& other)
+	{
+		*pImpl = *other.pImpl;
+
+		return *this;
+	}
+
+	PreparedText& PreparedText::operator =(PreparedText&& other) noexcept
+	{
+		std::swap(pImpl, other.pImpl);
+
+		return *this;
+	}
+
+	const Font& PreparedText::font() const noexcept
+	{
+		return pImpl->font();
+	}
+
+	const String& PreparedText::text() const noexcept
+	{
+		return pImpl->text();
+	}
+
+	bool PreparedText::isEmpty() const noexcept
+	{
+		return pImpl->text().isEmpty();
+	}
+
+	PreparedText::operator bool() const noexcept
+	{
+		return (not isEmpty());
+	}
+
+	void PreparedText::setText(String text)
+	{
+		pImpl->setText(std::move(text));
+	}
+
+	void PreparedText::append(const StringView text)
+	{
+		pImpl->setText(pImpl->text() + text);
+	}
+
+	size_t PreparedText::num_relayoutClusters() const noexcept
+	{
+		return pImpl->num_relayoutClusters();
+	}
+
+	size_t PreparedText::num_glyphs() const noexcept
+	{
+		return pImpl->num_glyphs();
+	}
+
+	size_t PreparedText::memoryUsage() const noexcept
+	{
+		return pImpl->memoryUsage();
+	}
+
+	RectF PreparedText::region(const Vec2& pos) const
+	{
+		return pImpl->region(pImpl->font().fontSize(), pos);
+	}
+
+	RectF PreparedText::region(const double size, const Vec2& pos) const
+	{
+		return pImpl->region(size, pos);
+	}
+
+	RectF PreparedText::regionAt(const Vec2& pos) const
+	{
+		return regionAt(pImpl->font().fontSize(), pos);
+	}
+
+	RectF PreparedText::regionAt(const double size, const Vec2& pos) const
+	{
+		const RectF rect = region(size, Vec2{ 0, 0 });
+
+		return rect.movedBy(pos - rect.center());
+	}
+
+	RectF PreparedText::draw(const double x, const double y, const ColorF& color) const
+	{
+		return draw(Vec2{ x, y }, color);
+	}
+
+	RectF PreparedText::draw(const Vec2& pos, const ColorF& color) const
+	{
+		return draw(TextStyle::Default(), pImpl->font().fontSize(), pos, color);
+	}
+
+	RectF PreparedText::draw(const double size, const Vec2& pos, const ColorF& color) const
+	{
+		return draw(TextStyle::Default(), size, pos, color);
+	}
+
+	RectF PreparedText::draw(const TextStyle& textStyle, const Vec2& pos, const ColorF& color) const
+	{
+		return draw(textStyle, pImpl->font().fontSize(), pos, color);
+	}
+
+	RectF PreparedText::draw(const TextStyle& textStyle, const double size, const Vec2& pos, const ColorF& color) const
+	{
+		return pImpl->draw(textStyle, size, pos, color);
+	}
+
+	RectF PreparedText::drawAt(const Vec2& pos, const ColorF& color) const
+	{
+		return drawAt(TextStyle::Default(), pImpl->font().fontSize(), pos, color);
+	}
+
+	RectF PreparedText::drawAt(const double size, const Vec2& pos, const ColorF& color) const
+	{
+		return drawAt(TextStyle::Default(), size, pos, color);
+	}
+
+	RectF PreparedText::drawAt(const TextStyle& textStyle, const double size, const Vec2& pos, const ColorF& color) const
+	{
+		const RectF rect = region(size, Vec2{ 0, 0 });
+
+		const Vec2 drawPos = (pos - rect.center());
+
+		return draw(textStyle, size, drawPos, color);
+	}
+}
@@ -19,6 +19,7 @@
 # include <Siv3D/Window/IWindow.hpp>
 # include <Siv3D/Renderer/IRenderer.hpp>
 # include <Siv3D/Renderer2D/IRenderer2D.hpp>
+# include <Siv3D/Renderer3D/IRenderer3D.hpp>
 # include <Siv3D/Texture/ITexture.hpp>
 # include <Siv3D/Font/IFont.hpp>
 # include <Siv3D/Audio/IAudio.hpp>
@@ -59,8 +60,23 @@ namespace s3d
 				m_stat.triangleCount = stat.triangleCount;
 			}
 
+			{
+				// インスタンス描画は 1 回の描画呼び出しとして数える
+				const auto stat = SIV3D_ENGINE(Renderer3D)->getStat();
+				m_stat.drawCalls += stat.drawCalls;
+				m_stat.triangleCount += stat.triangleCount;
+			}
+
+			{
+				// 前のフレームからのシェーピングキャッシュの利用状況
+				const auto stat = SIV3D_ENGINE(Font)->takeShapingCacheStat();
+				m_stat.glyphShapingCacheHits = static_cast<uint32>(stat.hits);
+				m_stat.glyphShapingCacheMisses = static_cast<uint32>(stat.misses);
+			}
+
 			m_stat.textureCount	= static_cast<uint32>(SIV3D_ENGINE(Texture)->getTextureCount());
 			m_stat.fontCount	= static_cast<uint32>(SIV3D_ENGINE(Font)->getFontCount());
+			m_stat.pendingGlyphCount = static_cast<uint32>(SIV3D_ENGINE(Font)->getPendingGlyphCount());
 			m_stat.audioCount	= static_cast<uint32>(SIV3D_ENGINE(Audio)->getAudioCount());
 			m_stat.activeVoice	= static_cast<uint32>(GlobalAudio::GetActiveVoiceCount());
 		}
@@ -22,5 +22,8 @@ namespace s3d
 		Print << U"Font count\t\t\t" << fontCount;
 		Print << U"Audio count\t\t" << audioCount;
 		Print << U"Active voice\t\t" << activeVoice;
+		Print << U"Shaping cache hits\t" << glyphShapingCacheHits;
+		Print << U"Shaping cache misses\t" << glyphShapingCacheMisses;
+		Print << U"Pending glyphs\t\t" << pendingGlyphCount;
 	}
 }
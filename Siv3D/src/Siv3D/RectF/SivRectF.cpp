@@ -546,6 +546,29 @@ namespace s3d
 		return *this;
 	}
 
+	namespace detail
+	{
+		static void DrawRectBatch(const RectF* rects, const size_t size, const ColorF* colors, const size_t num_colors)
+		{
+			SIV3D_ENGINE(Renderer2D)->addBatch([=](const BufferCreatorFunc& bufferCreator, Array<Vertex2DBatchOffset>&, const float, size_t& offset)
+			{
+				return Vertex2DBuilder::BuildRects(bufferCreator, rects, size, colors, num_colors, offset);
+			});
+		}
+	}
+
+	void RectF::DrawBatch(const Array<RectF>& rects, const ColorF& color)
+	{
+		detail::DrawRectBatch(rects.data(), rects.size(), &color, 1);
+	}
+
+	void RectF::DrawBatch(const Array<RectF>& rects, const Array<ColorF>& colors)
+	{
+		const size_t size = Min(rects.size(), colors.size());
+
+		detail::DrawRectBatch(rects.data(), size, colors.data(), size);
+	}
+
 	TexturedQuad RectF::operator ()(const Texture& texture) const
 	{
 		return{ texture,
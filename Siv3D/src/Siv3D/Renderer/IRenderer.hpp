@@ -48,6 +48,15 @@ namespace s3d
 
 		virtual const Image& getScreenCapture() const = 0;
 
+		/// @brief 現在のフレームの非同期の読み出しを開始します。
+		/// @return 読み出しを開始した場合 true, 非同期の読み出しに対応していないか、読み出し中のフレームが多すぎる場合は false
+		virtual bool captureScreenshotAsync() = 0;
+
+		/// @brief 非同期の読み出しが完了したフレームを、古い順に 1 つ取得します。
+		/// @param image 取得した画像の格納先
+		/// @return 読み出しが完了したフレームがあった場合 true, それ以外の場合は false
+		virtual bool retrieveScreenshotAsync(Image& image) = 0;
+
 		virtual void setSceneResizeMode(ResizeMode resizeMode) = 0;
 
 		virtual ResizeMode getSceneResizeMode() const noexcept = 0;
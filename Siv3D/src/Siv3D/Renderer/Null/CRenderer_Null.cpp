@@ -92,6 +92,17 @@ namespace s3d
 		return emptyImage;
 	}
 
+	bool CRenderer_Null::captureScreenshotAsync()
+	{
+		// do nothing
+		return false;
+	}
+
+	bool CRenderer_Null::retrieveScreenshotAsync(Image&)
+	{
+		return false;
+	}
+
 	void CRenderer_Null::setSceneResizeMode(ResizeMode)
 	{
 		// do nothing
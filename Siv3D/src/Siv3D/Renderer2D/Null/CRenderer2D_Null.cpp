@@ -167,6 +167,32 @@ namespace s3d
 		// do nothing
 	}
 
+	void CRenderer2D_Null::addBatch(const Batch2DBuildFunc& build)
+	{
+		// 描画はしないが、頂点の作成にかかる時間を計測できるよう、作業用のバッファに頂点を作成する
+		const BufferCreatorFunc bufferCreator = [this](const Vertex2D::IndexType vertexSize, const Vertex2D::IndexType indexSize)
+		{
+			m_vertices.resize(vertexSize);
+			m_indices.resize(indexSize);
+			return Vertex2DBufferPointer{ m_vertices.data(), m_indices.data(), 0 };
+		};
+
+		size_t offset = 0;
+
+		while (const auto indexCount = build(bufferCreator, m_batchOffsetBuffer, 1.0f, offset))
+		{
+			++m_stat.drawCalls;
+			m_stat.triangleCount += (indexCount / 3);
+		}
+	}
+
+	void CRenderer2D_Null::addParticles(const ParticleStore2D&,
+		const ParticleSystem2DParameters::SizeOverLifeTimeFunc&,
+		const ParticleSystem2DParameters::ColorOverLifeTimeFunc&)
+	{
+		// do nothing
+	}
+
 	void CRenderer2D_Null::addNullVertices(const uint32)
 	{
 		// do nothing
@@ -202,9 +228,9 @@ namespace s3d
 		// do nothing
 	}
 
-	void CRenderer2D_Null::addTexturedParticles(const Texture&, const Array<Particle2D>&,
-		ParticleSystem2DParameters::SizeOverLifeTimeFunc,
-		ParticleSystem2DParameters::ColorOverLifeTimeFunc)
+	void CRenderer2D_Null::addTexturedParticles(const Texture&, const ParticleStore2D&,
+		const ParticleSystem2DParameters::SizeOverLifeTimeFunc&,
+		const ParticleSystem2DParameters::ColorOverLifeTimeFunc&)
 	{
 		// do nothing
 	}
@@ -13,6 +13,7 @@
 # include <Siv3D/FastMath.hpp>
 # include <Siv3D/Math.hpp>
 # include <Siv3D/OffsetCircular.hpp>
+# include <Siv3D/ThreadPool.hpp>
 
 namespace s3d
 {
@@ -116,6 +117,78 @@ namespace s3d
 				: r <= 12.0f ? 8
 				: static_cast<Vertex2D::IndexType>(Min(64.0f, r * 0.2f + 6));
 		}
+
+		// 多数の図形をまとめて作成するとき、1 回に確保する頂点とインデックスの最大数
+		static constexpr size_t MaxBatchVertexCount = 65535;
+
+		static constexpr size_t MaxBatchIndexCount = (65535 / 3 * 3);
+
+		// 多数の図形をまとめて作成するとき、1 つのスレッドが受け持つ図形の最小数
+		static constexpr size_t BatchGrainSize = 1024;
+
+		[[nodiscard]]
+		inline Float4 GetBatchColor(const ColorF* colors, const size_t num_colors, const size_t i) noexcept
+		{
+			return colors[(num_colors == 1) ? 0 : i].toFloat4();
+		}
+
+		// 範囲 [0, size) を分割して、複数のスレッドで互いに重ならないバッファの範囲に書き込む
+		template <class Fty>
+		void ParallelFill(const size_t size, Fty f)
+		{
+		# if defined(SIV3D_NO_CONCURRENT_API)
+
+			f(size_t{ 0 }, size);
+
+		# else
+
+			if (size < (BatchGrainSize * 2))
+			{
+				f(size_t{ 0 }, size);
+			}
+			else
+			{
+				Threading::GetDefaultPool().parallel_for(0, size, BatchGrainSize, f);
+			}
+
+		# endif
+		}
+
+		// offset から順に、1 回のバッファの確保に収まる図形の頂点とインデックスの位置を計算する
+		// 頂点またはインデックスが多すぎて収まらない図形は、offset を進めて読み飛ばす
+		template <class SizeFunc>
+		void CalculateBatchOffsets(const size_t size, size_t& offset, Array<Vertex2DBatchOffset>& offsets, SizeFunc sizeFunc)
+		{
+			offsets.clear();
+
+			for (; offset < size; ++offset)
+			{
+				const auto [vertexCount, indexCount] = sizeFunc(offset);
+
+				if ((0 < indexCount) && (vertexCount <= MaxBatchVertexCount) && (indexCount <= MaxBatchIndexCount))
+				{
+					break;
+				}
+			}
+
+			Vertex2DBatchOffset current{ 0, 0 };
+			offsets << current;
+
+			for (size_t i = offset; i < size; ++i)
+			{
+				const auto [vertexCount, indexCount] = sizeFunc(i);
+
+				if ((MaxBatchVertexCount < (current.vertex + vertexCount))
+					|| (MaxBatchIndexCount < (current.index + indexCount)))
+				{
+					break;
+				}
+
+				current.vertex += static_cast<uint32>(vertexCount);
+				current.index += static_cast<uint32>(indexCount);
+				offsets << current;
+			}
+		}
 	}
 
 	namespace Vertex2DBuilder
@@ -2549,6 +2622,256 @@ namespace s3d
 			return indexSize;
 		}
 
+		Vertex2D::IndexType BuildRects(const BufferCreatorFunc& bufferCreator, const RectF* rects, const size_t size, const ColorF* colors, const size_t num_colors, size_t& offset)
+		{
+			if (size <= offset)
+			{
+				return 0;
+			}
+
+			constexpr size_t MaxCount = (detail::MaxBatchIndexCount / 6);
+			const size_t count = Min((size - offset), MaxCount);
+			const Vertex2D::IndexType vertexSize = static_cast<Vertex2D::IndexType>(count * 4), indexSize = static_cast<Vertex2D::IndexType>(count * 6);
+			const Vertex2DBufferPointer buffer = bufferCreator(vertexSize, indexSize);
+
+			if (not buffer.pVertex)
+			{
+				return 0;
+			}
+
+			const RectF* pSrc = (rects + offset);
+			const ColorF* pColor = ((num_colors == 1) ? colors : (colors + offset));
+
+			detail::ParallelFill(count, [=](const size_t begin, const size_t end)
+			{
+				Vertex2D* pVertex = (buffer.pVertex + (begin * 4));
+				Vertex2D::IndexType* pIndex = (buffer.pIndex + (begin * 6));
+
+				for (size_t i = begin; i < end; ++i)
+				{
+					const RectF& rect = pSrc[i];
+					const Float4 color = detail::GetBatchColor(pColor, num_colors, i);
+					const float left = static_cast<float>(rect.x);
+					const float top = static_cast<float>(rect.y);
+					const float right = static_cast<float>(rect.x + rect.w);
+					const float bottom = static_cast<float>(rect.y + rect.h);
+
+					pVertex[0].set(left, top, color);
+					pVertex[1].set(right, top, color);
+					pVertex[2].set(left, bottom, color);
+					pVertex[3].set(right, bottom, color);
+					pVertex += 4;
+
+					const Vertex2D::IndexType indexOffset = static_cast<Vertex2D::IndexType>(buffer.indexOffset + (i * 4));
+
+					for (Vertex2D::IndexType k = 0; k < 6; ++k)
+					{
+						*pIndex++ = (indexOffset + detail::RectIndexTable[k]);
+					}
+				}
+			});
+
+			offset += count;
+			return indexSize;
+		}
+
+		Vertex2D::IndexType BuildCircles(const BufferCreatorFunc& bufferCreator, Array<Vertex2DBatchOffset>& buffer, const Circle* circles, const size_t size, const ColorF* colors, const size_t num_colors, const float scale, size_t& offset)
+		{
+			detail::CalculateBatchOffsets(size, offset, buffer, [=](const size_t i)
+			{
+				const size_t quality = detail::CalculateCircleQuality(static_cast<float>(Abs(circles[i].r)) * scale);
+				return std::pair{ (quality + 1), (quality * 3) };
+			});
+
+			const size_t count = (buffer.size() - 1);
+
+			if (count == 0)
+			{
+				return 0;
+			}
+
+			const Vertex2D::IndexType vertexSize = static_cast<Vertex2D::IndexType>(buffer.back().vertex), indexSize = static_cast<Vertex2D::IndexType>(buffer.back().index);
+			const Vertex2DBufferPointer bufferPointer = bufferCreator(vertexSize, indexSize);
+
+			if (not bufferPointer.pVertex)
+			{
+				return 0;
+			}
+
+			const Circle* pSrc = (circles + offset);
+			const ColorF* pColor = ((num_colors == 1) ? colors : (colors + offset));
+			const Vertex2DBatchOffset* pOffsets = buffer.data();
+
+			detail::ParallelFill(count, [=](const size_t begin, const size_t end)
+			{
+				for (size_t i = begin; i < end; ++i)
+				{
+					const Circle& circle = pSrc[i];
+					const Float4 color = detail::GetBatchColor(pColor, num_colors, i);
+					const float centerX = static_cast<float>(circle.x);
+					const float centerY = static_cast<float>(circle.y);
+					const float r = static_cast<float>(circle.r);
+					const Vertex2D::IndexType quality = static_cast<Vertex2D::IndexType>(pOffsets[i + 1].vertex - pOffsets[i].vertex - 1);
+
+					Vertex2D* pVertex = (bufferPointer.pVertex + pOffsets[i].vertex);
+					Vertex2D::IndexType* pIndex = (bufferPointer.pIndex + pOffsets[i].index);
+					const Vertex2D::IndexType indexOffset = static_cast<Vertex2D::IndexType>(bufferPointer.indexOffset + pOffsets[i].vertex);
+
+					// 中心
+					(pVertex++)->set(centerX, centerY, color);
+
+					// 周
+					if (quality <= detail::MaxSinCosTableQuality)
+					{
+						const Float2* pCS = detail::GetSinCosTableStartPtr(quality);
+
+						for (Vertex2D::IndexType k = 0; k < quality; ++k)
+						{
+							(pVertex++)->set((r * pCS->x + centerX), (r * pCS->y + centerY), color);
+							++pCS;
+						}
+					}
+					else
+					{
+						const float radDelta = (Math::TwoPiF / quality);
+
+						for (Vertex2D::IndexType k = 0; k < quality; ++k)
+						{
+							const auto [s, c] = FastMath::SinCos(radDelta * k);
+							(pVertex++)->set((centerX + r * c), (centerY - r * s), color);
+						}
+					}
+
+					for (Vertex2D::IndexType k = 0; k < (quality - 1); ++k)
+					{
+						*pIndex++ = indexOffset + (k + 1);
+						*pIndex++ = indexOffset;
+						*pIndex++ = indexOffset + (k + 2);
+					}
+
+					*pIndex++ = (indexOffset + quality);
+					*pIndex++ = indexOffset;
+					*pIndex++ = (indexOffset + 1);
+				}
+			});
+
+			offset += count;
+			return indexSize;
+		}
+
+		Vertex2D::IndexType BuildLines(const BufferCreatorFunc& bufferCreator, const Line* lines, const size_t size, const float thickness, const ColorF* colors, const size_t num_colors, size_t& offset)
+		{
+			if ((size <= offset) || (thickness <= 0.0f))
+			{
+				return 0;
+			}
+
+			constexpr size_t MaxCount = (detail::MaxBatchIndexCount / 6);
+			const size_t count = Min((size - offset), MaxCount);
+			const Vertex2D::IndexType vertexSize = static_cast<Vertex2D::IndexType>(count * 4), indexSize = static_cast<Vertex2D::IndexType>(count * 6);
+			const Vertex2DBufferPointer buffer = bufferCreator(vertexSize, indexSize);
+
+			if (not buffer.pVertex)
+			{
+				return 0;
+			}
+
+			const Line* pSrc = (lines + offset);
+			const ColorF* pColor = ((num_colors == 1) ? colors : (colors + offset));
+			const float halfThickness = (thickness * 0.5f);
+
+			detail::ParallelFill(count, [=](const size_t begin, const size_t end)
+			{
+				Vertex2D* pVertex = (buffer.pVertex + (begin * 4));
+				Vertex2D::IndexType* pIndex = (buffer.pIndex + (begin * 6));
+
+				for (size_t i = begin; i < end; ++i)
+				{
+					const Float2 lineBegin = pSrc[i].begin;
+					const Float2 lineEnd = pSrc[i].end;
+					const Float4 color = detail::GetBatchColor(pColor, num_colors, i);
+
+					// LineStyle::SquareCap の線
+					const Float2 line = (lineEnd - lineBegin).normalized();
+					const Float2 vNormal{ (-line.y * halfThickness), (line.x * halfThickness) };
+					const Float2 lineHalf{ line * halfThickness };
+					const Float2 begin2 = (lineBegin - lineHalf);
+					const Float2 end2 = (lineEnd + lineHalf);
+
+					pVertex[0].set(begin2 + vNormal, color);
+					pVertex[1].set(begin2 - vNormal, color);
+					pVertex[2].set(end2 + vNormal, color);
+					pVertex[3].set(end2 - vNormal, color);
+					pVertex += 4;
+
+					const Vertex2D::IndexType indexOffset = static_cast<Vertex2D::IndexType>(buffer.indexOffset + (i * 4));
+
+					for (Vertex2D::IndexType k = 0; k < 6; ++k)
+					{
+						*pIndex++ = (indexOffset + detail::RectIndexTable[k]);
+					}
+				}
+			});
+
+			offset += count;
+			return indexSize;
+		}
+
+		Vertex2D::IndexType BuildShapes(const BufferCreatorFunc& bufferCreator, Array<Vertex2DBatchOffset>& buffer, const Shape2D* shapes, const size_t size, const ColorF* colors, const size_t num_colors, size_t& offset)
+		{
+			detail::CalculateBatchOffsets(size, offset, buffer, [=](const size_t i)
+			{
+				return std::pair{ shapes[i].vertices().size(), (shapes[i].indices().size() * 3) };
+			});
+
+			const size_t count = (buffer.size() - 1);
+
+			if (count == 0)
+			{
+				return 0;
+			}
+
+			const Vertex2D::IndexType vertexSize = static_cast<Vertex2D::IndexType>(buffer.back().vertex), indexSize = static_cast<Vertex2D::IndexType>(buffer.back().index);
+			const Vertex2DBufferPointer bufferPointer = bufferCreator(vertexSize, indexSize);
+
+			if (not bufferPointer.pVertex)
+			{
+				return 0;
+			}
+
+			const Shape2D* pSrc = (shapes + offset);
+			const ColorF* pColor = ((num_colors == 1) ? colors : (colors + offset));
+			const Vertex2DBatchOffset* pOffsets = buffer.data();
+
+			detail::ParallelFill(count, [=](const size_t begin, const size_t end)
+			{
+				for (size_t i = begin; i < end; ++i)
+				{
+					const Shape2D& shape = pSrc[i];
+					const Float4 color = detail::GetBatchColor(pColor, num_colors, i);
+
+					Vertex2D* pVertex = (bufferPointer.pVertex + pOffsets[i].vertex);
+					Vertex2D::IndexType* pIndex = (bufferPointer.pIndex + pOffsets[i].index);
+					const Vertex2D::IndexType indexOffset = static_cast<Vertex2D::IndexType>(bufferPointer.indexOffset + pOffsets[i].vertex);
+
+					for (const auto& vertex : shape.vertices())
+					{
+						(pVertex++)->set(vertex, color);
+					}
+
+					for (const auto& triangleIndex : shape.indices())
+					{
+						*pIndex++ = (indexOffset + triangleIndex.i0);
+						*pIndex++ = (indexOffset + triangleIndex.i1);
+						*pIndex++ = (indexOffset + triangleIndex.i2);
+					}
+				}
+			});
+
+			offset += count;
+			return indexSize;
+		}
+
 		Vertex2D::IndexType BuildTextureRegion(const BufferCreatorFunc& bufferCreator, const FloatRect& rect, const FloatRect& uv, const Float4& color)
 		{
 			constexpr Vertex2D::IndexType vertexSize = 4, indexSize = 6;
@@ -2812,54 +3135,95 @@ namespace s3d
 			return indexSize;
 		}
 
-		Vertex2D::IndexType BuildTexturedParticles(const BufferCreatorFunc& bufferCreator, const Array<Particle2D>& particles,
-			const ParticleSystem2DParameters::SizeOverLifeTimeFunc& sizeOverLifeTimeFunc, const ParticleSystem2DParameters::ColorOverLifeTimeFunc& colorOverLifeTimeFunc)
+		Vertex2D::IndexType BuildParticles(const BufferCreatorFunc& bufferCreator, const ParticleStore2D& particles,
+			const ParticleSystem2DParameters::SizeOverLifeTimeFunc& sizeOverLifeTimeFunc, const ParticleSystem2DParameters::ColorOverLifeTimeFunc& colorOverLifeTimeFunc, size_t& offset)
 		{
-			const Vertex2D::IndexType vertexSize = static_cast<Vertex2D::IndexType>(particles.size() * 4);
-			const Vertex2D::IndexType indexSize = static_cast<Vertex2D::IndexType>(particles.size() * 6);
-			auto [pVertex, pIndex, indexOffset] = bufferCreator(vertexSize, indexSize);
+			const size_t size = particles.size();
 
-			if (not pVertex)
+			if (size <= offset)
 			{
 				return 0;
 			}
 
-			for (const auto& particle : particles)
-			{
-				const float size = sizeOverLifeTimeFunc(particle.startSize, particle.startLifeTime, particle.remainingLifeTime);
-				const Float4 color = colorOverLifeTimeFunc(particle.startColor, particle.startLifeTime, particle.remainingLifeTime);
-
-				const float size_half = (size * 0.5f);
-				const float cx = particle.position.x;
-				const float cy = particle.position.y;
-
-				const float x = size_half;
-				const auto [s, c] = FastMath::SinCos(particle.rotation);
-				const float xc = x * c;
-				const float xs = x * s;
+			const size_t count = Min((size - offset), MaxParticlesPerBatch);
+			const Vertex2D::IndexType vertexSize = static_cast<Vertex2D::IndexType>(count * 4), indexSize = static_cast<Vertex2D::IndexType>(count * 6);
+			const Vertex2DBufferPointer buffer = bufferCreator(vertexSize, indexSize);
 
-				pVertex[0].set({ -xc + xs + cx, -xs - xc + cy }, 0.0f, 0.0f, color);
-				pVertex[1].set({ xc + xs + cx, xs - xc + cy }, 1.0f, 0.0f, color);
-				pVertex[2].set({ -xc - xs + cx, -xs + xc + cy }, 0.0f, 1.0f, color);
-				pVertex[3].set({ xc - xs + cx, xs + xc + cy }, 1.0f, 1.0f, color);
-				pVertex += 4;
+			if (not buffer.pVertex)
+			{
+				return 0;
 			}
 
+			const auto fill = [&, buffer](const size_t begin, const size_t end)
 			{
-				Vertex2D::IndexType indexBase = indexOffset;
+				WriteParticleVertices((buffer.pVertex + (begin * 4)), particles, (offset + begin), (offset + end), sizeOverLifeTimeFunc, colorOverLifeTimeFunc);
+
+				Vertex2D::IndexType* pIndex = (buffer.pIndex + (begin * 6));
 
-				for (Vertex2D::IndexType n = 0; n < particles.size(); ++n)
+				for (size_t i = begin; i < end; ++i)
 				{
-					for (Vertex2D::IndexType i = 0; i < 6; ++i)
+					const Vertex2D::IndexType indexOffset = static_cast<Vertex2D::IndexType>(buffer.indexOffset + (i * 4));
+
+					for (Vertex2D::IndexType k = 0; k < 6; ++k)
 					{
-						*pIndex++ = (indexBase + detail::RectIndexTable[i]);
+						*pIndex++ = (indexOffset + detail::RectIndexTable[k]);
 					}
-
-					indexBase += 4;
 				}
+			};
+
+			// ユーザー定義の関数は、これまでどおり呼び出し元のスレッドで順番に呼ぶ
+			if (sizeOverLifeTimeFunc || colorOverLifeTimeFunc)
+			{
+				fill(0, count);
+			}
+			else
+			{
+				detail::ParallelFill(count, fill);
 			}
 
+			offset += count;
 			return indexSize;
 		}
+
+		void WriteParticleVertices(Vertex2D* pVertex, const ParticleStore2D& particles, const size_t begin, const size_t end,
+			const ParticleSystem2DParameters::SizeOverLifeTimeFunc& sizeOverLifeTimeFunc, const ParticleSystem2DParameters::ColorOverLifeTimeFunc& colorOverLifeTimeFunc)
+		{
+			const float* pX = particles.positionX();
+			const float* pY = particles.positionY();
+			const float* pRotation = particles.rotation();
+			const float* pStartSize = particles.startSize();
+			const float* pStartLifeTime = particles.startLifeTime();
+			const float* pRemainingLifeTime = particles.remainingLifeTime();
+			const float* pR = particles.colorR();
+			const float* pG = particles.colorG();
+			const float* pB = particles.colorB();
+			const float* pA = particles.colorA();
+			const bool hasSizeFunc = static_cast<bool>(sizeOverLifeTimeFunc);
+			const bool hasColorFunc = static_cast<bool>(colorOverLifeTimeFunc);
+
+			for (size_t i = begin; i < end; ++i)
+			{
+				const float startLifeTime = pStartLifeTime[i];
+				const float remainingLifeTime = pRemainingLifeTime[i];
+				const Float4 startColor{ pR[i], pG[i], pB[i], pA[i] };
+
+				const float size = (hasSizeFunc ? sizeOverLifeTimeFunc(pStartSize[i], startLifeTime, remainingLifeTime)
+					: (pStartSize[i] * (remainingLifeTime / startLifeTime)));
+				const Float4 color = (hasColorFunc ? colorOverLifeTimeFunc(startColor, startLifeTime, remainingLifeTime) : startColor);
+
+				const float cx = pX[i];
+				const float cy = pY[i];
+				const float x = (size * 0.5f);
+				const auto [s, c] = FastMath::SinCos(pRotation[i]);
+				const float xc = x * c;
+				const float xs = x * s;
+
+				pVertex[0].set({ -xc + xs + cx, -xs - xc + cy }, 0.0f, 0.0f, color);
+				pVertex[1].set({ xc + xs + cx, xs - xc + cy }, 1.0f, 0.0f, color);
+				pVertex[2].set({ -xc - xs + cx, -xs + xc + cy }, 0.0f, 1.0f, color);
+				pVertex[3].set({ xc - xs + cx, xs + xc + cy }, 1.0f, 1.0f, color);
+				pVertex += 4;
+			}
+		}
 	}
 }
@@ -17,19 +17,36 @@
 # include <Siv3D/TriangleIndex.hpp>
 # include <Siv3D/ColorHSV.hpp>
 # include <Siv3D/Optional.hpp>
+# include <Siv3D/2DShapes.hpp>
+# include <Siv3D/Shape2D.hpp>
 # include <Siv3D/LineStyle.hpp>
 # include <Siv3D/YesNo.hpp>
 # include <Siv3D/PredefinedYesNo.hpp>
-# include <Siv3D/Particle2D.hpp>
 # include <Siv3D/ParticleSystem2DParameters.hpp>
+# include <Siv3D/ParticleSystem2D/ParticleStore2D.hpp>
 # include "Vertex2DBufferPointer.hpp"
 
 namespace s3d
 {
 	using BufferCreatorFunc = std::function<Vertex2DBufferPointer(Vertex2D::IndexType, Vertex2D::IndexType)>;
 
+	/// @brief 多数の図形をまとめて作成するときの、図形の頂点とインデックスの書き込み位置
+	struct Vertex2DBatchOffset
+	{
+		uint32 vertex;
+
+		uint32 index;
+	};
+
+	/// @brief 多数の図形を、1 回のバッファ確保に収まる数ずつ作成する関数
+	/// @remark 作成した図形の数だけ offset を進め、作成したインデックスの数を返します。作成する図形が残っていない場合は 0 を返します。
+	using Batch2DBuildFunc = std::function<Vertex2D::IndexType(const BufferCreatorFunc& bufferCreator, Array<Vertex2DBatchOffset>& offsetBuffer, float scale, size_t& offset)>;
+
 	namespace Vertex2DBuilder
 	{
+		/// @brief 1 回のバッファの確保で作成できるパーティクルの最大数（インデックスが 16-bit に収まる数）
+		inline constexpr size_t MaxParticlesPerBatch = ((65535 / 3 * 3) / 6);
+
 		[[nodiscard]]
 		Vertex2D::IndexType BuildLine(const LineStyle& style, const BufferCreatorFunc& bufferCreator, const Float2& begin, const Float2& end, float thickness, const Float4(&colors)[2], float scale);
 
@@ -132,6 +149,25 @@ namespace s3d
 		[[nodiscard]]
 		Vertex2D::IndexType BuildPolygonFrame(const BufferCreatorFunc& bufferCreator, Array<Float2>& buffer, const Float2* points, size_t size, float thickness, const Float4& color, float scale);
 
+		//
+		//	多数の図形の頂点を、まとめて確保したバッファに作成します。
+		//	offset 番目の図形から 1 回のバッファの確保に収まるだけ作成し、作成した図形の数だけ offset を進めます。
+		//	colors の要素数 num_colors が 1 の場合はすべての図形に同じ色を、それ以外の場合は図形ごとの色を使います。
+		//	作成する図形が無い場合や、バッファを確保できなかった場合は 0 を返します。
+		//
+
+		[[nodiscard]]
+		Vertex2D::IndexType BuildRects(const BufferCreatorFunc& bufferCreator, const RectF* rects, size_t size, const ColorF* colors, size_t num_colors, size_t& offset);
+
+		[[nodiscard]]
+		Vertex2D::IndexType BuildCircles(const BufferCreatorFunc& bufferCreator, Array<Vertex2DBatchOffset>& buffer, const Circle* circles, size_t size, const ColorF* colors, size_t num_colors, float scale, size_t& offset);
+
+		[[nodiscard]]
+		Vertex2D::IndexType BuildLines(const BufferCreatorFunc& bufferCreator, const Line* lines, size_t size, float thickness, const ColorF* colors, size_t num_colors, size_t& offset);
+
+		[[nodiscard]]
+		Vertex2D::IndexType BuildShapes(const BufferCreatorFunc& bufferCreator, Array<Vertex2DBatchOffset>& buffer, const Shape2D* shapes, size_t size, const ColorF* colors, size_t num_colors, size_t& offset);
+
 		[[nodiscard]]
 		Vertex2D::IndexType BuildTextureRegion(const BufferCreatorFunc& bufferCreator, const FloatRect& rect, const FloatRect& uv, const Float4& color);
 
@@ -151,7 +187,12 @@ namespace s3d
 		Vertex2D::IndexType BuildTexturedVertices(const BufferCreatorFunc& bufferCreator, const Vertex2D* vertices, size_t vertexCount, const TriangleIndex* indices, size_t num_triangles);
 
 		[[nodiscard]]
-		Vertex2D::IndexType BuildTexturedParticles(const BufferCreatorFunc& bufferCreator, const Array<Particle2D>& particles,
+		Vertex2D::IndexType BuildParticles(const BufferCreatorFunc& bufferCreator, const ParticleStore2D& particles,
+			const ParticleSystem2DParameters::SizeOverLifeTimeFunc& sizeOverLifeTimeFunc, const ParticleSystem2DParameters::ColorOverLifeTimeFunc& colorOverLifeTimeFunc, size_t& offset);
+
+		/// @brief パーティクル [begin, end) の四角形の頂点を、1 つあたり 4 個ずつ書き込みます。
+		/// @remark インデックスは RectIndexTable と同じ並び (0, 1, 2, 2, 1, 3) を想定します。
+		void WriteParticleVertices(Vertex2D* pVertex, const ParticleStore2D& particles, size_t begin, size_t end,
 			const ParticleSystem2DParameters::SizeOverLifeTimeFunc& sizeOverLifeTimeFunc, const ParticleSystem2DParameters::ColorOverLifeTimeFunc& colorOverLifeTimeFunc);
 	}
 }
@@ -10,6 +10,7 @@
 //-----------------------------------------------
 
 # pragma once
+# include <span>
 # include <Siv3D/Common.hpp>
 # include <Siv3D/2DShapes.hpp>
 # include <Siv3D/ShaderStage.hpp>
@@ -45,6 +46,8 @@ namespace s3d
 
 		virtual void init() = 0;
 
+		virtual void update() = 0;
+
 		virtual const Renderer3DStat& getStat() const = 0;
 
 		virtual void addMesh(uint32 startIndex, uint32 indexCount, const Mesh& mesh, const PhongMaterial& material) = 0;
@@ -53,6 +56,11 @@ namespace s3d
 
 		virtual void addTexturedMesh(uint32 startIndex, uint32 indexCount, const Mesh& mesh, const TextureRegion& textureRegion, const PhongMaterial& material) = 0;
 
+		/// @remark colors が空でない場合、i 番目のインスタンスの拡散反射色は colors[i] になります。
+		virtual void addMeshInstanced(uint32 startIndex, uint32 indexCount, const Mesh& mesh, const PhongMaterial& material, std::span<const Mat4x4> transforms, std::span<const ColorF> colors) = 0;
+
+		virtual void addTexturedMeshInstanced(uint32 startIndex, uint32 indexCount, const Mesh& mesh, const Texture& texture, const PhongMaterial& material, std::span<const Mat4x4> transforms, std::span<const ColorF> colors) = 0;
+
 		virtual void addLine3D(const Float3& begin, const Float3& end, const Float4(&colors)[2]) = 0;
 
 
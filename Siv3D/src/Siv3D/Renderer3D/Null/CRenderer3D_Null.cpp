@@ -27,6 +27,8 @@ namespace s3d
 		LOG_SCOPED_TRACE(U"CRenderer3D_Null::init()");
 	}
 
+	void CRenderer3D_Null::update() {}
+
 	const Renderer3DStat& CRenderer3D_Null::getStat() const
 	{
 		return m_stat;
@@ -38,6 +40,10 @@ namespace s3d
 
 	void CRenderer3D_Null::addTexturedMesh(uint32, uint32, const Mesh&, const TextureRegion&, const PhongMaterial&) {}
 
+	void CRenderer3D_Null::addMeshInstanced(uint32, uint32, const Mesh&, const PhongMaterial&, std::span<const Mat4x4>, std::span<const ColorF>) {}
+
+	void CRenderer3D_Null::addTexturedMeshInstanced(uint32, uint32, const Mesh&, const Texture&, const PhongMaterial&, std::span<const Mat4x4>, std::span<const ColorF>) {}
+
 	void CRenderer3D_Null::addLine3D(const Float3&, const Float3&, const Float4(&)[2]) {}
 
 	BlendState CRenderer3D_Null::getBlendState() const
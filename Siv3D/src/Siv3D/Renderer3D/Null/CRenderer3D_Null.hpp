@@ -24,6 +24,8 @@ namespace s3d
 
 		void init() override;
 
+		void update() override;
+
 		const Renderer3DStat& getStat() const override;
 
 		void addMesh(uint32 startIndex, uint32 indexCount, const Mesh& mesh, const PhongMaterial& material) override;
@@ -32,6 +34,10 @@ namespace s3d
 
 		void addTexturedMesh(uint32 startIndex, uint32 indexCount, const Mesh& mesh, const TextureRegion& textureRegion, const PhongMaterial& material) override;
 
+		void addMeshInstanced(uint32 startIndex, uint32 indexCount, const Mesh& mesh, const PhongMaterial& material, std::span<const Mat4x4> transforms, std::span<const ColorF> colors) override;
+
+		void addTexturedMeshInstanced(uint32 startIndex, uint32 indexCount, const Mesh& mesh, const Texture& texture, const PhongMaterial& material, std::span<const Mat4x4> transforms, std::span<const ColorF> colors) override;
+
 		void addLine3D(const Float3& begin, const Float3& end, const Float4(&colors)[2]) override;
 
 
@@ -33,6 +33,14 @@ namespace s3d
 		Float4 uvTransform = Float4{ 1.0f, 1.0f, 0.0f, 0.0f };
 	};
 
+	struct VSPerInstanceData3D // (VS slot-2, インスタンス描画で VSPerObjectConstants3D の代わりに使う)
+	{
+		Mat4x4 localToWorld = Mat4x4::Identity();
+
+		Float4 diffuseColor = Float4{ 1.0f, 1.0f, 1.0f, 1.0f };
+	};
+	static_assert(sizeof(VSPerInstanceData3D) == 80);
+
 	struct PSPerFrameConstants3D // (PS slot-0)
 	{
 		Float4 gloablAmbientColor = Float4{ Graphics3D::DefaultGlobalAmbientColor.rgb(), 0.0f };
@@ -24,6 +24,30 @@ namespace s3d
 	CScreenCapture::~CScreenCapture()
 	{
 		LOG_SCOPED_TRACE(U"CScreenCapture::~CScreenCapture()");
+
+		// 読み出しが完了していないフレームと、その後ろで順番を待っているフレームは保存しない
+		m_readbackRequests.push_back(std::move(m_asyncRequest));
+
+		for (auto& readbackRequest : m_readbackRequests)
+		{
+			for (auto& request : readbackRequest.saveRequests)
+			{
+				request.result.set_value(false);
+			}
+		}
+
+		// エンコード待ちのタスクをすべて保存してから終了する
+		if (m_encoderThread.joinable())
+		{
+			{
+				std::lock_guard lock{ m_encodeMutex };
+				m_abortEncoder = true;
+			}
+
+			m_encodeCondition.notify_all();
+
+			m_encoderThread.join();
+		}
 	}
 
 	void CScreenCapture::init()
@@ -79,20 +103,27 @@ namespace s3d
 			}
 			else
 			{
+				Array<SaveRequest> requests;
+
 				for (const auto& requestedPath : m_requestedPaths)
 				{
 					if (requestedPath)
 					{
-						const FilePath path = (m_screenshotDirectory + requestedPath);
-						image.save(path);
-						LOG_INFO(U"📷 Screen capture saved (path: \"{0}\")"_fmt(path));
+						requests.push_back(SaveRequest{ (m_screenshotDirectory + requestedPath), {} });
 					}
 				}
+
+				if (requests)
+				{
+					pushEncodeTask(Image{ image }, std::move(requests));
+				}
 			}
 
 			m_requestedPaths.clear();
 			m_hasNewFrame = true;
 		}
+
+		updateAsyncCapture();
 	}
 
 	const FilePath& CScreenCapture::getScreenshotDirectory() const
@@ -110,6 +141,22 @@ namespace s3d
 		m_requestedPaths.push_back(std::move(path));
 	}
 
+	AsyncTask<bool> CScreenCapture::requestScreenCaptureAsync(FilePath&& path)
+	{
+		SaveRequest request{ (m_screenshotDirectory + path), {} };
+
+		AsyncTask<bool> task{ request.result.get_future() };
+
+		m_asyncRequest.saveRequests.push_back(std::move(request));
+
+		return task;
+	}
+
+	void CScreenCapture::requestFrameAsync(std::function<void(Image&)> receiver)
+	{
+		m_asyncRequest.receivers.push_back(std::move(receiver));
+	}
+
 	bool CScreenCapture::hasNewFrame() const
 	{
 		return m_hasNewFrame;
@@ -124,4 +171,168 @@ namespace s3d
 	{
 		m_screenshotShortcutKeys = screenshotShortcutKeys;
 	}
+
+	void CScreenCapture::updateAsyncCapture()
+	{
+		retrieveAsyncCaptures();
+
+		if (m_asyncRequest.isEmpty())
+		{
+			return;
+		}
+
+		if (SIV3D_ENGINE(Renderer)->captureScreenshotAsync())
+		{
+			m_readbackRequests.push_back(std::exchange(m_asyncRequest, {}));
+		}
+		else
+		{
+			// 非同期の読み出しに対応していないか、読み出し中のフレームが多すぎる場合は、その場で読み出す
+			if (not m_hasNewFrame)
+			{
+				SIV3D_ENGINE(Renderer)->captureScreenshot();
+			}
+
+			// その場での読み出しは GPU の処理の完了を待つため、読み出し中のフレームの多くはここで受け取れる
+			retrieveAsyncCaptures();
+
+			if (m_readbackRequests.empty())
+			{
+				m_readbackImage = SIV3D_ENGINE(Renderer)->getScreenCapture();
+
+				dispatchFrame(std::exchange(m_asyncRequest, {}));
+			}
+			else
+			{
+				// 先に読み出しを開始したフレームを追い越さないよう、読み出した画像を持たせて順番を待つ
+				m_asyncRequest.capturedImage = SIV3D_ENGINE(Renderer)->getScreenCapture();
+
+				m_readbackRequests.push_back(std::exchange(m_asyncRequest, {}));
+			}
+		}
+	}
+
+	void CScreenCapture::retrieveAsyncCaptures()
+	{
+		// 読み出しが完了したフレームを、古い順に処理する
+		while (not m_readbackRequests.empty())
+		{
+			ReadbackRequest& front = m_readbackRequests.front();
+
+			if (front.capturedImage)
+			{
+				m_readbackImage = std::move(*front.capturedImage);
+			}
+			else if (not SIV3D_ENGINE(Renderer)->retrieveScreenshotAsync(m_readbackImage))
+			{
+				break;
+			}
+
+			ReadbackRequest request = std::move(front);
+
+			m_readbackRequests.pop_front();
+
+			dispatchFrame(std::move(request));
+		}
+	}
+
+	void CScreenCapture::dispatchFrame(ReadbackRequest&& request)
+	{
+		if (request.saveRequests)
+		{
+			// 受け取り側が画像の中身を入れ替える場合があるため、その前にコピーする
+			Image image = (request.receivers ? Image{ m_readbackImage } : std::move(m_readbackImage));
+
+			pushEncodeTask(std::move(image), std::move(request.saveRequests));
+		}
+
+		for (size_t i = 0; i < request.receivers.size(); ++i)
+		{
+			if ((i + 1) < request.receivers.size())
+			{
+				Image image{ m_readbackImage };
+				request.receivers[i](image);
+			}
+			else
+			{
+				request.receivers[i](m_readbackImage);
+			}
+		}
+	}
+
+	void CScreenCapture::pushEncodeTask(Image&& image, Array<SaveRequest>&& requests)
+	{
+		EncodeTask task{ std::move(image), std::move(requests) };
+
+	# if SIV3D_PLATFORM(WEB)
+
+		Encode(task);
+
+	# else
+
+		if (not m_encoderThread.joinable())
+		{
+			m_encoderThread = std::thread{ EncoderThread, std::ref(*this) };
+		}
+
+		{
+			std::unique_lock lock{ m_encodeMutex };
+
+			// エンコード待ちの画像が多い場合は、メモリの使用量を抑えるため、減るまで待つ
+			m_encodeCondition.wait(lock, [this]() { return (m_encodeTasks.size() < MaxPendingEncodeTasks); });
+
+			m_encodeTasks.push_back(std::move(task));
+		}
+
+		m_encodeCondition.notify_all();
+
+	# endif
+	}
+
+	void CScreenCapture::EncoderThread(CScreenCapture& screenCapture)
+	{
+		for (;;)
+		{
+			EncodeTask task;
+
+			{
+				std::unique_lock lock{ screenCapture.m_encodeMutex };
+
+				screenCapture.m_encodeCondition.wait(lock,
+					[&]() { return (screenCapture.m_abortEncoder || (not screenCapture.m_encodeTasks.empty())); });
+
+				if (screenCapture.m_encodeTasks.empty())
+				{
+					return;
+				}
+
+				task = std::move(screenCapture.m_encodeTasks.front());
+
+				screenCapture.m_encodeTasks.pop_front();
+			}
+
+			screenCapture.m_encodeCondition.notify_all();
+
+			Encode(task);
+		}
+	}
+
+	void CScreenCapture::Encode(EncodeTask& task)
+	{
+		for (auto& request : task.requests)
+		{
+			const bool result = (task.image && task.image.save(request.path));
+
+			if (result)
+			{
+				LOG_INFO(U"📷 Screen capture saved (path: \"{0}\")"_fmt(request.path));
+			}
+			else
+			{
+				LOG_FAIL(U"✖ failed to save a screen capture (path: \"{0}\")"_fmt(request.path));
+			}
+
+			request.result.set_value(result);
+		}
+	}
 }
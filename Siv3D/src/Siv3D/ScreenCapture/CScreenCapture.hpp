@@ -10,8 +10,14 @@
 //-----------------------------------------------
 
 # pragma once
+# include <deque>
+# include <future>
+# include <mutex>
+# include <condition_variable>
+# include <thread>
 # include <Siv3D/Common.hpp>
 # include <Siv3D/Optional.hpp>
+# include <Siv3D/Image.hpp>
 # include <Siv3D/ScreenCapture.hpp>
 # include <Siv3D/Keyboard.hpp>
 # include "IScreenCapture.hpp"
@@ -36,6 +42,10 @@ namespace s3d
 
 		void requestScreenCapture(FilePath&& path) override;
 
+		AsyncTask<bool> requestScreenCaptureAsync(FilePath&& path) override;
+
+		void requestFrameAsync(std::function<void(Image&)> receiver) override;
+
 		bool hasNewFrame() const override;
 
 		const Image& receiveScreenCapture() const override;
@@ -44,12 +54,80 @@ namespace s3d
 
 	private:
 
+		/// @brief 保存先のパスと、保存の結果の通知先
+		struct SaveRequest
+		{
+			FilePath path;
+
+			std::promise<bool> result;
+		};
+
+		/// @brief 1 つのフレームの非同期の読み出しを待っている要求
+		struct ReadbackRequest
+		{
+			Array<SaveRequest> saveRequests;
+
+			Array<std::function<void(Image&)>> receivers;
+
+			/// @brief 非同期で読み出せず、その場で読み出した画像
+			Optional<Image> capturedImage;
+
+			[[nodiscard]]
+			bool isEmpty() const noexcept
+			{
+				return (saveRequests.isEmpty() && receivers.isEmpty());
+			}
+		};
+
+		/// @brief ワーカースレッドでエンコードする画像と、その保存先
+		struct EncodeTask
+		{
+			Image image;
+
+			Array<SaveRequest> requests;
+		};
+
+		/// @brief エンコード待ちのタスクの最大数
+		/// @remark これを超えると、メインスレッドはタスクが減るまで待機します。
+		static constexpr size_t MaxPendingEncodeTasks = 4;
+
 		FilePath m_screenshotDirectory;
 
 		Array<FilePath> m_requestedPaths;
 
+		// 現在のフレームに対する非同期の読み出しの要求
+		ReadbackRequest m_asyncRequest;
+
+		// 読み出し中のフレームに対する要求（読み出しを開始した順）
+		std::deque<ReadbackRequest> m_readbackRequests;
+
+		// 非同期で読み出したフレームの格納先。受け取り側と中身を入れ替えて再利用する
+		Image m_readbackImage;
+
+		std::thread m_encoderThread;
+
+		std::mutex m_encodeMutex;
+
+		std::condition_variable m_encodeCondition;
+
+		std::deque<EncodeTask> m_encodeTasks;
+
+		bool m_abortEncoder = false;
+
 		Array<InputGroup> m_screenshotShortcutKeys = { KeyPrintScreen, KeyF12 };
 
 		bool m_hasNewFrame = false;
+
+		void updateAsyncCapture();
+
+		void retrieveAsyncCaptures();
+
+		void dispatchFrame(ReadbackRequest&& request);
+
+		void pushEncodeTask(Image&& image, Array<SaveRequest>&& requests);
+
+		static void EncoderThread(CScreenCapture& screenCapture);
+
+		static void Encode(EncodeTask& task);
 	};
 }
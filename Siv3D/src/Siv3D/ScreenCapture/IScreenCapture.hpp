@@ -10,9 +10,11 @@
 //-----------------------------------------------
 
 # pragma once
+# include <functional>
 # include <Siv3D/Common.hpp>
 # include <Siv3D/Array.hpp>
 # include <Siv3D/InputGroups.hpp>
+# include <Siv3D/AsyncTask.hpp>
 
 namespace s3d
 {
@@ -34,6 +36,13 @@ namespace s3d
 
 		virtual void requestScreenCapture(FilePath&& path) = 0;
 
+		virtual AsyncTask<bool> requestScreenCaptureAsync(FilePath&& path) = 0;
+
+		/// @brief 現在のフレームを非同期で読み出し、読み出しが完了したら receiver に渡します。
+		/// @param receiver 読み出したフレームを受け取る関数
+		/// @remark receiver はメインスレッドの `System::Update()` の中で呼ばれます。渡された画像は、別の画像と中身を入れ替えて受け取ってもかまいません。
+		virtual void requestFrameAsync(std::function<void(Image&)> receiver) = 0;
+
 		virtual bool hasNewFrame() const = 0;
 
 		virtual const Image& receiveScreenCapture() const = 0;
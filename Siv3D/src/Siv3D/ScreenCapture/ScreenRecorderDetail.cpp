@@ -0,0 +1,259 @@
+﻿//-----------------------------------------------
+//
+//	This file is part of the Siv3D Engine.
+//
+//	Copyright (c) 2008-2022 Ryo Suzuki
+//	Copyright (c) 2016-2022 OpenSiv3D Project
+//
+//	Licensed under the MIT License.
+//
+//-----------------------------------------------
+
+# include "ScreenRecorderDetail.hpp"
+# include <Siv3D/OpenCV_Bridge.hpp>
+# include <Siv3D/EngineLog.hpp>
+# include <Siv3D/ScreenCapture/IScreenCapture.hpp>
+# include <Siv3D/Common/Siv3DEngine.hpp>
+
+namespace s3d
+{
+	ScreenRecorder::ScreenRecorderDetail::ScreenRecorderDetail() {}
+
+	ScreenRecorder::ScreenRecorderDetail::~ScreenRecorderDetail()
+	{
+		close();
+	}
+
+	bool ScreenRecorder::ScreenRecorderDetail::open(const FilePathView path, const Size& size, const double fps)
+	{
+		LOG_SCOPED_TRACE(U"ScreenRecorderDetail::open()");
+
+		close();
+
+		if (not m_writer.open(path, size, fps))
+		{
+			return false;
+		}
+
+		++m_session;
+		m_writtenFrames = 0;
+		m_droppedFrames = 0;
+		m_missingFrames = 0;
+		m_abort = false;
+
+	# if not SIV3D_PLATFORM(WEB)
+
+		m_thread = std::thread{ Run, std::ref(*this) };
+
+	# endif
+
+		return true;
+	}
+
+	void ScreenRecorder::ScreenRecorderDetail::close()
+	{
+		if (not m_writer)
+		{
+			return;
+		}
+
+		LOG_SCOPED_TRACE(U"ScreenRecorderDetail::close()");
+
+		// 書き出し待ちのフレームをすべて書き出してから終了する
+		if (m_thread.joinable())
+		{
+			{
+				std::lock_guard lock{ m_mutex };
+				m_abort = true;
+			}
+
+			m_condition.notify_all();
+
+			m_thread.join();
+		}
+
+		// 読み出し中のフレームは、次の録画に含めない
+		++m_session;
+
+		LOG_INFO(U"ℹ️ ScreenRecorder: {0} frames written, {1} frames dropped"_fmt(m_writtenFrames, m_droppedFrames));
+
+		m_writer.close();
+	}
+
+	bool ScreenRecorder::ScreenRecorderDetail::isOpen() const noexcept
+	{
+		return m_writer.isOpen();
+	}
+
+	void ScreenRecorder::ScreenRecorderDetail::captureFrame()
+	{
+		if (not m_writer)
+		{
+			return;
+		}
+
+		SIV3D_ENGINE(ScreenCapture)->requestFrameAsync(
+			[recorder = weak_from_this(), session = m_session](Image& image)
+			{
+				if (const auto pRecorder = recorder.lock())
+				{
+					pRecorder->receiveFrame(image, session);
+				}
+			});
+	}
+
+	size_t ScreenRecorder::ScreenRecorderDetail::num_writtenFrames() const
+	{
+		std::lock_guard lock{ m_mutex };
+
+		return m_writtenFrames;
+	}
+
+	size_t ScreenRecorder::ScreenRecorderDetail::num_droppedFrames() const
+	{
+		std::lock_guard lock{ m_mutex };
+
+		return m_droppedFrames;
+	}
+
+	Size ScreenRecorder::ScreenRecorderDetail::getSize() const noexcept
+	{
+		return m_writer.getSize();
+	}
+
+	double ScreenRecorder::ScreenRecorderDetail::getFPS() const noexcept
+	{
+		return m_writer.getFPS();
+	}
+
+	const FilePath& ScreenRecorder::ScreenRecorderDetail::path() const noexcept
+	{
+		return m_writer.path();
+	}
+
+	void ScreenRecorder::ScreenRecorderDetail::receiveFrame(Image& image, const uint64 session)
+	{
+		if ((session != m_session) || (not m_writer))
+		{
+			return;
+		}
+
+		// 破棄したフレームの代わりに前後のフレームを繰り返し書き出して、動画の長さを保つ
+
+	# if SIV3D_PLATFORM(WEB)
+
+		if (image)
+		{
+			const size_t count = (1 + std::exchange(m_missingFrames, 0));
+
+			for (size_t i = 0; i < count; ++i)
+			{
+				writeFrame(image);
+			}
+
+			m_writtenFrames += count;
+		}
+		else
+		{
+			++m_droppedFrames;
+			++m_missingFrames;
+		}
+
+	# else
+
+		{
+			std::lock_guard lock{ m_mutex };
+
+			if ((not image) || (MaxPendingFrames <= m_frames.size()))
+			{
+				++m_droppedFrames;
+
+				if (m_frames.empty())
+				{
+					++m_missingFrames;
+				}
+				else
+				{
+					++m_frames.back().count;
+				}
+
+				return;
+			}
+
+			// 書き出しの終わった画像と中身を入れ替えて、メモリの確保とコピーを避ける
+			Image frame;
+
+			if (m_freeImages)
+			{
+				frame = std::move(m_freeImages.back());
+				m_freeImages.pop_back();
+			}
+
+			std::swap(frame, image);
+
+			m_frames.push_back(PendingFrame{ std::move(frame), (1 + std::exchange(m_missingFrames, 0)) });
+		}
+
+		m_condition.notify_one();
+
+	# endif
+	}
+
+	void ScreenRecorder::ScreenRecorderDetail::writeFrame(Image& image)
+	{
+		const Size size = m_writer.getSize();
+
+		if (image.size() == size)
+		{
+			m_writer.writeFrame(image);
+			return;
+		}
+
+		if (m_resizedImage.size() != size)
+		{
+			m_resizedImage.resize(size);
+		}
+
+		cv::Mat resized = OpenCV_Bridge::GetMatView(m_resizedImage);
+		cv::resize(OpenCV_Bridge::GetMatView(image), resized, resized.size(), 0.0, 0.0, cv::INTER_AREA);
+
+		m_writer.writeFrame(m_resizedImage);
+	}
+
+	void ScreenRecorder::ScreenRecorderDetail::Run(ScreenRecorderDetail& recorder)
+	{
+		for (;;)
+		{
+			PendingFrame frame;
+
+			{
+				std::unique_lock lock{ recorder.m_mutex };
+
+				recorder.m_condition.wait(lock,
+					[&]() { return (recorder.m_abort || (not recorder.m_frames.empty())); });
+
+				if (recorder.m_frames.empty())
+				{
+					return;
+				}
+
+				frame = std::move(recorder.m_frames.front());
+
+				recorder.m_frames.pop_front();
+			}
+
+			for (size_t i = 0; i < frame.count; ++i)
+			{
+				recorder.writeFrame(frame.image);
+			}
+
+			{
+				std::lock_guard lock{ recorder.m_mutex };
+
+				recorder.m_freeImages.push_back(std::move(frame.image));
+
+				recorder.m_writtenFrames += frame.count;
+			}
+		}
+	}
+}
@@ -0,0 +1,106 @@
+﻿//-----------------------------------------------
+//
+//	This file is part of the Siv3D Engine.
+//
+//	Copyright (c) 2008-2022 Ryo Suzuki
+//	Copyright (c) 2016-2022 OpenSiv3D Project
+//
+//	Licensed under the MIT License.
+//
+//-----------------------------------------------
+
+# pragma once
+# include <deque>
+# include <mutex>
+# include <condition_variable>
+# include <thread>
+# include <Siv3D/ScreenRecorder.hpp>
+# include <Siv3D/VideoWriter.hpp>
+# include <Siv3D/Image.hpp>
+# include <Siv3D/Array.hpp>
+
+namespace s3d
+{
+	class ScreenRecorder::ScreenRecorderDetail : public std::enable_shared_from_this<ScreenRecorderDetail>
+	{
+	public:
+
+		/// @brief 書き出し待ちのフレームの最大数
+		/// @remark これを超えて読み出されたフレームは破棄され、代わりに直前のフレームを繰り返し書き出します。
+		static constexpr size_t MaxPendingFrames = 3;
+
+		ScreenRecorderDetail();
+
+		~ScreenRecorderDetail();
+
+		bool open(FilePathView path, const Size& size, double fps);
+
+		void close();
+
+		[[nodiscard]]
+		bool isOpen() const noexcept;
+
+		void captureFrame();
+
+		[[nodiscard]]
+		size_t num_writtenFrames() const;
+
+		[[nodiscard]]
+		size_t num_droppedFrames() const;
+
+		[[nodiscard]]
+		Size getSize() const noexcept;
+
+		[[nodiscard]]
+		double getFPS() const noexcept;
+
+		[[nodiscard]]
+		const FilePath& path() const noexcept;
+
+	private:
+
+		/// @brief 書き出し待ちのフレーム
+		struct PendingFrame
+		{
+			Image image;
+
+			// 書き出す回数。破棄したフレームの分だけ増える
+			size_t count = 1;
+		};
+
+		VideoWriter m_writer;
+
+		std::thread m_thread;
+
+		mutable std::mutex m_mutex;
+
+		std::condition_variable m_condition;
+
+		// 書き出し待ちのフレーム
+		std::deque<PendingFrame> m_frames;
+
+		// 書き出しが終わり、再利用できる画像
+		Array<Image> m_freeImages;
+
+		// 解像度を変換したフレームの格納先（書き出しのスレッドのみが使う）
+		Image m_resizedImage;
+
+		// open() のたびに増え、以前の録画で要求したフレームを区別する
+		uint64 m_session = 0;
+
+		size_t m_writtenFrames = 0;
+
+		size_t m_droppedFrames = 0;
+
+		// 直前のフレームが無いために、次のフレームを繰り返して埋める数
+		size_t m_missingFrames = 0;
+
+		bool m_abort = false;
+
+		void receiveFrame(Image& image, uint64 session);
+
+		void writeFrame(Image& image);
+
+		static void Run(ScreenRecorderDetail& recorder);
+	};
+}
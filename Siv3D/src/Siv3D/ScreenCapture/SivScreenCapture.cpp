@@ -34,6 +34,11 @@ namespace s3d
 			SIV3D_ENGINE(ScreenCapture)->requestScreenCapture(std::move(path));
 		}
 
+		AsyncTask<bool> SaveCurrentFrameAsync(FilePath&& path)
+		{
+			return SIV3D_ENGINE(ScreenCapture)->requestScreenCaptureAsync(std::move(path));
+		}
+
 		void RequestCurrentFrame()
 		{
 			SIV3D_ENGINE(ScreenCapture)->requestScreenCapture(FilePath());
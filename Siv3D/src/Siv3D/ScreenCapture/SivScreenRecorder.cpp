@@ -0,0 +1,87 @@
+﻿//-----------------------------------------------
+//
+//	This file is part of the Siv3D Engine.
+//
+//	Copyright (c) 2008-2022 Ryo Suzuki
+//	Copyright (c) 2016-2022 OpenSiv3D Project
+//
+//	Licensed under the MIT License.
+//
+//-----------------------------------------------
+
+# include <Siv3D/ScreenRecorder.hpp>
+# include <Siv3D/Scene.hpp>
+# include <Siv3D/ScreenCapture/ScreenRecorderDetail.hpp>
+
+namespace s3d
+{
+	ScreenRecorder::ScreenRecorder()
+		: pImpl{ std::make_shared<ScreenRecorderDetail>() } {}
+
+	ScreenRecorder::ScreenRecorder(const FilePathView path, const double fps)
+		: ScreenRecorder{}
+	{
+		open(path, fps);
+	}
+
+	ScreenRecorder::ScreenRecorder(const FilePathView path, const Size& size, const double fps)
+		: ScreenRecorder{}
+	{
+		open(path, size, fps);
+	}
+
+	bool ScreenRecorder::open(const FilePathView path, const double fps)
+	{
+		return pImpl->open(path, Scene::Size(), fps);
+	}
+
+	bool ScreenRecorder::open(const FilePathView path, const Size& size, const double fps)
+	{
+		return pImpl->open(path, size, fps);
+	}
+
+	void ScreenRecorder::close()
+	{
+		pImpl->close();
+	}
+
+	bool ScreenRecorder::isOpen() const noexcept
+	{
+		return pImpl->isOpen();
+	}
+
+	ScreenRecorder::operator bool() const noexcept
+	{
+		return isOpen();
+	}
+
+	void ScreenRecorder::captureFrame()
+	{
+		pImpl->captureFrame();
+	}
+
+	size_t ScreenRecorder::num_writtenFrames() const
+	{
+		return pImpl->num_writtenFrames();
+	}
+
+	size_t ScreenRecorder::num_droppedFrames() const
+	{
+		return pImpl->num_droppedFrames();
+	}
+
+	Size ScreenRecorder::getSize() const noexcept
+	{
+		return pImpl->getSize();
+	}
+
+	double ScreenRecorder::getFPS() const noexcept
+	{
+		return pImpl->getFPS();
+	}
+
+	const FilePath& ScreenRecorder::path() const noexcept
+	{
+		return pImpl->path();
+	}
+}
@@ -577,6 +577,29 @@ namespace s3d
 		return *this;
 	}
 
+	namespace detail
+	{
+		static void DrawShapeBatch(const Shape2D* shapes, const size_t size, const ColorF* colors, const size_t num_colors)
+		{
+			SIV3D_ENGINE(Renderer2D)->addBatch([=](const BufferCreatorFunc& bufferCreator, Array<Vertex2DBatchOffset>& offsetBuffer, const float, size_t& offset)
+			{
+				return Vertex2DBuilder::BuildShapes(bufferCreator, offsetBuffer, shapes, size, colors, num_colors, offset);
+			});
+		}
+	}
+
+	void Shape2D::DrawBatch(const Array<Shape2D>& shapes, const ColorF& color)
+	{
+		detail::DrawShapeBatch(shapes.data(), shapes.size(), &color, 1);
+	}
+
+	void Shape2D::DrawBatch(const Array<Shape2D>& shapes, const Array<ColorF>& colors)
+	{
+		const size_t size = Min(shapes.size(), colors.size());
+
+		detail::DrawShapeBatch(shapes.data(), size, colors.data(), size);
+	}
+
 	Polygon Shape2D::asPolygon() const
 	{
 		return Polygon{ *this };
@@ -56,7 +56,7 @@ namespace s3d
 	Texture::Texture(const Image& image, const TextureDesc desc)
 		: AssetHandle{ std::make_shared<AssetIDWrapperType>(
 			detail::IsMipped(desc) ?
-				SIV3D_ENGINE(Texture)->createMipped(image, ImageProcessing::GenerateMips(image), desc) :
+				SIV3D_ENGINE(Texture)->createMipped(image, ImageProcessing::GenerateMips(image, Largest<size_t>, IsSRGB{ detail::IsSRGB(desc) }), desc) :
 				SIV3D_ENGINE(Texture)->createUnmipped(image, desc)) }
 	{
 		SIV3D_ENGINE(AssetMonitor)->created();
@@ -0,0 +1,237 @@
+﻿//-----------------------------------------------
+//
+//	This file is part of the Siv3D Engine.
+//
+//	Copyright (c) 2008-2022 Ryo Suzuki
+//	Copyright (c) 2016-2022 OpenSiv3D Project
+//
+//	Licensed under the MIT License.
+//
+//-----------------------------------------------
+
+# include <exception>
+# include <Siv3D/ThreadPool.hpp>
+# include "ThreadPoolDetail.hpp"
+
+namespace s3d
+{
+	namespace detail
+	{
+		struct ParallelForState
+		{
+			std::atomic<size_t> next;
+
+			size_t last;
+
+			size_t grainSize;
+
+			void(*function)(void*, size_t, size_t);
+
+			void* context;
+
+			std::atomic<size_t> remainingChunks;
+
+			std::atomic<bool> failed = { false };
+
+			std::exception_ptr exception;
+
+			std::mutex mutex;
+
+			std::condition_variable condition;
+
+			ParallelForState(const size_t _first, const size_t _last, const size_t _grainSize, const size_t numChunks, void(*_function)(void*, size_t, size_t), void* _context)
+				: next{ _first }
+				, last{ _last }
+				, grainSize{ _grainSize }
+				, function{ _function }
+				, context{ _context }
+				, remainingChunks{ numChunks } {}
+
+			// 未処理の範囲を 1 つ処理する。未処理の範囲が無ければ false を返す
+			bool runChunk()
+			{
+				const size_t begin = next.fetch_add(grainSize);
+
+				// すべての範囲が処理済みの場合、呼び出し元はすでに戻っている可能性があるため context に触れない
+				if (last <= begin)
+				{
+					return false;
+				}
+
+				const size_t end = Min((last - begin), grainSize) + begin;
+
+				if (not failed)
+				{
+					try
+					{
+						function(context, begin, end);
+					}
+					catch (...)
+					{
+						std::lock_guard lock{ mutex };
+
+						if (not exception)
+						{
+							exception = std::current_exception();
+						}
+
+						failed = true;
+					}
+				}
+
+				if (remainingChunks.fetch_sub(1) == 1)
+				{
+					std::lock_guard lock{ mutex };
+					condition.notify_all();
+				}
+
+				return true;
+			}
+		};
+	}
+
+	////////////////////////////////////////////////////////////////
+	//
+	//	WaitGroup
+	//
+	////////////////////////////////////////////////////////////////
+
+	void WaitGroup::add(const size_t n) noexcept
+	{
+		m_count += n;
+	}
+
+	void WaitGroup::done()
+	{
+		if (m_count.fetch_sub(1) == 1)
+		{
+			std::lock_guard lock{ m_mutex };
+			m_condition.notify_all();
+		}
+	}
+
+	bool WaitGroup::isDone() const noexcept
+	{
+		return (m_count == 0);
+	}
+
+	void WaitGroup::wait()
+	{
+		std::unique_lock lock{ m_mutex };
+
+		m_condition.wait(lock, [this]() { return (m_count == 0); });
+	}
+
+	////////////////////////////////////////////////////////////////
+	//
+	//	ThreadPool
+	//
+	////////////////////////////////////////////////////////////////
+
+	ThreadPool::ThreadPool()
+		: ThreadPool{ (Threading::GetConcurrency() - 1) } {}
+
+	ThreadPool::ThreadPool(const size_t numThreads)
+		: pImpl{ std::make_unique<ThreadPoolDetail>(numThreads) } {}
+
+	ThreadPool::~ThreadPool() {}
+
+	size_t ThreadPool::num_threads() const noexcept
+	{
+		return pImpl->num_threads();
+	}
+
+	bool ThreadPool::isWorkerThread() const noexcept
+	{
+		return pImpl->isWorkerThread();
+	}
+
+	void ThreadPool::submit(std::function<void()> task)
+	{
+		pImpl->submit(std::move(task));
+	}
+
+	void ThreadPool::submit(WaitGroup& waitGroup, std::function<void()> task)
+	{
+		waitGroup.add(1);
+
+		pImpl->submit([&waitGroup, task = std::move(task)]()
+		{
+			try
+			{
+				if (task)
+				{
+					task();
+				}
+			}
+			catch (...) {}
+
+			waitGroup.done();
+		});
+	}
+
+	bool ThreadPool::tryRunPendingTask()
+	{
+		return pImpl->tryRunPendingTask();
+	}
+
+	void ThreadPool::wait(WaitGroup& waitGroup)
+	{
+		while (not waitGroup.isDone())
+		{
+			if (pImpl->tryRunPendingTask())
+			{
+				continue;
+			}
+
+			// ワーカースレッドがブロックするとデッドロックの恐れがあるため、ワーカースレッドはタスクを待ち続ける
+			if (not pImpl->isWorkerThread())
+			{
+				waitGroup.wait();
+				return;
+			}
+
+			std::this_thread::yield();
+		}
+	}
+
+	void ThreadPool::parallelForImpl(const size_t first, const size_t last, size_t grainSize, void(*function)(void*, size_t, size_t), void* context)
+	{
+		grainSize = Max<size_t>(1, grainSize);
+
+		const size_t count = (last - first);
+		const size_t numChunks = ((count / grainSize) + ((count % grainSize) ? 1 : 0));
+
+		if (numChunks == 1)
+		{
+			function(context, first, last);
+			return;
+		}
+
+		const auto state = std::make_shared<detail::ParallelForState>(first, last, grainSize, numChunks, function, context);
+
+		// 呼び出し元のスレッドも処理に参加するため、ヘルパーは (範囲の数 - 1) 個まで
+		const size_t numHelpers = Min(pImpl->num_threads(), (numChunks - 1));
+
+		for (size_t i = 0; i < numHelpers; ++i)
+		{
+			pImpl->submit([state]()
+			{
+				while (state->runChunk()) {}
+			});
+		}
+
+		while (state->runChunk()) {}
+
+		{
+			std::unique_lock lock{ state->mutex };
+
+			state->condition.wait(lock, [&state]() { return (state->remainingChunks == 0); });
+		}
+
+		if (state->exception)
+		{
+			std::rethrow_exception(state->exception);
+		}
+	}
+}
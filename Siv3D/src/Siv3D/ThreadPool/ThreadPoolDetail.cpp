@@ -0,0 +1,257 @@
+﻿//-----------------------------------------------
+//
+//	This file is part of the Siv3D Engine.
+//
+//	Copyright (c) 2008-2022 Ryo Suzuki
+//	Copyright (c) 2016-2022 OpenSiv3D Project
+//
+//	Licensed under the MIT License.
+//
+//-----------------------------------------------
+
+# include "ThreadPoolDetail.hpp"
+
+namespace s3d
+{
+	namespace detail
+	{
+		constexpr size_t NotWorker = static_cast<size_t>(-1);
+
+		// try_lock での盗みに失敗したときに、ロックを待つ盗みに切り替えるまでに yield する回数
+		constexpr int32 MaxStealSpins = 16;
+
+		// タスクが見つからないまま未処理のタスク数が 0 にならない場合の、待機の最大時間
+		constexpr std::chrono::milliseconds MaxIdleWait{ 1 };
+
+		// 現在のスレッドが属するスレッドプールとワーカーのインデックス
+		static thread_local const void* t_currentPool = nullptr;
+
+		static thread_local size_t t_workerIndex = NotWorker;
+	}
+
+	ThreadPool::ThreadPoolDetail::ThreadPoolDetail(const size_t numThreads)
+	{
+		const size_t n = Max<size_t>(1, numThreads);
+
+		for (size_t i = 0; i < n; ++i)
+		{
+			m_localQueues.push_back(std::make_unique<WorkQueue>());
+		}
+
+		for (size_t i = 0; i < n; ++i)
+		{
+			m_threads.emplace_back(Run, std::ref(*this), i);
+		}
+	}
+
+	ThreadPool::ThreadPoolDetail::~ThreadPoolDetail()
+	{
+		{
+			std::lock_guard lock{ m_sleepMutex };
+			m_abort = true;
+		}
+
+		m_sleepCondition.notify_all();
+
+		for (auto& thread : m_threads)
+		{
+			if (thread.joinable())
+			{
+				thread.join();
+			}
+		}
+	}
+
+	size_t ThreadPool::ThreadPoolDetail::num_threads() const noexcept
+	{
+		return m_threads.size();
+	}
+
+	bool ThreadPool::ThreadPoolDetail::isWorkerThread() const noexcept
+	{
+		return (detail::t_currentPool == this);
+	}
+
+	void ThreadPool::ThreadPoolDetail::submit(Task&& task)
+	{
+		if (not task)
+		{
+			return;
+		}
+
+		{
+			// ワーカースレッドからの追加は自身のキューへ、それ以外は共有のキューへ
+			WorkQueue& queue = isWorkerThread() ? *m_localQueues[detail::t_workerIndex] : m_globalQueue;
+			std::lock_guard lock{ queue.mutex };
+			queue.tasks.push_back(std::move(task));
+		}
+
+		++m_pendingCount;
+
+		{
+			std::lock_guard lock{ m_sleepMutex };
+		}
+
+		m_sleepCondition.notify_one();
+	}
+
+	bool ThreadPool::ThreadPoolDetail::tryRunPendingTask()
+	{
+		const size_t workerIndex = (isWorkerThread() ? detail::t_workerIndex : detail::NotWorker);
+
+		Task task;
+
+		if (not popTask(workerIndex, task))
+		{
+			return false;
+		}
+
+		RunTask(task);
+
+		return true;
+	}
+
+	bool ThreadPool::ThreadPoolDetail::popTask(const size_t workerIndex, Task& task)
+	{
+		if (m_pendingCount == 0)
+		{
+			return false;
+		}
+
+		if (workerIndex != detail::NotWorker)
+		{
+			WorkQueue& queue = *m_localQueues[workerIndex];
+			std::lock_guard lock{ queue.mutex };
+
+			if (not queue.tasks.empty())
+			{
+				task = std::move(queue.tasks.back());
+				queue.tasks.pop_back();
+				--m_pendingCount;
+				return true;
+			}
+		}
+
+		{
+			std::lock_guard lock{ m_globalQueue.mutex };
+
+			if (not m_globalQueue.tasks.empty())
+			{
+				task = std::move(m_globalQueue.tasks.front());
+				m_globalQueue.tasks.pop_front();
+				--m_pendingCount;
+				return true;
+			}
+		}
+
+		return stealTask(workerIndex, task, false);
+	}
+
+	bool ThreadPool::ThreadPoolDetail::stealTask(const size_t workerIndex, Task& task, const bool blocking)
+	{
+		const size_t numQueues = m_localQueues.size();
+		const size_t start = ((workerIndex == detail::NotWorker) ? 0 : (workerIndex + 1));
+
+		for (size_t i = 0; i < numQueues; ++i)
+		{
+			const size_t victim = ((start + i) % numQueues);
+
+			if (victim == workerIndex)
+			{
+				continue;
+			}
+
+			WorkQueue& queue = *m_localQueues[victim];
+			std::unique_lock lock{ queue.mutex, std::defer_lock };
+
+			if (blocking)
+			{
+				lock.lock();
+			}
+			else if (not lock.try_lock())
+			{
+				continue;
+			}
+
+			if (not queue.tasks.empty())
+			{
+				task = std::move(queue.tasks.front());
+				queue.tasks.pop_front();
+				--m_pendingCount;
+				return true;
+			}
+		}
+
+		return false;
+	}
+
+	void ThreadPool::ThreadPoolDetail::RunTask(Task& task) noexcept
+	{
+		try
+		{
+			task();
+		}
+		catch (...) {}
+
+		task = nullptr;
+	}
+
+	void ThreadPool::ThreadPoolDetail::Run(ThreadPoolDetail& pool, const size_t workerIndex)
+	{
+		detail::t_currentPool = &pool;
+		detail::t_workerIndex = workerIndex;
+
+		Task task;
+
+		int32 spins = 0;
+
+		for (;;)
+		{
+			if (pool.popTask(workerIndex, task))
+			{
+				RunTask(task);
+				spins = 0;
+				continue;
+			}
+
+			// 未処理のタスクがあるのに取れなかった場合は、ほかのスレッドがキューをロックしている。
+			// しばらく yield してから、ロックを待って盗む
+			if (pool.m_pendingCount != 0)
+			{
+				if (spins < detail::MaxStealSpins)
+				{
+					++spins;
+					std::this_thread::yield();
+					continue;
+				}
+
+				if (pool.stealTask(workerIndex, task, true))
+				{
+					RunTask(task);
+					spins = 0;
+					continue;
+				}
+			}
+
+			spins = 0;
+
+			std::unique_lock lock{ pool.m_sleepMutex };
+
+			if (pool.m_pendingCount == 0)
+			{
+				pool.m_sleepCondition.wait(lock, [&pool]() { return (pool.m_abort || (pool.m_pendingCount != 0)); });
+			}
+			else
+			{
+				// ほかのワーカーが取り出し中のタスクを数えている間は、通知が来ないこともあるため短く待つ
+				pool.m_sleepCondition.wait_for(lock, detail::MaxIdleWait, [&pool]() { return pool.m_abort.load(); });
+			}
+
+			// 中断時も、キューに残っているタスクはすべて実行してから終了する
+			if (pool.m_abort && (pool.m_pendingCount == 0))
+			{
+				break;
+			}
+		}
+	}
+}
@@ -0,0 +1,73 @@
+﻿//-----------------------------------------------
+//
+//	This file is part of the Siv3D Engine.
+//
+//	Copyright (c) 2008-2022 Ryo Suzuki
+//	Copyright (c) 2016-2022 OpenSiv3D Project
+//
+//	Licensed under the MIT License.
+//
+//-----------------------------------------------
+
+# pragma once
+# include <thread>
+# include <deque>
+# include <Siv3D/ThreadPool.hpp>
+# include <Siv3D/Array.hpp>
+
+namespace s3d
+{
+	class ThreadPool::ThreadPoolDetail
+	{
+	public:
+
+		using Task = std::function<void()>;
+
+		explicit ThreadPoolDetail(size_t numThreads);
+
+		~ThreadPoolDetail();
+
+		[[nodiscard]]
+		size_t num_threads() const noexcept;
+
+		[[nodiscard]]
+		bool isWorkerThread() const noexcept;
+
+		void submit(Task&& task);
+
+		bool tryRunPendingTask();
+
+	private:
+
+		struct WorkQueue
+		{
+			std::mutex mutex;
+
+			std::deque<Task> tasks;
+		};
+
+		Array<std::thread> m_threads;
+
+		// ワーカースレッドごとのキュー。所有スレッドは末尾から、他のスレッドは先頭から取り出す
+		Array<std::unique_ptr<WorkQueue>> m_localQueues;
+
+		// ワーカースレッド以外から追加されたタスク
+		WorkQueue m_globalQueue;
+
+		std::atomic<size_t> m_pendingCount = { 0 };
+
+		std::atomic<bool> m_abort = { false };
+
+		std::mutex m_sleepMutex;
+
+		std::condition_variable m_sleepCondition;
+
+		bool popTask(size_t workerIndex, Task& task);
+
+		bool stealTask(size_t workerIndex, Task& task, bool blocking);
+
+		static void RunTask(Task& task) noexcept;
+
+		static void Run(ThreadPoolDetail& pool, size_t workerIndex);
+	};
+}
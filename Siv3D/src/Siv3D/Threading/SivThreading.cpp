@@ -11,6 +11,7 @@
 
 # include <thread>
 # include <Siv3D/Threading.hpp>
+# include <Siv3D/ThreadPool.hpp>
 # include <Siv3D/Utility.hpp>
 
 namespace s3d
@@ -22,5 +23,12 @@ namespace s3d
 			static const size_t n = Max<size_t>(1, std::thread::hardware_concurrency());
 			return n;
 		}
+
+		ThreadPool& GetDefaultPool()
+		{
+			// 最初に使われたときにワーカースレッドを起動し、プログラム終了時に停止する
+			static ThreadPool pool;
+			return pool;
+		}
 	}
 }
@@ -13,51 +13,89 @@
 # include <Siv3D/String.hpp>
 # include <Siv3D/Unicode.hpp>
 # include "UnicodeUtility.hpp"
+# include "UnicodeSIMD.hpp"
 
 namespace s3d
 {
-	namespace Unicode
+	namespace detail
 	{
-		String WidenAscii(const std::string_view asciiText)
-		{
-			return String(asciiText.begin(), asciiText.end());
-		}
-
-		String FromUTF8(const std::string_view s)
+		template <class String32>
+		[[nodiscard]]
+		static String32 DecodeUTF8(const std::string_view s)
 		{
-			String result(detail::UTF32_Length(s), '0');
+			String32 result(UTF8_CountCodePoints(s.data(), s.size()), '0');
 
 			const char8* pSrc = s.data();
 			const char8* const pSrcEnd = pSrc + s.size();
-			char32* pDst = &result[0];
+			char32* pDst = result.data();
 
-			while (pSrc != pSrcEnd)
+			pSrc = UTF8_DecodeValid(pSrc, pSrcEnd, pDst);
+
+			// 不正なシーケンスを含む場合、残りは 1 文字ずつ変換する
+			if (pSrc != pSrcEnd)
 			{
-				int32 offset;
-				*pDst++ = detail::utf8_decode(pSrc, pSrcEnd - pSrc, offset);
-				pSrc += offset;
+				const size_t decodedLength = (pDst - result.data());
+				result.resize(decodedLength + UTF32_Length(std::string_view(pSrc, (pSrcEnd - pSrc))));
+				pDst = (result.data() + decodedLength);
+
+				while (pSrc != pSrcEnd)
+				{
+					int32 offset;
+					*pDst++ = utf8_decode(pSrc, pSrcEnd - pSrc, offset);
+					pSrc += offset;
+				}
 			}
 
 			return result;
 		}
 
-		String FromUTF16(const std::u16string_view s)
+		template <class String32>
+		[[nodiscard]]
+		static String32 DecodeUTF16(const std::u16string_view s)
 		{
-			String result(detail::UTF32_Length(s), '0');
+			String32 result(UTF16_CountCodePoints(s.data(), s.size()), '0');
 
 			const char16* pSrc = s.data();
 			const char16* const pSrcEnd = pSrc + s.size();
-			char32* pDst = &result[0];
+			char32* pDst = result.data();
 
-			while (pSrc != pSrcEnd)
+			pSrc = UTF16_DecodeValid(pSrc, pSrcEnd, pDst);
+
+			// 不正なシーケンスを含む場合、残りは 1 文字ずつ変換する
+			if (pSrc != pSrcEnd)
 			{
-				int32 offset;
-				*pDst++ = detail::utf16_decode(pSrc, pSrcEnd - pSrc, offset);
-				pSrc += offset;
+				const size_t decodedLength = (pDst - result.data());
+				result.resize(decodedLength + UTF32_Length(std::u16string_view(pSrc, (pSrcEnd - pSrc))));
+				pDst = (result.data() + decodedLength);
+
+				while (pSrc != pSrcEnd)
+				{
+					int32 offset;
+					*pDst++ = utf16_decode(pSrc, pSrcEnd - pSrc, offset);
+					pSrc += offset;
+				}
 			}
 
 			return result;
 		}
+	}
+
+	namespace Unicode
+	{
+		String WidenAscii(const std::string_view asciiText)
+		{
+			return String(asciiText.begin(), asciiText.end());
+		}
+
+		String FromUTF8(const std::string_view s)
+		{
+			return detail::DecodeUTF8<String>(s);
+		}
+
+		String FromUTF16(const std::u16string_view s)
+		{
+			return detail::DecodeUTF16<String>(s);
+		}
 
 		String FromUTF32(const std::u32string_view s)
 		{
@@ -84,14 +122,7 @@ namespace s3d
 		{
 			std::string result(detail::UTF8_Length(s), '0');
 
-			const char32* pSrc = s.data();
-			const char32* const pSrcEnd = pSrc + s.size();
-			char8* pDst = &result[0];
-
-			while (pSrc != pSrcEnd)
-			{
-				detail::UTF8_Encode(&pDst, *pSrc++);
-			}
+			detail::UTF8_EncodeAll(s.data(), (s.data() + s.size()), result.data());
 
 			return result;
 		}
@@ -100,14 +131,7 @@ namespace s3d
 		{
 			std::u16string result(detail::UTF16_Length(s), u'0');
 
-			const char32* pSrc = s.data();
-			const char32* const pSrcEnd = pSrc + s.size();
-			char16* pDst = &result[0];
-
-			while (pSrc != pSrcEnd)
-			{
-				detail::UTF16_Encode(&pDst, *pSrc++);
-			}
+			detail::UTF16_EncodeAll(s.data(), (s.data() + s.size()), result.data());
 
 			return result;
 		}
@@ -139,22 +163,7 @@ namespace s3d
 
 		std::u32string UTF8ToUTF32(const std::string_view s)
 		{
-			std::u32string result(detail::UTF32_Length(s), '0');
-
-			const char8* pSrc = s.data();
-			const char8* const pSrcEnd = pSrc + s.size();
-			char32* pDst = &result[0];
-
-			while (pSrc != pSrcEnd)
-			{
-				int32 offset;
-
-				*pDst++ = detail::utf8_decode(pSrc, pSrcEnd - pSrc, offset);
-
-				pSrc += offset;
-			}
-
-			return result;
+			return detail::DecodeUTF8<std::u32string>(s);
 		}
 
 		std::string UTF16ToUTF8(const std::u16string_view s)
@@ -179,36 +188,14 @@ namespace s3d
 
 		std::u32string UTF16ToUTF32(const std::u16string_view s)
 		{
-			std::u32string result(detail::UTF32_Length(s), '0');
-
-			const char16* pSrc = s.data();
-			const char16* const pSrcEnd = pSrc + s.size();
-			char32* pDst = &result[0];
-
-			while (pSrc != pSrcEnd)
-			{
-				int32 offset;
-
-				*pDst++ = detail::utf16_decode(pSrc, pSrcEnd - pSrc, offset);
-
-				pSrc += offset;
-			}
-
-			return result;
+			return detail::DecodeUTF16<std::u32string>(s);
 		}
 
 		std::string UTF32ToUTF8(const std::u32string_view s)
 		{
 			std::string result(detail::UTF8_Length(s), '0');
 
-			const char32* pSrc = s.data();
-			const char32* const pSrcEnd = pSrc + s.size();
-			char8* pDst = &result[0];
-
-			while (pSrc != pSrcEnd)
-			{
-				detail::UTF8_Encode(&pDst, *pSrc++);
-			}
+			detail::UTF8_EncodeAll(s.data(), (s.data() + s.size()), result.data());
 
 			return result;
 		}
@@ -217,14 +204,7 @@ namespace s3d
 		{
 			std::u16string result(detail::UTF16_Length(s), u'0');
 
-			const char32* pSrc = s.data();
-			const char32* const pSrcEnd = pSrc + s.size();
-			char16* pDst = &result[0];
-
-			while (pSrc != pSrcEnd)
-			{
-				detail::UTF16_Encode(&pDst, *pSrc++);
-			}
+			detail::UTF16_EncodeAll(s.data(), (s.data() + s.size()), result.data());
 
 			return result;
 		}
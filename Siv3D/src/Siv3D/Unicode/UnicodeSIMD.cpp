@@ -0,0 +1,928 @@
+﻿//-----------------------------------------------
+//
+//	This file is part of the Siv3D Engine.
+//
+//	Copyright (c) 2008-2022 Ryo Suzuki
+//	Copyright (c) 2016-2022 OpenSiv3D Project
+//
+//	Licensed under the MIT License.
+//
+//-----------------------------------------------
+
+# include <bit>
+# include <cstring>
+# include <ThirdParty/miniutf/miniutf.hpp>
+# include "UnicodeSIMD.hpp"
+# include "UnicodeUtility.hpp"
+
+# if (defined(_M_X64) || defined(__x86_64__)) && (not SIV3D_PLATFORM(WEB))
+#	define SIV3D_UNICODE_SIMD 1
+#	include <immintrin.h>
+#	include <ThirdParty/cpu_features/cpuinfo_x86.h>
+#	if defined(_MSC_VER)
+#		define SIV3D_TARGET_SSE4_1
+#		define SIV3D_TARGET_AVX2
+#	else
+#		define SIV3D_TARGET_SSE4_1 __attribute__((target("sse4.1")))
+#		define SIV3D_TARGET_AVX2 __attribute__((target("avx2")))
+#	endif
+# else
+#	define SIV3D_UNICODE_SIMD 0
+# endif
+
+namespace s3d
+{
+	namespace detail
+	{
+		namespace
+		{
+			////////////////////////////////////////////////////////////////
+			//
+			//	Reference
+			//
+			////////////////////////////////////////////////////////////////
+
+			[[nodiscard]]
+			inline bool DecodeOneUTF8(const char8*& pSrc, const char8* const pSrcEnd, char32*& pDst) noexcept
+			{
+				const offset_pt result = utf8_decode_check(pSrc, (pSrcEnd - pSrc));
+
+				if (result.offset < 0)
+				{
+					return false;
+				}
+
+				*pDst++ = result.codePoint;
+				pSrc += result.offset;
+				return true;
+			}
+
+			[[nodiscard]]
+			inline bool DecodeOneUTF16(const char16*& pSrc, const char16* const pSrcEnd, char32*& pDst) noexcept
+			{
+				const offset_pt result = utf16_decode_check(pSrc, (pSrcEnd - pSrc));
+
+				if (result.offset < 0)
+				{
+					return false;
+				}
+
+				*pDst++ = result.codePoint;
+				pSrc += result.offset;
+				return true;
+			}
+
+			[[nodiscard]]
+			size_t UTF8_CountCodePoints_Reference(const char8* s, const size_t length) noexcept
+			{
+				size_t count = 0;
+
+				for (size_t i = 0; i < length; ++i)
+				{
+					count += ((static_cast<uint8>(s[i]) & 0xC0) != 0x80);
+				}
+
+				return count;
+			}
+
+			[[nodiscard]]
+			const char8* UTF8_DecodeValid_Reference(const char8* pSrc, const char8* const pSrcEnd, char32*& pDst) noexcept
+			{
+				while (pSrc != pSrcEnd)
+				{
+					if (not DecodeOneUTF8(pSrc, pSrcEnd, pDst))
+					{
+						break;
+					}
+				}
+
+				return pSrc;
+			}
+
+			void UTF8_EncodeAll_Reference(const char32* pSrc, const char32* const pSrcEnd, char8* pDst) noexcept
+			{
+				while (pSrc != pSrcEnd)
+				{
+					UTF8_Encode(&pDst, *pSrc++);
+				}
+			}
+
+			[[nodiscard]]
+			size_t UTF8_EncodedLength_Reference(const char32* s, const size_t length) noexcept
+			{
+				size_t result = 0;
+
+				for (size_t i = 0; i < length; ++i)
+				{
+					result += UTF8_Length(s[i]);
+				}
+
+				return result;
+			}
+
+			[[nodiscard]]
+			size_t UTF16_CountCodePoints_Reference(const char16* s, const size_t length) noexcept
+			{
+				size_t count = 0;
+
+				for (size_t i = 0; i < length; ++i)
+				{
+					count += (not is_low_surrogate(s[i]));
+				}
+
+				return count;
+			}
+
+			[[nodiscard]]
+			const char16* UTF16_DecodeValid_Reference(const char16* pSrc, const char16* const pSrcEnd, char32*& pDst) noexcept
+			{
+				while (pSrc != pSrcEnd)
+				{
+					if (not DecodeOneUTF16(pSrc, pSrcEnd, pDst))
+					{
+						break;
+					}
+				}
+
+				return pSrc;
+			}
+
+			void UTF16_EncodeAll_Reference(const char32* pSrc, const char32* const pSrcEnd, char16* pDst) noexcept
+			{
+				while (pSrc != pSrcEnd)
+				{
+					UTF16_Encode(&pDst, *pSrc++);
+				}
+			}
+
+			[[nodiscard]]
+			size_t UTF16_EncodedLength_Reference(const char32* s, const size_t length) noexcept
+			{
+				size_t result = 0;
+
+				for (size_t i = 0; i < length; ++i)
+				{
+					result += UTF16_Length(s[i]);
+				}
+
+				return result;
+			}
+
+		# if SIV3D_UNICODE_SIMD
+
+			enum class SIMDLevel : uint8
+			{
+				None,
+
+				SSE4_1,
+
+				AVX2,
+			};
+
+			[[nodiscard]]
+			SIMDLevel GetSIMDLevel() noexcept
+			{
+				// GetCPUInfo() は静的初期化の途中で Unicode 変換を使うため、ここでは直接調べる
+				static const SIMDLevel level = []()
+				{
+					const cpu_features::X86Features features = cpu_features::GetX86Info().features;
+
+					if (features.avx2)
+					{
+						return SIMDLevel::AVX2;
+					}
+					else if (features.sse4_1)
+					{
+						return SIMDLevel::SSE4_1;
+					}
+
+					return SIMDLevel::None;
+				}();
+
+				return level;
+			}
+
+			////////////////////////////////////////////////////////////////
+			//
+			//	SSE4.1
+			//
+			////////////////////////////////////////////////////////////////
+
+			/// @brief 各要素が [lo, hi) の範囲にあるか (符号なし 32-bit)
+			SIV3D_TARGET_SSE4_1
+			inline __m128i InRange_SSE4_1(const __m128i v, const uint32 lo, const uint32 hi) noexcept
+			{
+				const __m128i geLo = _mm_cmpeq_epi32(_mm_max_epu32(v, _mm_set1_epi32(static_cast<int32>(lo))), v);
+				const __m128i ltHi = _mm_cmpeq_epi32(_mm_min_epu32(v, _mm_set1_epi32(static_cast<int32>(hi - 1))), v);
+				return _mm_and_si128(geLo, ltHi);
+			}
+
+			/// @brief 各要素が threshold 未満なら -1, それ以外は 0 (符号なし 32-bit)
+			SIV3D_TARGET_SSE4_1
+			inline __m128i LessThan_SSE4_1(const __m128i v, const uint32 threshold) noexcept
+			{
+				return _mm_cmpeq_epi32(_mm_min_epu32(v, _mm_set1_epi32(static_cast<int32>(threshold - 1))), v);
+			}
+
+			SIV3D_TARGET_SSE4_1
+			inline int64 HorizontalSum_SSE4_1(const __m128i v) noexcept
+			{
+				return (static_cast<int64>(_mm_extract_epi32(v, 0)) + _mm_extract_epi32(v, 1)
+					+ _mm_extract_epi32(v, 2) + _mm_extract_epi32(v, 3));
+			}
+
+			SIV3D_TARGET_SSE4_1
+			size_t UTF8_CountCodePoints_SSE4_1(const char8* s, const size_t length) noexcept
+			{
+				const char8* p = s;
+				const char8* const pEnd = (s + length);
+
+				// 継続バイト (0x80-0xBF) は、符号付きで -128 ～ -65
+				const __m128i continuationMax = _mm_set1_epi8(static_cast<char>(0xBF));
+				size_t count = 0;
+
+				for (; 16 <= (pEnd - p); p += 16)
+				{
+					const __m128i v = _mm_loadu_si128(reinterpret_cast<const __m128i*>(p));
+					count += std::popcount(static_cast<uint32>(_mm_movemask_epi8(_mm_cmpgt_epi8(v, continuationMax))));
+				}
+
+				return (count + UTF8_CountCodePoints_Reference(p, (pEnd - p)));
+			}
+
+			/// @brief 16 バイト以上残っているときに、UTF-8 の一部を変換します。
+			/// @return 不正なシーケンスがあった場合 false
+			SIV3D_TARGET_SSE4_1
+			inline bool DecodeUTF8Block_SSE4_1(const char8*& pSrc, const char8* const pSrcEnd, char32*& pDst) noexcept
+			{
+				const __m128i v = _mm_loadu_si128(reinterpret_cast<const __m128i*>(pSrc));
+				const uint32 nonAsciiMask = static_cast<uint32>(_mm_movemask_epi8(v));
+
+				// ASCII x 16
+				if (nonAsciiMask == 0)
+				{
+					_mm_storeu_si128(reinterpret_cast<__m128i*>(pDst + 0), _mm_cvtepu8_epi32(v));
+					_mm_storeu_si128(reinterpret_cast<__m128i*>(pDst + 4), _mm_cvtepu8_epi32(_mm_srli_si128(v, 4)));
+					_mm_storeu_si128(reinterpret_cast<__m128i*>(pDst + 8), _mm_cvtepu8_epi32(_mm_srli_si128(v, 8)));
+					_mm_storeu_si128(reinterpret_cast<__m128i*>(pDst + 12), _mm_cvtepu8_epi32(_mm_srli_si128(v, 12)));
+					pSrc += 16;
+					pDst += 16;
+					return true;
+				}
+
+				// 先頭の ASCII
+				if (const int32 asciiLength = std::countr_zero(nonAsciiMask))
+				{
+					for (int32 i = 0; i < asciiLength; ++i)
+					{
+						*pDst++ = static_cast<uint8>(*pSrc++);
+					}
+
+					return true;
+				}
+
+				const uint8 lead = static_cast<uint8>(*pSrc);
+
+				if (lead < 0xC0)
+				{
+					// 不正な継続バイト
+				}
+				else if (lead < 0xE0)
+				{
+					// 2 バイト x 8 (lead: 110xxxxx, 0xC0 と 0xC1 は冗長表現のため除外)
+					const __m128i validMask = _mm_cmpeq_epi16(_mm_and_si128(v, _mm_set1_epi16(static_cast<int16>(0xC0E0))), _mm_set1_epi16(static_cast<int16>(0x80C0)));
+					const __m128i overlongMask = _mm_cmpeq_epi16(_mm_and_si128(v, _mm_set1_epi16(0x001E)), _mm_setzero_si128());
+
+					if (_mm_movemask_epi8(_mm_andnot_si128(overlongMask, validMask)) == 0xFFFF)
+					{
+						const __m128i codePoints = _mm_or_si128(
+							_mm_slli_epi16(_mm_and_si128(v, _mm_set1_epi16(0x001F)), 6),
+							_mm_and_si128(_mm_srli_epi16(v, 8), _mm_set1_epi16(0x003F)));
+
+						_mm_storeu_si128(reinterpret_cast<__m128i*>(pDst + 0), _mm_cvtepu16_epi32(codePoints));
+						_mm_storeu_si128(reinterpret_cast<__m128i*>(pDst + 4), _mm_cvtepu16_epi32(_mm_srli_si128(codePoints, 8)));
+						pSrc += 16;
+						pDst += 8;
+						return true;
+					}
+				}
+				else if (lead < 0xF0)
+				{
+					// 3 バイト x 4
+					const __m128i w = _mm_shuffle_epi8(v, _mm_setr_epi8(0, 1, 2, -1, 3, 4, 5, -1, 6, 7, 8, -1, 9, 10, 11, -1));
+					const __m128i validMask = _mm_cmpeq_epi32(_mm_and_si128(w, _mm_set1_epi32(0x00C0C0F0)), _mm_set1_epi32(0x008080E0));
+					const __m128i codePoints = _mm_or_si128(_mm_or_si128(
+						_mm_slli_epi32(_mm_and_si128(w, _mm_set1_epi32(0x0000000F)), 12),
+						_mm_srli_epi32(_mm_and_si128(w, _mm_set1_epi32(0x00003F00)), 2)),
+						_mm_and_si128(_mm_srli_epi32(w, 16), _mm_set1_epi32(0x0000003F)));
+					const __m128i notOverlongMask = _mm_cmpgt_epi32(codePoints, _mm_set1_epi32(0x07FF));
+
+					if (_mm_movemask_epi8(_mm_and_si128(validMask, notOverlongMask)) == 0xFFFF)
+					{
+						_mm_storeu_si128(reinterpret_cast<__m128i*>(pDst), codePoints);
+						pSrc += 12;
+						pDst += 4;
+						return true;
+					}
+				}
+				else if (lead < 0xF8)
+				{
+					// 4 バイト x 4
+					const __m128i validMask = _mm_cmpeq_epi32(_mm_and_si128(v, _mm_set1_epi32(static_cast<int32>(0xC0C0C0F8))), _mm_set1_epi32(static_cast<int32>(0x808080F0)));
+					const __m128i codePoints = _mm_or_si128(_mm_or_si128(
+						_mm_slli_epi32(_mm_and_si128(v, _mm_set1_epi32(0x00000007)), 18),
+						_mm_slli_epi32(_mm_and_si128(v, _mm_set1_epi32(0x00003F00)), 4)), _mm_or_si128(
+						_mm_srli_epi32(_mm_and_si128(v, _mm_set1_epi32(0x003F0000)), 10),
+						_mm_and_si128(_mm_srli_epi32(v, 24), _mm_set1_epi32(0x0000003F))));
+
+					if (_mm_movemask_epi8(_mm_and_si128(validMask, InRange_SSE4_1(codePoints, 0x10000, 0x110000))) == 0xFFFF)
+					{
+						_mm_storeu_si128(reinterpret_cast<__m128i*>(pDst), codePoints);
+						pSrc += 16;
+						pDst += 4;
+						return true;
+					}
+				}
+
+				// 長さの異なる文字が混在している、または不正なシーケンス
+				return DecodeOneUTF8(pSrc, pSrcEnd, pDst);
+			}
+
+			SIV3D_TARGET_SSE4_1
+			const char8* UTF8_DecodeValid_SSE4_1(const char8* pSrc, const char8* const pSrcEnd, char32*& pDst) noexcept
+			{
+				while (16 <= (pSrcEnd - pSrc))
+				{
+					if (not DecodeUTF8Block_SSE4_1(pSrc, pSrcEnd, pDst))
+					{
+						return pSrc;
+					}
+				}
+
+				return UTF8_DecodeValid_Reference(pSrc, pSrcEnd, pDst);
+			}
+
+			/// @brief 4 文字以上残っているときに、UTF-32 の一部を UTF-8 に変換します。
+			SIV3D_TARGET_SSE4_1
+			inline void EncodeUTF8Block_SSE4_1(const char32*& pSrc, const char32* const pSrcEnd, char8*& pDst) noexcept
+			{
+				const __m128i a = _mm_loadu_si128(reinterpret_cast<const __m128i*>(pSrc));
+				const __m128i nonAsciiBits = _mm_set1_epi32(static_cast<int32>(0xFFFFFF80));
+
+				if (16 <= (pSrcEnd - pSrc))
+				{
+					const __m128i b = _mm_loadu_si128(reinterpret_cast<const __m128i*>(pSrc + 4));
+					const __m128i c = _mm_loadu_si128(reinterpret_cast<const __m128i*>(pSrc + 8));
+					const __m128i d = _mm_loadu_si128(reinterpret_cast<const __m128i*>(pSrc + 12));
+
+					// ASCII x 16
+					if (_mm_testz_si128(_mm_or_si128(_mm_or_si128(a, b), _mm_or_si128(c, d)), nonAsciiBits))
+					{
+						_mm_storeu_si128(reinterpret_cast<__m128i*>(pDst), _mm_packus_epi16(_mm_packus_epi32(a, b), _mm_packus_epi32(c, d)));
+						pSrc += 16;
+						pDst += 16;
+						return;
+					}
+				}
+
+				// ASCII x 4
+				if (_mm_testz_si128(a, nonAsciiBits))
+				{
+					const int32 bytes = _mm_cvtsi128_si32(_mm_packus_epi16(_mm_packus_epi32(a, a), _mm_setzero_si128()));
+					std::memcpy(pDst, &bytes, 4);
+					pSrc += 4;
+					pDst += 4;
+					return;
+				}
+
+				const __m128i mask3F = _mm_set1_epi32(0x3F);
+				const __m128i continuation0 = _mm_or_si128(_mm_and_si128(a, mask3F), _mm_set1_epi32(0x80));
+				const __m128i continuation1 = _mm_or_si128(_mm_and_si128(_mm_srli_epi32(a, 6), mask3F), _mm_set1_epi32(0x80));
+
+				// 2 バイト x 4
+				if (_mm_movemask_epi8(InRange_SSE4_1(a, 0x80, 0x800)) == 0xFFFF)
+				{
+					const __m128i bytes = _mm_or_si128(_mm_or_si128(_mm_srli_epi32(a, 6), _mm_set1_epi32(0xC0)), _mm_slli_epi32(continuation0, 8));
+					_mm_storel_epi64(reinterpret_cast<__m128i*>(pDst), _mm_packus_epi32(bytes, bytes));
+					pSrc += 4;
+					pDst += 8;
+					return;
+				}
+
+				// 3 バイト x 4
+				if (_mm_movemask_epi8(InRange_SSE4_1(a, 0x800, 0x10000)) == 0xFFFF)
+				{
+					const __m128i bytes = _mm_or_si128(_mm_or_si128(
+						_mm_or_si128(_mm_srli_epi32(a, 12), _mm_set1_epi32(0xE0)),
+						_mm_slli_epi32(continuation1, 8)),
+						_mm_slli_epi32(continuation0, 16));
+					const __m128i packed = _mm_shuffle_epi8(bytes, _mm_setr_epi8(0, 1, 2, 4, 5, 6, 8, 9, 10, 12, 13, 14, -1, -1, -1, -1));
+					const int32 last = _mm_extract_epi32(packed, 2);
+					_mm_storel_epi64(reinterpret_cast<__m128i*>(pDst), packed);
+					std::memcpy(pDst + 8, &last, 4);
+					pSrc += 4;
+					pDst += 12;
+					return;
+				}
+
+				// 4 バイト x 4
+				if (_mm_movemask_epi8(InRange_SSE4_1(a, 0x10000, 0x110000)) == 0xFFFF)
+				{
+					const __m128i continuation2 = _mm_or_si128(_mm_and_si128(_mm_srli_epi32(a, 12), mask3F), _mm_set1_epi32(0x80));
+					const __m128i bytes = _mm_or_si128(_mm_or_si128(
+						_mm_or_si128(_mm_srli_epi32(a, 18), _mm_set1_epi32(0xF0)),
+						_mm_slli_epi32(continuation2, 8)), _mm_or_si128(
+						_mm_slli_epi32(continuation1, 16),
+						_mm_slli_epi32(continuation0, 24)));
+					_mm_storeu_si128(reinterpret_cast<__m128i*>(pDst), bytes);
+					pSrc += 4;
+					pDst += 16;
+					return;
+				}
+
+				// 長さの異なる文字が混在している、または範囲外のコードポイント
+				UTF8_Encode(&pDst, *pSrc++);
+			}
+
+			SIV3D_TARGET_SSE4_1
+			void UTF8_EncodeAll_SSE4_1(const char32* pSrc, const char32* const pSrcEnd, char8* pDst) noexcept
+			{
+				while (4 <= (pSrcEnd - pSrc))
+				{
+					EncodeUTF8Block_SSE4_1(pSrc, pSrcEnd, pDst);
+				}
+
+				UTF8_EncodeAll_Reference(pSrc, pSrcEnd, pDst);
+			}
+
+			SIV3D_TARGET_SSE4_1
+			size_t UTF8_EncodedLength_SSE4_1(const char32* s, const size_t length) noexcept
+			{
+				const size_t simdLength = (length & ~size_t{ 3 });
+				int64 result = 0;
+
+				// 1 + (0x80 以上) + (0x800 以上) + (0x10000 以上) - (0x110000 以上) = 3 + lt(0x80) + lt(0x800) + lt(0x10000) - lt(0x110000)
+				for (size_t i = 0; i < simdLength;)
+				{
+					// 32-bit のカウンタがあふれないよう、一定間隔で集計する
+					const size_t blockEnd = Min(simdLength, (i + (4 << 16)));
+					__m128i sum = _mm_setzero_si128();
+
+					for (; i < blockEnd; i += 4)
+					{
+						const __m128i v = _mm_loadu_si128(reinterpret_cast<const __m128i*>(s + i));
+						sum = _mm_add_epi32(sum, _mm_add_epi32(LessThan_SSE4_1(v, 0x80), LessThan_SSE4_1(v, 0x800)));
+						sum = _mm_add_epi32(sum, _mm_sub_epi32(LessThan_SSE4_1(v, 0x10000), LessThan_SSE4_1(v, 0x110000)));
+					}
+
+					result += HorizontalSum_SSE4_1(sum);
+				}
+
+				return (static_cast<size_t>(result + static_cast<int64>(simdLength * 3))
+					+ UTF8_EncodedLength_Reference((s + simdLength), (length - simdLength)));
+			}
+
+			SIV3D_TARGET_SSE4_1
+			size_t UTF16_CountCodePoints_SSE4_1(const char16* s, const size_t length) noexcept
+			{
+				const char16* p = s;
+				const char16* const pEnd = (s + length);
+				size_t lowSurrogates = 0;
+
+				for (; 8 <= (pEnd - p); p += 8)
+				{
+					const __m128i v = _mm_loadu_si128(reinterpret_cast<const __m128i*>(p));
+					const __m128i lowSurrogateMask = _mm_cmpeq_epi16(_mm_and_si128(v, _mm_set1_epi16(static_cast<int16>(0xFC00))), _mm_set1_epi16(static_cast<int16>(0xDC00)));
+					lowSurrogates += (std::popcount(static_cast<uint32>(_mm_movemask_epi8(lowSurrogateMask))) / 2);
+				}
+
+				return ((p - s) - lowSurrogates) + UTF16_CountCodePoints_Reference(p, (pEnd - p));
+			}
+
+			/// @brief 8 要素以上残っているときに、UTF-16 の一部を変換します。
+			/// @return 不正なシーケンスがあった場合 false
+			SIV3D_TARGET_SSE4_1
+			inline bool DecodeUTF16Block_SSE4_1(const char16*& pSrc, const char16* const pSrcEnd, char32*& pDst) noexcept
+			{
+				const __m128i v = _mm_loadu_si128(reinterpret_cast<const __m128i*>(pSrc));
+				const __m128i surrogateMask = _mm_cmpeq_epi16(_mm_and_si128(v, _mm_set1_epi16(static_cast<int16>(0xF800))), _mm_set1_epi16(static_cast<int16>(0xD800)));
+				const uint32 mask = static_cast<uint32>(_mm_movemask_epi8(surrogateMask));
+
+				// サロゲートを含まない x 8
+				if (mask == 0)
+				{
+					_mm_storeu_si128(reinterpret_cast<__m128i*>(pDst + 0), _mm_cvtepu16_epi32(v));
+					_mm_storeu_si128(reinterpret_cast<__m128i*>(pDst + 4), _mm_cvtepu16_epi32(_mm_srli_si128(v, 8)));
+					pSrc += 8;
+					pDst += 8;
+					return true;
+				}
+
+				if (const int32 bmpLength = (std::countr_zero(mask) / 2))
+				{
+					for (int32 i = 0; i < bmpLength; ++i)
+					{
+						*pDst++ = *pSrc++;
+					}
+
+					return true;
+				}
+
+				return DecodeOneUTF16(pSrc, pSrcEnd, pDst);
+			}
+
+			SIV3D_TARGET_SSE4_1
+			const char16* UTF16_DecodeValid_SSE4_1(const char16* pSrc, const char16* const pSrcEnd, char32*& pDst) noexcept
+			{
+				while (8 <= (pSrcEnd - pSrc))
+				{
+					if (not DecodeUTF16Block_SSE4_1(pSrc, pSrcEnd, pDst))
+					{
+						return pSrc;
+					}
+				}
+
+				return UTF16_DecodeValid_Reference(pSrc, pSrcEnd, pDst);
+			}
+
+			/// @brief 4 文字以上残っているときに、UTF-32 の一部を UTF-16 に変換します。
+			SIV3D_TARGET_SSE4_1
+			inline void EncodeUTF16Block_SSE4_1(const char32*& pSrc, const char32* const pSrcEnd, char16*& pDst) noexcept
+			{
+				const __m128i a = _mm_loadu_si128(reinterpret_cast<const __m128i*>(pSrc));
+				const __m128i nonBMPBits = _mm_set1_epi32(static_cast<int32>(0xFFFF0000));
+
+				if (8 <= (pSrcEnd - pSrc))
+				{
+					const __m128i b = _mm_loadu_si128(reinterpret_cast<const __m128i*>(pSrc + 4));
+
+					// BMP x 8
+					if (_mm_testz_si128(_mm_or_si128(a, b), nonBMPBits))
+					{
+						_mm_storeu_si128(reinterpret_cast<__m128i*>(pDst), _mm_packus_epi32(a, b));
+						pSrc += 8;
+						pDst += 8;
+						return;
+					}
+				}
+
+				// BMP x 4
+				if (_mm_testz_si128(a, nonBMPBits))
+				{
+					_mm_storel_epi64(reinterpret_cast<__m128i*>(pDst), _mm_packus_epi32(a, a));
+					pSrc += 4;
+					pDst += 4;
+					return;
+				}
+
+				UTF16_Encode(&pDst, *pSrc++);
+			}
+
+			SIV3D_TARGET_SSE4_1
+			void UTF16_EncodeAll_SSE4_1(const char32* pSrc, const char32* const pSrcEnd, char16* pDst) noexcept
+			{
+				while (4 <= (pSrcEnd - pSrc))
+				{
+					EncodeUTF16Block_SSE4_1(pSrc, pSrcEnd, pDst);
+				}
+
+				UTF16_EncodeAll_Reference(pSrc, pSrcEnd, pDst);
+			}
+
+			SIV3D_TARGET_SSE4_1
+			size_t UTF16_EncodedLength_SSE4_1(const char32* s, const size_t length) noexcept
+			{
+				const size_t simdLength = (length & ~size_t{ 3 });
+				int64 result = 0;
+
+				// 1 + (0x10000 以上 0x110000 未満) = 1 + lt(0x10000) - lt(0x110000)
+				for (size_t i = 0; i < simdLength;)
+				{
+					const size_t blockEnd = Min(simdLength, (i + (4 << 16)));
+					__m128i sum = _mm_setzero_si128();
+
+					for (; i < blockEnd; i += 4)
+					{
+						const __m128i v = _mm_loadu_si128(reinterpret_cast<const __m128i*>(s + i));
+						sum = _mm_add_epi32(sum, _mm_sub_epi32(LessThan_SSE4_1(v, 0x10000), LessThan_SSE4_1(v, 0x110000)));
+					}
+
+					result += HorizontalSum_SSE4_1(sum);
+				}
+
+				return (static_cast<size_t>(result + static_cast<int64>(simdLength))
+					+ UTF16_EncodedLength_Reference((s + simdLength), (length - simdLength)));
+			}
+
+			////////////////////////////////////////////////////////////////
+			//
+			//	AVX2
+			//
+			//	ASCII / BMP の区間を 256-bit 単位で処理し、それ以外は SSE4.1 版と共通
+			//
+			////////////////////////////////////////////////////////////////
+
+			SIV3D_TARGET_AVX2
+			size_t UTF8_CountCodePoints_AVX2(const char8* s, const size_t length) noexcept
+			{
+				const char8* p = s;
+				const char8* const pEnd = (s + length);
+				const __m256i continuationMax = _mm256_set1_epi8(static_cast<char>(0xBF));
+				size_t count = 0;
+
+				for (; 32 <= (pEnd - p); p += 32)
+				{
+					const __m256i v = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(p));
+					count += std::popcount(static_cast<uint32>(_mm256_movemask_epi8(_mm256_cmpgt_epi8(v, continuationMax))));
+				}
+
+				return (count + UTF8_CountCodePoints_Reference(p, (pEnd - p)));
+			}
+
+			SIV3D_TARGET_AVX2
+			const char8* UTF8_DecodeValid_AVX2(const char8* pSrc, const char8* const pSrcEnd, char32*& pDst) noexcept
+			{
+				while (16 <= (pSrcEnd - pSrc))
+				{
+					// ASCII x 32
+					if (32 <= (pSrcEnd - pSrc))
+					{
+						const __m256i v = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(pSrc));
+
+						if (_mm256_movemask_epi8(v) == 0)
+						{
+							const __m128i lo = _mm256_castsi256_si128(v);
+							const __m128i hi = _mm256_extracti128_si256(v, 1);
+							_mm256_storeu_si256(reinterpret_cast<__m256i*>(pDst + 0), _mm256_cvtepu8_epi32(lo));
+							_mm256_storeu_si256(reinterpret_cast<__m256i*>(pDst + 8), _mm256_cvtepu8_epi32(_mm_srli_si128(lo, 8)));
+							_mm256_storeu_si256(reinterpret_cast<__m256i*>(pDst + 16), _mm256_cvtepu8_epi32(hi));
+							_mm256_storeu_si256(reinterpret_cast<__m256i*>(pDst + 24), _mm256_cvtepu8_epi32(_mm_srli_si128(hi, 8)));
+							pSrc += 32;
+							pDst += 32;
+							continue;
+						}
+					}
+
+					if (not DecodeUTF8Block_SSE4_1(pSrc, pSrcEnd, pDst))
+					{
+						return pSrc;
+					}
+				}
+
+				return UTF8_DecodeValid_Reference(pSrc, pSrcEnd, pDst);
+			}
+
+			SIV3D_TARGET_AVX2
+			void UTF8_EncodeAll_AVX2(const char32* pSrc, const char32* const pSrcEnd, char8* pDst) noexcept
+			{
+				const __m256i nonAsciiBits = _mm256_set1_epi32(static_cast<int32>(0xFFFFFF80));
+
+				while (4 <= (pSrcEnd - pSrc))
+				{
+					// ASCII x 32
+					if (32 <= (pSrcEnd - pSrc))
+					{
+						const __m256i a = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(pSrc + 0));
+						const __m256i b = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(pSrc + 8));
+						const __m256i c = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(pSrc + 16));
+						const __m256i d = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(pSrc + 24));
+
+						if (_mm256_testz_si256(_mm256_or_si256(_mm256_or_si256(a, b), _mm256_or_si256(c, d)), nonAsciiBits))
+						{
+							// pack は 128-bit レーンごとに行われるため、最後に並べ替える
+							const __m256i packed = _mm256_packus_epi16(_mm256_packus_epi32(a, b), _mm256_packus_epi32(c, d));
+							_mm256_storeu_si256(reinterpret_cast<__m256i*>(pDst), _mm256_permutevar8x32_epi32(packed, _mm256_setr_epi32(0, 4, 1, 5, 2, 6, 3, 7)));
+							pSrc += 32;
+							pDst += 32;
+							continue;
+						}
+					}
+
+					EncodeUTF8Block_SSE4_1(pSrc, pSrcEnd, pDst);
+				}
+
+				UTF8_EncodeAll_Reference(pSrc, pSrcEnd, pDst);
+			}
+
+			SIV3D_TARGET_AVX2
+			size_t UTF16_CountCodePoints_AVX2(const char16* s, const size_t length) noexcept
+			{
+				const char16* p = s;
+				const char16* const pEnd = (s + length);
+				size_t lowSurrogates = 0;
+
+				for (; 16 <= (pEnd - p); p += 16)
+				{
+					const __m256i v = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(p));
+					const __m256i lowSurrogateMask = _mm256_cmpeq_epi16(_mm256_and_si256(v, _mm256_set1_epi16(static_cast<int16>(0xFC00))), _mm256_set1_epi16(static_cast<int16>(0xDC00)));
+					lowSurrogates += (std::popcount(static_cast<uint32>(_mm256_movemask_epi8(lowSurrogateMask))) / 2);
+				}
+
+				return ((p - s) - lowSurrogates) + UTF16_CountCodePoints_Reference(p, (pEnd - p));
+			}
+
+			SIV3D_TARGET_AVX2
+			const char16* UTF16_DecodeValid_AVX2(const char16* pSrc, const char16* const pSrcEnd, char32*& pDst) noexcept
+			{
+				while (8 <= (pSrcEnd - pSrc))
+				{
+					// サロゲートを含まない x 16
+					if (16 <= (pSrcEnd - pSrc))
+					{
+						const __m256i v = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(pSrc));
+						const __m256i surrogateMask = _mm256_cmpeq_epi16(_mm256_and_si256(v, _mm256_set1_epi16(static_cast<int16>(0xF800))), _mm256_set1_epi16(static_cast<int16>(0xD800)));
+
+						if (_mm256_testz_si256(surrogateMask, surrogateMask))
+						{
+							_mm256_storeu_si256(reinterpret_cast<__m256i*>(pDst + 0), _mm256_cvtepu16_epi32(_mm256_castsi256_si128(v)));
+							_mm256_storeu_si256(reinterpret_cast<__m256i*>(pDst + 8), _mm256_cvtepu16_epi32(_mm256_extracti128_si256(v, 1)));
+							pSrc += 16;
+							pDst += 16;
+							continue;
+						}
+					}
+
+					if (not DecodeUTF16Block_SSE4_1(pSrc, pSrcEnd, pDst))
+					{
+						return pSrc;
+					}
+				}
+
+				return UTF16_DecodeValid_Reference(pSrc, pSrcEnd, pDst);
+			}
+
+			SIV3D_TARGET_AVX2
+			void UTF16_EncodeAll_AVX2(const char32* pSrc, const char32* const pSrcEnd, char16* pDst) noexcept
+			{
+				const __m256i nonBMPBits = _mm256_set1_epi32(static_cast<int32>(0xFFFF0000));
+
+				while (4 <= (pSrcEnd - pSrc))
+				{
+					// BMP x 16
+					if (16 <= (pSrcEnd - pSrc))
+					{
+						const __m256i a = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(pSrc + 0));
+						const __m256i b = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(pSrc + 8));
+
+						if (_mm256_testz_si256(_mm256_or_si256(a, b), nonBMPBits))
+						{
+							const __m256i packed = _mm256_packus_epi32(a, b);
+							_mm256_storeu_si256(reinterpret_cast<__m256i*>(pDst), _mm256_permute4x64_epi64(packed, 0b11'01'10'00));
+							pSrc += 16;
+							pDst += 16;
+							continue;
+						}
+					}
+
+					EncodeUTF16Block_SSE4_1(pSrc, pSrcEnd, pDst);
+				}
+
+				UTF16_EncodeAll_Reference(pSrc, pSrcEnd, pDst);
+			}
+
+		# endif
+		}
+
+		size_t UTF8_CountCodePoints(const char8* s, const size_t length) noexcept
+		{
+		# if SIV3D_UNICODE_SIMD
+
+			switch (GetSIMDLevel())
+			{
+			case SIMDLevel::AVX2:
+				return UTF8_CountCodePoints_AVX2(s, length);
+			case SIMDLevel::SSE4_1:
+				return UTF8_CountCodePoints_SSE4_1(s, length);
+			default:
+				break;
+			}
+
+		# endif
+
+			return UTF8_CountCodePoints_Reference(s, length);
+		}
+
+		const char8* UTF8_DecodeValid(const char8* pSrc, const char8* const pSrcEnd, char32*& pDst) noexcept
+		{
+		# if SIV3D_UNICODE_SIMD
+
+			switch (GetSIMDLevel())
+			{
+			case SIMDLevel::AVX2:
+				return UTF8_DecodeValid_AVX2(pSrc, pSrcEnd, pDst);
+			case SIMDLevel::SSE4_1:
+				return UTF8_DecodeValid_SSE4_1(pSrc, pSrcEnd, pDst);
+			default:
+				break;
+			}
+
+		# endif
+
+			return UTF8_DecodeValid_Reference(pSrc, pSrcEnd, pDst);
+		}
+
+		void UTF8_EncodeAll(const char32* pSrc, const char32* const pSrcEnd, char8* pDst) noexcept
+		{
+		# if SIV3D_UNICODE_SIMD
+
+			switch (GetSIMDLevel())
+			{
+			case SIMDLevel::AVX2:
+				return UTF8_EncodeAll_AVX2(pSrc, pSrcEnd, pDst);
+			case SIMDLevel::SSE4_1:
+				return UTF8_EncodeAll_SSE4_1(pSrc, pSrcEnd, pDst);
+			default:
+				break;
+			}
+
+		# endif
+
+			UTF8_EncodeAll_Reference(pSrc, pSrcEnd, pDst);
+		}
+
+		size_t UTF8_EncodedLength(const char32* s, const size_t length) noexcept
+		{
+		# if SIV3D_UNICODE_SIMD
+
+			if (GetSIMDLevel() != SIMDLevel::None)
+			{
+				return UTF8_EncodedLength_SSE4_1(s, length);
+			}
+
+		# endif
+
+			return UTF8_EncodedLength_Reference(s, length);
+		}
+
+		size_t UTF16_CountCodePoints(const char16* s, const size_t length) noexcept
+		{
+		# if SIV3D_UNICODE_SIMD
+
+			switch (GetSIMDLevel())
+			{
+			case SIMDLevel::AVX2:
+				return UTF16_CountCodePoints_AVX2(s, length);
+			case SIMDLevel::SSE4_1:
+				return UTF16_CountCodePoints_SSE4_1(s, length);
+			default:
+				break;
+			}
+
+		# endif
+
+			return UTF16_CountCodePoints_Reference(s, length);
+		}
+
+		const char16* UTF16_DecodeValid(const char16* pSrc, const char16* const pSrcEnd, char32*& pDst) noexcept
+		{
+		# if SIV3D_UNICODE_SIMD
+
+			switch (GetSIMDLevel())
+			{
+			case SIMDLevel::AVX2:
+				return UTF16_DecodeValid_AVX2(pSrc, pSrcEnd, pDst);
+			case SIMDLevel::SSE4_1:
+				return UTF16_DecodeValid_SSE4_1(pSrc, pSrcEnd, pDst);
+			default:
+				break;
+			}
+
+		# endif
+
+			return UTF16_DecodeValid_Reference(pSrc, pSrcEnd, pDst);
+		}
+
+		void UTF16_EncodeAll(const char32* pSrc, const char32* const pSrcEnd, char16* pDst) noexcept
+		{
+		# if SIV3D_UNICODE_SIMD
+
+			switch (GetSIMDLevel())
+			{
+			case SIMDLevel::AVX2:
+				return UTF16_EncodeAll_AVX2(pSrc, pSrcEnd, pDst);
+			case SIMDLevel::SSE4_1:
+				return UTF16_EncodeAll_SSE4_1(pSrc, pSrcEnd, pDst);
+			default:
+				break;
+			}
+
+		# endif
+
+			UTF16_EncodeAll_Reference(pSrc, pSrcEnd, pDst);
+		}
+
+		size_t UTF16_EncodedLength(const char32* s, const size_t length) noexcept
+		{
+		# if SIV3D_UNICODE_SIMD
+
+			if (GetSIMDLevel() != SIMDLevel::None)
+			{
+				return UTF16_EncodedLength_SSE4_1(s, length);
+			}
+
+		# endif
+
+			return UTF16_EncodedLength_Reference(s, length);
+		}
+	}
+}
@@ -0,0 +1,66 @@
+﻿//-----------------------------------------------
+//
+//	This file is part of the Siv3D Engine.
+//
+//	Copyright (c) 2008-2022 Ryo Suzuki
+//	Copyright (c) 2016-2022 OpenSiv3D Project
+//
+//	Licensed under the MIT License.
+//
+//-----------------------------------------------
+
+# pragma once
+# include <Siv3D/Common.hpp>
+
+namespace s3d
+{
+	namespace detail
+	{
+		//
+		//	実行時に CPU の対応命令セット (AVX2 / SSE4.1) を調べて、最適な実装を使います。
+		//	いずれの実装も、スカラー版 (miniutf) と同じ結果を返します。
+		//
+
+		/// @brief 正しい UTF-8 であると仮定したときのコードポイントの数を返します。
+		/// @remark 継続バイト以外のバイトの数を返します。
+		[[nodiscard]]
+		size_t UTF8_CountCodePoints(const char8* s, size_t length) noexcept;
+
+		/// @brief UTF-8 を、最初の不正なシーケンスの手前まで UTF-32 に変換します。
+		/// @param pSrc 変換元の先頭
+		/// @param pSrcEnd 変換元の終端
+		/// @param pDst 書き込み先。書き込んだ分だけ進みます。
+		/// @return 変換を止めた位置。すべて変換できた場合は pSrcEnd
+		[[nodiscard]]
+		const char8* UTF8_DecodeValid(const char8* pSrc, const char8* pSrcEnd, char32*& pDst) noexcept;
+
+		/// @brief UTF-32 を UTF-8 に変換します。
+		/// @remark 書き込み先には UTF8_Length() のサイズが必要です。
+		void UTF8_EncodeAll(const char32* pSrc, const char32* pSrcEnd, char8* pDst) noexcept;
+
+		/// @brief UTF-32 を UTF-8 に変換したときのサイズを返します。
+		[[nodiscard]]
+		size_t UTF8_EncodedLength(const char32* s, size_t length) noexcept;
+
+		/// @brief 正しい UTF-16 であると仮定したときのコードポイントの数を返します。
+		/// @remark 下位サロゲート以外の要素の数を返します。
+		[[nodiscard]]
+		size_t UTF16_CountCodePoints(const char16* s, size_t length) noexcept;
+
+		/// @brief UTF-16 を、最初の不正なシーケンスの手前まで UTF-32 に変換します。
+		/// @param pSrc 変換元の先頭
+		/// @param pSrcEnd 変換元の終端
+		/// @param pDst 書き込み先。書き込んだ分だけ進みます。
+		/// @return 変換を止めた位置。すべて変換できた場合は pSrcEnd
+		[[nodiscard]]
+		const char16* UTF16_DecodeValid(const char16* pSrc, const char16* pSrcEnd, char32*& pDst) noexcept;
+
+		/// @brief UTF-32 を UTF-16 に変換します。
+		/// @remark 書き込み先には UTF16_Length() のサイズが必要です。
+		void UTF16_EncodeAll(const char32* pSrc, const char32* pSrcEnd, char16* pDst) noexcept;
+
+		/// @brief UTF-32 を UTF-16 に変換したときのサイズを返します。
+		[[nodiscard]]
+		size_t UTF16_EncodedLength(const char32* s, size_t length) noexcept;
+	}
+}
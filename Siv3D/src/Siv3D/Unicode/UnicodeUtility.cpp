@@ -11,6 +11,7 @@
 
 # include "UnicodeUtility.hpp"
 # include <ThirdParty/miniutf/miniutf.hpp>
+# include "UnicodeSIMD.hpp"
 
 namespace s3d
 {
@@ -68,17 +69,7 @@ namespace s3d
 
 		size_t UTF8_Length(const StringView s) noexcept
 		{
-			size_t result = 0;
-
-			const char32* pSrc = s.data();
-			const char32* const pSrcEnd = pSrc + s.size();
-
-			while (pSrc != pSrcEnd)
-			{
-				result += UTF8_Length(*pSrc++);
-			}
-
-			return result;
+			return UTF8_EncodedLength(s.data(), s.size());
 		}
 
 		void UTF8_Encode(char8** s, const char32 codePoint) noexcept
@@ -159,17 +150,7 @@ namespace s3d
 
 		size_t UTF16_Length(const StringView s) noexcept
 		{
-			size_t result = 0;
-
-			const char32* pSrc = s.data();
-			const char32* const pSrcEnd = pSrc + s.size();
-
-			while (pSrc != pSrcEnd)
-			{
-				result += UTF16_Length(*pSrc++);
-			}
-
-			return result;
+			return UTF16_EncodedLength(s.data(), s.size());
 		}
 
 		size_t UTF32_Length(const std::string_view s) noexcept
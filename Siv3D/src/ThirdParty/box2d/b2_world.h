@@ -31,6 +31,8 @@
 #include "b2_time_step.h"
 #include "b2_world_callbacks.h"
 
+#include <vector>
+
 struct b2AABB;
 struct b2BodyDef;
 struct b2Color;
@@ -66,6 +68,12 @@ public:
 	/// remain in scope.
 	void SetContactListener(b2ContactListener* listener);
 
+	/// [Siv3D] Register a callback that solves independent islands concurrently.
+	/// Islands that share a static body are solved on the same thread, in the
+	/// same order as the single-threaded solver, so the results do not depend on
+	/// the number of threads. Pass nullptr to solve on the calling thread.
+	void SetParallelForCallback(b2ParallelForCallback* callback);
+
 	/// Register a routine for debug drawing. The debug draw functions are called
 	/// inside with b2World::DebugDraw method. The debug draw object is owned
 	/// by you and must remain in scope.
@@ -224,6 +232,20 @@ private:
 	void Solve(const b2TimeStep& step);
 	void SolveTOI(const b2TimeStep& step);
 
+	// [Siv3D]
+	struct b2IslandRange
+	{
+		int32 bodyBegin, bodyCount;
+		int32 contactBegin, contactCount;
+		int32 jointBegin, jointCount;
+	};
+
+	// [Siv3D]
+	friend class b2IslandGroupTask;
+	void BuildIslands();
+	void SolveIslandGroups(const b2TimeStep& step, int32 begin, int32 end);
+	void SynchronizeMovedBodies();
+
 	void DrawShape(b2Fixture* shape, const b2Transform& xf, const b2Color& color);
 
 	b2BlockAllocator m_blockAllocator;
@@ -259,6 +281,17 @@ private:
 	bool m_stepComplete;
 
 	b2Profile m_profile;
+
+	// [Siv3D] Islands of the current step, grouped by shared static bodies.
+	b2ParallelForCallback* m_parallelForCallback;
+	std::vector<b2Body*> m_islandBodies;
+	std::vector<b2Contact*> m_islandContacts;
+	std::vector<b2Joint*> m_islandJoints;
+	std::vector<b2ContactImpulse> m_islandImpulses;
+	std::vector<b2IslandRange> m_islands;
+	std::vector<int32> m_islandGroupOf;
+	std::vector<int32> m_groupIslands;
+	std::vector<int32> m_groupOffsets;
 };
 
 inline b2Body* b2World::GetBodyList()
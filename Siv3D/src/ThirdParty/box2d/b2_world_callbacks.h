@@ -158,4 +158,31 @@ public:
 									const b2Vec2& normal, float fraction) = 0;
 };
 
+//-----------------------------------------------
+//
+//	[Siv3D]
+//
+/// A range of work items passed to b2ParallelForCallback.
+class B2_API b2ParallelForTask
+{
+public:
+	virtual ~b2ParallelForTask() {}
+
+	/// Process the items in [begin, end).
+	virtual void Run(int32 begin, int32 end) = 0;
+};
+
+/// Implement this to let b2World solve independent islands on multiple threads.
+class B2_API b2ParallelForCallback
+{
+public:
+	virtual ~b2ParallelForCallback() {}
+
+	/// Call task->Run() for disjoint ranges that cover [0, count). The ranges
+	/// may run concurrently. Must not return until every range has been processed.
+	virtual void ParallelFor(int32 count, b2ParallelForTask* task) = 0;
+};
+//
+//-----------------------------------------------
+
 #endif
@@ -38,6 +38,7 @@
 #include "box2d/b2_timer.h"
 #include "box2d/b2_world.h"
 
+#include <memory>
 #include <new>
 
 b2World::b2World(const b2Vec2& gravity)
@@ -58,6 +59,8 @@ b2World::b2World(const b2Vec2& gravity)
 	m_stepComplete = true;
 
 	m_allowSleep = true;
+
+	m_parallelForCallback = nullptr;
 	m_gravity = gravity;
 
 	m_newContacts = false;
@@ -107,6 +110,11 @@ void b2World::SetContactListener(b2ContactListener* listener)
 	m_contactManager.m_contactListener = listener;
 }
 
+void b2World::SetParallelForCallback(b2ParallelForCallback* callback)
+{
+	m_parallelForCallback = callback;
+}
+
 void b2World::SetDebugDraw(b2Draw* debugDraw)
 {
 	m_debugDraw = debugDraw;
@@ -391,12 +399,68 @@ void b2World::SetAllowSleeping(bool flag)
 }
 
 // Find islands, integrate and solve constraints, solve position constraints
+// [Siv3D] Records the impulses reported by b2Island, so that they can be
+// reported to the user's listener from the calling thread.
+class b2ImpulseRecorder : public b2ContactListener
+{
+public:
+	explicit b2ImpulseRecorder(b2ContactImpulse* impulses)
+		: m_impulses(impulses) {}
+
+	void PostSolve(b2Contact* contact, const b2ContactImpulse* impulse) override
+	{
+		B2_NOT_USED(contact);
+		*m_impulses++ = *impulse;
+	}
+
+private:
+	b2ContactImpulse* m_impulses;
+};
+
+class b2IslandGroupTask : public b2ParallelForTask
+{
+public:
+	b2IslandGroupTask(b2World* world, const b2TimeStep& step)
+		: m_world(world)
+		, m_step(step) {}
+
+	void Run(int32 begin, int32 end) override
+	{
+		m_world->SolveIslandGroups(m_step, begin, end);
+	}
+
+private:
+	b2World* m_world;
+	const b2TimeStep& m_step;
+};
+
 void b2World::Solve(const b2TimeStep& step)
 {
 	m_profile.solveInit = 0.0f;
 	m_profile.solveVelocity = 0.0f;
 	m_profile.solvePosition = 0.0f;
 
+	// [Siv3D]
+	if (m_parallelForCallback)
+	{
+		BuildIslands();
+
+		b2IslandGroupTask task(this, step);
+		m_parallelForCallback->ParallelFor(int32(m_groupOffsets.size() - 1), &task);
+
+		// Report in the same order as the single-threaded solver.
+		if (b2ContactListener* listener = m_contactManager.m_contactListener)
+		{
+			for (size_t i = 0; i < m_islandContacts.size(); ++i)
+			{
+				listener->PostSolve(m_islandContacts[i], &m_islandImpulses[i]);
+			}
+		}
+
+		SynchronizeMovedBodies();
+		return;
+	}
+
 	// Size the island for the worst case.
 	b2Island island(m_bodyCount,
 					m_contactManager.m_contactCount,
@@ -555,6 +619,11 @@ void b2World::Solve(const b2TimeStep& step)
 
 	m_stackAllocator.Free(stack);
 
+	SynchronizeMovedBodies();
+}
+
+void b2World::SynchronizeMovedBodies()
+{
 	{
 		b2Timer timer;
 		// Synchronize fixtures, check for out of range bodies.
@@ -581,6 +650,278 @@ void b2World::Solve(const b2TimeStep& step)
 	}
 }
 
+//-----------------------------------------------
+//
+//	[Siv3D]
+//
+// Build all awake islands without solving them, then group the islands that
+// share a static body. Static bodies are written by every island that contains
+// them (m_islandIndex and the state write-back), so such islands must be solved
+// on the same thread.
+void b2World::BuildIslands()
+{
+	m_islandBodies.clear();
+	m_islandContacts.clear();
+	m_islandJoints.clear();
+	m_islands.clear();
+	m_islandGroupOf.clear();
+
+	// Clear all the island flags. The island index of a static body records
+	// the first island that reached it.
+	for (b2Body* b = m_bodyList; b; b = b->m_next)
+	{
+		b->m_flags &= ~b2Body::e_islandFlag;
+		b->m_islandIndex = -1;
+	}
+	for (b2Contact* c = m_contactManager.m_contactList; c; c = c->m_next)
+	{
+		c->m_flags &= ~b2Contact::e_islandFlag;
+	}
+	for (b2Joint* j = m_jointList; j; j = j->m_next)
+	{
+		j->m_islandFlag = false;
+	}
+
+	// Union-find over the islands. The root of a group is its smallest island.
+	std::vector<int32>& parents = m_islandGroupOf;
+	auto findRoot = [&parents](int32 i)
+	{
+		while (parents[i] != i)
+		{
+			parents[i] = parents[parents[i]];
+			i = parents[i];
+		}
+		return i;
+	};
+
+	int32 stackSize = m_bodyCount;
+	b2Body** stack = (b2Body**)m_stackAllocator.Allocate(stackSize * sizeof(b2Body*));
+	for (b2Body* seed = m_bodyList; seed; seed = seed->m_next)
+	{
+		if (seed->m_flags & b2Body::e_islandFlag)
+		{
+			continue;
+		}
+
+		if (seed->IsAwake() == false || seed->IsEnabled() == false)
+		{
+			continue;
+		}
+
+		// The seed can be dynamic or kinematic.
+		if (seed->GetType() == b2_staticBody)
+		{
+			continue;
+		}
+
+		const int32 islandIndex = int32(m_islands.size());
+		b2IslandRange range;
+		range.bodyBegin = int32(m_islandBodies.size());
+		range.contactBegin = int32(m_islandContacts.size());
+		range.jointBegin = int32(m_islandJoints.size());
+		parents.push_back(islandIndex);
+
+		int32 stackCount = 0;
+		stack[stackCount++] = seed;
+		seed->m_flags |= b2Body::e_islandFlag;
+
+		// Perform a depth first search (DFS) on the constraint graph, in the
+		// same order as Solve().
+		while (stackCount > 0)
+		{
+			b2Body* b = stack[--stackCount];
+			b2Assert(b->IsEnabled() == true);
+			m_islandBodies.push_back(b);
+
+			if (b->GetType() == b2_staticBody)
+			{
+				if (b->m_islandIndex < 0)
+				{
+					b->m_islandIndex = islandIndex;
+				}
+				else
+				{
+					const int32 rootA = findRoot(b->m_islandIndex);
+					const int32 rootB = findRoot(islandIndex);
+					parents[b2Max(rootA, rootB)] = b2Min(rootA, rootB);
+				}
+
+				continue;
+			}
+
+			// Make sure the body is awake (without resetting sleep timer).
+			b->m_flags |= b2Body::e_awakeFlag;
+
+			for (b2ContactEdge* ce = b->m_contactList; ce; ce = ce->next)
+			{
+				b2Contact* contact = ce->contact;
+
+				if (contact->m_flags & b2Contact::e_islandFlag)
+				{
+					continue;
+				}
+
+				if (contact->IsEnabled() == false ||
+					contact->IsTouching() == false)
+				{
+					continue;
+				}
+
+				if (contact->m_fixtureA->m_isSensor || contact->m_fixtureB->m_isSensor)
+				{
+					continue;
+				}
+
+				m_islandContacts.push_back(contact);
+				contact->m_flags |= b2Contact::e_islandFlag;
+
+				b2Body* other = ce->other;
+
+				if (other->m_flags & b2Body::e_islandFlag)
+				{
+					continue;
+				}
+
+				b2Assert(stackCount < stackSize);
+				stack[stackCount++] = other;
+				other->m_flags |= b2Body::e_islandFlag;
+			}
+
+			for (b2JointEdge* je = b->m_jointList; je; je = je->next)
+			{
+				if (je->joint->m_islandFlag == true)
+				{
+					continue;
+				}
+
+				b2Body* other = je->other;
+
+				if (other->IsEnabled() == false)
+				{
+					continue;
+				}
+
+				m_islandJoints.push_back(je->joint);
+				je->joint->m_islandFlag = true;
+
+				if (other->m_flags & b2Body::e_islandFlag)
+				{
+					continue;
+				}
+
+				b2Assert(stackCount < stackSize);
+				stack[stackCount++] = other;
+				other->m_flags |= b2Body::e_islandFlag;
+			}
+		}
+
+		range.bodyCount = int32(m_islandBodies.size()) - range.bodyBegin;
+		range.contactCount = int32(m_islandContacts.size()) - range.contactBegin;
+		range.jointCount = int32(m_islandJoints.size()) - range.jointBegin;
+		m_islands.push_back(range);
+
+		// Allow static bodies to participate in other islands.
+		for (int32 i = range.bodyBegin; i < range.bodyBegin + range.bodyCount; ++i)
+		{
+			b2Body* b = m_islandBodies[i];
+			if (b->GetType() == b2_staticBody)
+			{
+				b->m_flags &= ~b2Body::e_islandFlag;
+			}
+		}
+	}
+	m_stackAllocator.Free(stack);
+
+	// Number the groups in the order of their first island. A root is never
+	// larger than its members, so the group ids can overwrite the parents.
+	const int32 islandCount = int32(m_islands.size());
+	for (int32 i = 0; i < islandCount; ++i)
+	{
+		parents[i] = findRoot(i);
+	}
+
+	int32 groupCount = 0;
+	for (int32 i = 0; i < islandCount; ++i)
+	{
+		const int32 root = parents[i];
+		parents[i] = (root == i) ? groupCount++ : parents[root];
+	}
+
+	// List the islands of each group in island order.
+	m_groupOffsets.assign(groupCount + 1, 0);
+	for (int32 i = 0; i < islandCount; ++i)
+	{
+		++m_groupOffsets[m_islandGroupOf[i] + 1];
+	}
+	for (int32 g = 0; g < groupCount; ++g)
+	{
+		m_groupOffsets[g + 1] += m_groupOffsets[g];
+	}
+
+	m_groupIslands.resize(islandCount);
+	for (int32 i = 0; i < islandCount; ++i)
+	{
+		m_groupIslands[m_groupOffsets[m_islandGroupOf[i]]++] = i;
+	}
+	for (int32 g = groupCount; g > 0; --g)
+	{
+		m_groupOffsets[g] = m_groupOffsets[g - 1];
+	}
+	m_groupOffsets[0] = 0;
+
+	m_islandImpulses.resize(m_islandContacts.size());
+}
+
+// [Siv3D] b2StackAllocator is not thread-safe, and at over 100 KB it is too
+// large for the stack of a worker thread. Each thread keeps one on the heap and
+// reuses it; every island frees its allocations before the next one starts.
+static b2StackAllocator& b2GetThreadStackAllocator()
+{
+	thread_local std::unique_ptr<b2StackAllocator> allocator;
+
+	if (allocator == nullptr)
+	{
+		allocator = std::make_unique<b2StackAllocator>();
+	}
+
+	return *allocator;
+}
+
+void b2World::SolveIslandGroups(const b2TimeStep& step, int32 begin, int32 end)
+{
+	b2StackAllocator& allocator = b2GetThreadStackAllocator();
+
+	for (int32 g = begin; g < end; ++g)
+	{
+		for (int32 k = m_groupOffsets[g]; k < m_groupOffsets[g + 1]; ++k)
+		{
+			const b2IslandRange& range = m_islands[m_groupIslands[k]];
+
+			// PostSolve is reported by Solve() after all the groups have been solved.
+			b2ImpulseRecorder recorder(m_islandImpulses.data() + range.contactBegin);
+			b2Island island(range.bodyCount, range.contactCount, range.jointCount, &allocator, &recorder);
+
+			for (int32 i = 0; i < range.bodyCount; ++i)
+			{
+				island.Add(m_islandBodies[range.bodyBegin + i]);
+			}
+			for (int32 i = 0; i < range.contactCount; ++i)
+			{
+				island.Add(m_islandContacts[range.contactBegin + i]);
+			}
+			for (int32 i = 0; i < range.jointCount; ++i)
+			{
+				island.Add(m_islandJoints[range.jointBegin + i]);
+			}
+
+			b2Profile profile;
+			island.Solve(&profile, step, m_gravity, m_allowSleep);
+		}
+	}
+}
+//
+//-----------------------------------------------
+
 // Find TOI contacts and solve them.
 void b2World::SolveTOI(const b2TimeStep& step)
 {
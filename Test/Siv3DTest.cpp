@@ -15,6 +15,21 @@
 
 void Siv3DTest()
 {
+# if not SIV3D_PLATFORM(WEB)
+
+	// 終了時の処理を確かめるテストは、このプログラムを子プロセスとして起動する
+	if (const Array<String>& args = System::GetCommandLineArgs();
+		args.includes(U"--logger-shutdown"))
+	{
+		return Siv3DTestChild_LoggerShutdown();
+	}
+	else if (args.includes(U"--screencapture-shutdown"))
+	{
+		return Siv3DTestChild_ScreenCaptureShutdown();
+	}
+
+# endif
+
 	Console.open();
 	
 	{
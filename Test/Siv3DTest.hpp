@@ -17,4 +17,8 @@
 using namespace s3d;
 using namespace std::literals;
 
+// 終了時の処理を確かめるテストが、このプログラムを子プロセスとして起動したときに実行する関数
+void Siv3DTestChild_LoggerShutdown();
+void Siv3DTestChild_ScreenCaptureShutdown();
+
 //# define SIV3D_RUN_BENCHMARK
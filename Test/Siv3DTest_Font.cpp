@@ -0,0 +1,240 @@
+﻿//-----------------------------------------------
+//
+//	This file is part of the Siv3D Engine.
+//
+//	Copyright (c) 2008-2022 Ryo Suzuki
+//	Copyright (c) 2016-2022 OpenSiv3D Project
+//
+//	Licensed under the MIT License.
+//
+//-----------------------------------------------
+
+# include "Siv3DTest.hpp"
+
+TEST_CASE("Font::getGlyphClusters()")
+{
+	const Font font{ 20 };
+	const String text = U"Siv3D \U0001F600 HP: 100/100";
+
+	const Array<GlyphCluster> clusters0 = font.getGlyphClusters(text);
+	const Array<GlyphCluster> clusters1 = font.getGlyphClusters(text);
+
+	// 2 回目はキャッシュした結果を返す
+	REQUIRE(clusters0.size() == clusters1.size());
+	REQUIRE(clusters0.map([](const GlyphCluster& g) { return g.glyphIndex; }) == clusters1.map([](const GlyphCluster& g) { return g.glyphIndex; }));
+	REQUIRE(font.getGlyphClusters(U"Siv3D", UseFallback::No, Ligature::No).size() == 5);
+
+	const size_t emojiIndex = 6;
+	REQUIRE(clusters0[emojiIndex].glyphIndex == 0);
+
+	{
+		const Font emojiFont{ 20, Typeface::ColorEmoji };
+		REQUIRE(font.addFallback(emojiFont));
+
+		// フォールバックフォントを追加すると、以前の結果は使われない
+		const Array<GlyphCluster> clusters2 = font.getGlyphClusters(text);
+		REQUIRE(clusters2[emojiIndex].glyphIndex != 0);
+		REQUIRE(clusters2[emojiIndex].fontIndex == 1);
+
+		// フォールバックを使わない場合の結果は変わらない
+		REQUIRE(font.getGlyphClusters(text, UseFallback::No)[emojiIndex].fontIndex == 0);
+	}
+
+	// フォールバックフォントが解放されると、以前の結果は使われない
+	REQUIRE(font.getGlyphClusters(text)[emojiIndex].fontIndex == 0);
+}
+
+TEST_CASE("Font::setGlyphCacheMemoryBudget()")
+{
+	const Font font{ 32 };
+	REQUIRE(font.getGlyphCacheMemoryBudget() == (64 * 1024 * 1024));
+
+	font.setGlyphCacheMemoryBudget(1024 * 1024);
+	REQUIRE(font.getGlyphCacheMemoryBudget() == (1024 * 1024));
+
+	String text;
+
+	for (char32 ch = U'\u4E00'; ch < U'\u4E00' + 2000; ++ch)
+	{
+		text << ch;
+	}
+
+	// 同じフレームで使うグリフは追い出されないため、上限を超えてもキャッシュできる
+	REQUIRE(font.preload(text));
+}
+
+TEST_CASE("Font : .notdef is not evicted")
+{
+	// 余白を大きくして、1 ページに数個のグリフしか入らないようにする
+	const Font font{ FontMethod::SDF, 16 };
+	font.setBufferThickness(200);
+	font.setGlyphCacheMemoryBudget(1);
+
+	REQUIRE(System::Update());
+
+	// フォントに無い文字は .notdef で描かれる
+	const Glyph notdef = font.getGlyph(U'\U0010FFFF');
+	REQUIRE(notdef.glyphIndex == 0);
+
+	// 以降のフレームでは、古いページが再利用される
+	for (const StringView text : { U"ABCDEFGHIJKL", U"MNOPQRSTUVWX" })
+	{
+		REQUIRE(System::Update());
+		REQUIRE(font.preload(text));
+	}
+
+	const Glyph glyph = font.getGlyph(U'\U0010FFFF');
+	REQUIRE(glyph.texture.size == notdef.texture.size);
+
+	if (System::GetRendererType() != EngineOption::Renderer::Headless)
+	{
+		// .notdef のページは再利用されず、同じ場所に残っている
+		REQUIRE(glyph.texture.uvRect.left == notdef.texture.uvRect.left);
+		REQUIRE(glyph.texture.uvRect.top == notdef.texture.uvRect.top);
+	}
+}
+
+TEST_CASE("Font::preloadAsync()")
+{
+	const String text = U"OpenSiv3D \u3042\u3044\u3046";
+	const RectF region = Font{ FontMethod::MSDF, 40 }(text).region();
+
+	const Font font{ FontMethod::MSDF, 40 };
+	REQUIRE(font.preloadAsync(text));
+
+	// 生成中のグリフがあっても、文字の幅は同じように計算できる
+	REQUIRE(font(text).region() == region);
+
+	// preload() は生成中のグリフを待つ
+	REQUIRE(font.preload(text));
+	REQUIRE(font.getGlyph(U'O').texture.size.x > 0);
+}
+
+TEST_CASE("Font::preloadAsync() : full atlas")
+{
+	// 余白を大きくして、1 ページに数個のグリフしか入らないようにする
+	const Font font{ FontMethod::SDF, 16 };
+	font.setBufferThickness(200);
+	font.setGlyphCacheMemoryBudget(1);
+
+	REQUIRE(System::Update());
+
+	// 同じフレームで使ったページは再利用できないため、ページ数の上限に達するとグリフを追加できない
+	REQUIRE(not font.preload(U"ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789"));
+
+	// 生成が完了しても追加できなかったグリフは、画像の無いまま残らない
+	REQUIRE(font.preloadAsync(U"?"));
+	REQUIRE(font.getGlyph(U'?').texture.size.x == 0);
+
+	// 次のフレームでは、古いページを再利用して追加できる
+	REQUIRE(System::Update());
+	REQUIRE(font.getGlyph(U'?').texture.size.x > 0);
+}
+
+TEST_CASE("Font : glyph cache file")
+{
+	const String text = U"OpenSiv3D \u3042\u3044\u3046";
+	Array<Float2> sizes;
+	Array<double> xAdvances;
+
+	{
+		const Font font{ FontMethod::SDF, 37 };
+		REQUIRE(font.preload(text));
+
+		for (const auto& glyph : font.getGlyphs(text))
+		{
+			sizes << glyph.texture.size;
+			xAdvances << glyph.xAdvance;
+		}
+
+		// 以前の実行で書き込んだキャッシュファイルを読み込んでいた場合は、変更が無いため書き込まない
+		font.saveGlyphCache();
+
+		// 変更が無ければ書き込まない
+		REQUIRE(not font.saveGlyphCache());
+	}
+
+	// 前回のフォントが書き込んだキャッシュファイルから、同じグリフを読み込む
+	const Font font{ FontMethod::SDF, 37 };
+	REQUIRE(font.getGlyphs(text).map([](const Glyph& glyph) { return glyph.texture.size; }) == sizes);
+	REQUIRE(font.getGlyphs(text).map([](const Glyph& glyph) { return glyph.xAdvance; }) == xAdvances);
+}
+
+TEST_CASE("PreparedText")
+{
+	const Font font{ 24 };
+
+	// 途中でアトラスが変わると、すべてのクラスタを配置し直すため、先にグリフをキャッシュしておく
+	REQUIRE(font.preload(U"Score: 0123456789HP"));
+
+	PreparedText prepared = font(U"Score: 100").prepare();
+	REQUIRE(prepared.text() == U"Score: 100");
+	REQUIRE(prepared.region().w == Approx(font(U"Score: 100").region().w).margin(0.01));
+	REQUIRE(prepared.region(48).h == Approx(font(U"Score: 100").region(48).h));
+	REQUIRE(0 < prepared.memoryUsage());
+
+	// 末尾だけが変わった場合は、変わったクラスタだけを配置し直す
+	prepared.setText(U"Score: 105");
+	REQUIRE(prepared.num_relayoutClusters() == 1);
+	REQUIRE(prepared.region().w == Approx(font(U"Score: 105").region().w).margin(0.01));
+
+	prepared.append(U"\nHP: 20");
+	REQUIRE(prepared.num_relayoutClusters() == 7);
+	REQUIRE(prepared.region().h == Approx(font(U"Score: 105\nHP: 20").region().h));
+
+	prepared.setText(U"");
+	REQUIRE(prepared.isEmpty());
+	REQUIRE(prepared.num_glyphs() == 0);
+	REQUIRE(prepared.region().w == 0.0);
+}
+
+# if defined(SIV3D_RUN_BENCHMARK)
+
+TEST_CASE("Font : benchmark")
+{
+	const Font font{ 20 };
+	Array<String> labels;
+
+	for (int32 i = 0; i < 64; ++i)
+	{
+		labels << U"Score: {} / HP: {}"_fmt((i * 1234), (100 - i));
+	}
+
+	// 毎フレーム同じラベルを描く場合
+	BENCHMARK("getGlyphClusters | 64 labels")
+	{
+		size_t count = 0;
+
+		for (const auto& label : labels)
+		{
+			count += font.getGlyphClusters(label).size();
+		}
+
+		return count;
+	};
+
+	const Array<DrawableText> texts = labels.map([&](const String& label) { return font(label); });
+	const Array<PreparedText> preparedTexts = texts.map([](const DrawableText& text) { return text.prepare(); });
+
+	BENCHMARK("DrawableText::draw | 64 labels")
+	{
+		for (const auto& text : texts)
+		{
+			text.draw(20, 20);
+		}
+
+		Graphics2D::Flush();
+	};
+
+	BENCHMARK("PreparedText::draw | 64 labels")
+	{
+		for (const auto& text : preparedTexts)
+		{
+			text.draw(20, 20);
+		}
+
+		Graphics2D::Flush();
+	};
+}
+
+# endif
@@ -200,4 +200,200 @@ TEST_CASE("Image")
 			}
 		}
 	}
+	SECTION("Decoder PNG (scaled)")
+	{
+		const FilePathView path = U"test/image/png/3x3.png";
+
+		{
+			// 拡大はしない
+			const Image image = ImageDecoder::DecodeScaled(path, Size(16, 16));
+			REQUIRE(image.size() == Size(3, 3));
+			REQUIRE(image[2][2] == Color(111, 0, 222));
+		}
+
+		{
+			// 3x3 ピクセルの平均
+			const Image image = ImageDecoder::DecodeScaled(path, Size(1, 1));
+			REQUIRE(image.size() == Size(1, 1));
+			REQUIRE(image[0][0] == Color(44, 52, 59));
+		}
+
+		{
+			const Image image = ImageDecoder::DecodeScaled(path, Size(2, 5));
+			REQUIRE(image.size() == Size(2, 2));
+		}
+
+		REQUIRE(ImageDecoder::DecodeScaled(path, Size(0, 0)).isEmpty());
+	}
+
+	SECTION("Decoder PNG (region)")
+	{
+		const FilePathView path = U"test/image/png/3x3.png";
+
+		{
+			const Image image = ImageDecoder::DecodeRegion(path, Rect(1, 2, 2, 1));
+			REQUIRE(image.size() == Size(2, 1));
+			REQUIRE(image[0][0] == Color(0, 222, 111));
+			REQUIRE(image[0][1] == Color(111, 0, 222));
+		}
+
+		{
+			// 画像の範囲外の部分は含まない
+			const Image image = ImageDecoder::DecodeRegion(path, Rect(-1, 1, 3, 8));
+			REQUIRE(image.size() == Size(2, 2));
+			REQUIRE(image[0][0] == Color(11, 22, 33));
+			REQUIRE(image[1][0] == Color(222, 111, 0));
+			REQUIRE(image[1][1] == Color(0, 222, 111));
+		}
+
+		REQUIRE(ImageDecoder::DecodeRegion(path, Rect(3, 3, 1, 1)).isEmpty());
+	}
+
+	// 2 つの画像の各チャンネルの差の最大値と平均値
+	const auto compare = [](const Image& a, const Image& b)
+	{
+		int32 maxDiff = 0;
+		double sumDiff = 0.0;
+
+		for (int32 y = 0; y < a.height(); ++y)
+		{
+			for (int32 x = 0; x < a.width(); ++x)
+			{
+				const Color ca = a[y][x], cb = b[y][x];
+
+				for (const int32 diff : { Abs(ca.r - cb.r), Abs(ca.g - cb.g), Abs(ca.b - cb.b), Abs(ca.a - cb.a) })
+				{
+					maxDiff = Max(maxDiff, diff);
+					sumDiff += diff;
+				}
+			}
+		}
+
+		return std::pair{ maxDiff, (sumDiff / (a.num_pixels() * 4)) };
+	};
+
+	SECTION("Decoder JPEG (scaled)")
+	{
+		// 4:2:0 の 100x75 ピクセルの画像（MCU の大きさは 16x16）
+		const FilePathView path = U"test/image/jpg/100x75.jpg";
+		const Image full = ImageDecoder::Decode(path);
+		REQUIRE(full.size() == Size(100, 75));
+
+		{
+			// 拡大はしない
+			const Image image = ImageDecoder::DecodeScaled(path, Size(200, 200));
+			REQUIRE(image.size() == full.size());
+			REQUIRE(compare(image, full).first == 0);
+		}
+
+		// DCT スケーリングで 1/2 または 1/4 の大きさにデコードしてから縮小する
+		for (const Size targetSize : { Size(40, 40), Size(50, 50), Size(25, 25) })
+		{
+			const Image expected = full.fitted(targetSize, AllowScaleUp::No);
+			const Image image = ImageDecoder::DecodeScaled(path, targetSize);
+			REQUIRE(image.size() == expected.size());
+
+			const auto [maxDiff, meanDiff] = compare(image, expected);
+			REQUIRE(maxDiff <= 16);
+			REQUIRE(meanDiff < 3.0);
+		}
+
+		{
+			BinaryReader reader{ path };
+			REQUIRE(ImageDecoder::DecodeScaled(reader, Size(40, 40)).size() == Size(40, 30));
+		}
+
+		REQUIRE(ImageDecoder::DecodeScaled(path, Size(0, 0)).isEmpty());
+	}
+
+	SECTION("Decoder JPEG (region)")
+	{
+		const FilePathView path = U"test/image/jpg/100x75.jpg";
+		const Image full = ImageDecoder::Decode(path);
+
+		{
+			// 画像全体は、そのままデコードした結果と一致する
+			const Image image = ImageDecoder::DecodeRegion(path, Rect(0, 0, 100, 75));
+			REQUIRE(image.size() == full.size());
+			REQUIRE(compare(image, full).first == 0);
+		}
+
+		// MCU の境界に揃っていない領域。色差の補間が切り出しの端の影響を受けるため、わずかな差を許容する
+		for (const Rect region : { Rect(13, 21, 30, 17), Rect(16, 32, 32, 16), Rect(97, 70, 3, 5), Rect(1, 1, 1, 1) })
+		{
+			const Image expected = full.clipped(region);
+			const Image image = ImageDecoder::DecodeRegion(path, region);
+			REQUIRE(image.size() == region.size);
+
+			const auto [maxDiff, meanDiff] = compare(image, expected);
+			REQUIRE(maxDiff <= 8);
+			REQUIRE(meanDiff < 2.0);
+		}
+
+		{
+			// 画像の範囲外の部分は含まない
+			const Image image = ImageDecoder::DecodeRegion(path, Rect(90, -5, 20, 20));
+			REQUIRE(image.size() == Size(10, 15));
+			REQUIRE(compare(image, full.clipped(90, 0, 10, 15)).first <= 8);
+		}
+
+		{
+			BinaryReader reader{ path };
+			REQUIRE(ImageDecoder::DecodeRegion(reader, Rect(13, 21, 30, 17)).size() == Size(30, 17));
+		}
+
+		REQUIRE(ImageDecoder::DecodeRegion(path, Rect(100, 0, 10, 10)).isEmpty());
+	}
 }
+
+TEST_CASE("Image : PNG encoder")
+{
+	// 複数の帯に分割される大きさを含む
+	for (const Size size : { Size{ 1, 1 }, Size{ 37, 5 }, Size{ 1024, 1100 } })
+	{
+		Image image{ size };
+
+		for (int32 y = 0; y < image.height(); ++y)
+		{
+			for (int32 x = 0; x < image.width(); ++x)
+			{
+				image[y][x] = Color(static_cast<uint8>(x * 3 + y), static_cast<uint8>(x ^ y), static_cast<uint8>(x * y), static_cast<uint8>(255 - (y & 63)));
+			}
+		}
+
+		for (const auto compression : { PNGCompression::Store, PNGCompression::Fastest, PNGCompression::Fast, PNGCompression::Default, PNGCompression::Best })
+		{
+			for (const auto filter : { PNGFilter::Default, PNGFilter::None_, PNGFilter::Paeth })
+			{
+				const Image decoded{ MemoryReader{ image.encodePNG(filter, compression) } };
+				REQUIRE(decoded.size() == image.size());
+				REQUIRE(std::equal(decoded.begin(), decoded.end(), image.begin()));
+			}
+		}
+	}
+}
+
+# if defined(SIV3D_RUN_BENCHMARK)
+
+TEST_CASE("Image : PNG encoder benchmark")
+{
+	Image image{ 3840, 2160 };
+
+	for (int32 y = 0; y < image.height(); ++y)
+	{
+		for (int32 x = 0; x < image.width(); ++x)
+		{
+			image[y][x] = HSV{ (x * 0.1 + y * 0.05), 0.5, 0.9 };
+		}
+	}
+
+	for (const auto compression : { PNGCompression::Store, PNGCompression::Fastest, PNGCompression::Fast, PNGCompression::Default, PNGCompression::Best })
+	{
+		BENCHMARK(U"Image::encodePNG() | 3840x2160 {}"_fmt(FromEnum(compression)).narrow())
+		{
+			return image.encodePNG(PNGEncoder::DefaultFilter, compression).size();
+		};
+	}
+}
+
+# endif
@@ -0,0 +1,125 @@
+﻿//-----------------------------------------------
+//
+//	This file is part of the Siv3D Engine.
+//
+//	Copyright (c) 2008-2022 Ryo Suzuki
+//	Copyright (c) 2016-2022 OpenSiv3D Project
+//
+//	Licensed under the MIT License.
+//
+//-----------------------------------------------
+
+# include "Siv3DTest.hpp"
+
+TEST_CASE("ImageProcessing::GenerateMips()")
+{
+	SECTION("Size")
+	{
+		const Image image{ 37, 10, Palette::White };
+		const Array<Image> mips = ImageProcessing::GenerateMips(image);
+		REQUIRE(ImageProcessing::CalculateMipCount(37, 10) == 4);
+		REQUIRE(mips.size() == 3);
+		REQUIRE(mips[0].size() == Size(18, 5));
+		REQUIRE(mips[1].size() == Size(9, 2));
+		REQUIRE(mips[2].size() == Size(4, 1));
+
+		REQUIRE(ImageProcessing::GenerateMips(image, 2).size() == 2);
+		REQUIRE(ImageProcessing::GenerateMips(Image{ 1, 1 }).isEmpty());
+	}
+
+	SECTION("Box filter")
+	{
+		// SIMD で処理される幅と、端数の幅の両方を含む
+		Image image{ 22, 4 };
+
+		for (int32 y = 0; y < image.height(); ++y)
+		{
+			for (int32 x = 0; x < image.width(); ++x)
+			{
+				image[y][x] = Color(static_cast<uint8>(x * 11), static_cast<uint8>(y * 60), static_cast<uint8>(x * y), static_cast<uint8>(255 - x));
+			}
+		}
+
+		const Image mip = ImageProcessing::GenerateMips(image, 1).front();
+		REQUIRE(mip.size() == Size(11, 2));
+
+		for (int32 y = 0; y < mip.height(); ++y)
+		{
+			for (int32 x = 0; x < mip.width(); ++x)
+			{
+				const Color c0 = image[y * 2][x * 2], c1 = image[y * 2][x * 2 + 1];
+				const Color c2 = image[y * 2 + 1][x * 2], c3 = image[y * 2 + 1][x * 2 + 1];
+				REQUIRE(mip[y][x].r == ((c0.r + c1.r + c2.r + c3.r + 2) / 4));
+				REQUIRE(mip[y][x].g == ((c0.g + c1.g + c2.g + c3.g + 2) / 4));
+				REQUIRE(mip[y][x].b == ((c0.b + c1.b + c2.b + c3.b + 2) / 4));
+				REQUIRE(mip[y][x].a == ((c0.a + c1.a + c2.a + c3.a + 2) / 4));
+			}
+		}
+	}
+
+	SECTION("sRGB")
+	{
+		// 白と黒の市松模様は、線形な色空間で平均すると 50% のグレー (sRGB で 188) になる
+		Image image{ 64, 64 };
+
+		for (int32 y = 0; y < image.height(); ++y)
+		{
+			for (int32 x = 0; x < image.width(); ++x)
+			{
+				image[y][x] = (((x + y) % 2) ? Palette::White : Palette::Black);
+			}
+		}
+
+		const Image linear = ImageProcessing::GenerateMips(image, 1, IsSRGB::No).front();
+		const Image srgb = ImageProcessing::GenerateMips(image, 1, IsSRGB::Yes).front();
+		REQUIRE(linear[0][0] == Color(128, 128, 128, 255));
+		REQUIRE(InRange<int32>(srgb[0][0].r, 187, 189));
+		REQUIRE(srgb[0][0].a == 255);
+	}
+
+	SECTION("Parallel")
+	{
+		// 行を分割して並列に処理しても、結果は変わらない
+		Image image{ 1024, 1024 };
+
+		for (int32 y = 0; y < image.height(); ++y)
+		{
+			for (int32 x = 0; x < image.width(); ++x)
+			{
+				image[y][x] = Color(static_cast<uint8>(x ^ y), static_cast<uint8>(x), static_cast<uint8>(y), 255);
+			}
+		}
+
+		const Image mip = ImageProcessing::GenerateMips(image, 1).front();
+		REQUIRE(mip.size() == Size(512, 512));
+
+		for (const Point pos : { Point{ 0, 0 }, Point{ 3, 200 }, Point{ 511, 511 }, Point{ 255, 17 } })
+		{
+			const Color c0 = image[pos.y * 2][pos.x * 2], c1 = image[pos.y * 2][pos.x * 2 + 1];
+			const Color c2 = image[pos.y * 2 + 1][pos.x * 2], c3 = image[pos.y * 2 + 1][pos.x * 2 + 1];
+			REQUIRE(mip[pos].r == ((c0.r + c1.r + c2.r + c3.r + 2) / 4));
+		}
+	}
+}
+
+# if defined(SIV3D_RUN_BENCHMARK)
+
+TEST_CASE("ImageProcessing::GenerateMips() : benchmark")
+{
+	for (const Size size : { Size{ 3840, 2160 }, Size{ 7680, 4320 } })
+	{
+		const Image image{ size, Palette::Skyblue };
+
+		BENCHMARK(U"ImageProcessing::GenerateMips() | {}x{}"_fmt(size.x, size.y).narrow())
+		{
+			return ImageProcessing::GenerateMips(image).size();
+		};
+
+		BENCHMARK(U"ImageProcessing::GenerateMips() | {}x{} sRGB"_fmt(size.x, size.y).narrow())
+		{
+			return ImageProcessing::GenerateMips(image, Largest<size_t>, IsSRGB::Yes).size();
+		};
+	}
+}
+
+# endif
@@ -0,0 +1,256 @@
+﻿//-----------------------------------------------
+//
+//	This file is part of the Siv3D Engine.
+//
+//	Copyright (c) 2008-2022 Ryo Suzuki
+//	Copyright (c) 2016-2022 OpenSiv3D Project
+//
+//	Licensed under the MIT License.
+//
+//-----------------------------------------------
+
+
+# include "Siv3DTest.hpp"
+
+SIV3D_DISABLE_MSVC_WARNINGS_PUSH(4566)
+
+namespace
+{
+	void WriteBytes(const FilePath& path, const std::string& bytes)
+	{
+		BinaryWriter writer{ path };
+		writer.write(bytes.data(), static_cast<int64>(bytes.size()));
+	}
+}
+
+TEST_CASE("JSON::Parse()")
+{
+	SECTION("Basic")
+	{
+		const JSON json = JSON::Parse(U"{ \"name\": \"Siv3D\", \"values\": [1, 2, 3] }");
+		REQUIRE(json.isObject());
+		REQUIRE(json[U"name"].getString() == U"Siv3D");
+		REQUIRE(json[U"values"].size() == 3);
+		REQUIRE(json[U"values"][2].get<int32>() == 3);
+	}
+
+	SECTION("Non-ASCII")
+	{
+		const JSON json = JSON::Parse(U"{ \"text\": \"こんにちは🐈\" }");
+		REQUIRE(json[U"text"].getString() == U"こんにちは🐈");
+	}
+
+	SECTION("Embedded NUL")
+	{
+		// 文字列の長さが明示されているので、NUL 文字で打ち切られない
+		const String str{ U"[1, 2]\0 [3]", 11 };
+		REQUIRE(not JSON::Parse(str));
+
+		const String str2{ U"[\"a\0b\"]", 7 };
+		REQUIRE(not JSON::Parse(str2));
+	}
+
+	SECTION("Invalid")
+	{
+		REQUIRE(not JSON::Parse(U"{ \"a\": }"));
+		REQUIRE_THROWS_AS(JSON::Parse(U"{ \"a\": }", AllowExceptions::Yes), Error);
+	}
+}
+
+TEST_CASE("JSON::Load()")
+{
+	SECTION("UTF8_NO_BOM")
+	{
+		const FilePath path = FileSystem::FullPath(U"test/runtime/json/utf8_no_bom.json");
+		WriteBytes(path, "{ \"a\": [1, 2, 3] }");
+
+		const JSON json = JSON::Load(path);
+		REQUIRE(json[U"a"].size() == 3);
+	}
+
+	SECTION("UTF8_WITH_BOM")
+	{
+		const FilePath path = FileSystem::FullPath(U"test/runtime/json/utf8_with_bom.json");
+		WriteBytes(path, "\xEF\xBB\xBF{ \"a\": \"\xE3\x81\x82\" }");
+
+		const JSON json = JSON::Load(path);
+		REQUIRE(json[U"a"].getString() == U"あ");
+	}
+
+	SECTION("Invalid UTF-8")
+	{
+		// 不正な UTF-8 は TextReader と同様に U+FFFD に置き換えられる
+		const std::string bytes = "{ \"a\": \"x\xFFy\", \"b\": \"\xED\xA0\x80\" }";
+		const FilePath path = FileSystem::FullPath(U"test/runtime/json/invalid_utf8.json");
+		WriteBytes(path, bytes);
+
+		const String expected = TextReader{ path }.readAll();
+
+		const JSON json = JSON::Load(path);
+		REQUIRE(json);
+		REQUIRE(json[U"a"].getString().starts_with(U'x'));
+		REQUIRE(json[U"a"].getString().ends_with(U'y'));
+		REQUIRE(json[U"a"].getString().includes(U'�'));
+		REQUIRE(json == JSON::Parse(expected));
+
+		const JSON json2 = JSON::Load(MemoryReader{ bytes.data(), bytes.size() });
+		REQUIRE(json2 == json);
+	}
+
+	SECTION("NUL")
+	{
+		// TextReader::readAll() と同様に、NUL 文字以降は読み込まない
+		const std::string bytes{ "[1, 2]\0garbage", 14 };
+		const FilePath path = FileSystem::FullPath(U"test/runtime/json/nul.json");
+		WriteBytes(path, bytes);
+
+		const JSON json = JSON::Load(path);
+		REQUIRE(json.size() == 2);
+
+		const JSON json2 = JSON::Load(MemoryReader{ bytes.data(), bytes.size() });
+		REQUIRE(json2.size() == 2);
+	}
+
+	SECTION("Nonexist")
+	{
+		REQUIRE(not JSON::Load(U"test/runtime/json/nonexist.json"));
+	}
+}
+
+TEST_CASE("JSON::ForEach()")
+{
+	const std::string source = R"({
+		"meta": { "items": [ { "skip": true } ] },
+		"items": [
+			{ "id": 1, "tags": [ "a", "b" ], "child": { "items": [ 100 ] } },
+			[ 2, [ 3, 4 ] ],
+			5,
+			"six",
+			null
+		],
+		"nested": { "list": [ { "values": [ 10, 20 ] }, { "values": [ 30 ] } ] },
+		"single": { "x": 7 }
+	})";
+
+	const auto forEach = [&](StringView jsonPointer, auto f, AllowExceptions allowExceptions = AllowExceptions::No)
+	{
+		return JSON::ForEach(MemoryReader{ source.data(), source.size() }, jsonPointer, f, allowExceptions);
+	};
+
+	SECTION("Root array")
+	{
+		const std::string array = "[ 1, [ 2, 3 ], { \"a\": [ 4 ] } ]";
+		Array<JSON> elements;
+
+		REQUIRE(JSON::ForEach(MemoryReader{ array.data(), array.size() }, U"", [&](const JSON& element) { elements << element; }));
+		REQUIRE(elements.size() == 3);
+		REQUIRE(elements[0].get<int32>() == 1);
+		REQUIRE(elements[1] == JSON::Parse(U"[ 2, 3 ]"));
+		REQUIRE(elements[2] == JSON::Parse(U"{ \"a\": [ 4 ] }"));
+	}
+
+	SECTION("Nested arrays and objects")
+	{
+		Array<JSON> elements;
+
+		REQUIRE(forEach(U"/items", [&](const JSON& element) { elements << element; }));
+		REQUIRE(elements.size() == 5);
+		REQUIRE(elements[0] == JSON::Parse(U"{ \"id\": 1, \"tags\": [ \"a\", \"b\" ], \"child\": { \"items\": [ 100 ] } }"));
+		REQUIRE(elements[1] == JSON::Parse(U"[ 2, [ 3, 4 ] ]"));
+		REQUIRE(elements[2].get<int32>() == 5);
+		REQUIRE(elements[3].getString() == U"six");
+		REQUIRE(elements[4].isNull());
+	}
+
+	SECTION("Deep pointer")
+	{
+		Array<int32> values;
+
+		REQUIRE(forEach(U"/nested/list/1/values", [&](const JSON& element) { values << element.get<int32>(); }));
+		REQUIRE(values == Array<int32>{ 30 });
+
+		values.clear();
+		REQUIRE(forEach(U"/items/1/1", [&](const JSON& element) { values << element.get<int32>(); }));
+		REQUIRE(values == Array<int32>{ 3, 4 });
+	}
+
+	SECTION("Non-array target")
+	{
+		Array<JSON> elements;
+
+		REQUIRE(forEach(U"/single", [&](const JSON& element) { elements << element; }));
+		REQUIRE(elements.size() == 1);
+		REQUIRE(elements[0][U"x"].get<int32>() == 7);
+	}
+
+	SECTION("No match")
+	{
+		size_t count = 0;
+
+		REQUIRE(forEach(U"/missing", [&](const JSON&) { ++count; }));
+		REQUIRE(count == 0);
+	}
+
+	SECTION("Early stop")
+	{
+		Array<JSON> elements;
+
+		REQUIRE(forEach(U"/items", [&](const JSON& element)
+			{
+				elements << element;
+				return (elements.size() < 2);
+			}));
+		REQUIRE(elements.size() == 2);
+		REQUIRE(elements[1] == JSON::Parse(U"[ 2, [ 3, 4 ] ]"));
+	}
+
+	SECTION("Early stop before malformed input")
+	{
+		// 中断した後の不正な入力は読み込まれない
+		const std::string array = "[ 1, 2, { oops ";
+		size_t count = 0;
+
+		REQUIRE(JSON::ForEach(MemoryReader{ array.data(), array.size() }, U"", [&](const JSON&) { return (++count < 2); }));
+		REQUIRE(count == 2);
+	}
+
+	SECTION("Malformed input")
+	{
+		const std::string array = "[ 1, 2, { \"a\": } ]";
+		Array<int32> values;
+
+		REQUIRE(not JSON::ForEach(MemoryReader{ array.data(), array.size() }, U"", [&](const JSON& element) { values << element.get<int32>(); }));
+		REQUIRE(values == Array<int32>{ 1, 2 });
+
+		REQUIRE_THROWS_AS(JSON::ForEach(MemoryReader{ array.data(), array.size() }, U"", [](const JSON&) {}, AllowExceptions::Yes), Error);
+
+		const std::string truncated = "[ 1, 2";
+		REQUIRE(not JSON::ForEach(MemoryReader{ truncated.data(), truncated.size() }, U"", [](const JSON&) {}));
+	}
+
+	SECTION("Out-of-range index")
+	{
+		const std::string object = R"({ "99999999999999999999999": [ 1, 2 ], "list": [ [ 3 ] ] })";
+		Array<int32> values;
+
+		// size_t に収まらない番号は、配列の要素を指さない
+		REQUIRE(forEach(U"/99999999999999999999999", [&](const JSON& element) { values << element.get<int32>(); }));
+		REQUIRE(values.isEmpty());
+
+		REQUIRE(JSON::ForEach(MemoryReader{ object.data(), object.size() }, U"/list/99999999999999999999999", [&](const JSON& element) { values << element.get<int32>(); }));
+		REQUIRE(values.isEmpty());
+
+		// オブジェクトのキーとしては一致する
+		REQUIRE(JSON::ForEach(MemoryReader{ object.data(), object.size() }, U"/99999999999999999999999", [&](const JSON& element) { values << element.get<int32>(); }));
+		REQUIRE(values == Array<int32>{ 1, 2 });
+	}
+
+	SECTION("Invalid JSON Pointer")
+	{
+		REQUIRE(not forEach(U"items", [](const JSON&) {}));
+		REQUIRE(not forEach(U"/items~2", [](const JSON&) {}));
+		REQUIRE_THROWS_AS(forEach(U"items", [](const JSON&) {}, AllowExceptions::Yes), Error);
+	}
+}
+
+SIV3D_DISABLE_MSVC_WARNINGS_POP()
@@ -0,0 +1,177 @@
+﻿//-----------------------------------------------
+//
+//	This file is part of the Siv3D Engine.
+//
+//	Copyright (c) 2008-2022 Ryo Suzuki
+//	Copyright (c) 2016-2022 OpenSiv3D Project
+//
+//	Licensed under the MIT License.
+//
+//-----------------------------------------------
+
+
+# include "Siv3DTest.hpp"
+# include <iostream>
+
+void Siv3DTestChild_LoggerShutdown()
+{
+	// 親プロセスが読み込めるよう、ログを標準出力に書き出す
+	std::clog.rdbuf(std::cout.rdbuf());
+
+	// バッファの容量を超える数のログを、フラッシュせずに書き込んで終了する
+	for (size_t i = 0; i < 10000; ++i)
+	{
+		Logger << U"shutdown {}"_fmt(i);
+	}
+}
+
+# if SIV3D_PLATFORM(MACOS) || SIV3D_PLATFORM(LINUX)
+
+# include <sstream>
+# include <thread>
+
+namespace
+{
+	// std::clog への出力を一時的に横取りする
+	class ClogCapture
+	{
+	public:
+
+		ClogCapture()
+			: m_previous{ std::clog.rdbuf(m_stream.rdbuf()) } {}
+
+		~ClogCapture()
+		{
+			std::clog.rdbuf(m_previous);
+		}
+
+		[[nodiscard]]
+		Array<std::string> lines() const
+		{
+			Array<std::string> result;
+			std::istringstream input{ m_stream.str() };
+
+			for (std::string line; std::getline(input, line);)
+			{
+				// タイムスタンプを除く
+				result << line.substr(line.find(": ") + 2);
+			}
+
+			return result;
+		}
+
+	private:
+
+		std::ostringstream m_stream;
+
+		std::streambuf* m_previous;
+	};
+}
+
+TEST_CASE("Logger")
+{
+	SECTION("Order")
+	{
+		// 以前のログが混ざらないよう、先に書き出しておく
+		Logger.flush();
+
+		constexpr size_t N = 10000;
+		Array<std::string> lines;
+		{
+			ClogCapture capture;
+
+			for (size_t i = 0; i < N; ++i)
+			{
+				Logger << i;
+			}
+
+			Logger.flush();
+			lines = capture.lines();
+		}
+
+		REQUIRE(lines.size() == N);
+
+		for (size_t i = 0; i < N; ++i)
+		{
+			REQUIRE(lines[i] == std::to_string(i));
+		}
+	}
+
+	SECTION("Order from multiple threads")
+	{
+		Logger.flush();
+
+		constexpr size_t ThreadCount = 4;
+		constexpr size_t N = 5000;
+		Array<std::string> lines;
+		{
+			ClogCapture capture;
+			Array<std::thread> threads;
+
+			for (size_t t = 0; t < ThreadCount; ++t)
+			{
+				threads.emplace_back([t]()
+				{
+					for (size_t i = 0; i < N; ++i)
+					{
+						Logger << U"{} {}"_fmt(t, i);
+					}
+				});
+			}
+
+			for (auto& thread : threads)
+			{
+				thread.join();
+			}
+
+			Logger.flush();
+			lines = capture.lines();
+		}
+
+		REQUIRE(lines.size() == (ThreadCount * N));
+
+		// 各スレッドのログは、書き込んだ順に出力される
+		std::array<size_t, ThreadCount> next{};
+
+		for (const auto& line : lines)
+		{
+			const size_t t = static_cast<size_t>(std::stoull(line));
+			REQUIRE(t < ThreadCount);
+			REQUIRE(line == (std::to_string(t) + ' ' + std::to_string(next[t])));
+			++next[t];
+		}
+	}
+
+	SECTION("Flush on shutdown")
+	{
+		constexpr size_t N = 10000;
+		Array<std::string> lines;
+		{
+			// Pipe::StdIn で、子プロセスの標準出力を istream() から読み込む
+			ChildProcess child{ FileSystem::ModulePath(), U"--logger-shutdown", Pipe::StdIn };
+			REQUIRE(child);
+
+			for (std::string line; std::getline(child.istream(), line);)
+			{
+				// エンジンのログを除く
+				if (const size_t pos = line.find(": shutdown ");
+					pos != std::string::npos)
+				{
+					lines << line.substr(pos + 11);
+				}
+			}
+
+			child.wait();
+		}
+
+		// 終了の時点で、書き込み待ちのログはすべて出力されている
+		REQUIRE(lines.size() == N);
+
+		for (size_t i = 0; i < N; ++i)
+		{
+			REQUIRE(lines[i] == std::to_string(i));
+		}
+	}
+}
+
+# endif
@@ -0,0 +1,109 @@
+﻿//-----------------------------------------------
+//
+//	This file is part of the Siv3D Engine.
+//
+//	Copyright (c) 2008-2022 Ryo Suzuki
+//	Copyright (c) 2016-2022 OpenSiv3D Project
+//
+//	Licensed under the MIT License.
+//
+//-----------------------------------------------
+
+# include "Siv3DTest.hpp"
+
+TEST_CASE("Mesh::drawInstanced()")
+{
+	const Mesh mesh{ MeshData::OneSidedPlane(1.0) };
+	const Texture texture{ Image{ 16, 16, Palette::White } };
+
+	Array<Mat4x4> transforms;
+	Array<ColorF> colors;
+
+	// 一度の描画呼び出しに収まらない数のインスタンスも描ける
+	for (int32 i = 0; i < 1000; ++i)
+	{
+		transforms << Mat4x4::Translate((i % 32), 0, (i / 32));
+		colors << HSV{ (i * 10.0) };
+	}
+
+	// 空の配列も描ける
+	mesh.drawInstanced({});
+	mesh.drawInstanced(transforms);
+	mesh.drawInstanced(transforms, colors);
+	mesh.drawInstanced(transforms, PhongMaterial{ Palette::Orange });
+	mesh.drawInstanced(transforms, texture);
+	mesh.drawInstanced(transforms, texture, colors);
+
+	{
+		// ローカル座標変換は、各インスタンスの変換行列の後に適用される
+		const Transformer3D transformer{ Mat4x4::Translate(0, 1, 0) };
+		mesh.drawInstanced(transforms, colors);
+	}
+
+	// 同じメッシュの連続した draw() も描ける
+	for (size_t i = 0; i < transforms.size(); ++i)
+	{
+		mesh.draw(transforms[i], colors[i]);
+	}
+
+	Graphics3D::Flush();
+}
+
+TEST_CASE("Mesh::draw() : draw calls")
+{
+	const Mesh mesh{ MeshData::OneSidedPlane(1.0) };
+
+	// 前のテストで描いたものを含まない、新しいフレームから始める
+	REQUIRE(System::Update());
+
+	for (int32 i = 0; i < 1000; ++i)
+	{
+		mesh.draw(Mat4x4::Translate((i % 32), 0, (i / 32)), HSV{ (i * 10.0) });
+	}
+
+	// ProfilerStat には直前のフレームの統計が入る
+	REQUIRE(System::Update());
+	const ProfilerStat& stat = Profiler::GetStat();
+
+	if (System::GetRendererType() == EngineOption::Renderer::OpenGL)
+	{
+		// 同じメッシュの連続した draw() は、192 インスタンスずつの描画呼び出しにまとめられる
+		REQUIRE(stat.drawCalls == ((1000 + 191) / 192));
+		REQUIRE(stat.triangleCount == (1000 * 2));
+	}
+}
+
+# if defined(SIV3D_RUN_BENCHMARK)
+
+TEST_CASE("Mesh::drawInstanced() : benchmark")
+{
+	constexpr size_t N = 10'000;
+	const Mesh mesh{ MeshData::Box(0.5) };
+	Array<Mat4x4> transforms(N);
+	Array<ColorF> colors(N);
+
+	for (size_t i = 0; i < N; ++i)
+	{
+		transforms[i] = Mat4x4::Translate(RandomVec3(Box{ 100 }));
+		colors[i] = HSV{ Random(360.0) };
+	}
+
+	BENCHMARK("Mesh::draw() | 10k")
+	{
+		for (size_t i = 0; i < N; ++i)
+		{
+			mesh.draw(transforms[i], colors[i]);
+		}
+
+		Graphics3D::Flush();
+	};
+
+	BENCHMARK("Mesh::drawInstanced() | 10k")
+	{
+		mesh.drawInstanced(transforms, colors);
+
+		Graphics3D::Flush();
+	};
+}
+
+# endif
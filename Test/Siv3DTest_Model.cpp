@@ -0,0 +1,122 @@
+﻿//-----------------------------------------------
+//
+//	This file is part of the Siv3D Engine.
+//
+//	Copyright (c) 2008-2022 Ryo Suzuki
+//	Copyright (c) 2016-2022 OpenSiv3D Project
+//
+//	Licensed under the MIT License.
+//
+//-----------------------------------------------
+
+# include "Siv3DTest.hpp"
+
+namespace s3dTest
+{
+	// n × n の格子状の面を持つ OBJ ファイルを作成する
+	static void WriteGridObj(const FilePath& path, const int32 n)
+	{
+		TextWriter writer{ path };
+
+		for (int32 y = 0; y <= n; ++y)
+		{
+			for (int32 x = 0; x <= n; ++x)
+			{
+				writer.writeln(U"v {} 0 {}"_fmt(x, y));
+				writer.writeln(U"vt {} {}"_fmt((static_cast<double>(x) / n), (static_cast<double>(y) / n)));
+			}
+		}
+
+		writer.writeln(U"vn 0 1 0");
+
+		for (int32 y = 0; y < n; ++y)
+		{
+			for (int32 x = 0; x < n; ++x)
+			{
+				const int32 i = (y * (n + 1) + x + 1);
+				writer.writeln(U"f {0}/{0}/1 {1}/{1}/1 {2}/{2}/1 {3}/{3}/1"_fmt(i, (i + n + 1), (i + n + 2), (i + 1)));
+			}
+		}
+	}
+}
+
+TEST_CASE("Model")
+{
+	const FilePath path = FileSystem::FullPath(U"test/runtime/model/grid.obj");
+	s3dTest::WriteGridObj(path, 16);
+
+	const Model model{ path };
+	REQUIRE(model.objects().size() == 1);
+	REQUIRE(model.objects()[0].parts.size() == 1);
+
+	// 面の間で共有される頂点は 1 つにまとめられる
+	const Mesh& mesh = model.objects()[0].parts[0].mesh;
+	REQUIRE(mesh.num_vertices() == (17 * 17));
+	REQUIRE(mesh.num_triangles() == (16 * 16 * 2));
+}
+
+TEST_CASE("Model cache")
+{
+	const FilePath path = FileSystem::FullPath(U"test/runtime/model/grid_cache.obj");
+	s3dTest::WriteGridObj(path, 16);
+
+	const FilePath cachePath = (path + U".s3dmodel");
+	FileSystem::Remove(cachePath);
+
+	// 初回の読み込みでキャッシュが作成され、2 回目はキャッシュから読み込まれる
+	for (int32 i = 0; i < 2; ++i)
+	{
+		const Model model{ path, ColorOption::Default, UseCache::Yes };
+		REQUIRE(FileSystem::Exists(cachePath));
+		REQUIRE(model.objects().size() == 1);
+		REQUIRE(model.objects()[0].parts[0].mesh.num_vertices() == (17 * 17));
+		REQUIRE(model.objects()[0].parts[0].mesh.num_triangles() == (16 * 16 * 2));
+	}
+
+	// Model::Bake() で作成したファイルは、元のファイルがなくても読み込める
+	const FilePath bakedPath = FileSystem::FullPath(U"test/runtime/model/grid_baked.s3dmodel");
+	REQUIRE(Model::Bake(path, bakedPath));
+
+	const Model baked{ bakedPath };
+	REQUIRE(baked.objects().size() == 1);
+	REQUIRE(baked.objects()[0].parts[0].mesh.num_vertices() == (17 * 17));
+
+	// マテリアルやオブジェクトの個数が壊れたファイルは、配列を確保する前に読み込みに失敗する
+	for (const size_t countOffset : { 32, 36 })
+	{
+		Blob blob{ bakedPath };
+		REQUIRE(countOffset + sizeof(uint32) <= blob.size());
+		const uint32 count = 0xFFFF'FFFF;
+		std::memcpy(blob.data() + countOffset, &count, sizeof(count));
+
+		const FilePath brokenPath = FileSystem::FullPath(U"test/runtime/model/grid_broken.s3dmodel");
+		REQUIRE(blob.save(brokenPath));
+
+		const Model broken{ brokenPath };
+		REQUIRE(broken.objects().isEmpty());
+	}
+}
+
+# if defined(SIV3D_RUN_BENCHMARK)
+
+TEST_CASE("Model : benchmark")
+{
+	const FilePath path = FileSystem::FullPath(U"test/runtime/model/grid_large.obj");
+	s3dTest::WriteGridObj(path, 500);
+
+	// 読み込みにかかった時間、頂点数、ACMR はエンジンのログに出力される
+	BENCHMARK("Model | OBJ 500'000 triangles")
+	{
+		return Model{ path };
+	};
+
+	const FilePath bakedPath = FileSystem::FullPath(U"test/runtime/model/grid_large.s3dmodel");
+	Model::Bake(path, bakedPath);
+
+	BENCHMARK("Model | baked 500'000 triangles")
+	{
+		return Model{ bakedPath };
+	};
+}
+
+# endif
@@ -0,0 +1,72 @@
+﻿//-----------------------------------------------
+//
+//	This file is part of the Siv3D Engine.
+//
+//	Copyright (c) 2008-2022 Ryo Suzuki
+//	Copyright (c) 2016-2022 OpenSiv3D Project
+//
+//	Licensed under the MIT License.
+//
+//-----------------------------------------------
+
+
+# include "Siv3DTest.hpp"
+# include <Siv3D/OpenCV_Bridge.hpp>
+
+TEST_CASE("OpenCV_Bridge::ToMatVec3bBGR()")
+{
+	// SIMD で処理される幅と、端数の幅の両方を含む
+	for (const int32 width : { 1, 2, 3, 4, 5, 6, 7, 8, 9, 37 })
+	{
+		Image image{ width, 3 };
+
+		for (int32 y = 0; y < image.height(); ++y)
+		{
+			for (int32 x = 0; x < image.width(); ++x)
+			{
+				image[y][x] = Color(static_cast<uint8>(x * 7 + y), static_cast<uint8>(x * 13 + 50), static_cast<uint8>(255 - x - y * 40), static_cast<uint8>(x * 3));
+			}
+		}
+
+		const auto isBGR = [&](const cv::Mat_<cv::Vec3b>& mat)
+		{
+			for (int32 y = 0; y < image.height(); ++y)
+			{
+				for (int32 x = 0; x < image.width(); ++x)
+				{
+					const Color c = image[y][x];
+
+					if (mat(y, x) != cv::Vec3b{ c.b, c.g, c.r })
+					{
+						return false;
+					}
+				}
+			}
+
+			return true;
+		};
+
+		const cv::Mat_<cv::Vec3b> mat = OpenCV_Bridge::ToMatVec3bBGR(image);
+		REQUIRE(mat.cols == width);
+		REQUIRE(mat.rows == 3);
+		REQUIRE(isBGR(mat));
+
+		// 大きな行列の一部に書き込むとき、範囲外の画素を書き換えない
+		const cv::Vec3b guard{ 11, 22, 33 };
+		cv::Mat_<cv::Vec3b> canvas(5, (width + 8), guard);
+		cv::Mat_<cv::Vec3b> roi = canvas(cv::Rect{ 2, 1, width, 3 });
+		OpenCV_Bridge::ToMatVec3bBGR(image, roi);
+		REQUIRE(isBGR(roi));
+
+		for (int32 y = 0; y < canvas.rows; ++y)
+		{
+			for (int32 x = 0; x < canvas.cols; ++x)
+			{
+				if ((not InRange(y, 1, 3)) || (not InRange(x, 2, (width + 1))))
+				{
+					REQUIRE(canvas(y, x) == guard);
+				}
+			}
+		}
+	}
+}
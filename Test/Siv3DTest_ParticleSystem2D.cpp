@@ -0,0 +1,190 @@
+﻿//-----------------------------------------------
+//
+//	This file is part of the Siv3D Engine.
+//
+//	Copyright (c) 2008-2022 Ryo Suzuki
+//	Copyright (c) 2016-2022 OpenSiv3D Project
+//
+//	Licensed under the MIT License.
+//
+//-----------------------------------------------
+
+# include "Siv3DTest.hpp"
+
+TEST_CASE("ParticleSystem2D")
+{
+	ParticleSystem2DParameters parameters;
+	parameters.rate = 100;
+	parameters.startLifeTime = 1.0;
+	parameters.maxParticles = 1000;
+
+	ParticleSystem2D particleSystem{ Vec2{ 400, 300 }, Vec2{ 0, 100 }, CircleEmitter2D{}, parameters, Texture{} };
+	REQUIRE(particleSystem.num_particles() == 0);
+
+	particleSystem.prewarm();
+	REQUIRE(InRange<size_t>(particleSystem.num_particles(), 99, 100));
+
+	// 寿命が尽きたパーティクルは削除される
+	parameters.rate = 0;
+	particleSystem.setParameters(parameters);
+	particleSystem.update(0.5);
+	REQUIRE(InRange<size_t>(particleSystem.num_particles(), 40, 60));
+	particleSystem.update(0.6);
+	REQUIRE(particleSystem.num_particles() == 0);
+
+	// 上限を超えた分は、古いものから削除される
+	parameters.rate = 1000;
+	parameters.maxParticles = 50;
+	particleSystem.setParameters(parameters);
+	particleSystem.prewarm();
+	REQUIRE(particleSystem.num_particles() == 50);
+
+	for (int32 i = 0; i < 10; ++i)
+	{
+		particleSystem.update(1.0 / 60.0);
+		REQUIRE(particleSystem.num_particles() == 50);
+	}
+
+	// 一度のバッファの確保に収まらない数のパーティクルも描ける
+	parameters.maxParticles = 100'000;
+	parameters.rate = 50'000;
+	parameters.sizeOverLifeTimeFunc = [](float startSize, float, float) { return startSize; };
+	particleSystem.setParameters(parameters);
+	particleSystem.prewarm();
+	REQUIRE(particleSystem.num_particles() > 20'000);
+
+	particleSystem.draw();
+	particleSystem.setTexture(Texture{ Image{ 16, 16, Palette::White } });
+	particleSystem.draw();
+
+	Graphics2D::Flush();
+}
+
+TEST_CASE("ParticleSystem2D::UpdateAll()")
+{
+	ParticleSystem2DParameters parameters;
+	parameters.rate = 500;
+	parameters.startLifeTime = 1.0;
+	parameters.randomStartRotationDeg = 360;
+
+	const auto makeSystems = [&]()
+	{
+		Array<ParticleSystem2D> systems;
+
+		for (uint64 i = 0; i < 32; ++i)
+		{
+			// 放出の位置がランダムになるエミッターを使う
+			ParticleSystem2D system{ Vec2{ 400, 300 }, Vec2{ 0, 100 }, RectEmitter2D{}, parameters, Texture{} };
+			system.setSeed(i);
+			systems << system;
+		}
+
+		return systems;
+	};
+
+	Array<ParticleSystem2D> parallel = makeSystems();
+	Array<ParticleSystem2D> serial = makeSystems();
+
+	// スレッドの数や実行順によらず、1 つずつ更新した場合と同じ結果になる
+	for (int32 frame = 0; frame < 10; ++frame)
+	{
+		ParticleSystem2D::UpdateAll(parallel, (1.0 / 60.0));
+
+		for (auto& system : serial)
+		{
+			system.update(1.0 / 60.0);
+		}
+	}
+
+	for (size_t i = 0; i < parallel.size(); ++i)
+	{
+		REQUIRE(parallel[i].num_particles() == serial[i].num_particles());
+		REQUIRE(parallel[i].num_particles() > 0);
+
+		// 個々のパーティクルの状態も完全に一致する
+		const Array<Particle2D> parallelParticles = parallel[i].getParticles();
+		const Array<Particle2D> serialParticles = serial[i].getParticles();
+		REQUIRE(parallelParticles.size() == serialParticles.size());
+
+		for (size_t k = 0; k < parallelParticles.size(); ++k)
+		{
+			REQUIRE(parallelParticles[k].position == serialParticles[k].position);
+			REQUIRE(parallelParticles[k].velocity == serialParticles[k].velocity);
+			REQUIRE(parallelParticles[k].rotation == serialParticles[k].rotation);
+			REQUIRE(parallelParticles[k].remainingLifeTime == serialParticles[k].remainingLifeTime);
+		}
+	}
+
+	ParticleSystem2D::DrawAll(parallel);
+	Graphics2D::Flush();
+}
+
+# if defined(SIV3D_RUN_BENCHMARK)
+
+TEST_CASE("ParticleSystem2D : benchmark")
+{
+	for (const size_t num_particles : { 100'000, 1'000'000 })
+	{
+		ParticleSystem2DParameters parameters;
+		parameters.rate = static_cast<double>(num_particles);
+		parameters.startLifeTime = 1.0;
+		parameters.maxParticles = static_cast<double>(num_particles);
+
+		ParticleSystem2D particleSystem{ Vec2{ 400, 300 }, Vec2{ 0, 100 }, CircleEmitter2D{}, parameters, Texture{} };
+		particleSystem.prewarm();
+
+		// 毎フレーム、寿命が尽きた 1/60 のパーティクルが新しいものに入れ替わる
+		BENCHMARK(U"ParticleSystem2D::update() | {}"_fmt(num_particles).narrow())
+		{
+			particleSystem.update(1.0 / 60.0);
+			return particleSystem.num_particles();
+		};
+
+		// Null レンダラーで実行すると、頂点の作成を含まない API の呼び出しにかかる時間になる
+		BENCHMARK(U"ParticleSystem2D::draw() | {}"_fmt(num_particles).narrow())
+		{
+			particleSystem.draw();
+
+			Graphics2D::Flush();
+		};
+	}
+}
+
+TEST_CASE("ParticleSystem2D::UpdateAll() : benchmark")
+{
+	ParticleSystem2DParameters parameters;
+	parameters.rate = 2000;
+	parameters.startLifeTime = 1.0;
+
+	Array<ParticleSystem2D> systems;
+
+	for (uint64 i = 0; i < 256; ++i)
+	{
+		ParticleSystem2D system{ Vec2{ 400, 300 }, Vec2{ 0, 100 }, CircleEmitter2D{}, parameters, Texture{} };
+		system.setSeed(i);
+		system.prewarm();
+		systems << system;
+	}
+
+	BENCHMARK("ParticleSystem2D::update() | 256 systems")
+	{
+		for (auto& system : systems)
+		{
+			system.update(1.0 / 60.0);
+		}
+	};
+
+	BENCHMARK("ParticleSystem2D::UpdateAll() | 256 systems")
+	{
+		ParticleSystem2D::UpdateAll(systems, (1.0 / 60.0));
+	};
+
+	BENCHMARK("ParticleSystem2D::DrawAll() | 256 systems")
+	{
+		ParticleSystem2D::DrawAll(systems);
+
+		Graphics2D::Flush();
+	};
+}
+
+# endif
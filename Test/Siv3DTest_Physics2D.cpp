@@ -0,0 +1,469 @@
+﻿//-----------------------------------------------
+//
+//	This file is part of the Siv3D Engine.
+//
+//	Copyright (c) 2008-2022 Ryo Suzuki
+//	Copyright (c) 2016-2022 OpenSiv3D Project
+//
+//	Licensed under the MIT License.
+//
+//-----------------------------------------------
+
+# include "Siv3DTest.hpp"
+
+TEST_CASE("P2World : queries")
+{
+	P2World world;
+	const P2Body ground = world.createRect(P2BodyType::Static, Vec2{ 0, 500 }, SizeF{ 1000, 20 });
+	const P2Body ball = world.createCircle(P2BodyType::Dynamic, Vec2{ 0, 100 }, 20);
+	const P2Body box = world.createRect(P2BodyType::Dynamic, Vec2{ 200, 100 }, 40);
+
+	REQUIRE(world.queryAABB(RectF{ -30, 70, 60, 60 }) == Array<P2BodyID>{ ball.id() });
+	REQUIRE(world.queryAABB(RectF{ -1000, -1000, 2000, 2000 }) == Array<P2BodyID>{ ground.id(), ball.id(), box.id() });
+	REQUIRE(world.queryAABB(RectF{ 500, 0, 10, 10 }).isEmpty());
+
+	// 下向きのレイは、先に円に当たる
+	const auto hit = world.raycast(Vec2{ 0, 0 }, Vec2{ 0, 1000 });
+	REQUIRE(hit.has_value());
+	REQUIRE(hit->id == ball.id());
+	REQUIRE(hit->pos.y == Approx(80).margin(0.1));
+	REQUIRE(hit->normal.y == Approx(-1.0).margin(0.01));
+	REQUIRE(hit->fraction == Approx(0.08).margin(0.001));
+
+	REQUIRE(not world.raycast(Vec2{ 600, 0 }, Vec2{ 600, 100 }));
+	REQUIRE(not world.raycast(Vec2{ 0, 0 }, Vec2{ 0, 0 }));
+
+	const Array<P2RaycastHit> hits = world.raycastAll(Line{ 0, 0, 0, 1000 });
+	REQUIRE(hits.size() == 2);
+	REQUIRE(hits[0].id == ball.id());
+	REQUIRE(hits[1].id == ground.id());
+
+	// 円を右に動かすと、箱の左の面に当たる
+	const auto castHit = world.shapeCast(Circle{ 0, 100, 10 }, Vec2{ 400, 0 });
+	REQUIRE(castHit.has_value());
+	REQUIRE(castHit->id == box.id());
+	REQUIRE(castHit->normal.x < 0.0);
+	REQUIRE(castHit->fraction == Approx(0.425).margin(0.01));
+
+	// 結果の配列を使いまわす
+	Array<Optional<P2RaycastHit>> rayResults;
+	world.raycast({ Line{ 0, 0, 0, 1000 }, Line{ 200, 0, 200, 1000 }, Line{ 600, 0, 600, 10 } }, rayResults);
+	REQUIRE(rayResults.size() == 3);
+	REQUIRE(rayResults[0]->id == ball.id());
+	REQUIRE(rayResults[1]->id == box.id());
+	REQUIRE(not rayResults[2]);
+
+	Array<P2BodyID> ids;
+	Array<size_t> offsets;
+	world.queryAABB({ RectF{ -30, 70, 60, 60 }, RectF{ 500, 0, 10, 10 }, RectF{ 150, 50, 100, 500 } }, ids, offsets);
+	REQUIRE(offsets == Array<size_t>{ 0, 1, 1, 3 });
+	REQUIRE(ids == Array<P2BodyID>{ ball.id(), ground.id(), box.id() });
+}
+
+TEST_CASE("P2World : contact events")
+{
+	P2World world;
+	world.setContactMode(P2ContactMode::Events);
+	REQUIRE(world.getContactMode() == P2ContactMode::Events);
+
+	const P2Body ground = world.createRect(P2BodyType::Static, Vec2{ 0, 100 }, SizeF{ 1000, 20 });
+	P2Body ball = world.createCircle(P2BodyType::Dynamic, Vec2{ 0, 70 }, 20, P2Material{ .restitution = 0.0 });
+
+	size_t numBegin = 0, numPersist = 0;
+
+	for (int32 i = 0; i < 120; ++i)
+	{
+		world.update(1.0 / 60.0);
+
+		for (const auto& event : world.getContactEvents())
+		{
+			REQUIRE(((event.pair == P2ContactPair{ ground.id(), ball.id() }) || (event.pair == P2ContactPair{ ball.id(), ground.id() })));
+			REQUIRE(event.type != P2ContactEventType::End);
+
+			if (event.type == P2ContactEventType::Begin)
+			{
+				++numBegin;
+			}
+			else
+			{
+				REQUIRE(numBegin == 1);
+				++numPersist;
+			}
+
+			REQUIRE(event.num_contacts == 1);
+			REQUIRE(Abs(event.normal.y) == Approx(1.0).margin(0.01));
+		}
+	}
+
+	REQUIRE(numBegin == 1);
+	REQUIRE(numPersist > 0);
+
+	// イベントモードでは P2Collision は記録しない
+	REQUIRE(world.getCollisions().empty());
+
+	// 物体を削除して終わった接触は、End として残る
+	ball.release();
+	REQUIRE(world.getContactEvents().size() == 2);
+	REQUIRE(world.getContactEvents().back().type == P2ContactEventType::End);
+
+	world.update(1.0 / 60.0);
+	REQUIRE(world.getContactEvents().size() == 1);
+	REQUIRE(world.getContactEvents().front().type == P2ContactEventType::End);
+
+	world.update(1.0 / 60.0);
+	REQUIRE(world.getContactEvents().empty());
+}
+
+TEST_CASE("P2World : states and snapshot")
+{
+	P2World world;
+	const P2Body ground = world.createRect(P2BodyType::Static, Vec2{ 0, 500 }, SizeF{ 1000, 20 });
+	Array<P2Body> bodies;
+
+	for (int32 i = 0; i < 10; ++i)
+	{
+		bodies << world.createCircle(P2BodyType::Dynamic, Vec2{ (i * 50), 0 }, 10);
+	}
+
+	bodies[3].setVelocity(Vec2{ 100, -50 });
+
+	P2BodyStates states;
+	world.exportStates(states);
+	REQUIRE(states.size() == 11);
+	REQUIRE(states.ids.front() == ground.id());
+	REQUIRE(std::is_sorted(states.ids.begin(), states.ids.end()));
+	REQUIRE(states.positions[4] == bodies[3].getPos());
+	REQUIRE(states.linearVelocities[4] == bodies[3].getVelocity());
+
+	const Blob snapshot = world.saveSnapshot();
+
+	for (int32 i = 0; i < 60; ++i)
+	{
+		world.update(1.0 / 60.0);
+	}
+
+	REQUIRE(bodies[3].getPos() != states.positions[4]);
+
+	// スナップショットから戻すと、保存時の状態と完全に一致する
+	REQUIRE(world.loadSnapshot(snapshot));
+	{
+		P2BodyStates restored;
+		world.exportStates(restored);
+		REQUIRE(restored.ids == states.ids);
+		REQUIRE(restored.positions == states.positions);
+		REQUIRE(restored.angles == states.angles);
+		REQUIRE(restored.linearVelocities == states.linearVelocities);
+		REQUIRE(restored.angularVelocities == states.angularVelocities);
+	}
+
+	REQUIRE(not world.loadSnapshot(Blob{}));
+	REQUIRE(not world.loadSnapshot(Blob{ snapshot.data(), (snapshot.size() - 1) }));
+
+	// ID の順序が任意でも、存在しない ID があってもよい
+	P2BodyStates partial;
+	partial.ids = { bodies[5].id(), 12345, bodies[1].id() };
+	partial.positions = { Vec2{ 10, 20 }, Vec2{ 0, 0 }, Vec2{ 30, 40 } };
+	partial.angles = { 0.5, 0.0, 0.0 };
+	partial.linearVelocities = { Vec2{ 1, 2 }, Vec2{ 0, 0 }, Vec2{ 0, 0 } };
+	partial.angularVelocities = { 0.0, 0.0, 3.0 };
+	REQUIRE(world.importStates(partial) == 2);
+	REQUIRE(bodies[5].getPos() == Vec2{ 10, 20 });
+	REQUIRE(bodies[5].getAngle() == Approx(0.5));
+	REQUIRE(bodies[5].getVelocity() == Vec2{ 1, 2 });
+	REQUIRE(bodies[1].getPos() == Vec2{ 30, 40 });
+	REQUIRE(bodies[1].getAngularVelocity() == Approx(3.0));
+}
+
+TEST_CASE("P2World : states with a mouse joint")
+{
+	// マウスジョイントが内部で作成する物体は、状態やスナップショットに含まれない
+	P2World world;
+	const P2Body ground = world.createRect(P2BodyType::Static, Vec2{ 0, 500 }, SizeF{ 1000, 20 });
+	P2Body ball = world.createCircle(P2BodyType::Dynamic, Vec2{ 0, 0 }, 10);
+	const P2MouseJoint mouseJoint = world.createMouseJoint(ball, Vec2{ 0, 0 });
+	const P2Body box = world.createRect(P2BodyType::Dynamic, Vec2{ 100, 0 }, 20);
+
+	P2BodyStates states;
+	world.exportStates(states);
+	REQUIRE(states.ids == Array<P2BodyID>{ ground.id(), ball.id(), box.id() });
+	REQUIRE(states.positions[1] == ball.getPos());
+
+	const Blob snapshot = world.saveSnapshot();
+
+	for (int32 i = 0; i < 30; ++i)
+	{
+		world.update(1.0 / 60.0);
+	}
+
+	REQUIRE(world.loadSnapshot(snapshot));
+	REQUIRE(ball.getPos() == states.positions[1]);
+	REQUIRE(box.getPos() == states.positions[2]);
+
+	P2BodyStates moved;
+	moved.ids = { box.id(), ball.id() };
+	moved.positions = { Vec2{ 200, 0 }, Vec2{ 50, 0 } };
+	moved.angles = { 0.0, 0.0 };
+	moved.linearVelocities = { Vec2{ 0, 0 }, Vec2{ 0, 0 } };
+	moved.angularVelocities = { 0.0, 0.0 };
+	REQUIRE(world.importStates(moved) == 2);
+	REQUIRE(box.getPos() == Vec2{ 200, 0 });
+	REQUIRE(ball.getPos() == Vec2{ 50, 0 });
+
+	REQUIRE(world.updateFixed((1.0 / 30.0), (1.0 / 60.0)) == 2);
+	P2BodyStates interpolated;
+	world.exportInterpolatedStates(interpolated);
+	REQUIRE(interpolated.ids == states.ids);
+}
+
+TEST_CASE("P2World : parallel solve and fixed update")
+{
+	const auto createRooms = [](P2World& world, Array<P2Body>& bodies)
+	{
+		for (int32 room = 0; room < 8; ++room)
+		{
+			const double x = (room * 400);
+			bodies << world.createRect(P2BodyType::Static, Vec2{ x, 300 }, SizeF{ 300, 20 });
+
+			for (int32 i = 0; i < 30; ++i)
+			{
+				bodies << world.createRect(P2BodyType::Dynamic, Vec2{ (x - 50 + (i % 5) * 21 + (i / 5 % 2) * 5), (280 - (i / 5) * 21) }, 20);
+			}
+		}
+	};
+
+	P2World serialWorld, parallelWorld;
+	Array<P2Body> serialBodies, parallelBodies;
+	createRooms(serialWorld, serialBodies);
+	createRooms(parallelWorld, parallelBodies);
+	parallelWorld.setParallelSolveEnabled(true);
+	REQUIRE(parallelWorld.getParallelSolveEnabled());
+
+	for (int32 i = 0; i < 120; ++i)
+	{
+		serialWorld.update(1.0 / 60.0);
+		parallelWorld.update(1.0 / 60.0);
+	}
+
+	// 並列に解いても、結果は完全に一致する
+	P2BodyStates serialStates, parallelStates;
+	serialWorld.exportStates(serialStates);
+	parallelWorld.exportStates(parallelStates);
+	REQUIRE(serialStates.positions == parallelStates.positions);
+	REQUIRE(serialStates.angles == parallelStates.angles);
+	REQUIRE(serialStates.linearVelocities == parallelStates.linearVelocities);
+	REQUIRE(serialWorld.getCollisions().size() == parallelWorld.getCollisions().size());
+
+	// 固定のタイムステップ
+	P2World world;
+	const P2Body ball = world.createCircle(P2BodyType::Dynamic, Vec2{ 0, 0 }, 10);
+	REQUIRE(world.updateFixed(0.04, (1.0 / 60.0)) == 2);
+	REQUIRE(world.getInterpolationAlpha() == Approx(0.4).margin(0.001));
+	REQUIRE(world.updateFixed(0.005, (1.0 / 60.0)) == 0);
+	REQUIRE(world.getInterpolationAlpha() == Approx(0.7).margin(0.001));
+
+	P2BodyStates interpolated;
+	world.exportInterpolatedStates(interpolated);
+	REQUIRE(interpolated.size() == 1);
+	REQUIRE(0.0 < interpolated.positions[0].y);
+	REQUIRE(interpolated.positions[0].y < ball.getPos().y);
+
+	// 処理が追い付かない分は切り捨てる
+	REQUIRE(world.updateFixed(1.0, (1.0 / 60.0), 4) == 4);
+	REQUIRE(world.getInterpolationAlpha() < 1.0);
+}
+
+# if defined(SIV3D_RUN_BENCHMARK)
+
+TEST_CASE("P2World : query benchmark")
+{
+	constexpr double R = 5.0;
+	P2World world;
+	Array<P2Body> bodies;
+
+	for (int32 y = 0; y < 100; ++y)
+	{
+		for (int32 x = 0; x < 100; ++x)
+		{
+			bodies << world.createCircle(P2BodyType::Static, Vec2{ (x * 40), (y * 40) }, R);
+		}
+	}
+
+	Array<RectF> rects;
+	Array<Line> rays;
+
+	for (int32 i = 0; i < 1000; ++i)
+	{
+		const Vec2 pos = RandomVec2(RectF{ 0, 0, 4000, 4000 });
+		rects << RectF{ Arg::center = pos, 100 };
+		rays << Line{ pos, pos.movedBy(Circular{ 200, Random(Math::TwoPi) }) };
+	}
+
+	Array<P2BodyID> ids;
+	Array<size_t> offsets;
+	Array<Optional<P2RaycastHit>> hits;
+
+	BENCHMARK("Brute force AABB | 1000 rects x 10000 bodies")
+	{
+		size_t count = 0;
+
+		for (const auto& rect : rects)
+		{
+			for (const auto& body : bodies)
+			{
+				count += Circle{ body.getPos(), R }.intersects(rect);
+			}
+		}
+
+		return count;
+	};
+
+	BENCHMARK("P2World::queryAABB | 1000 rects x 10000 bodies")
+	{
+		world.queryAABB(rects, ids, offsets);
+		return ids.size();
+	};
+
+	BENCHMARK("Brute force raycast | 1000 rays x 10000 bodies")
+	{
+		size_t count = 0;
+
+		for (const auto& ray : rays)
+		{
+			for (const auto& body : bodies)
+			{
+				count += Circle{ body.getPos(), R }.intersects(ray);
+			}
+		}
+
+		return count;
+	};
+
+	BENCHMARK("P2World::raycast | 1000 rays x 10000 bodies")
+	{
+		world.raycast(rays, hits);
+		return hits.size();
+	};
+}
+
+
+TEST_CASE("P2World : contact mode benchmark")
+{
+	for (const auto mode : { P2ContactMode::Collisions, P2ContactMode::Events })
+	{
+		P2World world;
+		world.setContactMode(mode);
+
+		const P2Body ground = world.createRect(P2BodyType::Static, Vec2{ 0, 1200 }, SizeF{ 4000, 20 });
+		Array<P2Body> bodies;
+
+		for (int32 y = 0; y < 40; ++y)
+		{
+			for (int32 x = 0; x < 100; ++x)
+			{
+				bodies << world.createRect(P2BodyType::Dynamic, Vec2{ (x * 20 - 1000), (y * 20) }, 19);
+			}
+		}
+
+		// 積み上がって接触が安定するまで進める
+		for (int32 i = 0; i < 300; ++i)
+		{
+			world.update(1.0 / 60.0);
+		}
+
+		BENCHMARK((mode == P2ContactMode::Events) ? "P2World::update | P2ContactMode::Events" : "P2World::update | P2ContactMode::Collisions")
+		{
+			world.update(1.0 / 60.0);
+			return (world.getCollisions().size() + world.getContactEvents().size());
+		};
+	}
+}
+
+
+TEST_CASE("P2World : states benchmark")
+{
+	for (const int32 num_bodies : { 1'000, 10'000, 50'000 })
+	{
+		P2World world;
+		Array<P2Body> bodies;
+
+		for (int32 i = 0; i < num_bodies; ++i)
+		{
+			bodies << world.createCircle(P2BodyType::Dynamic, Vec2{ ((i % 250) * 20), ((i / 250) * 20) }, 5);
+		}
+
+		P2BodyStates states;
+		Blob snapshot;
+		world.exportStates(states);
+		world.saveSnapshot(snapshot);
+
+		BENCHMARK(U"P2Body getters | {} bodies"_fmt(num_bodies).narrow())
+		{
+			double sum = 0.0;
+
+			for (const auto& body : bodies)
+			{
+				sum += (body.getPos().x + body.getAngle() + body.getVelocity().x + body.getAngularVelocity());
+			}
+
+			return sum;
+		};
+
+		BENCHMARK(U"P2World::exportStates | {} bodies"_fmt(num_bodies).narrow())
+		{
+			world.exportStates(states);
+			return states.size();
+		};
+
+		BENCHMARK(U"P2World::importStates | {} bodies"_fmt(num_bodies).narrow())
+		{
+			return world.importStates(states);
+		};
+
+		BENCHMARK(U"P2World::saveSnapshot | {} bodies"_fmt(num_bodies).narrow())
+		{
+			world.saveSnapshot(snapshot);
+			return snapshot.size();
+		};
+
+		BENCHMARK(U"P2World::loadSnapshot | {} bodies"_fmt(num_bodies).narrow())
+		{
+			return world.loadSnapshot(snapshot);
+		};
+	}
+}
+
+
+TEST_CASE("P2World : parallel solve benchmark")
+{
+	for (const bool parallel : { false, true })
+	{
+		P2World world;
+		world.setParallelSolveEnabled(parallel);
+		Array<P2Body> bodies;
+
+		// 独立した 64 の部屋に、それぞれ箱を積む
+		for (int32 room = 0; room < 64; ++room)
+		{
+			const double x = (room * 600);
+			bodies << world.createRect(P2BodyType::Static, Vec2{ x, 500 }, SizeF{ 500, 20 });
+
+			for (int32 i = 0; i < 100; ++i)
+			{
+				bodies << world.createRect(P2BodyType::Dynamic, Vec2{ (x - 100 + (i % 10) * 21), (480 - (i / 10) * 21) }, 20);
+			}
+		}
+
+		for (int32 i = 0; i < 60; ++i)
+		{
+			world.update(1.0 / 60.0);
+		}
+
+		BENCHMARK(parallel ? "P2World::update | 64 islands, parallel" : "P2World::update | 64 islands, serial")
+		{
+			world.update(1.0 / 60.0);
+			return world.getCollisions().size();
+		};
+	}
+}
+
+# endif
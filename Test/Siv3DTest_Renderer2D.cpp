@@ -0,0 +1,266 @@
+﻿//-----------------------------------------------
+//
+//	This file is part of the Siv3D Engine.
+//
+//	Copyright (c) 2008-2022 Ryo Suzuki
+//	Copyright (c) 2016-2022 OpenSiv3D Project
+//
+//	Licensed under the MIT License.
+//
+//-----------------------------------------------
+
+# include "Siv3DTest.hpp"
+# include <Siv3D/Renderer2D/Vertex2DBuilder.hpp>
+
+namespace
+{
+	struct BatchResult
+	{
+		size_t vertexCount = 0;
+
+		size_t indexCount = 0;
+
+		size_t drawCount = 0;
+
+		// すべてのインデックスが、同じバッファの頂点を指しているか
+		bool indicesInRange = true;
+	};
+
+	// addBatch() と同じ手順で、バッファに収まる数ずつ図形を作成する
+	BatchResult BuildBatch(const Batch2DBuildFunc& build)
+	{
+		Array<Vertex2D> vertices;
+		Array<Vertex2D::IndexType> indices;
+		Array<Vertex2DBatchOffset> offsetBuffer;
+
+		const BufferCreatorFunc bufferCreator = [&](const Vertex2D::IndexType vertexSize, const Vertex2D::IndexType indexSize)
+		{
+			vertices.resize(vertexSize);
+			indices.resize(indexSize);
+			return Vertex2DBufferPointer{ vertices.data(), indices.data(), 0 };
+		};
+
+		BatchResult result;
+		size_t offset = 0;
+
+		while (const auto indexCount = build(bufferCreator, offsetBuffer, 1.0f, offset))
+		{
+			REQUIRE(indexCount == indices.size());
+			result.vertexCount += vertices.size();
+			result.indexCount += indices.size();
+			++result.drawCount;
+			result.indicesInRange &= indices.all([&](const Vertex2D::IndexType index) { return (index < vertices.size()); });
+		}
+
+		return result;
+	}
+}
+
+TEST_CASE("Shape2D::indices()")
+{
+	const Shape2D shape = Shape2D::Star(100, Vec2{ 200, 200 });
+
+	// 頂点インデックスの配列はコピーされない
+	REQUIRE(&shape.indices() == &shape.indices());
+	REQUIRE(shape.indices().size() == 8);
+}
+
+TEST_CASE("Vertex2DBuilder : batch")
+{
+	const Array<ColorF> colors = { ColorF{ 1.0, 0.0, 0.0 }, ColorF{ 0.0, 1.0, 0.0 } };
+
+	SECTION("Rects")
+	{
+		const Array<RectF> rects = { RectF{ 10, 10, 20, 20 }, RectF{ 50, 50, 0, 0 } };
+
+		const BatchResult result = BuildBatch([&](const BufferCreatorFunc& bufferCreator, Array<Vertex2DBatchOffset>&, float, size_t& offset)
+		{
+			return Vertex2DBuilder::BuildRects(bufferCreator, rects.data(), rects.size(), colors.data(), colors.size(), offset);
+		});
+
+		REQUIRE(result.vertexCount == 8);
+		REQUIRE(result.indexCount == 12);
+		REQUIRE(result.drawCount == 1);
+		REQUIRE(result.indicesInRange);
+	}
+
+	SECTION("Rects : multiple buffers")
+	{
+		// インデックスが 65535 を超えないよう、複数回に分けて作成する
+		constexpr size_t N = 30000;
+		const Array<RectF> rects(N, RectF{ 0, 0, 10, 10 });
+		const ColorF color = Palette::White;
+
+		const BatchResult result = BuildBatch([&](const BufferCreatorFunc& bufferCreator, Array<Vertex2DBatchOffset>&, float, size_t& offset)
+		{
+			return Vertex2DBuilder::BuildRects(bufferCreator, rects.data(), rects.size(), &color, 1, offset);
+		});
+
+		REQUIRE(result.vertexCount == (N * 4));
+		REQUIRE(result.indexCount == (N * 6));
+		constexpr size_t MaxRectsPerBatch = ((65535 / 3 * 3) / 6);
+		REQUIRE(result.drawCount == ((N + MaxRectsPerBatch - 1) / MaxRectsPerBatch));
+		REQUIRE(result.indicesInRange);
+	}
+
+	SECTION("Circles")
+	{
+		const Array<Circle> circles = { Circle{ 100, 100, 10 }, Circle{ 200, 100, 0 }, Circle{ 300, 100, -5 }, Circle{ 400, 100, 500 } };
+		const ColorF color = Palette::White;
+
+		const BatchResult result = BuildBatch([&](const BufferCreatorFunc& bufferCreator, Array<Vertex2DBatchOffset>& offsetBuffer, float scale, size_t& offset)
+		{
+			return Vertex2DBuilder::BuildCircles(bufferCreator, offsetBuffer, circles.data(), circles.size(), &color, 1, scale, offset);
+		});
+
+		// 円は中心と周の頂点からなり、周の頂点 1 つにつき 1 つの三角形を作る
+		REQUIRE(result.vertexCount > (circles.size() * 7));
+		REQUIRE(result.indexCount == ((result.vertexCount - circles.size()) * 3));
+		REQUIRE(result.drawCount == 1);
+		REQUIRE(result.indicesInRange);
+	}
+
+	SECTION("Lines")
+	{
+		const Array<Line> lines = { Line{ 0, 0, 100, 100 }, Line{ 10, 10, 10, 10 } };
+
+		const BatchResult result = BuildBatch([&](const BufferCreatorFunc& bufferCreator, Array<Vertex2DBatchOffset>&, float, size_t& offset)
+		{
+			return Vertex2DBuilder::BuildLines(bufferCreator, lines.data(), lines.size(), 2.0f, colors.data(), colors.size(), offset);
+		});
+
+		REQUIRE(result.vertexCount == 8);
+		REQUIRE(result.indexCount == 12);
+		REQUIRE(result.drawCount == 1);
+		REQUIRE(result.indicesInRange);
+
+		// 太さが 0 の線は作成しない
+		const BatchResult empty = BuildBatch([&](const BufferCreatorFunc& bufferCreator, Array<Vertex2DBatchOffset>&, float, size_t& offset)
+		{
+			return Vertex2DBuilder::BuildLines(bufferCreator, lines.data(), lines.size(), 0.0f, colors.data(), colors.size(), offset);
+		});
+
+		REQUIRE(empty.drawCount == 0);
+	}
+
+	SECTION("Shapes")
+	{
+		const Array<Shape2D> shapes = { Shape2D::Star(50, Vec2{ 100, 100 }), Shape2D{}, Shape2D::Hexagon(20, Vec2{ 200, 100 }) };
+
+		const BatchResult result = BuildBatch([&](const BufferCreatorFunc& bufferCreator, Array<Vertex2DBatchOffset>& offsetBuffer, float, size_t& offset)
+		{
+			return Vertex2DBuilder::BuildShapes(bufferCreator, offsetBuffer, shapes.data(), shapes.size(), colors.data(), colors.size(), offset);
+		});
+
+		REQUIRE(result.vertexCount == (shapes[0].vertices().size() + shapes[2].vertices().size()));
+		REQUIRE(result.indexCount == ((shapes[0].indices().size() + shapes[2].indices().size()) * 3));
+		REQUIRE(result.drawCount == 1);
+		REQUIRE(result.indicesInRange);
+	}
+
+	SECTION("Empty")
+	{
+		const Array<Circle> circles;
+		const ColorF color = Palette::White;
+
+		const BatchResult result = BuildBatch([&](const BufferCreatorFunc& bufferCreator, Array<Vertex2DBatchOffset>& offsetBuffer, float scale, size_t& offset)
+		{
+			return Vertex2DBuilder::BuildCircles(bufferCreator, offsetBuffer, circles.data(), circles.size(), &color, 1, scale, offset);
+		});
+
+		REQUIRE(result.drawCount == 0);
+	}
+}
+
+TEST_CASE("DrawBatch()")
+{
+	const Array<Circle> circles = { Circle{ 100, 100, 10 }, Circle{ 200, 100, 0 }, Circle{ 300, 100, -5 } };
+	const Array<ColorF> colors = { ColorF{ 1.0, 0.0, 0.0 }, ColorF{ 0.0, 1.0, 0.0 } };
+
+	// 空の配列や、色の配列のほうが少ない場合も描ける
+	Circle::DrawBatch({});
+	Circle::DrawBatch(circles);
+	Circle::DrawBatch(circles, colors);
+	RectF::DrawBatch({ RectF{ 10, 10, 20, 20 }, RectF{ 50, 50, 0, 0 } }, colors);
+	Line::DrawBatch({ Line{ 0, 0, 100, 100 }, Line{ 10, 10, 10, 10 } }, 2.0);
+	Line::DrawBatch({ Line{ 0, 0, 100, 100 } }, 0.0);
+	Shape2D::DrawBatch({ Shape2D::Star(50, Vec2{ 100, 100 }), Shape2D{} }, colors);
+
+	Graphics2D::Flush();
+}
+
+# if defined(SIV3D_RUN_BENCHMARK)
+
+TEST_CASE("DrawBatch : benchmark")
+{
+	constexpr size_t N = 100'000;
+	Array<Circle> circles(N);
+	Array<RectF> rects(N);
+	Array<Line> lines(N);
+	Array<ColorF> colors(N);
+
+	for (size_t i = 0; i < N; ++i)
+	{
+		const Vec2 pos = RandomVec2(Scene::Rect());
+		circles[i] = Circle{ pos, Random(2.0, 8.0) };
+		rects[i] = RectF{ Arg::center = pos, 6 };
+		lines[i] = Line{ pos, pos.movedBy(RandomVec2(10.0)) };
+		colors[i] = HSV{ Random(360.0) };
+	}
+
+	// Null レンダラーで実行すると、API の呼び出しにかかる時間だけを比較できる
+	// 描画のたびに Graphics2D::Flush() で頂点バッファを空にする
+
+	BENCHMARK("Circle::draw() | 100k")
+	{
+		for (size_t i = 0; i < N; ++i)
+		{
+			circles[i].draw(colors[i]);
+		}
+
+		Graphics2D::Flush();
+	};
+
+	BENCHMARK("Circle::DrawBatch() | 100k")
+	{
+		Circle::DrawBatch(circles, colors);
+
+		Graphics2D::Flush();
+	};
+
+	BENCHMARK("RectF::draw() | 100k")
+	{
+		for (size_t i = 0; i < N; ++i)
+		{
+			rects[i].draw(colors[i]);
+		}
+
+		Graphics2D::Flush();
+	};
+
+	BENCHMARK("RectF::DrawBatch() | 100k")
+	{
+		RectF::DrawBatch(rects, colors);
+
+		Graphics2D::Flush();
+	};
+
+	BENCHMARK("Line::draw() | 100k")
+	{
+		for (size_t i = 0; i < N; ++i)
+		{
+			lines[i].draw(2.0, colors[i]);
+		}
+
+		Graphics2D::Flush();
+	};
+
+	BENCHMARK("Line::DrawBatch() | 100k")
+	{
+		Line::DrawBatch(lines, 2.0, colors);
+
+		Graphics2D::Flush();
+	};
+}
+
+# endif
@@ -0,0 +1,100 @@
+﻿//-----------------------------------------------
+//
+//	This file is part of the Siv3D Engine.
+//
+//	Copyright (c) 2008-2022 Ryo Suzuki
+//	Copyright (c) 2016-2022 OpenSiv3D Project
+//
+//	Licensed under the MIT License.
+//
+//-----------------------------------------------
+
+
+# include "Siv3DTest.hpp"
+
+namespace
+{
+	// 子プロセスと親プロセスで同じディレクトリを指す
+	[[nodiscard]]
+	FilePath ShutdownDirectory()
+	{
+		return (FileSystem::ParentPath(FileSystem::ModulePath()) + U"test/runtime/screencapture/drain/");
+	}
+}
+
+void Siv3DTestChild_ScreenCaptureShutdown()
+{
+	ScreenCapture::SetScreenshotDirectory(ShutdownDirectory());
+
+	// エンコード待ちの上限を超える数の保存を要求する
+	for (int32 i = 0; i < 8; ++i)
+	{
+		ScreenCapture::SaveCurrentFrame(U"{}.png"_fmt(i));
+		System::Update();
+	}
+
+	// 結果を待たずに終了する
+	const AsyncTask<bool> pending = ScreenCapture::SaveCurrentFrameAsync(U"pending.png");
+	System::Update();
+}
+
+TEST_CASE("ScreenCapture::SaveCurrentFrameAsync()")
+{
+	const FilePath previousDirectory = ScreenCapture::GetScreenshotDirectory();
+	const FilePath directory = FileSystem::FullPath(U"test/runtime/screencapture/");
+	ScreenCapture::SetScreenshotDirectory(FilePath{ directory });
+
+	AsyncTask<bool> task = ScreenCapture::SaveCurrentFrameAsync(U"async.png");
+	REQUIRE(task.isValid());
+
+	// 非同期の読み出しは、数フレーム以内に完了する
+	for (int32 i = 0; ((i < 10) && (not task.isReady())); ++i)
+	{
+		REQUIRE(System::Update());
+	}
+
+	REQUIRE(task.isReady());
+
+	if (System::GetRendererType() == EngineOption::Renderer::Headless)
+	{
+		// Null レンダラーは非同期の読み出しに対応しておらず、その場で読み出した空の画像は保存できない
+		REQUIRE(not task.get());
+	}
+	else
+	{
+		REQUIRE(task.get());
+		REQUIRE(Image{ directory + U"async.png" }.size() == Scene::Size());
+	}
+
+	ScreenCapture::SetScreenshotDirectory(FilePath{ previousDirectory });
+}
+
+TEST_CASE("ScreenCapture : drain on shutdown")
+{
+	const FilePath directory = ShutdownDirectory();
+	FileSystem::Remove(directory);
+
+	// 保存を要求した直後に終了する子プロセス
+	ChildProcess child{ FileSystem::ModulePath(), U"--screencapture-shutdown" };
+	REQUIRE(child);
+	child.wait();
+
+	// 読み出し中のフレームを待ち続けず、終了できる
+	REQUIRE(child.getExitCode().has_value());
+
+	if (System::GetRendererType() == EngineOption::Renderer::Headless)
+	{
+		// Null レンダラーで読み出した空の画像は保存できない
+		REQUIRE(not FileSystem::Exists(directory + U"0.png"));
+	}
+	else
+	{
+		// エンコード待ちだった画像は、終了時にすべて保存される
+		for (int32 i = 0; i < 8; ++i)
+		{
+			REQUIRE(FileSystem::Exists(directory + U"{}.png"_fmt(i)));
+		}
+	}
+
+	FileSystem::Remove(directory);
+}
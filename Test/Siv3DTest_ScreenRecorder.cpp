@@ -0,0 +1,132 @@
+﻿//-----------------------------------------------
+//
+//	This file is part of the Siv3D Engine.
+//
+//	Copyright (c) 2008-2022 Ryo Suzuki
+//	Copyright (c) 2016-2022 OpenSiv3D Project
+//
+//	Licensed under the MIT License.
+//
+//-----------------------------------------------
+
+
+# include "Siv3DTest.hpp"
+
+TEST_CASE("ScreenRecorder")
+{
+	ScreenRecorder empty;
+	REQUIRE(not empty.isOpen());
+	REQUIRE(empty.num_writtenFrames() == 0);
+	empty.captureFrame();
+
+	const FilePath path = FileSystem::FullPath(U"test/runtime/screenrecorder/scaled.mp4");
+	ScreenRecorder recorder{ path, Size{ 320, 240 }, 30.0 };
+	REQUIRE(recorder.isOpen());
+	REQUIRE(recorder.getSize() == Size{ 320, 240 });
+	REQUIRE(recorder.getFPS() == 30.0);
+
+	constexpr size_t NumFrames = 30;
+
+	for (size_t i = 0; i < NumFrames; ++i)
+	{
+		Scene::Rect().draw(HSV{ (i * 12.0) });
+		recorder.captureFrame();
+		REQUIRE(System::Update());
+	}
+
+	// 読み出し中のフレームが書き出しのスレッドに渡るまで待つ
+	for (int32 i = 0; i < 3; ++i)
+	{
+		REQUIRE(System::Update());
+	}
+
+	recorder.close();
+	REQUIRE(not recorder.isOpen());
+
+	if (System::GetRendererType() == EngineOption::Renderer::Headless)
+	{
+		// Null レンダラーでは読み出した画像が空のため、すべてのフレームが破棄される
+		REQUIRE(recorder.num_writtenFrames() == 0);
+		REQUIRE(recorder.num_droppedFrames() == NumFrames);
+	}
+	else
+	{
+		// 書き出しが間に合わなかったフレームは前後のフレームで埋められ、動画の長さは変わらない
+		REQUIRE(recorder.num_writtenFrames() == NumFrames);
+
+		const VideoReader video{ path };
+		REQUIRE(video.getSize() == Size{ 320, 240 });
+		REQUIRE(video.getFrameCount() == NumFrames);
+	}
+
+	// 録画を閉じる前に要求したフレームは、次の録画に含まれない
+	REQUIRE(recorder.open(FileSystem::FullPath(U"test/runtime/screenrecorder/reopen.mp4"), Size{ 160, 120 }, 30.0));
+	recorder.captureFrame();
+	REQUIRE(recorder.open(FileSystem::FullPath(U"test/runtime/screenrecorder/reopen.mp4"), Size{ 160, 120 }, 30.0));
+
+	for (int32 i = 0; i < 3; ++i)
+	{
+		REQUIRE(System::Update());
+	}
+
+	REQUIRE(recorder.num_writtenFrames() == 0);
+	REQUIRE(recorder.num_droppedFrames() == 0);
+}
+
+TEST_CASE("ScreenRecorder : frame order")
+{
+	const FilePath path = FileSystem::FullPath(U"test/runtime/screenrecorder/order.mp4");
+	ScreenRecorder recorder{ path, Size{ 320, 240 }, 30.0 };
+	REQUIRE(recorder.isOpen());
+
+	// 垂直同期を無効にして GPU の処理を溜め、読み出し中のフレームがあるままその場での読み出しが起こるようにする
+	const bool vsync = Graphics::IsVSyncEnabled();
+	Graphics::SetVSyncEnabled(false);
+
+	constexpr size_t NumFrames = 30;
+
+	for (size_t i = 0; i < NumFrames; ++i)
+	{
+		for (int32 k = 0; k < 200; ++k)
+		{
+			Scene::Rect().draw(ColorF{ 0.0, 0.01 });
+		}
+
+		// フレームごとに明るくする
+		Scene::Rect().draw(Color{ static_cast<uint8>(i * 8) });
+		recorder.captureFrame();
+		REQUIRE(System::Update());
+	}
+
+	for (int32 i = 0; i < 3; ++i)
+	{
+		REQUIRE(System::Update());
+	}
+
+	Graphics::SetVSyncEnabled(vsync);
+	recorder.close();
+
+	if (System::GetRendererType() == EngineOption::Renderer::Headless)
+	{
+		REQUIRE(recorder.num_writtenFrames() == 0);
+		return;
+	}
+
+	REQUIRE(recorder.num_writtenFrames() == NumFrames);
+
+	// 動画のフレームは、録画を要求した順に並ぶ（破棄したフレームは前後のフレームの繰り返しになる）
+	VideoReader video{ path };
+	REQUIRE(video.getFrameCount() == NumFrames);
+
+	Image frame;
+	int32 previous = -1;
+
+	for (size_t i = 0; i < NumFrames; ++i)
+	{
+		REQUIRE(video.readFrame(frame));
+
+		const int32 brightness = frame[frame.height() / 2][frame.width() / 2].r;
+		REQUIRE((previous - 3) <= brightness);
+		previous = brightness;
+	}
+}
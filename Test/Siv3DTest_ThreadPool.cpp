@@ -0,0 +1,182 @@
+﻿//-----------------------------------------------
+//
+//	This file is part of the Siv3D Engine.
+//
+//	Copyright (c) 2008-2022 Ryo Suzuki
+//	Copyright (c) 2016-2022 OpenSiv3D Project
+//
+//	Licensed under the MIT License.
+//
+//-----------------------------------------------
+
+# include "Siv3DTest.hpp"
+
+TEST_CASE("ThreadPool::submit()")
+{
+	ThreadPool pool{ 4 };
+	REQUIRE(pool.num_threads() == 4);
+
+	WaitGroup waitGroup;
+	std::atomic<int32> count = 0;
+
+	for (int32 i = 0; i < 1000; ++i)
+	{
+		pool.submit(waitGroup, [&]() { ++count; });
+	}
+
+	pool.wait(waitGroup);
+	REQUIRE(waitGroup.isDone());
+	REQUIRE(count == 1000);
+}
+
+TEST_CASE("ThreadPool::parallel_for()")
+{
+	ThreadPool pool{ 3 };
+
+	for (const size_t grainSize : { 1, 7, 64, 1000, 5000 })
+	{
+		Array<int32> v(4000, 0);
+		std::atomic<bool> oversized = false;
+
+		pool.parallel_for(0, v.size(), grainSize, [&](size_t first, size_t last)
+		{
+			if (grainSize < (last - first))
+			{
+				oversized = true;
+			}
+
+			for (size_t i = first; i < last; ++i)
+			{
+				++v[i];
+			}
+		});
+
+		REQUIRE(not oversized);
+		REQUIRE(v.all([](int32 n) { return (n == 1); }));
+	}
+
+	REQUIRE_THROWS_AS(pool.parallel_for(0, 100, 1, [](size_t first, size_t) { if (first == 50) { throw std::runtime_error{ "" }; } }), std::runtime_error);
+}
+
+TEST_CASE("ThreadPool : nested tasks")
+{
+	ThreadPool pool{ 1 };
+
+	auto task = Async(pool, [&pool]()
+	{
+		// ワーカースレッドが 1 つでも、内側のタスクの完了を待てる
+		auto inner = Async(pool, []() { return 21; });
+		return (inner.get() * 2);
+	});
+
+	REQUIRE(task.get() == 42);
+}
+
+TEST_CASE("Async() : dedicated threads")
+{
+	std::atomic<bool> released = false;
+	Array<AsyncTask<void>> blockingTasks;
+
+	// スレッドプールのワーカースレッドより多くの、長時間ブロックするタスク
+	for (size_t i = 0; i <= Threading::GetConcurrency(); ++i)
+	{
+		blockingTasks << Async([&released]()
+		{
+			while (not released)
+			{
+				std::this_thread::sleep_for(std::chrono::milliseconds(1));
+			}
+		});
+	}
+
+	// Async(f) は専用のスレッドで実行されるため、スレッドプールのタスクは待たされない
+	auto task = Async(Threading::GetDefaultPool(), []() { return 42; });
+	const std::future_status status = task.wait_for(std::chrono::seconds(10));
+
+	released = true;
+	blockingTasks.clear();
+
+	REQUIRE(status == std::future_status::ready);
+	REQUIRE(task.get() == 42);
+}
+
+# if defined(SIV3D_RUN_BENCHMARK)
+
+TEST_CASE("ThreadPool : benchmark")
+{
+	Array<double> v(64 * 1024);
+	for (size_t i = 0; i < v.size(); ++i)
+	{
+		v[i] = Random();
+	}
+
+	const size_t numThreads = Threading::GetConcurrency();
+
+	// 変更前の Array::parallel_count_if() と同じ、呼び出しごとに std::async でスレッドを起動する実装
+	const auto asyncCountIf = [&](auto f)
+	{
+		const size_t countPerthread = Max<size_t>(1, (v.size() + (numThreads - 1)) / numThreads);
+		Array<std::future<std::ptrdiff_t>> futures;
+		auto it = v.begin();
+		size_t countLeft = v.size();
+
+		for (size_t i = 0; i < (numThreads - 1); ++i)
+		{
+			const size_t n = Min(countPerthread, countLeft);
+			futures.emplace_back(std::async(std::launch::async, [=]() { return std::count_if(it, it + n, f); }));
+			it += n;
+			countLeft -= n;
+		}
+
+		size_t result = std::count_if(it, it + countLeft, f);
+
+		for (auto& future : futures)
+		{
+			result += future.get();
+		}
+
+		return result;
+	};
+
+	BENCHMARK("std::async | 64K")
+	{
+		return asyncCountIf([](double x) { return x < 0.5; });
+	};
+
+	BENCHMARK("ThreadPool | 64K")
+	{
+		return v.parallel_count_if([](double x) { return x < 0.5; }, Threading::GetDefaultPool());
+	};
+
+	BENCHMARK("std::async | Async() x 64")
+	{
+		Array<std::future<int32>> tasks;
+		for (int32 i = 0; i < 64; ++i)
+		{
+			tasks << std::async(std::launch::async, [i]() { return i; });
+		}
+		int32 sum = 0;
+		for (auto& task : tasks)
+		{
+			sum += task.get();
+		}
+		return sum;
+	};
+
+	BENCHMARK("ThreadPool | Async() x 64")
+	{
+		Array<AsyncTask<int32>> tasks;
+		for (int32 i = 0; i < 64; ++i)
+		{
+			tasks << Async(Threading::GetDefaultPool(), [i]() { return i; });
+		}
+		int32 sum = 0;
+		for (auto& task : tasks)
+		{
+			sum += task.get();
+		}
+		return sum;
+	};
+}
+
+# endif
@@ -0,0 +1,180 @@
+﻿//-----------------------------------------------
+//
+//	This file is part of the Siv3D Engine.
+//
+//	Copyright (c) 2008-2022 Ryo Suzuki
+//	Copyright (c) 2016-2022 OpenSiv3D Project
+//
+//	Licensed under the MIT License.
+//
+//-----------------------------------------------
+
+# include "Siv3DTest.hpp"
+
+namespace
+{
+	// 1 文字ずつ変換する単純な実装
+	String ReferenceFromUTF8(const std::string_view s)
+	{
+		String result;
+
+		for (size_t i = 0; i < s.size();)
+		{
+			const uint8 b0 = static_cast<uint8>(s[i]);
+			const size_t length = ((b0 < 0x80) ? 1 : (b0 < 0xC0) ? 0 : (b0 < 0xE0) ? 2 : (b0 < 0xF0) ? 3 : (b0 < 0xF8) ? 4 : 0);
+			char32 ch = ((length == 1) ? b0 : (b0 & (0x7F >> length)));
+			bool valid = ((length != 0) && ((i + length) <= s.size()));
+
+			for (size_t k = 1; valid && (k < length); ++k)
+			{
+				const uint8 b = static_cast<uint8>(s[i + k]);
+				valid = ((b & 0xC0) == 0x80);
+				ch = ((ch << 6) | (b & 0x3F));
+			}
+
+			constexpr char32 MinCodePoints[] = { 0, 0, 0x80, 0x800, 0x10000 };
+
+			if (valid && (ch < MinCodePoints[length] || 0x10FFFF < ch))
+			{
+				valid = false;
+			}
+
+			result << (valid ? ch : U'\xFFFD');
+			i += (valid ? length : 1);
+		}
+
+		return result;
+	}
+
+	String MakeText(const Array<char32>& chars, const size_t length)
+	{
+		String s;
+
+		for (size_t i = 0; i < length; ++i)
+		{
+			s << chars.choice();
+		}
+
+		return s;
+	}
+}
+
+TEST_CASE("Unicode::FromUTF8()")
+{
+	REQUIRE(Unicode::FromUTF8("") == U"");
+	REQUIRE(Unicode::FromUTF8("Siv3D") == U"Siv3D");
+	REQUIRE(Unicode::FromUTF8("\xC3\xA9" "\xE3\x81\x82" "\xF0\x9F\x98\x80") == U"éあ\U0001F600");
+
+	// 不正なシーケンス（冗長表現、範囲外、途中で切れたシーケンス）は 1 バイトごとに U+FFFD になる
+	REQUIRE(Unicode::FromUTF8("\xC0\x80") == U"\xFFFD\xFFFD");
+	REQUIRE(Unicode::FromUTF8("\xE0\x80\x80" "abc") == U"\xFFFD\xFFFD\xFFFD" U"abc");
+	REQUIRE(Unicode::FromUTF8("\xF4\x90\x80\x80") == U"\xFFFD\xFFFD\xFFFD\xFFFD");
+	REQUIRE(Unicode::FromUTF8("abcdefghijklmnopqrstuvwxyz\xE3\x81") == U"abcdefghijklmnopqrstuvwxyz\xFFFD\xFFFD");
+
+	const Array<char32> chars = { U'a', U'Z', U' ', U'é', U'Ω', U'あ', U'漢', U'！', U'\U0001F600', U'\U0001F680' };
+
+	for (size_t length : { 1, 15, 16, 17, 31, 32, 33, 100, 1000 })
+	{
+		const String text = MakeText(chars, length);
+		std::string utf8 = text.toUTF8();
+		REQUIRE(Unicode::FromUTF8(utf8) == text);
+		REQUIRE(Unicode::FromUTF8(utf8) == ReferenceFromUTF8(utf8));
+
+		// ランダムなバイトを壊しても、1 文字ずつ変換した場合と一致する
+		for (int32 i = 0; i < 8; ++i)
+		{
+			utf8[Random(utf8.size() - 1)] = static_cast<char>(Random(255));
+			REQUIRE(Unicode::FromUTF8(utf8) == ReferenceFromUTF8(utf8));
+		}
+	}
+}
+
+TEST_CASE("Unicode::ToUTF8()")
+{
+	REQUIRE(Unicode::ToUTF8(U"") == "");
+	REQUIRE(Unicode::ToUTF8(U"Siv3D") == "Siv3D");
+	REQUIRE(Unicode::ToUTF8(U"éあ\U0001F600") == "\xC3\xA9" "\xE3\x81\x82" "\xF0\x9F\x98\x80");
+
+	// 範囲外のコードポイントは U+FFFD になる
+	constexpr char32 OutOfRange[] = { 0x110000 };
+	REQUIRE(Unicode::ToUTF8(StringView{ OutOfRange, 1 }) == "\xEF\xBF\xBD");
+
+	const Array<char32> chars = { U'a', U'Z', U' ', U'é', U'Ω', U'あ', U'漢', U'！', U'\U0001F600', U'\U0001F680' };
+
+	for (size_t length : { 1, 3, 4, 5, 15, 16, 17, 31, 32, 33, 100, 1000 })
+	{
+		const String text = MakeText(chars, length);
+		REQUIRE(Unicode::FromUTF8(Unicode::ToUTF8(text)) == text);
+		REQUIRE(Unicode::FromUTF16(Unicode::ToUTF16(text)) == text);
+		REQUIRE(Unicode::UTF8ToUTF16(Unicode::ToUTF8(text)) == Unicode::ToUTF16(text));
+	}
+}
+
+TEST_CASE("Unicode::FromUTF16()")
+{
+	REQUIRE(Unicode::FromUTF16(u"") == U"");
+	REQUIRE(Unicode::FromUTF16(u"Siv3D あ \U0001F600") == U"Siv3D あ \U0001F600");
+
+	// 対になっていないサロゲートは U+FFFD になる
+	REQUIRE(Unicode::FromUTF16(std::u16string{ u'a', char16(0xD800), u'b', char16(0xDC00), u'c' }) == U"a\xFFFD" U"b\xFFFD" U"c");
+	REQUIRE(Unicode::FromUTF16(std::u16string(20, u'x') + char16(0xD83D)) == (String(20, U'x') + U'\xFFFD'));
+}
+
+# if defined(SIV3D_RUN_BENCHMARK)
+
+TEST_CASE("Unicode : benchmark")
+{
+	// ASCII, 日本語 (3 バイト), 絵文字 (4 バイト) それぞれ 1 MiB 程度
+	const String ascii = MakeText({ U'a', U'b', U'c', U'X', U'Y', U'Z', U'0', U'1', U' ', U'.' }, (1 << 20));
+	const String cjk = MakeText({ U'あ', U'い', U'う', U'漢', U'字', U'文', U'書' }, (1 << 18));
+	const String emoji = MakeText({ U'\U0001F600', U'\U0001F680', U'\U0001F34E', U'\U0001F431' }, (1 << 18));
+
+	const std::string asciiUTF8 = Unicode::ToUTF8(ascii);
+	const std::string cjkUTF8 = Unicode::ToUTF8(cjk);
+	const std::string emojiUTF8 = Unicode::ToUTF8(emoji);
+
+	// スループット (GB/s) は UTF-8 のサイズ / 所要時間
+	BENCHMARK("FromUTF8 | ASCII 1 MiB")
+	{
+		return Unicode::FromUTF8(asciiUTF8);
+	};
+
+	BENCHMARK("FromUTF8 | CJK 768 KiB")
+	{
+		return Unicode::FromUTF8(cjkUTF8);
+	};
+
+	BENCHMARK("FromUTF8 | Emoji 1 MiB")
+	{
+		return Unicode::FromUTF8(emojiUTF8);
+	};
+
+	BENCHMARK("ToUTF8 | ASCII 1 MiB")
+	{
+		return Unicode::ToUTF8(ascii);
+	};
+
+	BENCHMARK("ToUTF8 | CJK 768 KiB")
+	{
+		return Unicode::ToUTF8(cjk);
+	};
+
+	BENCHMARK("ToUTF8 | Emoji 1 MiB")
+	{
+		return Unicode::ToUTF8(emoji);
+	};
+
+	const std::u16string cjkUTF16 = Unicode::ToUTF16(cjk);
+
+	BENCHMARK("FromUTF16 | CJK 512 KiB")
+	{
+		return Unicode::FromUTF16(cjkUTF16);
+	};
+
+	BENCHMARK("ToUTF16 | CJK 512 KiB")
+	{
+		return Unicode::ToUTF16(cjk);
+	};
+}
+
+# endif